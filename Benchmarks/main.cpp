@@ -0,0 +1,306 @@
+/* Copyright 2020 Maxence Thevenet, Remi Lehe
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+/* Standalone microbenchmarks of the hot WarpX kernels.
+ *
+ * Each benchmark synthesizes particle and field data, times one kernel and
+ * prints one JSON record per measurement to stdout, e.g.
+ *
+ *   {"kernel": "doDepositionShapeN", "shape": 3, "n": 1048576, ...}
+ *
+ * so that results can be tracked across commits without running a full
+ * simulation. Build from the repository root with `make benchmarks` (see
+ * Benchmarks/GNUmakefile for the configuration knobs: DIM, COMP, USE_GPU,
+ * USE_PSATD, ...) and run the resulting executable on a single rank:
+ *
+ *   ./Benchmarks/benchmarks3d.gnu.MPI.OMP.ex [benchmarks.ncell=...]
+ *
+ * Runtime parameters (all optional):
+ *   benchmarks.ncell   : cells per direction of the field box (default: 64)
+ *   benchmarks.np      : number of macroparticles (default: 1048576)
+ *   benchmarks.nrepeat : timed calls per kernel; the fastest is reported
+ *                        (default: 10)
+ */
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Gather/FieldGather.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/Pusher/UpdateMomentumBoris.H"
+#include "Filter/BilinearFilter.H"
+#include "Utils/WarpXConst.H"
+#ifdef WARPX_USE_PSATD
+#   include "FieldSolver/SpectralSolver/SpectralKSpace.H"
+#   include "FieldSolver/SpectralSolver/SpectralFieldData.H"
+#   include "FieldSolver/SpectralSolver/SpectralAlgorithms/PsatdAlgorithm.H"
+#endif
+
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Gpu.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+using namespace amrex;
+
+namespace
+{
+
+using PType = WarpXParticleContainer::ParticleType;
+
+/** Time a kernel launch: one warm-up call, then the fastest of nrepeat
+ * timed calls (each bracketed by a device synchronization) */
+template <typename F>
+Real TimeKernel (F&& f, const int nrepeat)
+{
+    f();
+    Gpu::synchronize();
+    Real best = std::numeric_limits<Real>::max();
+    for (int i = 0; i < nrepeat; ++i) {
+        const Real t_begin = amrex::second();
+        f();
+        Gpu::synchronize();
+        best = std::min(best, amrex::second() - t_begin);
+    }
+    return best;
+}
+
+/** Print one JSON record (one line per measurement) to stdout
+ * \param kernel name of the timed kernel
+ * \param shape shape order, or -1 when not applicable
+ * \param n number of particles (or cells) processed per call
+ * \param time elapsed seconds of the fastest call
+ */
+void PrintRecord (const std::string& kernel, const int shape,
+                  const long n, const Real time)
+{
+    if (!ParallelDescriptor::IOProcessor()) return;
+    std::printf("{\"kernel\": \"%s\", \"shape\": %d, \"n\": %ld, "
+                "\"seconds\": %.6e, \"ns_per_item\": %.3f}\n",
+                kernel.c_str(), shape, n, time, 1.e9*time/n);
+}
+
+/** Synthetic macroparticles: structs with uniform random positions in
+ * [0, ncell*dx) per direction, and the usual real attributes */
+struct SyntheticParticles
+{
+    SyntheticParticles (const long np, const Real length)
+    {
+        Vector<PType> h_structs(np);
+        Vector<ParticleReal> h_u(np);
+        for (long i = 0; i < np; ++i) {
+            PType& p = h_structs[i];
+            p.id() = i+1;
+            p.cpu() = 0;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                p.pos(d) = length*amrex::Random();
+            }
+            // mildly relativistic thermal momenta
+            h_u[i] = PhysConst::c*(amrex::Random() - 0.5);
+        }
+        m_structs.resize(np);
+        Gpu::copyAsync(Gpu::hostToDevice, h_structs.begin(), h_structs.end(),
+                       m_structs.begin());
+        for (auto* v : {&m_w, &m_ux, &m_uy, &m_uz,
+                        &m_Ex, &m_Ey, &m_Ez, &m_Bx, &m_By, &m_Bz}) {
+            v->resize(np);
+            Gpu::copyAsync(Gpu::hostToDevice, h_u.begin(), h_u.end(),
+                           v->begin());
+        }
+        Gpu::streamSynchronize();
+    }
+
+    GetParticlePosition GetPosition () const
+    {
+        return GetParticlePosition(m_structs.dataPtr());
+    }
+
+    Gpu::DeviceVector<PType> m_structs;
+    Gpu::DeviceVector<ParticleReal> m_w, m_ux, m_uy, m_uz;
+    Gpu::DeviceVector<ParticleReal> m_Ex, m_Ey, m_Ez, m_Bx, m_By, m_Bz;
+};
+
+/** Benchmark the direct current deposition at one shape order */
+template <int depos_order>
+void BenchmarkDeposition (SyntheticParticles& particles,
+                          const Box& fab_box, const Real dt,
+                          const std::array<Real,3>& dx,
+                          const int nrepeat)
+{
+    FArrayBox jx_fab(fab_box), jy_fab(fab_box), jz_fab(fab_box);
+    jx_fab.setVal<RunOn::Device>(0.);
+    jy_fab.setVal<RunOn::Device>(0.);
+    jz_fab.setVal<RunOn::Device>(0.);
+
+    const long np = particles.m_structs.size();
+    const auto GetPosition = particles.GetPosition();
+    const std::array<Real,3> xyzmin {0., 0., 0.};
+    const Dim3 lo = lbound(fab_box);
+
+    const Real time = TimeKernel([&] () {
+        doDepositionShapeN<depos_order>(
+            GetPosition, particles.m_w.dataPtr(),
+            particles.m_ux.dataPtr(), particles.m_uy.dataPtr(),
+            particles.m_uz.dataPtr(), nullptr,
+            jx_fab, jy_fab, jz_fab, np, dt, dx, xyzmin, lo,
+            PhysConst::q_e, 0);
+    }, nrepeat);
+    PrintRecord("doDepositionShapeN", depos_order, np, time);
+}
+
+/** Benchmark the field gather at one shape order */
+template <int depos_order>
+void BenchmarkGather (SyntheticParticles& particles,
+                      const Box& fab_box,
+                      const std::array<Real,3>& dx,
+                      const int nrepeat)
+{
+    FArrayBox field_fab(fab_box);
+    field_fab.setVal<RunOn::Device>(1.);
+
+    const long np = particles.m_structs.size();
+    const auto GetPosition = particles.GetPosition();
+    const std::array<Real,3> xyzmin {0., 0., 0.};
+    const Dim3 lo = lbound(fab_box);
+
+    const Real time = TimeKernel([&] () {
+        doGatherShapeN<depos_order,1>(
+            GetPosition,
+            particles.m_Ex.dataPtr(), particles.m_Ey.dataPtr(),
+            particles.m_Ez.dataPtr(), particles.m_Bx.dataPtr(),
+            particles.m_By.dataPtr(), particles.m_Bz.dataPtr(),
+            &field_fab, &field_fab, &field_fab,
+            &field_fab, &field_fab, &field_fab,
+            np, dx, xyzmin, lo, 0);
+    }, nrepeat);
+    PrintRecord("doGatherShapeN", depos_order, np, time);
+}
+
+/** Benchmark the Boris momentum push */
+void BenchmarkBorisPush (SyntheticParticles& particles, const Real dt,
+                         const int nrepeat)
+{
+    const long np = particles.m_structs.size();
+    ParticleReal* const AMREX_RESTRICT ux = particles.m_ux.dataPtr();
+    ParticleReal* const AMREX_RESTRICT uy = particles.m_uy.dataPtr();
+    ParticleReal* const AMREX_RESTRICT uz = particles.m_uz.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Ex = particles.m_Ex.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Ey = particles.m_Ey.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Ez = particles.m_Ez.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Bx = particles.m_Bx.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT By = particles.m_By.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Bz = particles.m_Bz.dataPtr();
+    const Real q = -PhysConst::q_e;
+    const Real m = PhysConst::m_e;
+
+    const Real time = TimeKernel([&] () {
+        amrex::ParallelFor(np,
+        [=] AMREX_GPU_DEVICE (long i) {
+            UpdateMomentumBoris(ux[i], uy[i], uz[i],
+                                Ex[i], Ey[i], Ez[i],
+                                Bx[i], By[i], Bz[i], q, m, dt);
+        });
+    }, nrepeat);
+    PrintRecord("UpdateMomentumBoris", -1, np, time);
+}
+
+/** Benchmark the bilinear filter on a three-component MultiFab */
+void BenchmarkBilinearFilter (const Box& domain, const int nrepeat)
+{
+    BoxArray ba(domain);
+    DistributionMapping dm {ba};
+    constexpr int ncomp = 3;
+
+    BilinearFilter filter;
+    filter.npass_each_dir = IntVect::TheUnitVector();
+    filter.ComputeStencils();
+
+    MultiFab src(ba, dm, ncomp, filter.stencil_length_each_dir - IntVect::TheUnitVector());
+    MultiFab dst(ba, dm, ncomp, filter.stencil_length_each_dir - IntVect::TheUnitVector());
+    src.setVal(1.);
+    dst.setVal(0.);
+
+    const Real time = TimeKernel([&] () {
+        filter.ApplyStencil(dst, src, 0, 0, ncomp);
+    }, nrepeat);
+    PrintRecord("BilinearFilter::ApplyStencil", -1,
+                ncomp*domain.numPts(), time);
+}
+
+#ifdef WARPX_USE_PSATD
+/** Benchmark the PSATD update of the fields in spectral space */
+void BenchmarkPsatdPush (const Box& domain, const std::array<Real,3>& dx,
+                         const Real dt, const int nrepeat)
+{
+    BoxArray ba(domain);
+    DistributionMapping dm {ba};
+    const RealVect dx_v(AMREX_D_DECL(dx[0], dx[1], dx[2]));
+
+    SpectralKSpace k_space(ba, dm, dx_v);
+    PsatdAlgorithm psatd(k_space, dm, 16, 16, 16, false, dt);
+    SpectralFieldData fields(ba, k_space, dm,
+                             SpectralFieldIndex::n_fields, false);
+
+    const Real time = TimeKernel([&] () {
+        psatd.pushSpectralFields(fields);
+    }, nrepeat);
+    PrintRecord("PsatdAlgorithm::pushSpectralFields", -1,
+                domain.numPts(), time);
+}
+#endif
+
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        ParmParse pp("benchmarks");
+        int ncell = 64;
+        long np = 1048576;
+        int nrepeat = 10;
+        pp.query("ncell", ncell);
+        pp.query("np", np);
+        pp.query("nrepeat", nrepeat);
+
+        const Real dx = 1.e-6;
+        const Real dt = 0.5*dx/PhysConst::c;
+        const std::array<Real,3> dx_arr {dx, dx, dx};
+
+        // Cell-centered domain; the particles are spread over all of it, so
+        // the fabs carry enough guard cells for the widest stencil (order 3)
+        const Box domain(IntVect::TheZeroVector(),
+                         (ncell-1)*IntVect::TheUnitVector());
+        const Box fab_box = amrex::grow(amrex::surroundingNodes(domain), 4);
+
+        SyntheticParticles particles(np, ncell*dx);
+
+        BenchmarkDeposition<1>(particles, fab_box, dt, dx_arr, nrepeat);
+        BenchmarkDeposition<2>(particles, fab_box, dt, dx_arr, nrepeat);
+        BenchmarkDeposition<3>(particles, fab_box, dt, dx_arr, nrepeat);
+
+        BenchmarkGather<1>(particles, fab_box, dx_arr, nrepeat);
+        BenchmarkGather<2>(particles, fab_box, dx_arr, nrepeat);
+        BenchmarkGather<3>(particles, fab_box, dx_arr, nrepeat);
+
+        BenchmarkBorisPush(particles, dt, nrepeat);
+
+        BenchmarkBilinearFilter(domain, nrepeat);
+
+#ifdef WARPX_USE_PSATD
+        BenchmarkPsatdPush(domain, dx_arr, dt, nrepeat);
+#endif
+    }
+    amrex::Finalize();
+}
@@ -165,6 +165,18 @@ libwarpx.warpx_getChargeDensityCP.restype = _LP_LP_c_real
 libwarpx.warpx_getChargeDensityCPLoVects.restype = _LP_c_int
 libwarpx.warpx_getChargeDensityFP.restype = _LP_LP_c_real
 libwarpx.warpx_getChargeDensityFPLoVects.restype = _LP_c_int
+libwarpx.warpx_getEfieldViews.restype = _LP_LP_c_real
+libwarpx.warpx_getEfieldCPViews.restype = _LP_LP_c_real
+libwarpx.warpx_getEfieldFPViews.restype = _LP_LP_c_real
+libwarpx.warpx_getBfieldViews.restype = _LP_LP_c_real
+libwarpx.warpx_getBfieldCPViews.restype = _LP_LP_c_real
+libwarpx.warpx_getBfieldFPViews.restype = _LP_LP_c_real
+libwarpx.warpx_getCurrentDensityViews.restype = _LP_LP_c_real
+libwarpx.warpx_getCurrentDensityCPViews.restype = _LP_LP_c_real
+libwarpx.warpx_getCurrentDensityFPViews.restype = _LP_LP_c_real
+libwarpx.warpx_getEfieldSnapshotViews.restype = _LP_LP_c_real
+libwarpx.warpx_getBfieldSnapshotViews.restype = _LP_LP_c_real
+libwarpx.warpx_getParticleSoA.restype = _LP_LP_c_particlereal
 
 libwarpx.warpx_getEx_nodal_flag.restype = _LP_c_int
 libwarpx.warpx_getEy_nodal_flag.restype = _LP_c_int
@@ -481,6 +493,55 @@ def get_particle_arrays(species_number, comp, level):
     return particle_data
 
 
+def get_particle_soa(species_number, level=0):
+    '''
+
+    This returns a list of lists of numpy arrays, one list per real particle
+    component, containing the particle array data on each tile for this
+    process. All components are fetched in a single call, instead of one
+    call per component as with get_particle_arrays.
+
+    The data for the numpy arrays are not copied, but share the underlying
+    memory buffer with WarpX. The numpy arrays are fully writeable.
+
+    Parameters
+    ----------
+
+        species_number : the species id that the data will be returned for
+
+    Returns
+    -------
+
+        A list of lists of numpy arrays, indexed by [component][tile].
+
+    '''
+
+    particles_per_tile = _LP_c_int()
+    num_tiles = ctypes.c_int(0)
+    num_comps = ctypes.c_int(0)
+    data = libwarpx.warpx_getParticleSoA(species_number, level,
+                                         ctypes.byref(num_tiles),
+                                         ctypes.byref(num_comps),
+                                         ctypes.byref(particles_per_tile))
+
+    particle_data = []
+    for comp in range(num_comps.value):
+        comp_data = []
+        for i in range(num_tiles.value):
+            arr = np.ctypeslib.as_array(data[comp*num_tiles.value + i], (particles_per_tile[i],))
+            try:
+                # This fails on some versions of numpy
+                arr.setflags(write=1)
+            except ValueError:
+                pass
+            comp_data.append(arr)
+        particle_data.append(comp_data)
+
+    _libc.free(particles_per_tile)
+    _libc.free(data)
+    return particle_data
+
+
 def get_particle_x(species_number, level=0):
     '''
 
@@ -1198,6 +1259,212 @@ def get_mesh_charge_density_fp(level, include_ghosts=True):
     return _get_mesh_field_list(libwarpx.warpx_getChargeDensityFP, level, None, include_ghosts)
 
 
+def _get_mesh_field_views(warpx_func, level, include_ghosts):
+    '''
+     Generic routine to fetch the field data arrays and lo vectors of all
+     three components of a vector field in a single call.
+    '''
+    shapes = _LP_c_int()
+    lovects_p = _LP_c_int()
+    size = ctypes.c_int(0)
+    ncomps = ctypes.c_int(0)
+    ngrow = ctypes.c_int(0)
+    data = warpx_func(level,
+                      ctypes.byref(size), ctypes.byref(ncomps),
+                      ctypes.byref(ngrow), ctypes.byref(shapes),
+                      ctypes.byref(lovects_p))
+    ng = ngrow.value
+    shapesize = dim
+    if ncomps.value > 1:
+        shapesize += 1
+    grid_data = []
+    lovects = []
+    for idir in range(3):
+        dir_data = []
+        dir_lovects = np.zeros((dim, size.value), dtype='i4')
+        for i in range(size.value):
+            j = idir*size.value + i
+            shape = tuple([shapes[shapesize*j + d] for d in range(shapesize)])
+            # --- The data is stored in Fortran order, hence shape is reversed and a transpose is taken.
+            arr = np.ctypeslib.as_array(data[j], shape[::-1]).T
+            try:
+                # This fails on some versions of numpy
+                arr.setflags(write=1)
+            except ValueError:
+                pass
+            if include_ghosts:
+                dir_data.append(arr)
+            else:
+                dir_data.append(arr[tuple([slice(ng, -ng) for _ in range(dim)])])
+            for d in range(dim):
+                dir_lovects[d,i] = lovects_p[dim*j + d]
+        if not include_ghosts:
+            dir_lovects += ng
+        grid_data.append(dir_data)
+        lovects.append(dir_lovects)
+
+    _libc.free(shapes)
+    _libc.free(lovects_p)
+    _libc.free(data)
+    return grid_data, lovects
+
+
+def get_mesh_electric_field_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh electric field data and lo vectors for all three
+    directions in a single call, instead of one call per direction and
+    quantity. This version is for the full "auxiliary" solution on the
+    given level.
+
+    The data for the numpy arrays are not copied, but share the underlying
+    memory buffer with WarpX. The numpy arrays are fully writeable.
+
+    Parameters
+    ----------
+
+        level          : the AMR level to get the data for
+        include_ghosts : whether to include ghost zones or not
+
+    Returns
+    -------
+
+        A tuple of two lists, indexed by direction: the first holds, for each
+        direction, a list of numpy arrays (one per grid), and the second the
+        corresponding 2d numpy arrays of lo vectors with shape
+        (dims, number of grids).
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getEfieldViews, level, include_ghosts)
+
+
+def get_mesh_electric_field_cp_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh electric field data and lo vectors for all three
+    directions in a single call. This version returns the field on the
+    coarse patch for the given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getEfieldCPViews, level, include_ghosts)
+
+
+def get_mesh_electric_field_fp_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh electric field data and lo vectors for all three
+    directions in a single call. This version returns the field on the
+    fine patch for the given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getEfieldFPViews, level, include_ghosts)
+
+
+def get_mesh_magnetic_field_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh magnetic field data and lo vectors for all three
+    directions in a single call, instead of one call per direction and
+    quantity. This version is for the full "auxiliary" solution on the
+    given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getBfieldViews, level, include_ghosts)
+
+
+def get_mesh_magnetic_field_cp_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh magnetic field data and lo vectors for all three
+    directions in a single call. This version returns the field on the
+    coarse patch for the given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getBfieldCPViews, level, include_ghosts)
+
+
+def get_mesh_magnetic_field_fp_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh magnetic field data and lo vectors for all three
+    directions in a single call. This version returns the field on the
+    fine patch for the given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getBfieldFPViews, level, include_ghosts)
+
+
+def get_mesh_current_density_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh current density data and lo vectors for all three
+    directions in a single call, instead of one call per direction and
+    quantity. This version is for the full "auxiliary" solution on the
+    given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getCurrentDensityViews, level, include_ghosts)
+
+
+def get_mesh_current_density_cp_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh current density data and lo vectors for all three
+    directions in a single call. This version returns the field on the
+    coarse patch for the given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getCurrentDensityCPViews, level, include_ghosts)
+
+
+def get_mesh_current_density_fp_views(level, include_ghosts=True):
+    '''
+
+    This returns the mesh current density data and lo vectors for all three
+    directions in a single call. This version returns the field on the
+    fine patch for the given level.
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getCurrentDensityFPViews, level, include_ghosts)
+
+
+def get_mesh_electric_field_snapshot_views(level, include_ghosts=True):
+    '''
+
+    This returns the snapshot of the fine-patch electric field taken when
+    the last asynchronous callback was launched, with lo vectors, for all
+    three directions in a single call. Only valid from within an
+    asynchronous callback (see callbacks.setbeforestepasync and
+    callbacks.setafterstepasync).
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getEfieldSnapshotViews, level, include_ghosts)
+
+
+def get_mesh_magnetic_field_snapshot_views(level, include_ghosts=True):
+    '''
+
+    This returns the snapshot of the fine-patch magnetic field taken when
+    the last asynchronous callback was launched, with lo vectors, for all
+    three directions in a single call. Only valid from within an
+    asynchronous callback (see callbacks.setbeforestepasync and
+    callbacks.setafterstepasync).
+
+    '''
+
+    return _get_mesh_field_views(libwarpx.warpx_getBfieldSnapshotViews, level, include_ghosts)
+
+
 def _get_mesh_array_lovects(level, direction, include_ghosts=True, getarrayfunc=None):
     assert(0 <= level and level <= libwarpx.warpx_finestLevel())
 
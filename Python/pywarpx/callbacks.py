@@ -413,6 +413,13 @@ def uninstallbeforestep(f):
 def isinstalledbeforestep(f):
     "Checks if the function is called before a step"
     return _beforestep.isinstalledfuncinlist(f)
+def setbeforestepasync(async_=True):
+    """Declares that the functions called before a step do not mutate the
+    simulation state, so that they may run on a worker thread while the
+    simulation proceeds. Asynchronous callbacks must read fields through the
+    snapshot accessors (get_mesh_*_snapshot_views) instead of the live
+    arrays."""
+    libwarpx.warpx_set_callback_py_beforestep_async(int(async_))
 
 # ----------------------------------------------------------------------------
 def callfromafterstep(f):
@@ -427,6 +434,13 @@ def uninstallafterstep(f):
 def isinstalledafterstep(f):
     "Checks if the function is called after a step"
     return _afterstep.isinstalledfuncinlist(f)
+def setafterstepasync(async_=True):
+    """Declares that the functions called after a step do not mutate the
+    simulation state, so that they may run on a worker thread while the next
+    step proceeds. Asynchronous callbacks must read fields through the
+    snapshot accessors (get_mesh_*_snapshot_views) instead of the live
+    arrays."""
+    libwarpx.warpx_set_callback_py_afterstep_async(int(async_))
 
 # ----------------------------------------------------------------------------
 def callfromafterrestart(f):
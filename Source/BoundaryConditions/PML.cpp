@@ -90,7 +90,7 @@ namespace
     }
 }
 
-SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int ncell, int delta)
+SigmaBox::SigmaBox (const Box& box)
 {
     BL_ASSERT(box.cellCentered());
 
@@ -125,8 +125,21 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int n
         sigma_star_fac       [idim].m_hi = hi[idim];
         sigma_star_cumsum_fac[idim].m_lo = lo[idim];
         sigma_star_cumsum_fac[idim].m_hi = hi[idim];
+
+        // Initialize sigma to zero (i.e. no damping) everywhere;
+        // the fills below overwrite the parts of the box that
+        // overlap the damped layers
+        std::fill(sigma            [idim].begin(), sigma            [idim].end(), 0.0);
+        std::fill(sigma_cumsum     [idim].begin(), sigma_cumsum     [idim].end(), 0.0);
+        std::fill(sigma_star       [idim].begin(), sigma_star       [idim].end(), 0.0);
+        std::fill(sigma_star_cumsum[idim].begin(), sigma_star_cumsum[idim].end(), 0.0);
     }
+}
 
+void
+SigmaBox::ComputeSigmas (const Box& box, const BoxArray& grids,
+                         const Real* dx, int ncell, int delta)
+{
     Array<Real,AMREX_SPACEDIM> fac;
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
         fac[idim] = 4.0*PhysConst::c/(dx[idim]*static_cast<Real>(delta*delta));
@@ -210,7 +223,7 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int n
             }
 
             if (!looverlap.ok() && !hioverlap.ok()) {
-                amrex::Abort("SigmaBox::SigmaBox(): corners, how did this happen?\n");
+                amrex::Abort("SigmaBox::ComputeSigmas(): corners, how did this happen?\n");
             }
         }
 
@@ -224,7 +237,7 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int n
                         sigma_star[idim], sigma_star_cumsum[idim], overlap);
             }
             else {
-                amrex::Abort("SigmaBox::SigmaBox(): side_side_edges, how did this happen?\n");
+                amrex::Abort("SigmaBox::ComputeSigmas(): side_side_edges, how did this happen?\n");
             }
         }
 
@@ -249,7 +262,7 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int n
             }
 
             if (!looverlap.ok() && !hioverlap.ok()) {
-                amrex::Abort("SigmaBox::SigmaBox(): direct_side_edges, how did this happen?\n");
+                amrex::Abort("SigmaBox::ComputeSigmas(): direct_side_edges, how did this happen?\n");
             }
         }
 #endif
@@ -266,7 +279,7 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int n
                 FillZero(idim, sigma[idim], sigma_cumsum[idim],
                         sigma_star[idim], sigma_star_cumsum[idim], overlap);
             } else {
-                amrex::Abort("SigmaBox::SigmaBox(): side_faces, how did this happen?\n");
+                amrex::Abort("SigmaBox::ComputeSigmas(): side_faces, how did this happen?\n");
             }
         }
 
@@ -291,12 +304,25 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int n
             }
 
             if (!looverlap.ok() && !hioverlap.ok()) {
-                amrex::Abort("SigmaBox::SigmaBox(): direct faces, how did this happen?\n");
+                amrex::Abort("SigmaBox::ComputeSigmas(): direct faces, how did this happen?\n");
             }
         }
 
         if (direct_faces.size() > 1) {
-            amrex::Abort("SigmaBox::SigmaBox(): direct_faces.size() > 1, Box gaps not wide enough?\n");
+            amrex::Abort("SigmaBox::ComputeSigmas(): direct_faces.size() > 1, Box gaps not wide enough?\n");
+        }
+    }
+
+    // Flag boxes in which sigma vanishes identically along every direction:
+    // damping is the identity there and the damping kernels skip such boxes
+    m_all_sigma_zero = true;
+    for (int idim = 0; idim < AMREX_SPACEDIM && m_all_sigma_zero; ++idim)
+    {
+        for (int i = 0, N = sigma[idim].size(); i < N; ++i) {
+            if (sigma[idim][i] != 0.0) { m_all_sigma_zero = false; break; }
+        }
+        for (int i = 0, N = sigma_star[idim].size(); i < N; ++i) {
+            if (sigma_star[idim][i] != 0.0) { m_all_sigma_zero = false; break; }
         }
     }
 }
@@ -330,9 +356,23 @@ SigmaBox::ComputePMLFactorsE (const Real* dx, Real dt)
 
 MultiSigmaBox::MultiSigmaBox (const BoxArray& ba, const DistributionMapping& dm,
                               const BoxArray& grid_ba, const Real* dx, int ncell, int delta)
-    : FabArray<SigmaBox>(ba,dm,1,0,MFInfo(),
-                         FabFactory<SigmaBox>(grid_ba,dx,ncell,delta))
-{}
+    : FabArray<SigmaBox>(ba,dm,1,0,MFInfo(),FabFactory<SigmaBox>())
+{
+    // The costly part of the construction - intersecting each PML box
+    // with the grids and filling the damping profiles - is independent
+    // from one box to the next, so it is done here in a threaded loop
+    // rather than in the (serial) fab allocation above.
+    // Query the intersections once beforehand: the hash table of the
+    // BoxArray is built lazily on first use and this is not thread-safe
+    grid_ba.intersections(ba[0], false, ncell);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(*this); mfi.isValid(); ++mfi)
+    {
+        (*this)[mfi].ComputeSigmas(mfi.validbox(), grid_ba, dx, ncell, delta);
+    }
+}
 
 void
 MultiSigmaBox::ComputePMLFactorsB (const Real* dx, Real dt)
@@ -610,6 +650,11 @@ PML::MakeBoxArray (const amrex::Geometry& geom, const amrex::BoxArray& grid_ba,
             }
         }
 
+        // Every piece kept below is contained in bx = grow(grid_bx, ncell),
+        // i.e. within ncell of the grid box it was generated from, which is
+        // exactly the support of sigma: the PML BoxArray is already trimmed
+        // to the active damping region and contains no box in which the
+        // damping coefficients vanish everywhere.
         const BoxList& noncovered = grid_ba.complementIn(bx);
         for (const Box& b : noncovered) {
             for (const auto& bb : bndryboxes) {
@@ -800,8 +845,25 @@ PML::Exchange (MultiFab& pml, MultiFab& reg, const Geometry& geom,
     const int ncp = pml.nComp();
     const auto& period = geom.periodicity();
 
-    // Create temporary MultiFab to copy to and from the PML
-    MultiFab tmpregmf(reg.boxArray(), reg.DistributionMap(), ncp, ngr);
+    // Create temporary MultiFab to copy to and from the PML, restricted to
+    // the regular-grid boxes that can exchange data with the PML: duplicating
+    // the full regular field here would waste memory and make the interior
+    // ranks participate in the copy matching, while only the boxes within
+    // guard-cell reach of the PML send or receive anything.
+    const BoxArray& rba = reg.boxArray();
+    const DistributionMapping& rdm = reg.DistributionMap();
+    BoxList sub_bl(rba.ixType());
+    Vector<int> sub_procmap;
+    Vector<int> sub_gid; // index of each selected box in the regular BoxArray
+    for (int i = 0, N = rba.size(); i < N; ++i) {
+        if (pml.boxArray().intersects(amrex::grow(rba[i], ngr+ngp))) {
+            sub_bl.push_back(rba[i]);
+            sub_procmap.push_back(rdm[i]);
+            sub_gid.push_back(i);
+        }
+    }
+    MultiFab tmpregmf(BoxArray(sub_bl), DistributionMapping(std::move(sub_procmap)),
+                      ncp, ngr);
 
     // Create the sum of the split fields, in the PML
     MultiFab totpmlmf(pml.boxArray(), pml.DistributionMap(), 1, 0); // Allocate
@@ -821,15 +883,29 @@ PML::Exchange (MultiFab& pml, MultiFab& reg, const Geometry& geom,
         // Copy from valid cells of PML to ghost cells of regular grid
         // but avoid updating the outermost valid cell
         if (ngr.max() > 0) {
-            MultiFab::Copy(tmpregmf, reg, 0, 0, 1, ngr);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(tmpregmf); mfi.isValid(); ++mfi)
+            {
+                const FArrayBox& src = reg[sub_gid[mfi.index()]];
+                FArrayBox& dst = tmpregmf[mfi];
+                const auto srcarr = src.array();
+                auto dstarr = dst.array();
+                amrex::ParallelFor(dst.box(),
+                                   [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                                   {
+                                       dstarr(i,j,k,0) = srcarr(i,j,k,0);
+                                   });
+            }
             tmpregmf.ParallelCopy(totpmlmf, 0, 0, 1, IntVect(0), ngr, period);
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-            for (MFIter mfi(reg); mfi.isValid(); ++mfi)
+            for (MFIter mfi(tmpregmf); mfi.isValid(); ++mfi)
             {
                 const FArrayBox& src = tmpregmf[mfi];
-                FArrayBox& dst = reg[mfi];
+                FArrayBox& dst = reg[sub_gid[mfi.index()]];
                 const auto srcarr = src.array();
                 auto dstarr = dst.array();
                 const BoxList& bl = amrex::boxDiff(dst.box(), mfi.validbox());
@@ -849,7 +925,21 @@ PML::Exchange (MultiFab& pml, MultiFab& reg, const Geometry& geom,
     // (and outermost valid cell in the nodal direction)
     // More specifically, copy from regular data to PML's first component
     // Zero out the second (and third) component
-    MultiFab::Copy(tmpregmf,reg,0,0,1,0); // Fill first component of tmpregmf
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(tmpregmf); mfi.isValid(); ++mfi)
+    {
+        const FArrayBox& src = reg[sub_gid[mfi.index()]];
+        FArrayBox& dst = tmpregmf[mfi];
+        const auto srcarr = src.array();
+        auto dstarr = dst.array();
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                           {
+                               dstarr(i,j,k,0) = srcarr(i,j,k,0); // Fill first component of tmpregmf
+                           });
+    }
     tmpregmf.setVal(0.0, 1, ncp-1, 0); // Zero out the second (and third) component
     if (do_pml_in_domain){
         // Where valid cells of tmpregmf overlap with PML valid cells,
@@ -59,6 +59,10 @@ WarpX::DampPML (int lev, PatchType patch_type)
 #endif
         for ( MFIter mfi(*pml_E[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            // skip boxes where sigma vanishes identically:
+            // all damping factors are one there
+            if (sigba[mfi].m_all_sigma_zero) continue;
+
             const Box& tex  = mfi.tilebox(Ex_nodal_flag);
             const Box& tey  = mfi.tilebox(Ey_nodal_flag);
             const Box& tez  = mfi.tilebox(Ez_nodal_flag);
@@ -97,6 +101,55 @@ WarpX::DampPML (int lev, PatchType patch_type)
             int const z_lo = sigba[mfi].sigma_fac[1].lo();
 #endif
 
+            if (Gpu::inLaunchRegion()) {
+
+                // Fused damping: the damping kernels do very little work per
+                // cell, so for small boxes their launch latency dominates.
+                // One kernel per tile damps the six field components (and F,
+                // when present) instead of two or three separate launches.
+                // The loop covers the nodal tilebox, which contains the
+                // tileboxes of all the (staggered) components.
+                const Box& tnd = mfi.tilebox(amrex::IntVect::TheNodeVector());
+                Array4<Real> pml_F_fab;
+                if (pml_F) pml_F_fab = pml_F->array(mfi);
+                int const has_F = (pml_F != nullptr);
+
+                amrex::ParallelFor(tnd,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    const IntVect iv(AMREX_D_DECL(i,j,k));
+                    if (tex.contains(iv)) {
+                        warpx_damp_pml_ex(i,j,k,pml_Exfab,sigma_fac_y,sigma_fac_z,
+                                          sigma_star_fac_x,x_lo,y_lo,z_lo);
+                    }
+                    if (tey.contains(iv)) {
+                        warpx_damp_pml_ey(i,j,k,pml_Eyfab,sigma_fac_z,sigma_fac_x,
+                                          sigma_star_fac_y,x_lo,y_lo,z_lo);
+                    }
+                    if (tez.contains(iv)) {
+                        warpx_damp_pml_ez(i,j,k,pml_Ezfab,sigma_fac_x,sigma_fac_y,
+                                          sigma_star_fac_z,x_lo,y_lo,z_lo);
+                    }
+                    if (tbx.contains(iv)) {
+                        warpx_damp_pml_bx(i,j,k,pml_Bxfab,sigma_star_fac_y,
+                                          sigma_star_fac_z,y_lo,z_lo);
+                    }
+                    if (tby.contains(iv)) {
+                        warpx_damp_pml_by(i,j,k,pml_Byfab,sigma_star_fac_z,
+                                          sigma_star_fac_x,z_lo,x_lo);
+                    }
+                    if (tbz.contains(iv)) {
+                        warpx_damp_pml_bz(i,j,k,pml_Bzfab,sigma_star_fac_x,
+                                          sigma_star_fac_y,x_lo,y_lo);
+                    }
+                    if (has_F) {
+                        warpx_damp_pml_F(i,j,k,pml_F_fab,sigma_fac_x,
+                                         sigma_fac_y,sigma_fac_z,
+                                         x_lo,y_lo,z_lo);
+                    }
+                });
+
+            } else {
+
             amrex::ParallelFor(tex, tey, tez,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) {
                 warpx_damp_pml_ex(i,j,k,pml_Exfab,sigma_fac_y,sigma_fac_z,
@@ -141,6 +194,8 @@ WarpX::DampPML (int lev, PatchType patch_type)
                 });
 
             }
+
+            } // Gpu::inLaunchRegion()
         }
     }
 }
@@ -180,6 +235,10 @@ WarpX::DampJPML (int lev, PatchType patch_type)
 #endif
         for ( MFIter mfi(*pml_j[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            // skip boxes where sigma vanishes identically:
+            // all damping factors are one there
+            if (sigba[mfi].m_all_sigma_zero) continue;
+
             auto const& pml_jxfab = pml_j[0]->array(mfi);
             auto const& pml_jyfab = pml_j[1]->array(mfi);
             auto const& pml_jzfab = pml_j[2]->array(mfi);
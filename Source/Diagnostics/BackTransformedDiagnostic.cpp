@@ -690,84 +690,150 @@ void BackTransformedDiagnostic::Flush(const Geometry& /*geom*/)
     VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::NoFabHeader_v1);
 
-    auto & mypc = WarpX::GetInstance().GetPartContainer();
-    const std::vector<std::string> species_names = mypc.GetSpeciesNames();
-
     // Loop over BFD snapshots
     for (int i = 0; i < m_LabFrameDiags_.size(); ++i) {
+        FlushDiag(i);
+    }
 
-        Real zmin_lab = m_LabFrameDiags_[i]->m_prob_domain_lab_.lo(AMREX_SPACEDIM-1);
-        int i_lab = (m_LabFrameDiags_[i]->m_current_z_lab - zmin_lab) / m_dz_lab_;
-
-        if (m_LabFrameDiags_[i]->m_buff_counter_ != 0) {
-            if (WarpX::do_back_transformed_fields) {
-                const BoxArray& ba = m_LabFrameDiags_[i]->m_data_buffer_->boxArray();
-                const int hi = ba[0].bigEnd(m_boost_direction_);
-                const int lo = hi - m_LabFrameDiags_[i]->m_buff_counter_ + 1;
-
-                //Box buff_box = geom.Domain();
-                Box buff_box = m_LabFrameDiags_[i]->m_buff_box_;
-                buff_box.setSmall(m_boost_direction_, lo);
-                buff_box.setBig(m_boost_direction_, hi);
-
-                BoxArray buff_ba(buff_box);
-                buff_ba.maxSize(m_max_box_size_);
-                DistributionMapping buff_dm(buff_ba);
+    VisMF::SetHeaderVersion(current_version);
+}
 
-                const int ncomp = m_LabFrameDiags_[i]->m_data_buffer_->nComp();
+void
+BackTransformedDiagnostic::FlushDiag (const int i_diag)
+{
+    LabFrameDiag& diag = *m_LabFrameDiags_[i_diag];
+    if (diag.m_buff_counter_ == 0) return;
 
-                MultiFab tmp(buff_ba, buff_dm, ncomp, 0);
+    auto & mypc = WarpX::GetInstance().GetPartContainer();
+    const std::vector<std::string> species_names = mypc.GetSpeciesNames();
 
-                tmp.copy(*m_LabFrameDiags_[i]->m_data_buffer_, 0, 0, ncomp);
+    Real zmin_lab = diag.m_prob_domain_lab_.lo(AMREX_SPACEDIM-1);
+    int i_lab = (diag.m_current_z_lab - zmin_lab) / m_dz_lab_;
+
+    if (WarpX::do_back_transformed_fields && diag.m_data_buffer_) {
+        const int ncomp = diag.m_data_buffer_->nComp();
+        MultiFab* to_write = diag.m_data_buffer_.get();
+        Box buff_box = diag.m_buff_box_;
+        std::unique_ptr<MultiFab> tmp;
+        if (diag.m_buff_counter_ < m_num_buffer_) {
+            // The buffer is only partially filled (final flush):
+            // restrict the write to the filled slices
+            const BoxArray& ba = diag.m_data_buffer_->boxArray();
+            const int hi = ba[0].bigEnd(m_boost_direction_);
+            const int lo = hi - diag.m_buff_counter_ + 1;
+
+            buff_box.setSmall(m_boost_direction_, lo);
+            buff_box.setBig(m_boost_direction_, hi);
+
+            BoxArray buff_ba(buff_box);
+            buff_ba.maxSize(m_max_box_size_);
+            DistributionMapping buff_dm(buff_ba);
+
+            tmp.reset(new MultiFab(buff_ba, buff_dm, ncomp, 0));
+            tmp->copy(*diag.m_data_buffer_, 0, 0, ncomp);
+            to_write = tmp.get();
+        }
 
 #ifdef WARPX_USE_HDF5
-                for (int comp = 0; comp < ncomp; ++comp) {
-                    output_write_field(m_LabFrameDiags_[i]->m_file_name,
-                                       m_mesh_field_names[comp], tmp, comp,
-                                       lbound(buff_box).x, lbound(buff_box).y,
-                                       lbound(buff_box).z);
-                }
+        for (int comp = 0; comp < ncomp; ++comp) {
+            output_write_field(diag.m_file_name,
+                               m_mesh_field_names[comp], *to_write, comp,
+                               lbound(buff_box).x, lbound(buff_box).y,
+                               lbound(buff_box).z);
+        }
 #else
-                std::stringstream ss;
-                ss << m_LabFrameDiags_[i]->m_file_name << "/Level_0/"
-                   << Concatenate("buffer", i_lab, 5);
-                VisMF::Write(tmp, ss.str());
+        std::stringstream mesh_ss;
+        mesh_ss << diag.m_file_name << "/Level_0/"
+                << Concatenate("buffer", i_lab, 5);
+        VisMF::Write(*to_write, mesh_ss.str());
 #endif
-            }
+        // Release the field buffer: it is re-allocated the next time this
+        // snapshot intersects the domain, so the memory footprint stays
+        // bounded by the number of snapshots being filled at a given step
+        diag.m_data_buffer_.reset(nullptr);
+    }
 
-            if (WarpX::do_back_transformed_particles) {
-                // Loop over species to be dumped to BFD
-                for (int j = 0; j < mypc.nSpeciesBackTransformedDiagnostics(); ++j) {
-                    // Get species name
-                    std::string species_name =
-                        species_names[mypc.mapSpeciesBackTransformedDiagnostics(j)];
+    if (WarpX::do_back_transformed_particles) {
+        // Loop over species to be dumped to BFD
+        for (int j = 0; j < mypc.nSpeciesBackTransformedDiagnostics(); ++j) {
+            // Get species name
+            const std::string species_name =
+                species_names[mypc.mapSpeciesBackTransformedDiagnostics(j)];
 #ifdef WARPX_USE_HDF5
-                    // Dump species data
-                    writeParticleDataHDF5(m_LabFrameDiags_[i]->m_particles_buffer_[j],
-                                          m_LabFrameDiags_[i]->m_file_name,
-                                          species_name);
+            // Dump species data
+            writeParticleDataHDF5(diag.m_particles_buffer_[j],
+                                  diag.m_file_name,
+                                  species_name);
 #else
-                    std::stringstream part_ss;
-                    part_ss << m_LabFrameDiags_[i]->m_file_name + "/" +
-                               species_name + "/";
-                    // Dump species data
-                    writeParticleData(m_LabFrameDiags_[i]->m_particles_buffer_[j],
-                                      part_ss.str(), i_lab);
+            std::stringstream part_ss;
+            part_ss << diag.m_file_name + "/" + species_name + "/";
+            // Dump species data
+            writeParticleData(diag.m_particles_buffer_[j],
+                              part_ss.str(), i_lab);
 #endif
-                }
-                m_LabFrameDiags_[i]->m_particles_buffer_.clear();
-            }
-            m_LabFrameDiags_[i]->m_buff_counter_ = 0;
         }
+        diag.m_particles_buffer_.clear();
     }
-
-    VisMF::SetHeaderVersion(current_version);
+    diag.m_buff_counter_ = 0;
 }
 
 
 
 
 
+Box
+BackTransformedDiagnostic::
+GetZSliceBox(const Geometry& geom, const Real t_boost) const {
+
+    const RealBox& domain_z_boost = geom.ProbDomain();
+    const Real zlo_boost = domain_z_boost.lo(m_boost_direction_);
+    const Real zhi_boost = domain_z_boost.hi(m_boost_direction_);
+
+    // Compute the prospective z positions of the snapshots at t_boost,
+    // with the same update and selection as in writeLabFrameData, but
+    // without modifying the positions stored in the diags.
+    Real zmin_boost = zhi_boost;
+    Real zmax_boost = zlo_boost;
+    bool any_active = false;
+    for (int i = 0; i < m_LabFrameDiags_.size(); ++i) {
+        const Real t_lab = m_LabFrameDiags_[i]->m_t_lab;
+        const Real z_boost = (t_lab*m_inv_gamma_boost_ - t_boost)
+                             *PhysConst::c*m_inv_beta_boost_;
+        const Real z_lab = (t_lab - t_boost*m_inv_gamma_boost_)
+                           *PhysConst::c*m_inv_beta_boost_;
+        const Real diag_zmin_lab =
+            m_LabFrameDiags_[i]->m_diag_domain_lab_.lo(AMREX_SPACEDIM-1);
+        const Real diag_zmax_lab =
+            m_LabFrameDiags_[i]->m_diag_domain_lab_.hi(AMREX_SPACEDIM-1);
+
+        if ( (z_boost < zlo_boost) or (z_boost > zhi_boost) or
+             (z_lab < diag_zmin_lab) or (z_lab > diag_zmax_lab) ) continue;
+
+        zmin_boost = std::min(zmin_boost, z_boost);
+        zmax_boost = std::max(zmax_boost, z_boost);
+        any_active = true;
+    }
+
+    // No snapshot intersects the domain at t_boost: no cell-centered
+    // data is needed for this step.
+    if ( not any_active ) return Box();
+
+    // Convert the range of z positions to a slab of cells spanning the
+    // domain transversely, with one extra cell on each side for the
+    // interpolation between the two cells enclosing each slice.
+    const Real dz = geom.CellSize(m_boost_direction_);
+    const int k_min = static_cast<int>(
+        (zmin_boost - geom.ProbLo(m_boost_direction_))/dz );
+    const int k_max = static_cast<int>(
+        (zmax_boost - geom.ProbLo(m_boost_direction_))/dz );
+    Box slab = geom.Domain();
+    slab.setSmall(m_boost_direction_,
+                  std::max(slab.smallEnd(m_boost_direction_), k_min-1));
+    slab.setBig(m_boost_direction_,
+                std::min(slab.bigEnd(m_boost_direction_), k_max+1));
+    return slab;
+}
+
 void
 BackTransformedDiagnostic::
 writeLabFrameData(const MultiFab* cell_centered_data,
@@ -784,6 +850,7 @@ writeLabFrameData(const MultiFab* cell_centered_data,
 
     const std::vector<std::string> species_names = mypc.GetSpeciesNames();
     Real prev_t_lab = -dt;
+    amrex::Vector<int> snapshots_to_flush;
     std::unique_ptr<amrex::MultiFab> tmp_slice_ptr;
     std::unique_ptr<amrex::MultiFab> slice;
     amrex::Vector<WarpXParticleContainer::DiagnosticParticleData> tmp_particle_buffer;
@@ -898,55 +965,21 @@ writeLabFrameData(const MultiFab* cell_centered_data,
 
         ++m_LabFrameDiags_[i]->m_buff_counter_;
         prev_t_lab = m_LabFrameDiags_[i]->m_t_lab;
-        // If buffer full, write to disk.
+        // If the buffer is full, mark the snapshot for writing: all the
+        // snapshots that fill their buffer during this step are flushed
+        // together below, after the loop.
         if (m_LabFrameDiags_[i]->m_buff_counter_ == m_num_buffer_) {
-
-            if (WarpX::do_back_transformed_fields) {
-#ifdef WARPX_USE_HDF5
-
-                Box buff_box = m_LabFrameDiags_[i]->m_buff_box_;
-                for (int comp = 0; comp < m_LabFrameDiags_[i]->m_data_buffer_->nComp(); ++comp)
-                    output_write_field(m_LabFrameDiags_[i]->m_file_name,
-                                       m_mesh_field_names[comp],
-                                       *m_LabFrameDiags_[i]->m_data_buffer_, comp,
-                                       lbound(buff_box).x, lbound(buff_box).y,
-                                       lbound(buff_box).z);
-#else
-                std::stringstream mesh_ss;
-                mesh_ss << m_LabFrameDiags_[i]->m_file_name << "/Level_0/" <<
-                           Concatenate("buffer", i_lab, 5);
-                VisMF::Write( (*m_LabFrameDiags_[i]->m_data_buffer_), mesh_ss.str());
-#endif
-            }
-
-            if (WarpX::do_back_transformed_particles) {
-                // Loop over species to be dumped to BFD
-                for (int j = 0; j < mypc.nSpeciesBackTransformedDiagnostics(); ++j) {
-                    // Get species name
-                    const std::string species_name = species_names[
-                                      mypc.mapSpeciesBackTransformedDiagnostics(j)];
-#ifdef WARPX_USE_HDF5
-                    // Write data to disk (HDF5)
-                    writeParticleDataHDF5(m_LabFrameDiags_[i]->m_particles_buffer_[j],
-                                          m_LabFrameDiags_[i]->m_file_name,
-                                          species_name);
-#else
-                    std::stringstream part_ss;
-
-                    part_ss << m_LabFrameDiags_[i]->m_file_name + "/" +
-                               species_name + "/";
-
-                    // Write data to disk (custom)
-                    writeParticleData(m_LabFrameDiags_[i]->m_particles_buffer_[j],
-                                      part_ss.str(), i_lab);
-#endif
-                }
-                m_LabFrameDiags_[i]->m_particles_buffer_.clear();
-            }
-            m_LabFrameDiags_[i]->m_buff_counter_ = 0;
+            snapshots_to_flush.push_back(i);
         }
     }
 
+    // Aggregated flush: the snapshots that filled their buffer during
+    // this step are written back-to-back in one flush event, instead of
+    // interleaving small writes with the slice copies above
+    for (int i : snapshots_to_flush) {
+        FlushDiag(i);
+    }
+
     VisMF::SetHeaderVersion(current_version);
 }
 
@@ -0,0 +1,222 @@
+/* Copyright 2020 Maxence Thevenet, Remi Lehe
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CompressedCheckpoint.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_VisMF.H>
+
+#include <zstd.h>
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace amrex;
+
+namespace
+{
+    // Compression level: 1 trades a few percent of ratio for a large
+    // speedup, which is the right trade-off when compression has to
+    // keep up with the file system.
+    constexpr int compression_level = 1;
+
+    std::string DataFileName (const std::string& prefix, const int ifile)
+    {
+        return amrex::Concatenate(prefix + "_CD_", ifile, 5);
+    }
+
+    std::string HeaderFileName (const std::string& prefix)
+    {
+        return prefix + "_CH";
+    }
+
+    long FabBytes (const FArrayBox& fab)
+    {
+        return fab.box().numPts() * fab.nComp()
+            * static_cast<long>(sizeof(Real));
+    }
+}
+
+void
+CompressedCheckpoint::Write (const MultiFab& mf, const std::string& prefix)
+{
+    const int nfabs = mf.size();
+    const int myproc = ParallelDescriptor::MyProc();
+
+    // Local Fab indices, in MFIter order
+    Vector<int> local_fabs;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        local_fabs.push_back(mfi.index());
+    }
+    const int nlocal = static_cast<int>(local_fabs.size());
+
+    // Compress all local Fabs up front, threaded over the Fabs, so
+    // that the (sequential) writes below stream buffers that are
+    // already compressed.
+    Vector<Vector<char>> compressed(nlocal);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < nlocal; ++k)
+    {
+        const FArrayBox& fab = mf[local_fabs[k]];
+        const size_t raw_bytes = static_cast<size_t>(FabBytes(fab));
+        compressed[k].resize(ZSTD_compressBound(raw_bytes));
+        const size_t csize = ZSTD_compress(
+            compressed[k].data(), compressed[k].size(),
+            fab.dataPtr(), raw_bytes, compression_level);
+        if (ZSTD_isError(csize)) {
+            amrex::Abort("CompressedCheckpoint::Write: zstd error: "
+                         + std::string(ZSTD_getErrorName(csize)));
+        }
+        compressed[k].resize(csize);
+    }
+
+    // Per-Fab chunk locations: (data file, byte offset, compressed
+    // size). Each Fab is owned by exactly one rank, so a sum-reduction
+    // of zero-initialized arrays gathers them on the I/O processor.
+    Vector<long> chunk_file(nfabs, 0);
+    Vector<long> chunk_offset(nfabs, 0);
+    Vector<long> chunk_size(nfabs, 0);
+
+    if (nlocal > 0)
+    {
+        VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
+        std::ofstream ofs;
+        ofs.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+        ofs.open(DataFileName(prefix, myproc).c_str(),
+                 std::ofstream::out | std::ofstream::trunc
+                 | std::ofstream::binary);
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(DataFileName(prefix, myproc));
+        }
+        long offset = 0;
+        for (int k = 0; k < nlocal; ++k)
+        {
+            const int i = local_fabs[k];
+            chunk_file[i] = myproc;
+            chunk_offset[i] = offset;
+            chunk_size[i] = static_cast<long>(compressed[k].size());
+            ofs.write(compressed[k].data(), compressed[k].size());
+            offset += chunk_size[i];
+        }
+        ofs.close();
+    }
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    ParallelDescriptor::ReduceLongSum(chunk_file.dataPtr(), nfabs, IOProc);
+    ParallelDescriptor::ReduceLongSum(chunk_offset.dataPtr(), nfabs, IOProc);
+    ParallelDescriptor::ReduceLongSum(chunk_size.dataPtr(), nfabs, IOProc);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ofstream hfs(HeaderFileName(prefix).c_str(),
+                          std::ofstream::out | std::ofstream::trunc);
+        if (!hfs.good()) {
+            amrex::FileOpenFailed(HeaderFileName(prefix));
+        }
+        hfs << "CompressedCheckpoint version: 1\n";
+        hfs << "zstd\n";
+        hfs << mf.nComp() << ' ' << mf.nGrow() << ' '
+            << static_cast<int>(sizeof(Real)) << ' ' << nfabs << '\n';
+        for (int i = 0; i < nfabs; ++i) {
+            hfs << chunk_file[i] << ' ' << chunk_offset[i] << ' '
+                << chunk_size[i] << '\n';
+        }
+    }
+}
+
+void
+CompressedCheckpoint::Read (MultiFab& mf, const std::string& prefix)
+{
+    // Every rank parses the (small) header
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(HeaderFileName(prefix), fileCharPtr);
+    std::string fileCharPtrString(fileCharPtr.dataPtr());
+    std::istringstream is(fileCharPtrString, std::istringstream::in);
+
+    std::string line;
+    std::getline(is, line); // version
+    std::getline(is, line); // codec
+    if (line != "zstd") {
+        amrex::Abort("CompressedCheckpoint::Read: unknown codec " + line);
+    }
+
+    int ncomp, ngrow, realbytes, nfabs;
+    is >> ncomp >> ngrow >> realbytes >> nfabs;
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ncomp == mf.nComp() && ngrow == mf.nGrow()
+        && realbytes == static_cast<int>(sizeof(Real))
+        && nfabs == mf.size(),
+        "CompressedCheckpoint::Read: the checkpoint "
+        + prefix + " does not match the MultiFab it is read into");
+
+    Vector<long> chunk_file(nfabs), chunk_offset(nfabs), chunk_size(nfabs);
+    for (int i = 0; i < nfabs; ++i) {
+        is >> chunk_file[i] >> chunk_offset[i] >> chunk_size[i];
+    }
+
+    // Read the chunks of the locally owned Fabs -- which data file a
+    // chunk lives in only depends on the rank that wrote it, so this
+    // works for any number of reading ranks.
+    Vector<int> local_fabs;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        local_fabs.push_back(mfi.index());
+    }
+    const int nlocal = static_cast<int>(local_fabs.size());
+
+    Vector<Vector<char>> compressed(nlocal);
+    {
+        std::map<long, std::ifstream> data_files;
+        for (int k = 0; k < nlocal; ++k)
+        {
+            const int i = local_fabs[k];
+            auto it = data_files.find(chunk_file[i]);
+            if (it == data_files.end()) {
+                it = data_files.emplace(
+                    chunk_file[i],
+                    std::ifstream(
+                        DataFileName(prefix,
+                                     static_cast<int>(chunk_file[i])).c_str(),
+                        std::ifstream::in | std::ifstream::binary)).first;
+                if (!it->second.good()) {
+                    amrex::FileOpenFailed(
+                        DataFileName(prefix,
+                                     static_cast<int>(chunk_file[i])));
+                }
+            }
+            compressed[k].resize(chunk_size[i]);
+            it->second.seekg(chunk_offset[i]);
+            it->second.read(compressed[k].data(), chunk_size[i]);
+        }
+    }
+
+    // Decompress directly into the Fabs, threaded over the Fabs
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < nlocal; ++k)
+    {
+        FArrayBox& fab = mf[local_fabs[k]];
+        const size_t raw_bytes = static_cast<size_t>(FabBytes(fab));
+        const size_t dsize = ZSTD_decompress(
+            fab.dataPtr(), raw_bytes,
+            compressed[k].data(), compressed[k].size());
+        if (ZSTD_isError(dsize) || dsize != raw_bytes) {
+            amrex::Abort("CompressedCheckpoint::Read: corrupt chunk in "
+                         + prefix);
+        }
+    }
+}
+
+bool
+CompressedCheckpoint::Exists (const std::string& prefix)
+{
+    return amrex::FileExists(HeaderFileName(prefix));
+}
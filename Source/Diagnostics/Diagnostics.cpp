@@ -8,6 +8,9 @@
 #include "Utils/Average.H"
 #include "Utils/WarpXUtil.H"
 
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_VisMF.H>
+
 using namespace amrex;
 
 Diagnostics::Diagnostics (int i, std::string name)
@@ -18,7 +21,10 @@ Diagnostics::Diagnostics (int i, std::string name)
 
 Diagnostics::~Diagnostics ()
 {
-    delete m_flush_format;
+    WaitForAsyncFlush();
+    for (auto& flush_format : m_flush_formats) {
+        delete flush_format;
+    }
 }
 
 void
@@ -30,12 +36,37 @@ Diagnostics::ReadParameters ()
     m_file_prefix = "diags/" + m_diag_name;
     pp.query("file_prefix", m_file_prefix);
     pp.query("period", m_period);
-    pp.query("format", m_format);
-    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-        m_format == "plotfile" || m_format == "openpmd",
-        "<diag>.format must be plotfile or openpmd");
+    pp.query("average_period", m_average_period);
+    if (m_average_period > 0) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_period > 0 && m_average_period <= m_period,
+            "<diag>.average_period requires 0 < average_period <= <diag>.period");
+    }
+    // Several formats can be requested for one diagnostics: the fields are
+    // then computed and packed once, and written in each format from the
+    // same staged data.
+    pp.queryarr("format", m_format);
+    for (const auto& format : m_format) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            format == "plotfile" || format == "openpmd",
+            "<diag>.format must be plotfile or openpmd");
+    }
     pp.query("plot_raw_fields", m_plot_raw_fields);
     pp.query("plot_raw_fields_guards", m_plot_raw_fields_guards);
+    if (m_average_period > 0) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_plot_raw_fields == 0,
+            "<diag>.average_period does not support plot_raw_fields");
+    }
+    pp.query("async_flush", m_dump_async);
+    if (m_dump_async) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            hasFormat("plotfile"),
+            "<diag>.async_flush requires the plotfile format");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_plot_raw_fields == 0,
+            "<diag>.async_flush does not support plot_raw_fields");
+    }
     if (!pp.queryarr("fields_to_plot", m_varnames)){
         m_varnames = {"Ex", "Ey", "Ez", "Bx", "By", "Bz", "jx", "jy", "jz"};
     }
@@ -144,17 +175,31 @@ Diagnostics::InitData ()
         DefineDiagMultiFab( lev );
 
     }
-    // Construct Flush class.
-    if        (m_format == "plotfile"){
-        m_flush_format = new FlushFormatPlotfile;
-    } else if (m_format == "openpmd"){
+
+    // Allocate the accumulator of the time-averaged output
+    if (m_average_period > 0) {
+        m_mf_avg.resize( nlev );
+        for (int lev=0; lev<nlev; lev++) {
+            m_mf_avg[lev].define(
+                m_mf_output[lev].boxArray(), m_mf_output[lev].DistributionMap(),
+                m_mf_output[lev].nComp(), 0 );
+            m_mf_avg[lev].setVal(0._rt);
+        }
+    }
+
+    // Construct Flush classes, one per requested format.
+    for (const auto& format : m_format) {
+        if        (format == "plotfile"){
+            m_flush_formats.push_back( new FlushFormatPlotfile );
+        } else if (format == "openpmd"){
 #ifdef WARPX_USE_OPENPMD
-        m_flush_format = new FlushFormatOpenPMD(m_diag_name);
+            m_flush_formats.push_back( new FlushFormatOpenPMD(m_diag_name) );
 #else
-        amrex::Abort("To use openpmd output format, need to compile with USE_OPENPMD=TRUE");
+            amrex::Abort("To use openpmd output format, need to compile with USE_OPENPMD=TRUE");
 #endif
-    } else {
-        amrex::Abort("unknown output format");
+        } else {
+            amrex::Abort("unknown output format");
+        }
     }
 }
 
@@ -187,16 +232,149 @@ Diagnostics::ComputeAndPack ()
     }
     // Check that the proper number of components of m_mf_output were updated.
     AMREX_ALWAYS_ASSERT( icomp_dst == m_varnames.size() );
+
+    // Accumulate the freshly packed sample into the running sum. The
+    // functors above already swept the source fields, so this only touches
+    // the (coarsened, cell-centered) output MultiFab once more.
+    if (m_average_period > 0) {
+        for (int lev=0; lev<nlev; lev++) {
+            MultiFab::Add( m_mf_avg[lev], m_mf_output[lev],
+                           0, 0, m_mf_output[lev].nComp(), 0 );
+        }
+        m_avg_nsamples += 1;
+    }
 }
 
 void
 Diagnostics::Flush ()
 {
+    // Replace the instantaneous fields with the window average, and reset
+    // the accumulator for the next window
+    if (m_average_period > 0 && m_avg_nsamples > 0) {
+        for (int lev=0; lev<nlev; lev++) {
+            MultiFab::LinComb( m_mf_output[lev],
+                               1._rt/m_avg_nsamples, m_mf_avg[lev], 0,
+                               0._rt, m_mf_output[lev], 0,
+                               0, m_mf_output[lev].nComp(), 0 );
+            m_mf_avg[lev].setVal(0._rt);
+        }
+        m_avg_nsamples = 0;
+    }
+
     auto & warpx = WarpX::GetInstance();
-    m_flush_format->WriteToFile(
-        m_varnames, GetVecOfConstPtrs(m_mf_output), warpx.Geom(), warpx.getistep(),
-        warpx.gett_new(0), warpx.GetPartContainer(), nlev, m_file_prefix,
-        m_plot_raw_fields, m_plot_raw_fields_guards, m_plot_raw_rho, m_plot_raw_F);
+
+    if (m_dump_async) {
+        // The plotfile fields are written from the dedicated I/O thread;
+        // any other requested format is written synchronously in the
+        // meantime, from the same packed data.
+        FlushAsync();
+        for (int i = 0; i < static_cast<int>(m_format.size()); ++i) {
+            if (m_format[i] == "plotfile") continue;
+            m_flush_formats[i]->WriteToFile(
+                m_varnames, GetVecOfConstPtrs(m_mf_output), warpx.Geom(), warpx.getistep(),
+                warpx.gett_new(0), warpx.GetPartContainer(), nlev, m_file_prefix,
+                m_plot_raw_fields, m_plot_raw_fields_guards, m_plot_raw_rho, m_plot_raw_F);
+        }
+        return;
+    }
+
+    for (const auto& flush_format : m_flush_formats) {
+        flush_format->WriteToFile(
+            m_varnames, GetVecOfConstPtrs(m_mf_output), warpx.Geom(), warpx.getistep(),
+            warpx.gett_new(0), warpx.GetPartContainer(), nlev, m_file_prefix,
+            m_plot_raw_fields, m_plot_raw_fields_guards, m_plot_raw_rho, m_plot_raw_F);
+    }
+}
+
+void
+Diagnostics::FlushAsync ()
+{
+    auto & warpx = WarpX::GetInstance();
+
+    // Pick out the plotfile flush (the only format written asynchronously)
+    FlushFormatPlotfile* flush_format = nullptr;
+    for (int i = 0; i < static_cast<int>(m_format.size()); ++i) {
+        if (m_format[i] == "plotfile") {
+            flush_format = static_cast<FlushFormatPlotfile*>(m_flush_formats[i]);
+        }
+    }
+
+#ifdef AMREX_USE_MPI
+    // The I/O thread issues MPI calls (within the VisMF writes) while the
+    // time stepping keeps issuing its own on the main thread
+    int mpi_thread_level = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&mpi_thread_level);
+    if (mpi_thread_level < MPI_THREAD_MULTIPLE) {
+        static bool warned = false;
+        if (!warned) {
+            amrex::Print() << "WARNING: <diag>.async_flush requires an MPI library "
+                           << "providing MPI_THREAD_MULTIPLE; flushing synchronously\n";
+            warned = true;
+        }
+        flush_format->WriteToFile(
+            m_varnames, GetVecOfConstPtrs(m_mf_output), warpx.Geom(), warpx.getistep(),
+            warpx.gett_new(0), warpx.GetPartContainer(), nlev, m_file_prefix,
+            m_plot_raw_fields, m_plot_raw_fields_guards, m_plot_raw_rho, m_plot_raw_F);
+        return;
+    }
+#endif
+
+    // At most one flush is in flight: wait for the completion of the
+    // previous one before reusing its buffer
+    WaitForAsyncFlush();
+
+    // Snapshot the packed fields into the pinned host-side buffer, so that
+    // m_mf_output can be refilled while the write is still in progress
+    if (m_mf_output_buffer.size() == 0) {
+        m_mf_output_buffer.resize( nlev );
+        for (int lev=0; lev<nlev; lev++) {
+            m_mf_output_buffer[lev].define(
+                m_mf_output[lev].boxArray(), m_mf_output[lev].DistributionMap(),
+                m_mf_output[lev].nComp(), 0,
+                amrex::MFInfo().SetArena(amrex::The_Pinned_Arena()) );
+        }
+    }
+    for (int lev=0; lev<nlev; lev++) {
+        MultiFab::Copy( m_mf_output_buffer[lev], m_mf_output[lev],
+                        0, 0, m_mf_output[lev].nComp(), 0 );
+    }
+
+    // Write the particles and the metadata synchronously: they read live
+    // simulation data, which the next steps modify. The directory
+    // hierarchy has to exist before any of the writes.
+    const std::string& filename = amrex::Concatenate(m_file_prefix, warpx.getistep(0));
+    amrex::PreBuildDirectorHierarchy(filename, "Level_", nlev, true);
+    warpx.GetPartContainer().WritePlotFile(filename);
+    flush_format->WriteJobInfo(filename);
+    flush_format->WriteWarpXHeader(filename);
+
+    // Write the cell-centered fields (the bulk of the data) from a
+    // dedicated I/O thread, overlapping the write with the next steps
+    amrex::Vector<Geometry> geom = warpx.Geom();
+    amrex::Vector<int> iteration = warpx.getistep();
+    amrex::Vector<IntVect> ref_ratio = warpx.refRatio();
+    const double time = warpx.gett_new(0);
+    const int output_levels = nlev;
+    m_flush_thread = std::thread(
+        [this, filename, geom, iteration, ref_ratio, time, output_levels] () {
+            amrex::Print() << "  Writing plotfile " << filename << "\n";
+            VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
+            VisMF::SetHeaderVersion(amrex::VisMF::Header::Version_v1);
+            amrex::WriteMultiLevelPlotfile(filename, output_levels,
+                                           GetVecOfConstPtrs(m_mf_output_buffer),
+                                           m_varnames, geom,
+                                           time, iteration, ref_ratio,
+                                           "HyperCLaw-V1.1",
+                                           "Level_",
+                                           "Cell");
+            VisMF::SetHeaderVersion(current_version);
+        });
+}
+
+void
+Diagnostics::WaitForAsyncFlush ()
+{
+    if (m_flush_thread.joinable()) m_flush_thread.join();
 }
 
 void
@@ -210,6 +388,23 @@ Diagnostics::DoDump (int step, bool force_flush)
     return false;
 }
 
+bool
+Diagnostics::InAverageWindow (int step) const
+{
+    if ( m_average_period <= 0 || m_period <= 0 ) return false;
+    // The window is made of the m_average_period steps ending at a flush step
+    const int r = (step+1) % m_period;
+    return ( r == 0 || r > m_period - m_average_period );
+}
+
+bool
+Diagnostics::DoComputeAndPack (int step, bool force_flush)
+{
+    // Packed fields are needed not only at the steps where they are
+    // flushed, but also at every step of an averaging window
+    return InAverageWindow(step) || DoDump(step, force_flush);
+}
+
 void
 Diagnostics::AddRZModesToDiags (int lev)
 {
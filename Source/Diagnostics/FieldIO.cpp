@@ -239,14 +239,18 @@ ConstructTotalRZScalarField (MultiFab& scalar_total,
 
 /** \brief Takes an array of 3 MultiFab `vector_field`
  * (representing the x, y, z components of a vector),
- * averages it to the cell center, and stores the
- * resulting MultiFab in mf_avg (in the components dcomp to dcomp+2)
+ * averages it to the cell center (and coarsens it by `crse_ratio`, in
+ * the same fused pass), and stores the
+ * resulting MultiFab in mf_avg (in the components dcomp to dcomp+2).
+ * The optional box `region` restricts the cells of mf_avg that are filled.
  */
 void
 AverageAndPackVectorField( MultiFab& mf_avg,
                            const std::array< std::unique_ptr<MultiFab>, 3 >& vector_field,
                            const DistributionMapping& dm,
-                           const int dcomp, const int ngrow )
+                           const int dcomp, const int ngrow,
+                           const IntVect crse_ratio,
+                           const Box& region )
 {
 #ifndef WARPX_DIM_RZ
     (void)dm;
@@ -273,9 +277,9 @@ AverageAndPackVectorField( MultiFab& mf_avg,
     const std::array<std::unique_ptr<MultiFab>,3> &vector_total = vector_field;
 #endif
 
-    Average::CoarsenAndInterpolate( mf_avg, *(vector_total[0]), dcomp  , 0, 1, ngrow );
-    Average::CoarsenAndInterpolate( mf_avg, *(vector_total[1]), dcomp+1, 0, 1, ngrow );
-    Average::CoarsenAndInterpolate( mf_avg, *(vector_total[2]), dcomp+2, 0, 1, ngrow );
+    Average::CoarsenAndInterpolate( mf_avg, *(vector_total[0]), dcomp  , 0, 1, ngrow, crse_ratio, region );
+    Average::CoarsenAndInterpolate( mf_avg, *(vector_total[1]), dcomp+1, 0, 1, ngrow, crse_ratio, region );
+    Average::CoarsenAndInterpolate( mf_avg, *(vector_total[2]), dcomp+2, 0, 1, ngrow, crse_ratio, region );
 }
 
 /** \brief Takes all of the components of the three fields and
@@ -285,7 +289,8 @@ void
 AverageAndPackVectorFieldComponents (MultiFab& mf_avg,
                                      const std::array< std::unique_ptr<MultiFab>, 3 >& vector_field,
                                      const DistributionMapping& dm,
-                                     int& dcomp, const int ngrow )
+                                     int& dcomp, const int ngrow,
+                                     const IntVect crse_ratio=IntVect(1) )
 {
     if (vector_field[0]->nComp() > 1) {
         std::array<std::unique_ptr<MultiFab>,3> vector_field_component;
@@ -293,7 +298,7 @@ AverageAndPackVectorFieldComponents (MultiFab& mf_avg,
             vector_field_component[0].reset(new MultiFab(*vector_field[0], amrex::make_alias, icomp, 1));
             vector_field_component[1].reset(new MultiFab(*vector_field[1], amrex::make_alias, icomp, 1));
             vector_field_component[2].reset(new MultiFab(*vector_field[2], amrex::make_alias, icomp, 1));
-            AverageAndPackVectorField(mf_avg, vector_field_component, dm, dcomp, ngrow);
+            AverageAndPackVectorField(mf_avg, vector_field_component, dm, dcomp, ngrow, crse_ratio);
             dcomp += 3;
         }
     }
@@ -307,7 +312,9 @@ void
 AverageAndPackScalarField (MultiFab& mf_avg,
                            const MultiFab & scalar_field,
                            const DistributionMapping& dm,
-                           const int dcomp, const int ngrow )
+                           const int dcomp, const int ngrow,
+                           const IntVect crse_ratio,
+                           const Box& region )
 {
 
 #ifdef WARPX_DIM_RZ
@@ -326,12 +333,14 @@ AverageAndPackScalarField (MultiFab& mf_avg,
 
     // Check the type of staggering of the 3-component `vector_field`
     // and average accordingly:
-    // - Fully cell-centered field (no average needed; simply copy)
-    if ( scalar_total->is_cell_centered() ){
+    // - Fully cell-centered field without coarsening
+    //   (no average needed; simply copy)
+    if ( scalar_total->is_cell_centered() and crse_ratio == IntVect(1) ){
         MultiFab::Copy( mf_avg, *scalar_total, 0, dcomp, 1, ngrow);
-    } else if ( scalar_total->is_nodal() ){
-        // - Fully nodal
-        Average::CoarsenAndInterpolate( mf_avg, *scalar_total, dcomp, 0, 1, ngrow );
+    } else if ( scalar_total->is_cell_centered() or scalar_total->is_nodal() ){
+        // - Fully nodal, or cell-centered with coarsening: single
+        //   fused average-and-coarsen pass
+        Average::CoarsenAndInterpolate( mf_avg, *scalar_total, dcomp, 0, 1, ngrow, crse_ratio, region );
     } else {
         amrex::Abort("Unknown staggering.");
     }
@@ -345,10 +354,11 @@ AverageAndPackScalarFieldComponent (MultiFab& mf_avg,
                                     const MultiFab& scalar_field,
                                     const DistributionMapping& dm,
                                     const int icomp,
-                                    const int dcomp, const int ngrow )
+                                    const int dcomp, const int ngrow,
+                                    const IntVect crse_ratio=IntVect(1) )
 {
     MultiFab scalar_field_component(scalar_field, amrex::make_alias, icomp, 1);
-    AverageAndPackScalarField(mf_avg, scalar_field_component, dm, dcomp, ngrow);
+    AverageAndPackScalarField(mf_avg, scalar_field_component, dm, dcomp, ngrow, crse_ratio);
 }
 
 /** \brief Generate mode variable name
@@ -393,16 +403,17 @@ void
 CopyScalarFieldComponentsToMultiFab (int lev, amrex::Vector<MultiFab>& mf_avg, MultiFab& mf_tmp,
                                      const DistributionMapping& dm,
                                      int& dcomp, int ngrow, int n_rz_azimuthal_modes,
-                                     std::string fieldname, Vector<std::string>& varnames)
+                                     std::string fieldname, Vector<std::string>& varnames,
+                                     const IntVect crse_ratio=IntVect(1))
 {
     if (n_rz_azimuthal_modes > 1) {
         if (lev==0) varnames.push_back(ComponentName(fieldname, 0, "real"));
-        AverageAndPackScalarFieldComponent(mf_avg[lev], mf_tmp, dm, 0, dcomp++, ngrow);
+        AverageAndPackScalarFieldComponent(mf_avg[lev], mf_tmp, dm, 0, dcomp++, ngrow, crse_ratio);
         for (int mode=1 ; mode < n_rz_azimuthal_modes ; mode++) {
             if (lev==0) varnames.push_back(ComponentName(fieldname, mode, "real"));
-            AverageAndPackScalarFieldComponent(mf_avg[lev], mf_tmp, dm, 2*mode-1, dcomp++, ngrow);
+            AverageAndPackScalarFieldComponent(mf_avg[lev], mf_tmp, dm, 2*mode-1, dcomp++, ngrow, crse_ratio);
             if (lev==0) varnames.push_back(ComponentName(fieldname, mode, "imag"));
-            AverageAndPackScalarFieldComponent(mf_avg[lev], mf_tmp, dm, 2*mode  , dcomp++, ngrow);
+            AverageAndPackScalarFieldComponent(mf_avg[lev], mf_tmp, dm, 2*mode  , dcomp++, ngrow, crse_ratio);
         }
     }
 }
@@ -427,11 +438,15 @@ AddToVarNamesRZ (Vector<std::string>& varnames,
 
 /** \brief Write the different fields that are meant for output,
  * into the vector of MultiFab `mf_avg` (one MultiFab per level)
- * after averaging them to the cell centers.
+ * after averaging them to the cell centers. When `crse_ratio` is
+ * larger than 1, the output MultiFabs are built on a coarsened version
+ * of the simulation grids, and the averaging and the coarsening are
+ * performed in the same single pass over the full-resolution data.
  */
 void
 WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
-                              amrex::Vector<MultiFab>& mf_avg, const int ngrow) const
+                              amrex::Vector<MultiFab>& mf_avg, const int ngrow,
+                              const IntVect crse_ratio) const
 {
     // Count how many different fields should be written (ncomp)
     int ncomp = fields_to_plot.size()
@@ -458,8 +473,10 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
     // Loop over levels of refinement
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-        // Allocate pointers to the `ncomp` fields that will be added
-        mf_avg.push_back( MultiFab(grids[lev], dmap[lev], ncomp, ngrow));
+        // Allocate pointers to the `ncomp` fields that will be added,
+        // on the (possibly coarsened) output grids
+        const BoxArray out_grids = amrex::coarsen(grids[lev], crse_ratio);
+        mf_avg.push_back( MultiFab(out_grids, dmap[lev], ncomp, ngrow));
 
         // For E, B and J, if at least one component is requested,
         // build cell-centered temporary MultiFab with 3 comps
@@ -467,25 +484,25 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
         // Build mf_tmp_E is at least one component of E is requested
         if (WarpXUtilStr::is_in(fields_to_plot, {"Ex", "Ey", "Ez"} )){
             // Allocate temp MultiFab with 3 components
-            mf_tmp_E = MultiFab(grids[lev], dmap[lev], nvecs, ngrow);
-            // Fill MultiFab mf_tmp_E with averaged E
-            AverageAndPackVectorField          (mf_tmp_E, Efield_aux[lev], dmap[lev], 0, ngrow);
+            mf_tmp_E = MultiFab(out_grids, dmap[lev], nvecs, ngrow);
+            // Fill MultiFab mf_tmp_E with averaged (and coarsened) E
+            AverageAndPackVectorField          (mf_tmp_E, Efield_aux[lev], dmap[lev], 0, ngrow, crse_ratio);
             int dcomp = 3;
-            AverageAndPackVectorFieldComponents(mf_tmp_E, Efield_aux[lev], dmap[lev], dcomp, ngrow);
+            AverageAndPackVectorFieldComponents(mf_tmp_E, Efield_aux[lev], dmap[lev], dcomp, ngrow, crse_ratio);
         }
         // Same for B
         if (WarpXUtilStr::is_in(fields_to_plot, {"Bx", "By", "Bz"} )){
-            mf_tmp_B = MultiFab(grids[lev], dmap[lev], nvecs, ngrow);
-            AverageAndPackVectorField(mf_tmp_B, Bfield_aux[lev], dmap[lev], 0, ngrow);
+            mf_tmp_B = MultiFab(out_grids, dmap[lev], nvecs, ngrow);
+            AverageAndPackVectorField(mf_tmp_B, Bfield_aux[lev], dmap[lev], 0, ngrow, crse_ratio);
             int dcomp = 3;
-            AverageAndPackVectorFieldComponents(mf_tmp_B, Bfield_aux[lev], dmap[lev], dcomp, ngrow);
+            AverageAndPackVectorFieldComponents(mf_tmp_B, Bfield_aux[lev], dmap[lev], dcomp, ngrow, crse_ratio);
         }
         // Same for J
         if (WarpXUtilStr::is_in(fields_to_plot, {"jx", "jy", "jz"} )){
-            mf_tmp_J = MultiFab(grids[lev], dmap[lev], nvecs, ngrow);
-            AverageAndPackVectorField(mf_tmp_J, current_fp[lev], dmap[lev], 0, ngrow);
+            mf_tmp_J = MultiFab(out_grids, dmap[lev], nvecs, ngrow);
+            AverageAndPackVectorField(mf_tmp_J, current_fp[lev], dmap[lev], 0, ngrow, crse_ratio);
             int dcomp = 3;
-            AverageAndPackVectorFieldComponents(mf_tmp_J, current_fp[lev], dmap[lev], dcomp, ngrow);
+            AverageAndPackVectorFieldComponents(mf_tmp_J, current_fp[lev], dmap[lev], dcomp, ngrow, crse_ratio);
         }
 
         int dcomp;
@@ -525,19 +542,19 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
                 MultiFab::Copy( mf_avg[lev], mf_tmp_J, 2, dcomp++, 1, ngrow);
                 CopyVectorFieldComponentsToMultiFab(lev, mf_avg, mf_tmp_J, 2, dcomp, ngrow, "jz", varnames);
             } else if (fieldname == "rho"){
-                AverageAndPackScalarField( mf_avg[lev], *rho_fp[lev], dmap[lev], dcomp++, ngrow );
+                AverageAndPackScalarField( mf_avg[lev], *rho_fp[lev], dmap[lev], dcomp++, ngrow, crse_ratio );
                 CopyScalarFieldComponentsToMultiFab(lev, mf_avg, *rho_fp[lev], dmap[lev], dcomp, ngrow, n_rz_azimuthal_modes,
-                                                    fieldname, varnames);
+                                                    fieldname, varnames, crse_ratio);
             } else if (fieldname == "F"){
-                AverageAndPackScalarField( mf_avg[lev], *F_fp[lev], dmap[lev], dcomp++, ngrow);
+                AverageAndPackScalarField( mf_avg[lev], *F_fp[lev], dmap[lev], dcomp++, ngrow, crse_ratio);
                 CopyScalarFieldComponentsToMultiFab(lev, mf_avg, *F_fp[lev], dmap[lev], dcomp, ngrow, n_rz_azimuthal_modes,
-                                                    fieldname, varnames);
+                                                    fieldname, varnames, crse_ratio);
             } else if (fieldname == "part_per_cell") {
                 MultiFab temp_dat(grids[lev],mf_avg[lev].DistributionMap(),1,ngrow);
                 temp_dat.setVal(0);
                 // MultiFab containing number of particles in each cell
                 mypc->Increment(temp_dat, lev);
-                AverageAndPackScalarField( mf_avg[lev], temp_dat, dmap[lev], dcomp++, ngrow );
+                AverageAndPackScalarField( mf_avg[lev], temp_dat, dmap[lev], dcomp++, ngrow, crse_ratio );
             } else if (fieldname == "part_per_grid"){
                 const Vector<long>& npart_in_grid = mypc->NumberOfParticlesInGrid(lev);
                 // MultiFab containing number of particles per grid
@@ -569,11 +586,23 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
                 mf_avg[lev].setVal(static_cast<Real>(ParallelDescriptor::MyProc()),dcomp++,1);
             } else if (fieldname == "divB"){
                 if (do_nodal) amrex::Abort("TODO: do_nodal && plot divb");
-                ComputeDivB(mf_avg[lev], dcomp++,
-                            {Bfield_aux[lev][0].get(),
-                                    Bfield_aux[lev][1].get(),
-                                    Bfield_aux[lev][2].get()},
-                            WarpX::CellSize(lev) );
+                if (crse_ratio == IntVect(1)) {
+                    ComputeDivB(mf_avg[lev], dcomp++,
+                                {Bfield_aux[lev][0].get(),
+                                        Bfield_aux[lev][1].get(),
+                                        Bfield_aux[lev][2].get()},
+                                WarpX::CellSize(lev) );
+                } else {
+                    // The stencil of divB needs the full-resolution grids:
+                    // compute it in a temporary and coarsen it
+                    MultiFab divB( grids[lev], dmap[lev], 1, 0 );
+                    ComputeDivB(divB, 0,
+                                {Bfield_aux[lev][0].get(),
+                                        Bfield_aux[lev][1].get(),
+                                        Bfield_aux[lev][2].get()},
+                                WarpX::CellSize(lev) );
+                    AverageAndPackScalarField( mf_avg[lev], divB, dmap[lev], dcomp++, ngrow, crse_ratio );
+                }
             } else if (fieldname == "divE"){
                 const BoxArray& ba = amrex::convert(boxArray(lev),IntVect::TheUnitVector());
                 MultiFab divE( ba, DistributionMap(lev), 1, 0 );
@@ -582,16 +611,16 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
 #else
                 m_fdtd_solver_fp[lev]->ComputeDivE( Efield_aux[lev], divE );
 #endif
-                AverageAndPackScalarField( mf_avg[lev], divE, dmap[lev], dcomp++, ngrow );
+                AverageAndPackScalarField( mf_avg[lev], divE, dmap[lev], dcomp++, ngrow, crse_ratio );
             } else {
                 amrex::Abort("unknown field in fields_to_plot: " + fieldname);
             }
         }
         if (plot_finepatch)
         {
-            AverageAndPackVectorField( mf_avg[lev], Efield_fp[lev], dmap[lev], dcomp, ngrow );
+            AverageAndPackVectorField( mf_avg[lev], Efield_fp[lev], dmap[lev], dcomp, ngrow, crse_ratio );
             dcomp += 3;
-            AverageAndPackVectorFieldComponents(mf_avg[lev], Efield_fp[lev], dmap[lev], dcomp, ngrow);
+            AverageAndPackVectorFieldComponents(mf_avg[lev], Efield_fp[lev], dmap[lev], dcomp, ngrow, crse_ratio);
             if (lev == 0) {
                 AddToVarNames(varnames, "E", "_fp");
                 if (n_rz_azimuthal_modes > 1) {
@@ -602,9 +631,9 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
                     }
                 }
             }
-            AverageAndPackVectorField( mf_avg[lev], Bfield_fp[lev], dmap[lev], dcomp, ngrow );
+            AverageAndPackVectorField( mf_avg[lev], Bfield_fp[lev], dmap[lev], dcomp, ngrow, crse_ratio );
             dcomp += 3;
-            AverageAndPackVectorFieldComponents(mf_avg[lev], Bfield_fp[lev], dmap[lev], dcomp, ngrow);
+            AverageAndPackVectorFieldComponents(mf_avg[lev], Bfield_fp[lev], dmap[lev], dcomp, ngrow, crse_ratio);
             if (lev == 0) {
                 AddToVarNames(varnames, "B", "_fp");
                 if (n_rz_azimuthal_modes > 1) {
@@ -627,7 +656,7 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
             {
                 if (do_nodal) amrex::Abort("TODO: do_nodal && plot_crsepatch");
                 std::array<std::unique_ptr<MultiFab>, 3> E = getInterpolatedE(lev);
-                AverageAndPackVectorField( mf_avg[lev], E, dmap[lev], dcomp, ngrow );
+                AverageAndPackVectorField( mf_avg[lev], E, dmap[lev], dcomp, ngrow, crse_ratio );
 
             }
             if (lev == 0) AddToVarNames(varnames, "E", "_cp");
@@ -642,7 +671,7 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
             {
                 if (do_nodal) amrex::Abort("TODO: do_nodal && plot_crsepatch");
                 std::array<std::unique_ptr<MultiFab>, 3> B = getInterpolatedB(lev);
-                AverageAndPackVectorField( mf_avg[lev], B, dmap[lev], dcomp, ngrow );
+                AverageAndPackVectorField( mf_avg[lev], B, dmap[lev], dcomp, ngrow, crse_ratio );
             }
             if (lev == 0) AddToVarNames(varnames, "B", "_cp");
             dcomp += 3;
@@ -653,34 +682,6 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
 
 };
 
-/** \brief Reduce the size of all the fields in `source_mf`
-  * by `coarse_ratio` and store the results in `coarse_mf`.
-  * Calculate the corresponding coarse Geometry from `source_geom`
-  * and store the results in `coarse_geom` */
-void
-coarsenCellCenteredFields(
-    Vector<MultiFab>& coarse_mf, Vector<Geometry>& coarse_geom,
-    const Vector<MultiFab>& source_mf, const Vector<Geometry>& source_geom,
-    int coarse_ratio, int finest_level )
-{
-    // Check that the Vectors to be filled have an initial size of 0
-    AMREX_ALWAYS_ASSERT( coarse_mf.size()==0 );
-    AMREX_ALWAYS_ASSERT( coarse_geom.size()==0 );
-
-    // Fill the vectors with one element per level
-    int ncomp = source_mf[0].nComp();
-    for (int lev=0; lev<=finest_level; lev++) {
-        AMREX_ALWAYS_ASSERT( source_mf[lev].is_cell_centered() );
-
-        coarse_geom.push_back(amrex::coarsen( source_geom[lev], IntVect(coarse_ratio)));
-
-        BoxArray small_ba = amrex::coarsen(source_mf[lev].boxArray(), coarse_ratio);
-        coarse_mf.push_back( MultiFab(small_ba, source_mf[lev].DistributionMap(), ncomp, 0) );
-        Average::CoarsenAndInterpolate( coarse_mf[lev], source_mf[lev], 0, 0, ncomp, 0, IntVect(coarse_ratio) );
-    }
-};
-
-
 /** \brief Write the data from MultiFab `F` into the file `filename`
  *  as a raw field (i.e. no interpolation to cell centers).
  *  Write guard cells if `plot_guards` is True.
@@ -4,11 +4,62 @@
 
 #include <AMReX_buildInfo.H>
 
+#include <fstream>
+#include <sstream>
+
 using namespace amrex;
 
 namespace
 {
     const std::string level_prefix {"Level_"};
+
+    /** \brief Write the string \c contents into the file \c filename with a
+     *  single large write. Metadata files are assembled in memory first and
+     *  committed to disk in one call, because streaming them token by token
+     *  issues many tiny writes, which is slow on parallel file systems.
+     */
+    void
+    WriteStringToFile (const std::string& contents, const std::string& filename)
+    {
+        std::ofstream ofs(filename.c_str(), std::ofstream::out   |
+                                            std::ofstream::trunc |
+                                            std::ofstream::binary);
+        if( ! ofs.good()) amrex::FileOpenFailed(filename);
+        ofs.write(contents.c_str(), contents.size());
+        ofs.close();
+    }
+
+    /** \brief Create the per-species subdirectories of the plotfile
+     *  \c filename in a single pass on the I/O processor, followed by one
+     *  barrier. The particle writers then find the directories already in
+     *  place, so the flush does not serialize on one directory creation
+     *  (plus barrier) per species and level, which stalls all ranks on the
+     *  metadata server of a parallel file system at large scale.
+     */
+    void
+    PrebuildParticleDirectories (const std::string& filename,
+                                 MultiParticleContainer& mpc, const int nlev)
+    {
+        if (ParallelDescriptor::IOProcessor())
+        {
+            const std::vector<std::string> species_names = mpc.GetSpeciesNames();
+            for (int i = 0; i < mpc.nSpecies(); ++i)
+            {
+                if ( ! mpc.GetParticleContainer(i).plot_species) continue;
+                const std::string pdir = filename + "/" + species_names[i];
+                if ( ! UtilCreateDirectory(pdir, 0755))
+                    CreateDirectoryFailed(pdir);
+                for (int lev = 0; lev < nlev; ++lev)
+                {
+                    const std::string ldir = pdir + "/" +
+                        amrex::Concatenate(level_prefix, lev, 1);
+                    if ( ! UtilCreateDirectory(ldir, 0755))
+                        CreateDirectoryFailed(ldir);
+                }
+            }
+        }
+        ParallelDescriptor::Barrier();
+    }
 }
 
 void
@@ -42,6 +93,8 @@ FlushFormatPlotfile::WriteToFile (
     WriteAllRawFields(plot_raw_fields, nlev, filename, plot_raw_fields_guards,
                       plot_raw_rho, plot_raw_F);
 
+    PrebuildParticleDirectories(filename, mpc, nlev);
+
     mpc.WritePlotFile(filename);
 
     WriteJobInfo(filename);
@@ -59,8 +112,9 @@ FlushFormatPlotfile::WriteJobInfo(const std::string& dir) const
 
     if (ParallelDescriptor::IOProcessor())
     {
-        // job_info file with details about the run
-        std::ofstream jobInfoFile;
+        // job_info file with details about the run,
+        // assembled in memory and committed to disk in one write
+        std::ostringstream jobInfoFile;
         std::string FullPathJobInfoFile = dir;
 
         std::string PrettyLine = std::string(78, '=') + "\n";
@@ -68,7 +122,6 @@ FlushFormatPlotfile::WriteJobInfo(const std::string& dir) const
 //        std::string SkipSpace = std::string(8, ' ') + "\n";
 
         FullPathJobInfoFile += "/warpx_job_info";
-        jobInfoFile.open(FullPathJobInfoFile.c_str(), std::ios::out);
 
         // job information
         jobInfoFile << PrettyLine;
@@ -169,7 +222,7 @@ FlushFormatPlotfile::WriteJobInfo(const std::string& dir) const
 
         ParmParse::dumpTable(jobInfoFile, true);
 
-        jobInfoFile.close();
+        WriteStringToFile(jobInfoFile.str(), FullPathJobInfoFile);
     }
 }
 
@@ -179,15 +232,8 @@ FlushFormatPlotfile::WriteWarpXHeader(const std::string& name) const
     auto & warpx = WarpX::GetInstance();
     if (ParallelDescriptor::IOProcessor())
     {
-        VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
-        std::ofstream HeaderFile;
-        HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
-        std::string HeaderFileName(name + "/WarpXHeader");
-        HeaderFile.open(HeaderFileName.c_str(), std::ofstream::out   |
-                                                std::ofstream::trunc |
-                                                std::ofstream::binary);
-        if( ! HeaderFile.good())
-            amrex::FileOpenFailed(HeaderFileName);
+        // assemble the header in memory and commit it to disk in one write
+        std::ostringstream HeaderFile;
 
         HeaderFile.precision(17);
 
@@ -242,6 +288,8 @@ FlushFormatPlotfile::WriteWarpXHeader(const std::string& name) const
         }
 
         warpx.GetPartContainer().WriteHeader(HeaderFile);
+
+        WriteStringToFile(HeaderFile.str(), name + "/WarpXHeader");
     }
 }
 
@@ -46,8 +46,8 @@ void
 MultiDiagnostics::FilterComputePackFlush (int step, bool force_flush)
 {
     for (auto& diag : alldiags){
+        if ( diag->DoComputeAndPack( step, force_flush ) ) diag->ComputeAndPack();
         if ( !diag->DoDump( step, force_flush ) ) return;
-        diag->ComputeAndPack();
         diag->Flush();
         diag->FlushRaw();
     }
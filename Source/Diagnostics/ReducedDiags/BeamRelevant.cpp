@@ -7,6 +7,7 @@
 #include "BeamRelevant.H"
 #include "WarpX.H"
 #include "Utils/WarpXConst.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
 
 #include <AMReX_REAL.H>
 #include <AMReX_ParticleReduce.H>
@@ -134,13 +135,6 @@ void BeamRelevant::ComputeDiags (int step)
     // inverse of speed of light squared
     Real constexpr inv_c2 = 1.0 / (PhysConst::c * PhysConst::c);
 
-    // If 2D-XZ, p.pos(1) is z, rather than p.pos(2).
-#if (AMREX_SPACEDIM == 3)
-    int const index_z = 2;
-#elif (AMREX_SPACEDIM == 2)
-    int const index_z = 1;
-#endif
-
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -149,219 +143,265 @@ void BeamRelevant::ComputeDiags (int step)
         if (species_names[i_s] != m_beam_name) { continue; }
 
         // get WarpXParticleContainer class object
-        auto const & myspc = mypc.GetParticleContainer(i_s);
+        auto & myspc = mypc.GetParticleContainer(i_s);
 
         // get mass and charge (Real), FIXME actually all here are ParticleReal
         Real const m = myspc.getMass();
         Real const q = myspc.getCharge();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        // weight sum
-        Real w_sum = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::w); });
-
-        // reduced sum over mpi ranks
-        ParallelDescriptor::ReduceRealSum(w_sum);
-
-        if (w_sum < std::numeric_limits<Real>::min() )
+        const int nLevels = myspc.finestLevel();
+
+        // First fused pass over the particles: sum of the weights and
+        // weighted sums of the positions, the momenta and gamma, all
+        // accumulated in a single sweep. In 2D-XZ, the (undefined) y
+        // contributions are left at zero.
+        Real w_sum   = 0.0_rt;
+        Real x_mean  = 0.0_rt;
+        Real y_mean  = 0.0_rt;
+        Real z_mean  = 0.0_rt;
+        Real ux_mean = 0.0_rt;
+        Real uy_mean = 0.0_rt;
+        Real uz_mean = 0.0_rt;
+        Real gm_mean = 0.0_rt;
+
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion())
         {
-            for (int i = 0; i < m_data.size(); ++i) { m_data[i] = 0.0; }
-            return;
-        }
-
-        // x mean
-        Real x_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(0) * p.rdata(PIdx::w); });
-
+            ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                      ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+            ReduceData<Real, Real, Real, Real, Real, Real, Real, Real>
+                reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            for (int lev = 0; lev <= nLevels; ++lev) {
+                for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+                {
+                    const auto GetPosition = GetParticlePosition(pti);
+                    const auto wp  = pti.GetAttribs(PIdx::w).data();
+                    const auto uxp = pti.GetAttribs(PIdx::ux).data();
+                    const auto uyp = pti.GetAttribs(PIdx::uy).data();
+                    const auto uzp = pti.GetAttribs(PIdx::uz).data();
+                    const long np = pti.numParticles();
+                    reduce_op.eval(np, reduce_data,
+                    [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                    {
+                        ParticleReal xp, yp, zp;
+                        GetPosition(i, xp, yp, zp);
+                        const Real w  = wp[i];
+                        const Real us = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                        const Real gm = std::sqrt(1.0_rt + us*inv_c2);
 #if (AMREX_SPACEDIM == 3)
-        // y mean
-        Real y_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(1) * p.rdata(PIdx::w); });
+                        const Real yw = yp * w;
+#else
+                        const Real yw = 0.0_rt;
 #endif
-
-        // z mean
-        Real z_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(index_z) * p.rdata(PIdx::w); });
-
-        // ux mean
-        Real ux_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::ux) * p.rdata(PIdx::w); });
-
-        // uy mean
-        Real uy_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::uy) * p.rdata(PIdx::w); });
-
-        // uz mean
-        Real uz_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::uz) * p.rdata(PIdx::w); });
-
-        // gamma mean
-        Real gm_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real ux = p.rdata(PIdx::ux);
-            Real uy = p.rdata(PIdx::uy);
-            Real uz = p.rdata(PIdx::uz);
-            Real us = ux*ux + uy*uy + uz*uz;
-            return std::sqrt(1.0 + us*inv_c2) * p.rdata(PIdx::w);
-        });
-
-        // reduced sum over mpi ranks
-        ParallelDescriptor::ReduceRealSum(x_mean);  x_mean  /= w_sum;
-#if (AMREX_SPACEDIM == 3)
-        ParallelDescriptor::ReduceRealSum(y_mean);  y_mean  /= w_sum;
+                        return {w, xp*w, yw, zp*w,
+                                uxp[i]*w, uyp[i]*w, uzp[i]*w, gm*w};
+                    });
+                }
+            }
+            ReduceTuple hv = reduce_data.value();
+            w_sum   = amrex::get<0>(hv);
+            x_mean  = amrex::get<1>(hv);
+            y_mean  = amrex::get<2>(hv);
+            z_mean  = amrex::get<3>(hv);
+            ux_mean = amrex::get<4>(hv);
+            uy_mean = amrex::get<5>(hv);
+            uz_mean = amrex::get<6>(hv);
+            gm_mean = amrex::get<7>(hv);
+        }
+        else
 #endif
-        ParallelDescriptor::ReduceRealSum(z_mean);  z_mean  /= w_sum;
-        ParallelDescriptor::ReduceRealSum(ux_mean); ux_mean /= w_sum;
-        ParallelDescriptor::ReduceRealSum(uy_mean); uy_mean /= w_sum;
-        ParallelDescriptor::ReduceRealSum(uz_mean); uz_mean /= w_sum;
-        ParallelDescriptor::ReduceRealSum(gm_mean); gm_mean /= w_sum;
-
-        // x mean square
-        Real x_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
         {
-            Real const a = (p.pos(0)-x_mean) * (p.pos(0)-x_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
+            for (int lev = 0; lev <= nLevels; ++lev) {
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:w_sum, x_mean, y_mean, z_mean, \
+                                 ux_mean, uy_mean, uz_mean, gm_mean)
+#endif
+                for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+                {
+                    const auto GetPosition = GetParticlePosition(pti);
+                    const auto& wp  = pti.GetAttribs(PIdx::w);
+                    const auto& uxp = pti.GetAttribs(PIdx::ux);
+                    const auto& uyp = pti.GetAttribs(PIdx::uy);
+                    const auto& uzp = pti.GetAttribs(PIdx::uz);
+                    const long np = pti.numParticles();
+                    for (long i = 0; i < np; ++i) {
+                        ParticleReal xp, yp, zp;
+                        GetPosition(i, xp, yp, zp);
+                        const Real w  = wp[i];
+                        const Real us = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                        w_sum   += w;
+                        x_mean  += xp * w;
 #if (AMREX_SPACEDIM == 3)
-        // y mean square
-        Real y_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(1)-y_mean) * (p.pos(1)-y_mean);
-            return a * p.rdata(PIdx::w);
-        });
+                        y_mean  += yp * w;
 #endif
+                        z_mean  += zp * w;
+                        ux_mean += uxp[i] * w;
+                        uy_mean += uyp[i] * w;
+                        uz_mean += uzp[i] * w;
+                        gm_mean += std::sqrt(1.0_rt + us*inv_c2) * w;
+                    }
+                }
+            }
+        }
 
-        // z mean square
-        Real z_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(index_z)-z_mean) * (p.pos(index_z)-z_mean);
-            return a * p.rdata(PIdx::w);
-        });
+        // reduced sum over mpi ranks; the means are needed on every
+        // rank for the second pass
+        Real sums_mean[8] = {w_sum, x_mean, y_mean, z_mean,
+                             ux_mean, uy_mean, uz_mean, gm_mean};
+        ParallelDescriptor::ReduceRealSum(sums_mean, 8);
 
-        // ux mean square
-        Real ux_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.rdata(PIdx::ux)-ux_mean) *
-                           (p.rdata(PIdx::ux)-ux_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // uy mean square
-        Real uy_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.rdata(PIdx::uy)-uy_mean) *
-                           (p.rdata(PIdx::uy)-uy_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // uz mean square
-        Real uz_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.rdata(PIdx::uz)-uz_mean) *
-                           (p.rdata(PIdx::uz)-uz_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // gamma mean square
-        Real gm_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const ux = p.rdata(PIdx::ux);
-            Real const uy = p.rdata(PIdx::uy);
-            Real const uz = p.rdata(PIdx::uz);
-            Real const us = ux*ux + uy*uy + uz*uz;
-            Real const gm = std::sqrt(1.0 + us*inv_c2);
-            Real const a  = (gm - gm_mean) * (gm - gm_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // x times ux
-        Real xux = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+        w_sum = sums_mean[0];
+        if (w_sum < std::numeric_limits<Real>::min() )
         {
-            Real const a = (p.pos(0)-x_mean) * (p.rdata(PIdx::ux)-ux_mean);
-            return a * p.rdata(PIdx::w);
-        });
+            for (int i = 0; i < m_data.size(); ++i) { m_data[i] = 0.0; }
+            return;
+        }
 
-#if (AMREX_SPACEDIM == 3)
-        // y times uy
-        Real yuy = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+        x_mean  = sums_mean[1] / w_sum;
+        y_mean  = sums_mean[2] / w_sum;
+        z_mean  = sums_mean[3] / w_sum;
+        ux_mean = sums_mean[4] / w_sum;
+        uy_mean = sums_mean[5] / w_sum;
+        uz_mean = sums_mean[6] / w_sum;
+        gm_mean = sums_mean[7] / w_sum;
+
+        // the charge is just q times the total weight: no extra pass needed
+        Real charge = q * w_sum;
+
+        // Second fused pass: weighted second moments about the means,
+        // again accumulated in a single sweep
+        Real x_ms  = 0.0_rt;
+        Real y_ms  = 0.0_rt;
+        Real z_ms  = 0.0_rt;
+        Real ux_ms = 0.0_rt;
+        Real uy_ms = 0.0_rt;
+        Real uz_ms = 0.0_rt;
+        Real gm_ms = 0.0_rt;
+        Real xux   = 0.0_rt;
+        Real yuy   = 0.0_rt;
+        Real zuz   = 0.0_rt;
+
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion())
         {
-            Real const a = (p.pos(1)-y_mean) * (p.rdata(PIdx::uy)-uy_mean);
-            return a * p.rdata(PIdx::w);
-        });
+            ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                      ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                      ReduceOpSum, ReduceOpSum> reduce_op;
+            ReduceData<Real, Real, Real, Real, Real, Real, Real, Real,
+                       Real, Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            for (int lev = 0; lev <= nLevels; ++lev) {
+                for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+                {
+                    const auto GetPosition = GetParticlePosition(pti);
+                    const auto wp  = pti.GetAttribs(PIdx::w).data();
+                    const auto uxp = pti.GetAttribs(PIdx::ux).data();
+                    const auto uyp = pti.GetAttribs(PIdx::uy).data();
+                    const auto uzp = pti.GetAttribs(PIdx::uz).data();
+                    const long np = pti.numParticles();
+                    reduce_op.eval(np, reduce_data,
+                    [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                    {
+                        ParticleReal xp, yp, zp;
+                        GetPosition(i, xp, yp, zp);
+                        const Real w  = wp[i];
+                        const Real us = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                        const Real gm = std::sqrt(1.0_rt + us*inv_c2);
+                        const Real dx  = xp - x_mean;
+                        const Real dz  = zp - z_mean;
+                        const Real dux = uxp[i] - ux_mean;
+                        const Real duy = uyp[i] - uy_mean;
+                        const Real duz = uzp[i] - uz_mean;
+                        const Real dgm = gm - gm_mean;
+#if (AMREX_SPACEDIM == 3)
+                        const Real dy = yp - y_mean;
+                        const Real y_ms_w  = dy*dy*w;
+                        const Real yuy_w   = dy*duy*w;
+#else
+                        const Real y_ms_w  = 0.0_rt;
+                        const Real yuy_w   = 0.0_rt;
+#endif
+                        return {dx*dx*w, y_ms_w, dz*dz*w,
+                                dux*dux*w, duy*duy*w, duz*duz*w,
+                                dgm*dgm*w, dx*dux*w, yuy_w, dz*duz*w};
+                    });
+                }
+            }
+            ReduceTuple hv = reduce_data.value();
+            x_ms  = amrex::get<0>(hv);
+            y_ms  = amrex::get<1>(hv);
+            z_ms  = amrex::get<2>(hv);
+            ux_ms = amrex::get<3>(hv);
+            uy_ms = amrex::get<4>(hv);
+            uz_ms = amrex::get<5>(hv);
+            gm_ms = amrex::get<6>(hv);
+            xux   = amrex::get<7>(hv);
+            yuy   = amrex::get<8>(hv);
+            zuz   = amrex::get<9>(hv);
+        }
+        else
 #endif
-
-        // z times uz
-        Real zuz = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(index_z)-z_mean) * (p.rdata(PIdx::uz)-uz_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // charge
-        Real charge = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
         {
-            Real const w = p.rdata(PIdx::w);
-            return q * w;
-        });
-
-        // reduced sum over mpi ranks
-        ParallelDescriptor::ReduceRealSum
-            ( x_ms, ParallelDescriptor::IOProcessorNumber());
-        x_ms /= w_sum;
-#if (AMREX_SPACEDIM == 3)
-        ParallelDescriptor::ReduceRealSum
-            ( y_ms, ParallelDescriptor::IOProcessorNumber());
-        y_ms /= w_sum;
+            for (int lev = 0; lev <= nLevels; ++lev) {
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:x_ms, y_ms, z_ms, ux_ms, uy_ms, uz_ms, \
+                                 gm_ms, xux, yuy, zuz)
 #endif
-        ParallelDescriptor::ReduceRealSum
-            ( z_ms, ParallelDescriptor::IOProcessorNumber());
-        z_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (ux_ms, ParallelDescriptor::IOProcessorNumber());
-        ux_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (uy_ms, ParallelDescriptor::IOProcessorNumber());
-        uy_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (uz_ms, ParallelDescriptor::IOProcessorNumber());
-        uz_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (gm_ms, ParallelDescriptor::IOProcessorNumber());
-        gm_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (   xux, ParallelDescriptor::IOProcessorNumber());
-        xux /= w_sum;
+                for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+                {
+                    const auto GetPosition = GetParticlePosition(pti);
+                    const auto& wp  = pti.GetAttribs(PIdx::w);
+                    const auto& uxp = pti.GetAttribs(PIdx::ux);
+                    const auto& uyp = pti.GetAttribs(PIdx::uy);
+                    const auto& uzp = pti.GetAttribs(PIdx::uz);
+                    const long np = pti.numParticles();
+                    for (long i = 0; i < np; ++i) {
+                        ParticleReal xp, yp, zp;
+                        GetPosition(i, xp, yp, zp);
+                        const Real w  = wp[i];
+                        const Real us = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                        const Real gm = std::sqrt(1.0_rt + us*inv_c2);
+                        const Real dx  = xp - x_mean;
+                        const Real dz  = zp - z_mean;
+                        const Real dux = uxp[i] - ux_mean;
+                        const Real duy = uyp[i] - uy_mean;
+                        const Real duz = uzp[i] - uz_mean;
+                        const Real dgm = gm - gm_mean;
+                        x_ms  += dx*dx*w;
 #if (AMREX_SPACEDIM == 3)
-        ParallelDescriptor::ReduceRealSum
-            (   yuy, ParallelDescriptor::IOProcessorNumber());
-        yuy /= w_sum;
+                        const Real dy = yp - y_mean;
+                        y_ms  += dy*dy*w;
+                        yuy   += dy*duy*w;
 #endif
+                        z_ms  += dz*dz*w;
+                        ux_ms += dux*dux*w;
+                        uy_ms += duy*duy*w;
+                        uz_ms += duz*duz*w;
+                        gm_ms += dgm*dgm*w;
+                        xux   += dx*dux*w;
+                        zuz   += dz*duz*w;
+                    }
+                }
+            }
+        }
+
+        // reduced sum over mpi ranks (only the I/O rank needs the
+        // second moments)
+        Real sums_ms[10] = {x_ms, y_ms, z_ms, ux_ms, uy_ms, uz_ms,
+                            gm_ms, xux, yuy, zuz};
         ParallelDescriptor::ReduceRealSum
-            (   zuz, ParallelDescriptor::IOProcessorNumber());
-        zuz /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            ( charge, ParallelDescriptor::IOProcessorNumber());
+            (sums_ms, 10, ParallelDescriptor::IOProcessorNumber());
+        x_ms  = sums_ms[0] / w_sum;
+        y_ms  = sums_ms[1] / w_sum;
+        z_ms  = sums_ms[2] / w_sum;
+        ux_ms = sums_ms[3] / w_sum;
+        uy_ms = sums_ms[4] / w_sum;
+        uz_ms = sums_ms[5] / w_sum;
+        gm_ms = sums_ms[6] / w_sum;
+        xux   = sums_ms[7] / w_sum;
+        yuy   = sums_ms[8] / w_sum;
+        zuz   = sums_ms[9] / w_sum;
 
         // save data
 #if (AMREX_SPACEDIM == 3)
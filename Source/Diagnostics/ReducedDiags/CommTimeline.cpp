@@ -0,0 +1,162 @@
+/* Copyright 2020 Maxence Thevenet, Michael Rowan
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "CommTimeline.H"
+#include "Parallelization/CommTrace.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace amrex;
+
+// number of data fields per communication phase
+// (min, median, p99, max of the per-rank seconds, total bytes)
+constexpr int nFieldsPerPhase = 5;
+
+// constructor
+CommTimeline::CommTimeline (std::string rd_name)
+: ReducedDiags{rd_name}
+{
+
+    // turn on the timers at the communication call sites
+    CommTrace::Enable();
+
+    // read whether to write per-rank binary traces
+    ParmParse pp(m_rd_name);
+    pp.query("write_trace", m_write_trace);
+
+    // resize data array
+    m_data.resize(nFieldsPerPhase*CommTrace::nphases, 0.0);
+
+    // replace / create the per-rank trace file
+    if ( m_write_trace && m_IsNotRestart )
+    {
+        std::ofstream ofs;
+        ofs.open(TraceFileName(), std::ios::trunc | std::ios::binary);
+        ofs.close();
+    }
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs;
+            ofs.open(m_path + m_rd_name + "." + m_extension,
+                std::ofstream::out | std::ofstream::app);
+            // write header row
+            ofs << "#";
+            ofs << "[1]step()";
+            ofs << m_sep;
+            ofs << "[2]time(s)";
+            int c = 3;
+            for (int p = 0; p < CommTrace::nphases; ++p)
+            {
+                const std::string name = CommTrace::PhaseName(p);
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_min(s)";
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_p50(s)";
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_p99(s)";
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_max(s)";
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_bytes()";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+
+}
+// end constructor
+
+// function that collects the communication timers of all ranks
+void CommTimeline::ComputeDiags (int step)
+{
+
+    // Judge if the diags should be done
+    // (the timers then accumulate since the previous output)
+    if ( (step+1) % m_freq != 0 ) { return; }
+
+    // per-rank (seconds, bytes) of each phase
+    std::vector<Real> my_data;
+    CommTrace::FetchAndReset(my_data);
+    const int nvals = static_cast<int>(my_data.size());
+
+    // append the raw record of this rank to its binary trace
+    if ( m_write_trace )
+    {
+        std::vector<double> record;
+        record.reserve(nvals+1);
+        record.push_back(static_cast<double>(step+1));
+        record.insert(record.end(), my_data.begin(), my_data.end());
+        std::FILE* fp = std::fopen(TraceFileName().c_str(), "ab");
+        if (fp != nullptr)
+        {
+            std::fwrite(record.data(), sizeof(double), record.size(), fp);
+            std::fclose(fp);
+        } else {
+            Warning("CommTimeline: could not open " + TraceFileName()
+                + ", trace record skipped.");
+        }
+    }
+
+    // collect the timers of all ranks on the I/O rank
+    const int nprocs = ParallelDescriptor::NProcs();
+    std::vector<Real> all_data;
+    if (ParallelDescriptor::IOProcessor())
+    { all_data.resize(static_cast<std::size_t>(nvals)*nprocs); }
+    ParallelDescriptor::Gather(my_data.data(), nvals, all_data.data(),
+                               ParallelDescriptor::IOProcessorNumber());
+
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    // reduce into percentiles over the ranks
+    std::vector<Real> seconds(nprocs);
+    for (int p = 0; p < CommTrace::nphases; ++p)
+    {
+        for (int r = 0; r < nprocs; ++r)
+        { seconds[r] = all_data[static_cast<std::size_t>(r)*nvals + p]; }
+        std::sort(seconds.begin(), seconds.end());
+
+        m_data[nFieldsPerPhase*p+0] = seconds.front();
+        m_data[nFieldsPerPhase*p+1] =
+            seconds[static_cast<int>(0.50*(nprocs-1) + 0.5)];
+        m_data[nFieldsPerPhase*p+2] =
+            seconds[static_cast<int>(0.99*(nprocs-1) + 0.5)];
+        m_data[nFieldsPerPhase*p+3] = seconds.back();
+
+        Real bytes = 0.;
+        for (int r = 0; r < nprocs; ++r)
+        { bytes += all_data[static_cast<std::size_t>(r)*nvals
+                            + CommTrace::nphases + p]; }
+        m_data[nFieldsPerPhase*p+4] = bytes;
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [min, median, p99, max of the per-rank seconds, total bytes
+     *   of FillBoundaryE_post,
+     *   ... of FillBoundaryE_wait,
+     *   ......] */
+
+}
+// end void CommTimeline::ComputeDiags
+
+// name of the binary trace file of this rank
+std::string CommTimeline::TraceFileName () const
+{
+    return m_path + m_rd_name + "_rank"
+        + std::to_string(ParallelDescriptor::MyProc()) + ".bin";
+}
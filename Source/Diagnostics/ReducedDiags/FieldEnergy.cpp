@@ -6,6 +6,7 @@
  */
 
 #include "FieldEnergy.H"
+#include "FieldReduction.H"
 #include "WarpX.H"
 #include "Utils/WarpXConst.H"
 
@@ -106,17 +107,17 @@ void FieldEnergy::ComputeDiags (int step)
         auto dV = geom.CellSize(0) * geom.CellSize(1) * geom.CellSize(2);
         #endif
 
-        // compute E squared
-        Real tmpx = Ex.norm2(0,geom.periodicity());
-        Real tmpy = Ey.norm2(0,geom.periodicity());
-        Real tmpz = Ez.norm2(0,geom.periodicity());
-        Real Es = tmpx*tmpx + tmpy*tmpy + tmpz*tmpz;
-
-        // compute B squared
-        tmpx = Bx.norm2(0,geom.periodicity());
-        tmpy = By.norm2(0,geom.periodicity());
-        tmpz = Bz.norm2(0,geom.periodicity());
-        Real Bs = tmpx*tmpx + tmpy*tmpy + tmpz*tmpz;
+        // compute the sums of squares of all six components with the
+        // fused reduction engine: one device reduction per component and
+        // two MPI reductions, instead of six norm2 calls (each with its
+        // own allreduce)
+        const std::array<const MultiFab*,6> fields
+            {&Ex, &Ey, &Ez, &Bx, &By, &Bz};
+        const auto moments =
+            FieldReduction::ComputeMoments(fields, geom.periodicity());
+
+        const Real Es = moments[0].sum + moments[1].sum + moments[2].sum;
+        const Real Bs = moments[3].sum + moments[4].sum + moments[5].sum;
 
         // save data
         m_data[lev*3+1] = 0.5 * Es * PhysConst::ep0 * dV;
@@ -0,0 +1,312 @@
+/* Copyright 2019-2020 Yinjian Zhao
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "FieldProbe.H"
+#include "WarpX.H"
+
+#include <AMReX_REAL.H>
+#include <AMReX_ParticleReduce.H>
+
+#include <iostream>
+#include <cmath>
+
+
+using namespace amrex;
+
+namespace {
+
+    /// everything the gather kernel needs for one probe
+    struct ProbeFields
+    {
+        amrex::Array4<amrex::Real const> ex, ey, ez, bx, by, bz;
+        amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> ipos;
+        int iprobe;
+    };
+
+    /* \brief Interpolate one field component at the given position,
+     * with first-order (CIC) shape factors matching its staggering.
+     *
+     * \param[in] arr the field component on the owning grid
+     * \param[in] ipos position of the probe, in units of cells from
+     *            the lower domain corner
+     * \param[in] stag staggering of the component (1: nodal) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::Real InterpolateComponent (
+        amrex::Array4<amrex::Real const> const& arr,
+        amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& ipos,
+        amrex::GpuArray<int,AMREX_SPACEDIM> const& stag )
+    {
+        using namespace amrex;
+        int i[AMREX_SPACEDIM];
+        Real w[AMREX_SPACEDIM];
+        for (int d=0 ; d < AMREX_SPACEDIM ; d++) {
+            // Shift by half a cell in the directions in which the
+            // component is cell-centered
+            Real const s = ipos[d] - (stag[d] ? 0._rt : 0.5_rt);
+            i[d] = static_cast<int>(std::floor(s));
+            w[d] = s - i[d];
+        }
+#if (AMREX_SPACEDIM == 2)
+        return (1._rt-w[0])*(1._rt-w[1])*arr(i[0]  , i[1]  , 0)
+             +        w[0] *(1._rt-w[1])*arr(i[0]+1, i[1]  , 0)
+             + (1._rt-w[0])*       w[1] *arr(i[0]  , i[1]+1, 0)
+             +        w[0] *       w[1] *arr(i[0]+1, i[1]+1, 0);
+#else
+        return (1._rt-w[0])*(1._rt-w[1])*(1._rt-w[2])*arr(i[0]  , i[1]  , i[2]  )
+             +        w[0] *(1._rt-w[1])*(1._rt-w[2])*arr(i[0]+1, i[1]  , i[2]  )
+             + (1._rt-w[0])*       w[1] *(1._rt-w[2])*arr(i[0]  , i[1]+1, i[2]  )
+             +        w[0] *       w[1] *(1._rt-w[2])*arr(i[0]+1, i[1]+1, i[2]  )
+             + (1._rt-w[0])*(1._rt-w[1])*       w[2] *arr(i[0]  , i[1]  , i[2]+1)
+             +        w[0] *(1._rt-w[1])*       w[2] *arr(i[0]+1, i[1]  , i[2]+1)
+             + (1._rt-w[0])*       w[1] *       w[2] *arr(i[0]  , i[1]+1, i[2]+1)
+             +        w[0] *       w[1] *       w[2] *arr(i[0]+1, i[1]+1, i[2]+1);
+#endif
+    }
+
+    /// staggering of a field component, as needed by the kernel
+    amrex::GpuArray<int,AMREX_SPACEDIM> Staggering (amrex::MultiFab const& mf)
+    {
+        amrex::GpuArray<int,AMREX_SPACEDIM> stag;
+        for (int d=0 ; d < AMREX_SPACEDIM ; d++) {
+            stag[d] = mf.ixType().nodeCentered(d) ? 1 : 0;
+        }
+        return stag;
+    }
+
+}
+
+// constructor
+FieldProbe::FieldProbe (std::string rd_name)
+: ReducedDiags{rd_name}
+{
+
+    // RZ coordinate is not working
+    #if (defined WARPX_DIM_RZ)
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(false,
+        "FieldProbe reduced diagnostics does not work for RZ coordinate.");
+    #endif
+
+    // read probe positions
+    ParmParse pp(rd_name);
+    pp.getarr("x_probe", m_x_probe);
+#if (AMREX_SPACEDIM == 3)
+    pp.getarr("y_probe", m_y_probe);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_y_probe.size() == m_x_probe.size(),
+        "x_probe, y_probe and z_probe must have the same number of values.");
+#endif
+    pp.getarr("z_probe", m_z_probe);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_z_probe.size() == m_x_probe.size(),
+        "x_probe, y_probe and z_probe must have the same number of values.");
+
+    int const nprobes = m_x_probe.size();
+
+    // resize data array
+    m_data.resize(6*nprobes,0.0);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs;
+            ofs.open(m_path + m_rd_name + "." + m_extension,
+                std::ofstream::out | std::ofstream::app);
+            // write header row
+            ofs << "#";
+            ofs << "[1]step()";
+            ofs << m_sep;
+            ofs << "[2]time(s)";
+            std::vector<std::string> comps =
+                {"Ex(V/m)","Ey(V/m)","Ez(V/m)","Bx(T)","By(T)","Bz(T)"};
+            for (int ip = 0; ip < nprobes; ++ip)
+            {
+                for (int ic = 0; ic < 6; ++ic)
+                {
+                    ofs << m_sep;
+                    ofs << "[" + std::to_string(3+6*ip+ic) + "]";
+                    ofs << "probe"+std::to_string(ip)+"_"+comps[ic];
+                }
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+
+}
+// end constructor
+
+// function that resolves the probe positions to level, grid and rank
+void FieldProbe::UpdateProbeLocations ()
+{
+
+    // get WarpX class object
+    auto & warpx = WarpX::GetInstance();
+
+    // get number of level
+    auto const nLevel = warpx.finestLevel() + 1;
+
+    // The locations only need to be resolved again after a regrid
+    bool unchanged = (m_ba.size() == nLevel);
+    for (int lev = 0; unchanged && lev < nLevel; ++lev)
+    {
+        unchanged = (m_ba[lev] == warpx.boxArray(lev)) &&
+                    (m_dm[lev] == warpx.DistributionMap(lev));
+    }
+    if (unchanged) { return; }
+
+    m_ba.resize(nLevel);
+    m_dm.resize(nLevel);
+    for (int lev = 0; lev < nLevel; ++lev)
+    {
+        m_ba[lev] = warpx.boxArray(lev);
+        m_dm[lev] = warpx.DistributionMap(lev);
+    }
+
+    m_locations.clear();
+    int const myproc = ParallelDescriptor::MyProc();
+
+    // loop over probes
+    for (int ip = 0; ip < m_x_probe.size(); ++ip)
+    {
+        // find the finest level and the grid containing the probe
+        for (int lev = nLevel-1; lev >= 0; lev--)
+        {
+            Geometry const & geom = warpx.Geom(lev);
+            auto const problo = geom.ProbLoArray();
+            auto const dxinv = geom.InvCellSizeArray();
+#if (AMREX_SPACEDIM == 2)
+            IntVect const iv(
+                static_cast<int>(std::floor((m_x_probe[ip]-problo[0])*dxinv[0])),
+                static_cast<int>(std::floor((m_z_probe[ip]-problo[1])*dxinv[1])));
+#else
+            IntVect const iv(
+                static_cast<int>(std::floor((m_x_probe[ip]-problo[0])*dxinv[0])),
+                static_cast<int>(std::floor((m_y_probe[ip]-problo[1])*dxinv[1])),
+                static_cast<int>(std::floor((m_z_probe[ip]-problo[2])*dxinv[2])));
+#endif
+            int igrid = -1;
+            for (int ib = 0; ib < m_ba[lev].size(); ++ib)
+            {
+                if (m_ba[lev][ib].contains(iv)) { igrid = ib; break; }
+            }
+            // the level does not cover the probe: try the coarser one
+            if (igrid < 0) { continue; }
+
+            if (m_dm[lev][igrid] == myproc)
+            {
+                ProbeLocation loc;
+                loc.m_iprobe = ip;
+                loc.m_lev = lev;
+                loc.m_grid = igrid;
+                m_locations.push_back(loc);
+            }
+            break;
+        }
+    }
+    // end loop over probes
+
+}
+// end void FieldProbe::UpdateProbeLocations
+
+// function that samples the fields at the probe points
+void FieldProbe::ComputeDiags (int step)
+{
+
+    // Judge if the diags should be done
+    if ( (step+1) % m_freq != 0 ) { return; }
+
+    // get WarpX class object
+    auto & warpx = WarpX::GetInstance();
+
+    UpdateProbeLocations();
+
+    int const nprobes = m_x_probe.size();
+    m_data.assign(6*nprobes, 0.0);
+
+    // build the gather descriptors of the locally owned probes
+    amrex::Vector<ProbeFields> probes_h;
+    for (auto const & loc : m_locations)
+    {
+        Geometry const & geom = warpx.Geom(loc.m_lev);
+        auto const problo = geom.ProbLoArray();
+        auto const dxinv = geom.InvCellSizeArray();
+
+        ProbeFields pf;
+        pf.ex = warpx.getEfield(loc.m_lev,0)[loc.m_grid].array();
+        pf.ey = warpx.getEfield(loc.m_lev,1)[loc.m_grid].array();
+        pf.ez = warpx.getEfield(loc.m_lev,2)[loc.m_grid].array();
+        pf.bx = warpx.getBfield(loc.m_lev,0)[loc.m_grid].array();
+        pf.by = warpx.getBfield(loc.m_lev,1)[loc.m_grid].array();
+        pf.bz = warpx.getBfield(loc.m_lev,2)[loc.m_grid].array();
+#if (AMREX_SPACEDIM == 2)
+        pf.ipos = {(m_x_probe[loc.m_iprobe]-problo[0])*dxinv[0],
+                   (m_z_probe[loc.m_iprobe]-problo[1])*dxinv[1]};
+#else
+        pf.ipos = {(m_x_probe[loc.m_iprobe]-problo[0])*dxinv[0],
+                   (m_y_probe[loc.m_iprobe]-problo[1])*dxinv[1],
+                   (m_z_probe[loc.m_iprobe]-problo[2])*dxinv[2]};
+#endif
+        pf.iprobe = loc.m_iprobe;
+        probes_h.push_back(pf);
+    }
+
+    int const nlocal = probes_h.size();
+    if (nlocal > 0)
+    {
+        // staggering of the components (the same on all levels)
+        auto const stag_ex = Staggering(warpx.getEfield(0,0));
+        auto const stag_ey = Staggering(warpx.getEfield(0,1));
+        auto const stag_ez = Staggering(warpx.getEfield(0,2));
+        auto const stag_bx = Staggering(warpx.getBfield(0,0));
+        auto const stag_by = Staggering(warpx.getBfield(0,1));
+        auto const stag_bz = Staggering(warpx.getBfield(0,2));
+
+        // gather all the local probes in one small kernel
+        Gpu::DeviceVector<ProbeFields> probes_d(nlocal);
+        Gpu::copyAsync(Gpu::hostToDevice,
+                       probes_h.begin(), probes_h.end(), probes_d.begin());
+        Gpu::DeviceVector<Real> values_d(6*nlocal);
+        auto const * probes_ptr = probes_d.dataPtr();
+        auto * values_ptr = values_d.dataPtr();
+        amrex::ParallelFor( nlocal,
+        [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            ProbeFields const & p = probes_ptr[i];
+            values_ptr[6*i  ] = InterpolateComponent(p.ex, p.ipos, stag_ex);
+            values_ptr[6*i+1] = InterpolateComponent(p.ey, p.ipos, stag_ey);
+            values_ptr[6*i+2] = InterpolateComponent(p.ez, p.ipos, stag_ez);
+            values_ptr[6*i+3] = InterpolateComponent(p.bx, p.ipos, stag_bx);
+            values_ptr[6*i+4] = InterpolateComponent(p.by, p.ipos, stag_by);
+            values_ptr[6*i+5] = InterpolateComponent(p.bz, p.ipos, stag_bz);
+        });
+
+        amrex::Vector<Real> values_h(6*nlocal);
+        Gpu::copyAsync(Gpu::deviceToHost,
+                       values_d.begin(), values_d.end(), values_h.begin());
+        Gpu::streamSynchronize();
+
+        for (int i = 0; i < nlocal; ++i)
+        {
+            for (int ic = 0; ic < 6; ++ic)
+            { m_data[6*probes_h[i].iprobe+ic] = values_h[6*i+ic]; }
+        }
+    }
+
+    // Each probe is gathered by exactly one rank;
+    // the other ranks contribute zero
+    ParallelDescriptor::ReduceRealSum(m_data.data(), m_data.size());
+
+    /* m_data now contains up-to-date values for:
+     *  [Ex, Ey, Ez, Bx, By, Bz of probe 0,
+     *   Ex, Ey, Ez, Bx, By, Bz of probe 1,
+     *   ......] */
+
+}
+// end void FieldProbe::ComputeDiags
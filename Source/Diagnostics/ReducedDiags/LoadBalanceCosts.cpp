@@ -16,7 +16,9 @@ using namespace amrex;
 LoadBalanceCosts::LoadBalanceCosts (std::string rd_name)
     : ReducedDiags{rd_name}
 {
-
+    // WriteToFile reads live WarpX state (hostnames, final-step rewrite
+    // of the whole file), so it cannot run on the background I/O thread
+    m_supports_async = 0;
 }
 
 // function that gathers costs
@@ -0,0 +1,112 @@
+/* Copyright 2020 Maxence Thevenet, Michael Rowan
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "MemoryUsage.H"
+#include "Utils/WarpXMemoryMonitor.H"
+
+#include <AMReX_BaseFab.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace amrex;
+
+// number of data fields per subsystem
+// (bytes summed over ranks, largest single-rank bytes)
+constexpr int nFieldsPerLabel = 2;
+
+namespace
+{
+    // column name of a subsystem label: spaces to underscores,
+    // parentheses dropped
+    std::string SanitizeLabel (std::string s)
+    {
+        s.erase(std::remove(s.begin(), s.end(), '('), s.end());
+        s.erase(std::remove(s.begin(), s.end(), ')'), s.end());
+        std::replace(s.begin(), s.end(), ' ', '_');
+        return s;
+    }
+}
+
+// constructor
+MemoryUsage::MemoryUsage (std::string rd_name)
+: ReducedDiags{rd_name}
+{
+
+    // turn on the accounting at the instrumented allocation sites
+    // (regardless of warpx.do_memory_report)
+    MemoryMonitor::Enable();
+
+    // resize data array: one (total, rank-max) pair per subsystem,
+    // plus one for the actual Fab bytes tracked by AMReX
+    m_data.resize(nFieldsPerLabel*(MemoryMonitor::NumLabels()+1), 0.0);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs;
+            ofs.open(m_path + m_rd_name + "." + m_extension,
+                std::ofstream::out | std::ofstream::app);
+            // write header row
+            ofs << "#";
+            ofs << "[1]step()";
+            ofs << m_sep;
+            ofs << "[2]time(s)";
+            int c = 3;
+            for (int i = 0; i < MemoryMonitor::NumLabels(); ++i)
+            {
+                const std::string name =
+                    SanitizeLabel(MemoryMonitor::LabelName(i));
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_total(bytes)";
+                ofs << m_sep << "[" + std::to_string(c++) + "]";
+                ofs << name + "_max_rank(bytes)";
+            }
+            ofs << m_sep << "[" + std::to_string(c++) + "]";
+            ofs << "amrex_fabs_total(bytes)";
+            ofs << m_sep << "[" + std::to_string(c++) + "]";
+            ofs << "amrex_fabs_max_rank(bytes)";
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+
+}
+// end constructor
+
+// function that reduces the per-subsystem footprints over the ranks
+void MemoryUsage::ComputeDiags (int step)
+{
+
+    // Judge if the diags should be done
+    if ( (step+1) % m_freq != 0 ) { return; }
+
+    const int nlabels = MemoryMonitor::NumLabels();
+
+    // current local bytes of each subsystem, plus the actual Fab bytes;
+    // the label registry is fixed, so the reduction is collective even
+    // on ranks that never executed an instrumented site
+    std::vector<long> sums(nlabels+1);
+    for (int i = 0; i < nlabels; ++i) { sums[i] = MemoryMonitor::Current(i); }
+    sums[nlabels] = static_cast<long>(TotalBytesAllocatedInFabs());
+    std::vector<long> maxs = sums;
+
+    ParallelDescriptor::ReduceLongSum(sums.data(), nlabels+1);
+    ParallelDescriptor::ReduceLongMax(maxs.data(), nlabels+1);
+
+    for (int i = 0; i < nlabels+1; ++i)
+    {
+        m_data[nFieldsPerLabel*i+0] = static_cast<Real>(sums[i]);
+        m_data[nFieldsPerLabel*i+1] = static_cast<Real>(maxs[i]);
+    }
+
+}
+// end of function MemoryUsage::ComputeDiags
@@ -5,12 +5,16 @@
  * License: BSD-3-Clause-LBNL
  */
 
+#include "CommTimeline.H"
 #include "LoadBalanceCosts.H"
+#include "MemoryUsage.H"
 #include "ParticleHistogram.H"
 #include "BeamRelevant.H"
 #include "ParticleEnergy.H"
 #include "FieldEnergy.H"
+#include "FieldProbe.H"
 #include "MultiReducedDiags.H"
+#include "WarpX.H"
 #include "AMReX_ParmParse.H"
 #include "AMReX_ParallelDescriptor.H"
 #include <fstream>
@@ -28,6 +32,9 @@ MultiReducedDiags::MultiReducedDiags ()
     // if names are not given, reduced diags will not be done
     if ( m_plot_rd == 0 ) { return; }
 
+    // read whether to write the records from a background I/O thread
+    pp.query("reduced_diags_async_write", m_async_write);
+
     // resize
     m_multi_rd.resize(m_rd_names.size());
 
@@ -52,6 +59,11 @@ MultiReducedDiags::MultiReducedDiags ()
             m_multi_rd[i_rd].reset
                 ( new FieldEnergy(m_rd_names[i_rd]));
         }
+        else if (rd_type.compare("FieldProbe") == 0)
+        {
+            m_multi_rd[i_rd].reset
+                ( new FieldProbe(m_rd_names[i_rd]));
+        }
         else if (rd_type.compare("BeamRelevant") == 0)
         {
             m_multi_rd[i_rd].reset
@@ -62,11 +74,21 @@ MultiReducedDiags::MultiReducedDiags ()
             m_multi_rd[i_rd].reset
                 ( new LoadBalanceCosts(m_rd_names[i_rd]));
         }
+        else if (rd_type.compare("CommTimeline") == 0)
+        {
+            m_multi_rd[i_rd].reset
+                ( new CommTimeline(m_rd_names[i_rd]));
+        }
         else if (rd_type.compare("ParticleHistogram") == 0)
         {
             m_multi_rd[i_rd].reset
                 ( new ParticleHistogram(m_rd_names[i_rd]));
         }
+        else if (rd_type.compare("MemoryUsage") == 0)
+        {
+            m_multi_rd[i_rd].reset
+                ( new MemoryUsage(m_rd_names[i_rd]));
+        }
         else
         { Abort("No matching reduced diagnostics type found."); }
         // end if match diags
@@ -74,9 +96,28 @@ MultiReducedDiags::MultiReducedDiags ()
     }
     // end loop over all reduced diags
 
+    // start the background I/O thread on the I/O rank
+    if ( m_async_write && ParallelDescriptor::IOProcessor() )
+    {
+        m_queue.resize(queue_capacity);
+        m_io_thread = std::thread(&MultiReducedDiags::WriteLoop, this);
+    }
+
 }
 // end constructor
 
+// destructor
+MultiReducedDiags::~MultiReducedDiags ()
+{
+    if ( m_io_thread.joinable() )
+    {
+        // the I/O thread keeps writing until the queue is empty
+        m_done.store(1, std::memory_order_release);
+        m_io_thread.join();
+    }
+}
+// end destructor
+
 // call functions to compute diags
 void MultiReducedDiags::ComputeDiags (int step)
 {
@@ -103,10 +144,67 @@ void MultiReducedDiags::WriteToFile (int step)
         // Judge if the diags should be done
         if ( (step+1) % m_multi_rd[i_rd]->m_freq != 0 ) { return; }
 
-        // call the write to file function
-        m_multi_rd[i_rd]->WriteToFile(step);
+        if ( m_async_write && m_multi_rd[i_rd]->m_supports_async )
+        {
+            // hand the record over to the background I/O thread
+            EnqueueRecord(i_rd, step);
+        }
+        else
+        {
+            // call the write to file function
+            m_multi_rd[i_rd]->WriteToFile(step);
+        }
 
     }
     // end loop over all reduced diags
 }
 // end void MultiReducedDiags::WriteToFile
+
+// function to snapshot one record into the ring buffer
+void MultiReducedDiags::EnqueueRecord (int i_rd, int step)
+{
+    long const tail = m_queue_tail.load(std::memory_order_relaxed);
+
+    // wait for a free slot: the queue only fills up if the I/O thread
+    // cannot keep up, in which case waiting here is no worse than the
+    // synchronous write
+    while ( tail - m_queue_head.load(std::memory_order_acquire)
+            >= queue_capacity )
+    { std::this_thread::yield(); }
+
+    Record& record = m_queue[tail % queue_capacity];
+    record.i_rd = i_rd;
+    record.step = step;
+    record.time = WarpX::GetInstance().gett_new(0);
+    record.data = m_multi_rd[i_rd]->m_data;
+
+    // publish the record to the I/O thread
+    m_queue_tail.store(tail+1, std::memory_order_release);
+}
+// end void MultiReducedDiags::EnqueueRecord
+
+// main loop of the background I/O thread
+void MultiReducedDiags::WriteLoop ()
+{
+    long head = m_queue_head.load(std::memory_order_relaxed);
+    while ( true )
+    {
+        if ( head == m_queue_tail.load(std::memory_order_acquire) )
+        {
+            // only stop on an empty queue, so that the records still
+            // pending at the end of the run are written out
+            if ( m_done.load(std::memory_order_acquire) ) { return; }
+            std::this_thread::yield();
+            continue;
+        }
+
+        Record const& record = m_queue[head % queue_capacity];
+        m_multi_rd[record.i_rd]->WriteRecord(
+            record.step, record.time, record.data);
+
+        // release the slot back to the main thread
+        ++head;
+        m_queue_head.store(head, std::memory_order_release);
+    }
+}
+// end void MultiReducedDiags::WriteLoop
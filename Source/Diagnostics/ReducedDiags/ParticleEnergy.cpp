@@ -105,46 +105,74 @@ void ParticleEnergy::ComputeDiags (int step)
         // get mass (Real)
         auto m = myspc.getMass();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        // Use amex::ReduceSum to compute the sum of energies of all particles
-        // held by the current MPI rank, for this species. This involves a loop over all
-        // boxes held by this MPI rank.
+        // Photons have m = 0, but ux,uy and uz are calculated assuming
+        // a mass equal to the electron mass. Therefore, photons need a
+        // special treatment to calculate the total energy.
+        const bool is_photon = myspc.AmIA<PhysicalSpecies::photon>();
+        constexpr auto me_c = PhysConst::m_e * PhysConst::c;
+
+        // Compute the sum of the energies and of the weights of all
+        // particles held by the current MPI rank, for this species, in
+        // a single fused pass over the particles.
         Real Etot = 0.0_rt;
-        if(myspc.AmIA<PhysicalSpecies::photon>()){
-            //Photons have m = 0, but ux,uy and uz are calculated assuming
-            //a mass equal to the electron mass. Therefore, photons need a special
-            //treatment to calculate the total energy.
-            constexpr auto me_c = PhysConst::m_e * PhysConst::c;
-            Etot = ReduceSum( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-            {
-                const auto w  = p.rdata(PIdx::w);
-                const auto ux = p.rdata(PIdx::ux);
-                const auto uy = p.rdata(PIdx::uy);
-                const auto uz = p.rdata(PIdx::uz);
-                const auto us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(us) * me_c * w;
-            });
-        } else {
-            Etot = ReduceSum( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-            {
-                const auto w  = p.rdata(PIdx::w);
-                const auto ux = p.rdata(PIdx::ux);
-                const auto uy = p.rdata(PIdx::uy);
-                const auto uz = p.rdata(PIdx::uz);
-                const auto us = ux*ux + uy*uy + uz*uz;
-                return ( std::sqrt(us*c2 + c2*c2) - c2 ) * m * w;
-            });
-        }
+        Real Wtot = 0.0_rt;
 
-        // Same thing for the particles weights.
-        auto Wtot = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+        const int nLevels = myspc.finestLevel();
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion())
+        {
+            ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+            ReduceData<Real, Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            for (int lev = 0; lev <= nLevels; ++lev) {
+                for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+                {
+                    const auto wp  = pti.GetAttribs(PIdx::w).data();
+                    const auto uxp = pti.GetAttribs(PIdx::ux).data();
+                    const auto uyp = pti.GetAttribs(PIdx::uy).data();
+                    const auto uzp = pti.GetAttribs(PIdx::uz).data();
+                    const long np = pti.numParticles();
+                    reduce_op.eval(np, reduce_data,
+                    [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                    {
+                        const Real w  = wp[i];
+                        const Real us = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                        const Real e  = is_photon ?
+                            std::sqrt(us) * me_c * w :
+                            ( std::sqrt(us*c2 + c2*c2) - c2 ) * m * w;
+                        return {e, w};
+                    });
+                }
+            }
+            ReduceTuple hv = reduce_data.value();
+            Etot = amrex::get<0>(hv);
+            Wtot = amrex::get<1>(hv);
+        }
+        else
+#endif
         {
-            return p.rdata(PIdx::w);
-        });
+            for (int lev = 0; lev <= nLevels; ++lev) {
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:Etot, Wtot)
+#endif
+                for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+                {
+                    const auto& wp  = pti.GetAttribs(PIdx::w);
+                    const auto& uxp = pti.GetAttribs(PIdx::ux);
+                    const auto& uyp = pti.GetAttribs(PIdx::uy);
+                    const auto& uzp = pti.GetAttribs(PIdx::uz);
+                    const long np = pti.numParticles();
+                    for (long i = 0; i < np; ++i) {
+                        const Real w  = wp[i];
+                        const Real us = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                        Etot += is_photon ?
+                            std::sqrt(us) * me_c * w :
+                            ( std::sqrt(us*c2 + c2*c2) - c2 ) * m * w;
+                        Wtot += w;
+                    }
+                }
+            }
+        }
 
         // reduced sum over mpi ranks
         ParallelDescriptor::ReduceRealSum
@@ -9,7 +9,9 @@
 #include "WarpX.H"
 #include "Utils/WarpXUtil.H"
 #include <AMReX_REAL.H>
-#include <AMReX_ParticleReduce.H>
+#include <AMReX_GpuContainers.H>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 using namespace amrex;
@@ -130,9 +132,7 @@ void ParticleHistogram::ComputeDiags (int step)
     auto & mypc = warpx.GetPartContainer();
 
     // get WarpXParticleContainer class object
-    auto const & myspc = mypc.GetParticleContainer(m_selected_species_id);
-
-    using PType = typename WarpXParticleContainer::SuperParticleType;
+    auto & myspc = mypc.GetParticleContainer(m_selected_species_id);
 
     // get parser
     ParserWrapper<m_nvars> *fun_partparser = m_parser.get();
@@ -140,31 +140,89 @@ void ParticleHistogram::ComputeDiags (int step)
     // declare local variables
     Real const bin_min  = m_bin_min;
     Real const bin_size = m_bin_size;
+    int  const bin_num  = m_bin_num;
     const bool is_unity_particle_weight =
         (m_norm == NormalizationType::unity_particle_weight) ? true : false;
 
-    for ( int i = 0; i < m_bin_num; ++i )
+    // local histogram, filled atomically by one single pass over the
+    // particles (instead of one full sweep per bin)
+    Gpu::ManagedDeviceVector<Real> d_data(m_bin_num);
+    std::fill(d_data.begin(), d_data.end(), 0.0_rt);
+    Real * const AMREX_RESTRICT dptr = d_data.dataPtr();
+
+    int const nLevels = myspc.finestLevel();
+    for (int lev = 0; lev <= nLevels; ++lev)
     {
-        // compute the histogram
-        m_data[i] = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+#ifdef _OPENMP
+        #pragma omp parallel
+#endif
         {
-            auto const w  = p.rdata(PIdx::w);
-            auto const x  = p.pos(0);
-            auto const y  = p.pos(1);
-            auto const z  = p.pos(2);
-            auto const ux = p.rdata(PIdx::ux)/PhysConst::c;
-            auto const uy = p.rdata(PIdx::uy)/PhysConst::c;
-            auto const uz = p.rdata(PIdx::uz)/PhysConst::c;
-            auto const f = (*fun_partparser)(t,x,y,z,ux,uy,uz);
-            auto const f1 = bin_min + bin_size*i;
-            auto const f2 = bin_min + bin_size*(i+1);
-            if ( f > f1 && f < f2 ) {
-                if ( is_unity_particle_weight ) return 1.0_rt;
-                else return w;
-            } else return 0.0_rt;
-        });
+#if defined(_OPENMP) && !defined(AMREX_USE_GPU)
+            // Each thread fills a private histogram and the histograms
+            // are merged once per level below : with thousands of bins,
+            // per-particle atomic updates of a shared histogram would
+            // serialize on the hot bins.
+            amrex::Vector<Real> thread_data(bin_num, 0.0_rt);
+            Real * const AMREX_RESTRICT hptr = thread_data.dataPtr();
+#else
+            Real * const AMREX_RESTRICT hptr = dptr;
+#endif
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+        {
+            auto const np = pti.numParticles();
+            auto const & aos = pti.GetArrayOfStructs();
+            auto const * AMREX_RESTRICT pstruct = aos().dataPtr();
+            ParticleReal const * const AMREX_RESTRICT wp =
+                pti.GetAttribs(PIdx::w).data();
+            ParticleReal const * const AMREX_RESTRICT uxp =
+                pti.GetAttribs(PIdx::ux).data();
+            ParticleReal const * const AMREX_RESTRICT uyp =
+                pti.GetAttribs(PIdx::uy).data();
+            ParticleReal const * const AMREX_RESTRICT uzp =
+                pti.GetAttribs(PIdx::uz).data();
+
+            amrex::ParallelFor( np,
+            [=] AMREX_GPU_DEVICE (int ip)
+            {
+                auto const & p = pstruct[ip];
+                auto const x  = p.pos(0);
+#if (AMREX_SPACEDIM == 3)
+                auto const y  = p.pos(1);
+                auto const z  = p.pos(2);
+#elif (AMREX_SPACEDIM == 2)
+                // In 2D-XZ, p.pos(1) is z ; expose it as both y and z so
+                // that histogram functions written in terms of either
+                // keep working.
+                auto const y  = p.pos(1);
+                auto const z  = p.pos(1);
+#endif
+                auto const ux = uxp[ip]/PhysConst::c;
+                auto const uy = uyp[ip]/PhysConst::c;
+                auto const uz = uzp[ip]/PhysConst::c;
+                auto const f = (*fun_partparser)(t,x,y,z,ux,uy,uz);
+                int const bin = static_cast<int>(
+                    std::floor((f - bin_min)/bin_size));
+                if ( bin < 0 || bin >= bin_num ) { return; }
+                // same strictly-inside convention as the per-bin sweeps:
+                // a value that falls exactly on a bin edge is not counted
+                auto const f1 = bin_min + bin_size*bin;
+                auto const f2 = bin_min + bin_size*(bin+1);
+                if ( f > f1 && f < f2 ) {
+                    auto const w = is_unity_particle_weight ?
+                        1.0_rt : static_cast<Real>(wp[ip]);
+                    HostDevice::Atomic::Add(&hptr[bin], w);
+                }
+            });
+        }
+#if defined(_OPENMP) && !defined(AMREX_USE_GPU)
+            #pragma omp critical (particle_histogram_merge)
+            for ( int i = 0; i < bin_num; ++i ) { dptr[i] += hptr[i]; }
+#endif
+        }
     }
+    Gpu::synchronize();
+
+    for ( int i = 0; i < m_bin_num; ++i ) { m_data[i] = d_data[i]; }
     // reduced sum over mpi ranks
     ParallelDescriptor::ReduceRealSum
         (m_data.data(), m_data.size(), ParallelDescriptor::IOProcessorNumber());
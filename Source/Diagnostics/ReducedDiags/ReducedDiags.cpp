@@ -10,6 +10,7 @@
 #include "AMReX_ParmParse.H"
 #include "AMReX_Utility.H"
 #include <iomanip>
+#include <cstdio>
 
 using namespace amrex;
 
@@ -51,13 +52,50 @@ ReducedDiags::ReducedDiags (std::string rd_name)
     // read separator
     pp.query("separator", m_sep);
 
+    // read output format
+    pp.query("format", m_format);
+    if ( m_format.compare("ascii") != 0 && m_format.compare("binary") != 0 )
+    { Abort("Reduced diags format must be ascii or binary."); }
+
 }
 // end constructor
 
 // write to file function
 void ReducedDiags::WriteToFile (int step) const
+{
+    WriteRecord(step, WarpX::GetInstance().gett_new(0), m_data);
+}
+// end ReducedDiags::WriteToFile
+
+// append one record to file function
+void ReducedDiags::WriteRecord (int step, Real time,
+                                std::vector<Real> const& data) const
 {
 
+    if ( m_format.compare("binary") == 0 )
+    {
+        // pack step, time and the data as native doubles
+        std::vector<double> record;
+        record.reserve(data.size()+2);
+        record.push_back(static_cast<double>(step+1));
+        record.push_back(static_cast<double>(time));
+        record.insert(record.end(), data.begin(), data.end());
+
+        // append the whole record with a single unformatted write
+        std::FILE* fp = std::fopen(
+            (m_path + m_rd_name + "." + m_extension).c_str(), "ab");
+        if (fp == nullptr)
+        {
+            Warning("Reduced diags " + m_rd_name
+                + ": could not open output file, record skipped.");
+            return;
+        }
+        std::fwrite(record.data(), sizeof(double), record.size(), fp);
+        std::fclose(fp);
+
+        return;
+    }
+
     // open file
     std::ofstream ofs;
     ofs.open(m_path + m_rd_name + "." + m_extension,
@@ -72,13 +110,13 @@ void ReducedDiags::WriteToFile (int step) const
     ofs << std::fixed << std::setprecision(14) << std::scientific;
 
     // write time
-    ofs << WarpX::GetInstance().gett_new(0);
+    ofs << time;
 
     // loop over data size and write
-    for (int i = 0; i < m_data.size(); ++i)
+    for (int i = 0; i < data.size(); ++i)
     {
         ofs << m_sep;
-        ofs << m_data[i];
+        ofs << data[i];
     }
     // end loop over data size
 
@@ -89,4 +127,4 @@ void ReducedDiags::WriteToFile (int step) const
     ofs.close();
 
 }
-// end ReducedDiags::WriteToFile
+// end ReducedDiags::WriteRecord
@@ -21,7 +21,10 @@ using namespace amrex;
  *  The implementation assumes that the slice is aligned with the coordinate axes.
  *  The input parameters are modified if the user-input does not comply with requirements of coarsenability or if the slice extent is not contained within the simulation domain.
  *  First a slice multifab (smf) with cell size equal to that of the simulation grid is created such that it extends from slice.dim_lo to slice.dim_hi and shares the same index space as the source multifab (mf)
- *  The values are copied from src mf to dst smf using amrex::ParallelCopy
+ *  The values are copied from src mf to dst smf using amrex::ParallelCopy;
+ *  without coarsening, the slice BoxArray is partitioned along the source boxes
+ *  and distributed to the ranks owning the source data, so that this copy does
+ *  not move valid data between ranks
  *  If interpolation is required, then on the smf, using data points stored in the ghost cells, the data in interpolated.
  *  If coarsening is required, then a coarse slice multifab is generated (cs_mf) and the
  *  values of the refined slice (smf) is averaged down to obtain the coarse slice.
@@ -107,12 +110,54 @@ CreateSlice( const MultiFab& mf, const Vector<Geometry> &dom_geom,
     Box slice(slice_lo, slice_hi);
 
     Vector<BoxArray> sba(1);
-    sba[0].define(slice);
-    sba[0].maxSize(slice_grid_size);
-
-    // Distribution mapping for slice can be different from that of domain //
     Vector<DistributionMapping> sdmap(1);
-    sdmap[0] = DistributionMapping{sba[0]};
+
+    if (coarsen == false) {
+       // Direct extraction: partition the slice box along the boxes of the
+       // source MultiFab and assign each piece to the rank that owns the
+       // corresponding source data, so that the copy below moves no valid
+       // data between ranks (only the nearest-neighbor exchange filling the
+       // ghost cells used for interpolation remains). The slice BoxArray and
+       // DistributionMapping are cached across steps, which also lets
+       // ParallelCopy reuse its communication pattern internally; they are
+       // rebuilt only when the slice moves with the moving window or when
+       // the source grids change (regrid, load balancing).
+       static Box cached_slice;
+       static BoxArray cached_src_ba;
+       static DistributionMapping cached_src_dm;
+       static BoxArray cached_sba;
+       static DistributionMapping cached_sdmap;
+
+       // compare cell-centered boxes so that all staggerings share the cache
+       const BoxArray src_ba_cc = amrex::convert( mf.boxArray(),
+                                                  IntVect::TheZeroVector() );
+       if ( cached_slice != slice || cached_src_ba != src_ba_cc ||
+            cached_src_dm != mf.DistributionMap() ) {
+          BoxList bl;
+          Vector<int> procmap;
+          for (int i = 0; i < src_ba_cc.size(); ++i) {
+             const Box ovlp = src_ba_cc[i] & slice;
+             if (ovlp.ok()) {
+                bl.push_back(ovlp);
+                procmap.push_back(mf.DistributionMap()[i]);
+             }
+          }
+          cached_slice = slice;
+          cached_src_ba = src_ba_cc;
+          cached_src_dm = mf.DistributionMap();
+          cached_sba = BoxArray(std::move(bl));
+          cached_sdmap = DistributionMapping(std::move(procmap));
+       }
+       sba[0] = cached_sba;
+       sdmap[0] = cached_sdmap;
+    }
+    else {
+       sba[0].define(slice);
+       sba[0].maxSize(slice_grid_size);
+
+       // Distribution mapping for slice can be different from that of domain //
+       sdmap[0] = DistributionMapping{sba[0]};
+    }
 
     smf.reset(new MultiFab(amrex::convert(sba[0],SliceType), sdmap[0],
                            ncomp, nghost));
@@ -16,6 +16,10 @@
 #   include "Diagnostics/WarpXOpenPMD.H"
 #endif
 
+#ifdef WARPX_USE_ZSTD
+#   include "Diagnostics/CompressedCheckpoint.H"
+#endif
+
 #include <AMReX_MultiFabUtil.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_FillPatchUtil_F.H>
@@ -36,6 +40,35 @@ using namespace amrex;
 namespace
 {
     const std::string level_prefix {"Level_"};
+
+    // Checkpoint fields go through these helpers, so that the
+    // zstd-compressed chunk format can be swapped in for the plain
+    // VisMF one (`warpx.checkpoint_compression`). On restart the
+    // format of each field is detected from the checkpoint itself.
+    void WriteCheckpointField (const MultiFab& mf, const std::string& prefix,
+                               const int compressed)
+    {
+#ifdef WARPX_USE_ZSTD
+        if (compressed) {
+            CompressedCheckpoint::Write(mf, prefix);
+            return;
+        }
+#else
+        static_cast<void>(compressed);
+#endif
+        VisMF::Write(mf, prefix);
+    }
+
+    void ReadField (MultiFab& mf, const std::string& prefix)
+    {
+#ifdef WARPX_USE_ZSTD
+        if (CompressedCheckpoint::Exists(prefix)) {
+            CompressedCheckpoint::Read(mf, prefix);
+            return;
+        }
+#endif
+        VisMF::Read(mf, prefix);
+    }
 }
 
 void
@@ -62,7 +95,7 @@ WarpX::WriteWarpXHeader(const std::string& name) const
 
         HeaderFile.precision(17);
 
-        HeaderFile << "Checkpoint version: 1\n";
+        HeaderFile << "Checkpoint version: 2\n";
 
         const int nlevels = finestLevel()+1;
         HeaderFile << nlevels << "\n";
@@ -106,10 +139,19 @@ WarpX::WriteWarpXHeader(const std::string& name) const
         }
         HeaderFile << '\n';
 
-        // BoxArray
+        // Number of ranks: a restart on the same number of ranks reuses
+        // the grid-to-rank maps written below instead of recomputing a
+        // distribution mapping (see InitFromCheckpoint)
+        HeaderFile << ParallelDescriptor::NProcs() << "\n";
+
+        // BoxArray and grid-to-rank map
         for (int lev = 0; lev < nlevels; ++lev) {
             boxArray(lev).writeOn(HeaderFile);
             HeaderFile << '\n';
+            for (int rank : DistributionMap(lev).ProcessorMap()) {
+                HeaderFile << rank << ' ';
+            }
+            HeaderFile << '\n';
         }
 
         mypc->WriteHeader(HeaderFile);
@@ -135,52 +177,58 @@ WarpX::WriteCheckPointFile() const
 
     WriteJobInfo(checkpointname);
 
+    const auto WriteField =
+        [this] (const MultiFab& mf, const std::string& prefix)
+    {
+        WriteCheckpointField(mf, prefix, checkpoint_compression);
+    };
+
     for (int lev = 0; lev < nlevels; ++lev)
     {
-        VisMF::Write(*Efield_fp[lev][0],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_fp"));
-        VisMF::Write(*Efield_fp[lev][1],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_fp"));
-        VisMF::Write(*Efield_fp[lev][2],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_fp"));
-        VisMF::Write(*Bfield_fp[lev][0],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_fp"));
-        VisMF::Write(*Bfield_fp[lev][1],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_fp"));
-        VisMF::Write(*Bfield_fp[lev][2],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_fp"));
+        WriteField(*Efield_fp[lev][0],
+                   amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_fp"));
+        WriteField(*Efield_fp[lev][1],
+                   amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_fp"));
+        WriteField(*Efield_fp[lev][2],
+                   amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_fp"));
+        WriteField(*Bfield_fp[lev][0],
+                   amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_fp"));
+        WriteField(*Bfield_fp[lev][1],
+                   amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_fp"));
+        WriteField(*Bfield_fp[lev][2],
+                   amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_fp"));
         if (is_synchronized) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(*current_fp[lev][0],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_fp"));
-            VisMF::Write(*current_fp[lev][1],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_fp"));
-            VisMF::Write(*current_fp[lev][2],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_fp"));
+            WriteField(*current_fp[lev][0],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_fp"));
+            WriteField(*current_fp[lev][1],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_fp"));
+            WriteField(*current_fp[lev][2],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Write(*Efield_cp[lev][0],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_cp"));
-            VisMF::Write(*Efield_cp[lev][1],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_cp"));
-            VisMF::Write(*Efield_cp[lev][2],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_cp"));
-            VisMF::Write(*Bfield_cp[lev][0],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_cp"));
-            VisMF::Write(*Bfield_cp[lev][1],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_cp"));
-            VisMF::Write(*Bfield_cp[lev][2],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_cp"));
+            WriteField(*Efield_cp[lev][0],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_cp"));
+            WriteField(*Efield_cp[lev][1],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_cp"));
+            WriteField(*Efield_cp[lev][2],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_cp"));
+            WriteField(*Bfield_cp[lev][0],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_cp"));
+            WriteField(*Bfield_cp[lev][1],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_cp"));
+            WriteField(*Bfield_cp[lev][2],
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_cp"));
             if (is_synchronized) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(*current_cp[lev][0],
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_cp"));
-                VisMF::Write(*current_cp[lev][1],
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_cp"));
-                VisMF::Write(*current_cp[lev][2],
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_cp"));
+                WriteField(*current_cp[lev][0],
+                           amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_cp"));
+                WriteField(*current_cp[lev][1],
+                           amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_cp"));
+                WriteField(*current_cp[lev][2],
+                           amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_cp"));
             }
         }
 
@@ -214,7 +262,10 @@ WarpX::InitFromCheckpoint ()
 
         std::string line, word;
 
+        // "Checkpoint version: N"
         std::getline(is, line);
+        const int checkpoint_version =
+            std::stoi(line.substr(line.find(':')+1));
 
         int nlevs;
         is >> nlevs;
@@ -294,11 +345,93 @@ WarpX::InitFromCheckpoint ()
 
         ResetProbDomain(RealBox(prob_lo,prob_hi));
 
-        for (int lev = 0; lev < nlevs; ++lev) {
-            BoxArray ba;
-            ba.readFrom(is);
+        // Number of ranks the checkpoint was written with (version >= 2).
+        // When it matches the current number of ranks, the grid-to-rank
+        // maps saved in the header are reused below, so that every rank
+        // reads back exactly the field and particle data it wrote, and
+        // the load balance of the previous run is preserved.
+        int nprocs_chk = -1;
+        if (checkpoint_version >= 2) {
+            is >> nprocs_chk;
             GotoNextLine(is);
-            DistributionMapping dm { ba, ParallelDescriptor::NProcs() };
+        }
+        const bool reuse_pmap = (nprocs_chk == ParallelDescriptor::NProcs());
+
+        // The BoxArrays and grid-to-rank maps dominate the header at
+        // scale: parse them once on the I/O processor and broadcast the
+        // box corners and ranks as a flat binary blob, instead of having
+        // every rank run the text parser over them.
+        Vector<int> grid_data;
+        long pheader_pos = 0;
+        if (ParallelDescriptor::IOProcessor()) {
+            for (int lev = 0; lev < nlevs; ++lev) {
+                BoxArray ba;
+                ba.readFrom(is);
+                GotoNextLine(is);
+                const int nboxes = static_cast<int>(ba.size());
+                grid_data.push_back(nboxes);
+                for (int i = 0; i < nboxes; ++i) {
+                    const Box b = ba[i];
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        grid_data.push_back(b.smallEnd(d));
+                    }
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        grid_data.push_back(b.bigEnd(d));
+                    }
+                }
+                if (checkpoint_version >= 2) {
+                    for (int i = 0; i < nboxes; ++i) {
+                        int rank;
+                        is >> rank;
+                        grid_data.push_back(rank);
+                    }
+                    GotoNextLine(is);
+                }
+            }
+            pheader_pos = static_cast<long>(is.tellg());
+        }
+        long sizes[2] = {static_cast<long>(grid_data.size()), pheader_pos};
+        ParallelDescriptor::Bcast(sizes, 2,
+                                  ParallelDescriptor::IOProcessorNumber());
+        if (!ParallelDescriptor::IOProcessor()) {
+            grid_data.resize(sizes[0]);
+        }
+        ParallelDescriptor::Bcast(grid_data.dataPtr(), grid_data.size(),
+                                  ParallelDescriptor::IOProcessorNumber());
+        if (!ParallelDescriptor::IOProcessor()) {
+            // Skip to the particle part of the header, which the I/O
+            // processor has already parsed past
+            is.seekg(sizes[1]);
+        }
+
+        int idx = 0;
+        for (int lev = 0; lev < nlevs; ++lev) {
+            const int nboxes = grid_data[idx++];
+            BoxList bl;
+            for (int i = 0; i < nboxes; ++i) {
+                IntVect lo, hi;
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    lo[d] = grid_data[idx++];
+                }
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    hi[d] = grid_data[idx++];
+                }
+                bl.push_back(Box(lo,hi));
+            }
+            BoxArray ba(std::move(bl));
+            DistributionMapping dm;
+            if (checkpoint_version >= 2) {
+                Vector<int> pmap(grid_data.begin()+idx,
+                                 grid_data.begin()+idx+nboxes);
+                idx += nboxes;
+                if (reuse_pmap) {
+                    dm = DistributionMapping(std::move(pmap));
+                } else {
+                    dm.define(ba, ParallelDescriptor::NProcs());
+                }
+            } else {
+                dm.define(ba, ParallelDescriptor::NProcs());
+            }
             SetBoxArray(lev, ba);
             SetDistributionMap(lev, dm);
             AllocLevelData(lev, ba, dm);
@@ -329,52 +462,52 @@ WarpX::InitFromCheckpoint ()
             }
         }
 
-        VisMF::Read(*Efield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
-        VisMF::Read(*Efield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
-        VisMF::Read(*Efield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
+        ReadField(*Efield_fp[lev][0],
+                  amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
+        ReadField(*Efield_fp[lev][1],
+                  amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
+        ReadField(*Efield_fp[lev][2],
+                  amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
 
-        VisMF::Read(*Bfield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
-        VisMF::Read(*Bfield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
-        VisMF::Read(*Bfield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+        ReadField(*Bfield_fp[lev][0],
+                  amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
+        ReadField(*Bfield_fp[lev][1],
+                  amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
+        ReadField(*Bfield_fp[lev][2],
+                  amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
 
         if (is_synchronized) {
-            VisMF::Read(*current_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
-            VisMF::Read(*current_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
-            VisMF::Read(*current_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+            ReadField(*current_fp[lev][0],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
+            ReadField(*current_fp[lev][1],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
+            ReadField(*current_fp[lev][2],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Read(*Efield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
-            VisMF::Read(*Efield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
-            VisMF::Read(*Efield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
-
-            VisMF::Read(*Bfield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
-            VisMF::Read(*Bfield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
-            VisMF::Read(*Bfield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+            ReadField(*Efield_cp[lev][0],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
+            ReadField(*Efield_cp[lev][1],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
+            ReadField(*Efield_cp[lev][2],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
+
+            ReadField(*Bfield_cp[lev][0],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
+            ReadField(*Bfield_cp[lev][1],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
+            ReadField(*Bfield_cp[lev][2],
+                      amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
 
             if (is_synchronized) {
-                VisMF::Read(*current_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
-                VisMF::Read(*current_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
-                VisMF::Read(*current_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                ReadField(*current_cp[lev][0],
+                          amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
+                ReadField(*current_cp[lev][1],
+                          amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
+                ReadField(*current_cp[lev][2],
+                          amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
             }
         }
     }
@@ -395,7 +528,7 @@ WarpX::InitFromCheckpoint ()
 
 
 std::unique_ptr<MultiFab>
-WarpX::GetCellCenteredData() {
+WarpX::GetCellCenteredData(const Box& region) {
 
     WARPX_PROFILE("WarpX::GetCellCenteredData");
 
@@ -404,30 +537,39 @@ WarpX::GetCellCenteredData() {
 
     Vector<std::unique_ptr<MultiFab> > cc(finest_level+1);
 
+    // Region of interest expressed in the index space of each level
+    // (invalid box = full domain)
+    Vector<Box> region_lev(finest_level+1);
+    region_lev[0] = region;
+    for (int lev = 1; lev <= finest_level; ++lev) {
+        region_lev[lev] = region.ok() ?
+            amrex::refine(region_lev[lev-1], refRatio(lev-1)) : Box();
+    }
+
     for (int lev = 0; lev <= finest_level; ++lev)
     {
         cc[lev].reset( new MultiFab(grids[lev], dmap[lev], nc, ng) );
 
         int dcomp = 0;
         // first the electric field
-        AverageAndPackVectorField( *cc[lev], Efield_aux[lev], dmap[lev], dcomp, ng );
+        AverageAndPackVectorField( *cc[lev], Efield_aux[lev], dmap[lev], dcomp, ng, IntVect(1), region_lev[lev] );
         dcomp += 3;
         // then the magnetic field
-        AverageAndPackVectorField( *cc[lev], Bfield_aux[lev], dmap[lev], dcomp, ng );
+        AverageAndPackVectorField( *cc[lev], Bfield_aux[lev], dmap[lev], dcomp, ng, IntVect(1), region_lev[lev] );
         dcomp += 3;
         // then the current density
-        AverageAndPackVectorField( *cc[lev], current_fp[lev], dmap[lev], dcomp, ng );
+        AverageAndPackVectorField( *cc[lev], current_fp[lev], dmap[lev], dcomp, ng, IntVect(1), region_lev[lev] );
         dcomp += 3;
         // then the charge density
         const std::unique_ptr<MultiFab>& charge_density = mypc->GetChargeDensity(lev);
-        AverageAndPackScalarField( *cc[lev], *charge_density, dmap[lev], dcomp, ng );
+        AverageAndPackScalarField( *cc[lev], *charge_density, dmap[lev], dcomp, ng, IntVect(1), region_lev[lev] );
 
         cc[lev]->FillBoundary(geom[lev].periodicity());
     }
 
     for (int lev = finest_level; lev > 0; --lev)
     {
-        Average::CoarsenAndInterpolate( *cc[lev-1], *cc[lev], 0, 0, nc, 0, refRatio(lev-1) );
+        Average::CoarsenAndInterpolate( *cc[lev-1], *cc[lev], 0, 0, nc, 0, refRatio(lev-1), region_lev[lev-1] );
     }
 
     return std::move(cc[0]);
@@ -440,11 +582,21 @@ WarpX::UpdateInSitu () const
     WARPX_PROFILE("WarpX::UpdateInSitu()");
 
     // Average the fields from the simulation to the cell centers
+#ifdef BL_USE_SENSEI_INSITU
+    // The SENSEI bridge reads the mesh geometry from the AmrMesh itself,
+    // so the fields cannot be coarsened on this branch
     const int ngrow = 1;
+    const IntVect insitu_crse_ratio = IntVect(1);
+#else
+    // Guard cells cannot be filled when coarsening
+    const int ngrow = (plot_coarsening_ratio == 1) ? 1 : 0;
+    const IntVect insitu_crse_ratio = IntVect(plot_coarsening_ratio);
+#endif
     Vector<std::string> varnames; // Name of the written fields
-    // mf_avg will contain the averaged, cell-centered fields
+    // mf_avg will contain the averaged, cell-centered (and possibly
+    // coarsened) fields
     Vector<MultiFab> mf_avg;
-    WarpX::AverageAndPackFields( varnames, mf_avg, ngrow );
+    WarpX::AverageAndPackFields( varnames, mf_avg, ngrow, insitu_crse_ratio );
 
 #ifdef BL_USE_SENSEI_INSITU
     if (insitu_bridge->update(istep[0], t_new[0],
@@ -460,12 +612,20 @@ WarpX::UpdateInSitu () const
 #endif
 
 #ifdef AMREX_USE_ASCENT
+    // Geometry matching the (possibly coarsened) fields
+    Vector<Geometry> insitu_geom = Geom();
+    if (insitu_crse_ratio != IntVect(1)) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            insitu_geom[lev] = amrex::coarsen( Geom(lev), insitu_crse_ratio );
+        }
+    }
+
     // wrap mesh data
     conduit::Node bp_mesh;
     MultiLevelToBlueprint(finest_level+1,
             amrex::GetVecOfConstPtrs(mf_avg),
             varnames,
-            Geom(),
+            insitu_geom,
             t_new[0],
             istep,
             refRatio(),
@@ -548,18 +708,21 @@ WarpX::prepareFields(
         Vector<const MultiFab*>& output_mf,
         Vector<Geometry>& output_geom
 ) const {
-    // Average the fields from the simulation grid to the cell centers
+    // Average the fields from the simulation grid to the cell centers and,
+    // if requested by the user, coarsen them, all in one fused pass over
+    // the full-resolution data
     const int ngrow = 0;
-    WarpX::AverageAndPackFields( varnames, mf_avg, ngrow );
+    WarpX::AverageAndPackFields( varnames, mf_avg, ngrow,
+                                 IntVect(plot_coarsening_ratio) );
+    output_mf = amrex::GetVecOfConstPtrs(mf_avg);
 
-    // Coarsen the fields, if requested by the user
-    Vector<MultiFab> coarse_mf; // will remain empty if there is no coarsening
     if (plot_coarsening_ratio != 1) {
-        coarsenCellCenteredFields( coarse_mf, output_geom, mf_avg, Geom(),
-                                   plot_coarsening_ratio, finest_level );
-        output_mf = amrex::GetVecOfConstPtrs(coarse_mf);
-    } else {  // No averaging necessary, simply point to mf_avg
-        output_mf = amrex::GetVecOfConstPtrs(mf_avg);
+        output_geom.resize(finest_level+1);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            output_geom[lev] = amrex::coarsen( Geom(lev),
+                                               IntVect(plot_coarsening_ratio) );
+        }
+    } else {
         output_geom = Geom();
     }
 }
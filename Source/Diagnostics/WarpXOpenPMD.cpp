@@ -6,6 +6,8 @@
  */
 #include "WarpXOpenPMD.H"
 #include "FieldIO.H"  // for getReversedVec
+#include "Particles/Filter/FilterFunctors.H"
+#include "Particles/ParticleCreation/FilterCopyTransform.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
 
@@ -19,10 +21,99 @@
 #include <utility>
 #include <iostream>
 
+// openPMD-api 0.14 added spans (views into the buffer of the I/O engine,
+// e.g. ADIOS2 pre-allocated buffers), which allow staging particle data
+// without an intermediate copy
+#if defined(WARPX_USE_OPENPMD) && defined(OPENPMDAPI_VERSION_GE)
+#   if OPENPMDAPI_VERSION_GE(0, 14, 0)
+#       define WARPX_OPENPMD_HAS_SPAN 1
+#   endif
+#endif
+
 
 namespace detail
 {
+    /** Dump-time particle selection: product of the random, the
+     *  uniform-stride and the parsed-expression filters */
+    struct PlotFilter
+    {
+        RandomFilter m_random_filter;
+        UniformFilter m_uniform_filter;
+        ParserFilter m_parser_filter;
+
+        template <typename SrcData>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        int operator() (const SrcData& src, int i) const noexcept
+        {
+            const SuperParticleType p = src.getSuperParticle(i);
+            return m_random_filter(p) * m_uniform_filter(p)
+                 * m_parser_filter(p);
+        }
+    };
+
+    /** Copy a particle between two tiles of the same container type */
+    struct CopyIdentical
+    {
+        template <typename DstData, typename SrcData>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void operator() (DstData& dst, const SrcData& src,
+                         const int i_src, const int i_dst) const noexcept
+        {
+            dst.m_aos[i_dst] = src.m_aos[i_src];
+            for (int j = 0; j < DstData::NAR; ++j)
+                dst.m_rdata[j][i_dst] = src.m_rdata[j][i_src];
+            for (int j = 0; j < dst.m_num_runtime_real; ++j)
+                dst.m_runtime_rdata[j][i_dst] = src.m_runtime_rdata[j][i_src];
+            for (int j = 0; j < DstData::NAI; ++j)
+                dst.m_idata[j][i_dst] = src.m_idata[j][i_src];
+            for (int j = 0; j < dst.m_num_runtime_int; ++j)
+                dst.m_runtime_idata[j][i_dst] = src.m_runtime_idata[j][i_src];
+        }
+    };
+
+    struct NoTransform
+    {
+        template <typename DstData, typename SrcData>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void operator() (DstData&, SrcData&, int, int) const noexcept {}
+    };
+
 #ifdef WARPX_USE_OPENPMD
+    /** Stage a chunk of a record component for writing and return a
+     * buffer of `numElements` elements to be filled by the caller.
+     *
+     * When the openPMD-api supports spans, the buffer is a view into
+     * the buffer of the I/O engine, so that the data is written without
+     * an intermediate copy (note: the view can be invalidated by a
+     * subsequent storeChunk call, so it has to be filled right away);
+     * otherwise, this falls back to an allocated buffer that the series
+     * copies out on flush.
+     *
+     * @param currRecordComp the record component to write to
+     * @param offset the offset of the chunk in the (1D) dataset
+     * @param numElements the number of elements of the chunk
+     * @return buffer to be filled with the data of the chunk
+     */
+    template< typename T >
+    std::shared_ptr< T >
+    getChunkBuffer( openPMD::RecordComponent& currRecordComp,
+                    uint64_t const offset, uint64_t const numElements )
+    {
+#ifdef WARPX_OPENPMD_HAS_SPAN
+        auto span = currRecordComp.storeChunk< T >(
+            {offset}, {numElements} ).currentBuffer();
+        return std::shared_ptr< T >(
+            span.data(), [](T const *){ /* owned by the I/O engine */ } );
+#else
+        std::shared_ptr< T > buffer(
+            new T[numElements],
+            [](T const *p){ delete[] p; }
+        );
+        currRecordComp.storeChunk( buffer, {offset}, {numElements} );
+        return buffer;
+#endif
+    }
+
     /** Unclutter a real_names to openPMD record
      *
      * @param fullName name as in real_names variable
@@ -238,8 +329,40 @@ WarpXOpenPMDPlot::WriteOpenPMDParticles (MultiParticleContainer& mpc)
       // real_names contains a list of all real particle attributes.
       // pc->plot_flags is 1 or 0, whether quantity is dumped or not.
 
-      {
-        //
+      const bool do_filter = pc->m_do_random_filter || pc->m_do_uniform_filter
+                          || pc->m_do_parser_filter;
+      if (do_filter) {
+        // Compact the selected particles into one temporary tile per
+        // level, on the device, so that only the particles that are
+        // kept are ever staged (and copied to the host) for writing.
+        detail::PlotFilter const filter{
+            RandomFilter(pc->m_do_random_filter, pc->m_random_fraction),
+            UniformFilter(pc->m_do_uniform_filter, pc->m_uniform_stride),
+            ParserFilter(pc->m_do_parser_filter, i)};
+
+        using PTile = WarpXParticleContainer::ParticleTileType;
+        amrex::Vector<std::unique_ptr<PTile>> filtered_tiles(pc->finestLevel()+1);
+        for (auto lev = 0; lev <= pc->finestLevel(); lev++) {
+            filtered_tiles[lev].reset(new PTile());
+            filtered_tiles[lev]->define(pc->NumRuntimeRealComps(),
+                                        pc->NumRuntimeIntComps());
+            long dst_index = 0;
+            for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
+                dst_index += filterCopyTransformParticles<1>(
+                    *filtered_tiles[lev], pti.GetParticleTile(), dst_index,
+                    filter, detail::CopyIdentical(), detail::NoTransform());
+            }
+            filtered_tiles[lev]->resize(dst_index);
+        }
+
+        SavePlotFile(pc,
+           species_names[i],
+           m_CurrentStep,
+           pc->plot_flags,
+           int_flags,
+           real_names, int_names,
+           &filtered_tiles);
+      } else {
         SavePlotFile(pc,
            species_names[i],
            m_CurrentStep,
@@ -264,11 +387,21 @@ WarpXOpenPMDPlot::SavePlotFile (const std::unique_ptr<WarpXParticleContainer>& p
                     const amrex::Vector<int>& write_real_comp,
                     const amrex::Vector<int>& write_int_comp,
                     const amrex::Vector<std::string>& real_comp_names,
-                    const amrex::Vector<std::string>&  int_comp_names) const
+                    const amrex::Vector<std::string>&  int_comp_names,
+                    const amrex::Vector<std::unique_ptr<WarpXParticleContainer::ParticleTileType>>*
+                        filtered_tiles) const
 {
   AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_Series != nullptr, "openPMD series must be initialized");
 
-  WarpXParticleCounter counter(pc);
+  amrex::Vector<long> np_per_level;
+  if (filtered_tiles) {
+      np_per_level.resize(pc->finestLevel()+1);
+      for (auto lev = 0; lev <= pc->finestLevel(); lev++) {
+          np_per_level[lev] = (*filtered_tiles)[lev]->numParticles();
+      }
+  }
+  WarpXParticleCounter counter = filtered_tiles ?
+      WarpXParticleCounter(np_per_level) : WarpXParticleCounter(pc);
 
   openPMD::Iteration currIteration = m_Series->iterations[iteration];
   openPMD::ParticleSpecies currSpecies = currIteration.particles[name];
@@ -320,51 +453,64 @@ WarpXOpenPMDPlot::SavePlotFile (const std::unique_ptr<WarpXParticleContainer>& p
     {
       uint64_t offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[currentLevel] );
 
-      for (WarpXParIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
-         auto const numParticleOnTile = pti.numParticles();
-         uint64_t const numParticleOnTile64 = static_cast<uint64_t>( numParticleOnTile );
-
-         // get position and particle ID from aos
-         // note: this implementation iterates the AoS 4x...
-         // if we flush late as we do now, we can also copy out the data in one go
-         const auto& aos = pti.GetArrayOfStructs();  // size =  numParticlesOnTile
-         {
-           // Save positions
-           std::vector<std::string> axisNames={"x", "y", "z"};
-           for (auto currDim = 0; currDim < AMREX_SPACEDIM; currDim++) {
-                std::shared_ptr< amrex::ParticleReal > curr(
-                    new amrex::ParticleReal[numParticleOnTile],
-                    [](amrex::ParticleReal const *p){ delete[] p; }
-                );
-                for (auto i=0; i<numParticleOnTile; i++) {
-                     curr.get()[i] = aos[i].m_rdata.pos[currDim];
-                }
-                currSpecies["position"][axisNames[currDim]].storeChunk(curr, {offset}, {numParticleOnTile64});
-           }
-
-           // save particle ID after converting it to a globally unique ID
-           std::shared_ptr< uint64_t > ids(
-               new uint64_t[numParticleOnTile],
-               [](uint64_t const *p){ delete[] p; }
-           );
-           for (auto i=0; i<numParticleOnTile; i++) {
-               ids.get()[i] = WarpXUtilIO::localIDtoGlobal( aos[i].m_idata.id, aos[i].m_idata.cpu );
-           }
-           auto const scalar = openPMD::RecordComponent::SCALAR;
-           currSpecies["id"][scalar].storeChunk(ids, {offset}, {numParticleOnTile64});
-        }
-         //  save "extra" particle properties in AoS and SoA
-         SaveRealProperty(pti,
-             currSpecies,
-             offset,
-             write_real_comp, real_comp_names);
-
-         offset += numParticleOnTile64;
+      if (filtered_tiles) {
+         // the selected particles were already compacted into one tile
+         // per level
+         DumpParticleTile(*(*filtered_tiles)[currentLevel],
+             currSpecies, offset, write_real_comp, real_comp_names);
+      } else {
+         for (WarpXParIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
+            DumpParticleTile(pti.GetParticleTile(),
+                currSpecies, offset, write_real_comp, real_comp_names);
+            offset += static_cast<uint64_t>( pti.numParticles() );
+         }
       }
     }
     m_Series->flush();
 }
 
+void
+WarpXOpenPMDPlot::DumpParticleTile (const WarpXParticleContainer::ParticleTileType& ptile,
+                       openPMD::ParticleSpecies& currSpecies,
+                       unsigned long long const offset,
+                       amrex::Vector<int> const& write_real_comp,
+                       amrex::Vector<std::string> const& real_comp_names) const
+{
+   auto const numParticleOnTile = ptile.numParticles();
+   uint64_t const numParticleOnTile64 = static_cast<uint64_t>( numParticleOnTile );
+
+   // get position and particle ID from aos
+   // note: this implementation iterates the AoS 4x...
+   // if we flush late as we do now, we can also copy out the data in one go
+   const auto& aos = ptile.GetArrayOfStructs();  // size =  numParticlesOnTile
+   {
+     // Save positions
+     std::vector<std::string> axisNames={"x", "y", "z"};
+     for (auto currDim = 0; currDim < AMREX_SPACEDIM; currDim++) {
+          auto currRecordComp = currSpecies["position"][axisNames[currDim]];
+          auto curr = detail::getChunkBuffer< amrex::ParticleReal >(
+              currRecordComp, offset, numParticleOnTile64);
+          for (auto i=0; i<numParticleOnTile; i++) {
+               curr.get()[i] = aos[i].m_rdata.pos[currDim];
+          }
+     }
+
+     // save particle ID after converting it to a globally unique ID
+     auto const scalar = openPMD::RecordComponent::SCALAR;
+     auto idRecordComp = currSpecies["id"][scalar];
+     auto ids = detail::getChunkBuffer< uint64_t >(
+         idRecordComp, offset, numParticleOnTile64);
+     for (auto i=0; i<numParticleOnTile; i++) {
+         ids.get()[i] = WarpXUtilIO::localIDtoGlobal( aos[i].m_idata.id, aos[i].m_idata.cpu );
+     }
+  }
+   //  save "extra" particle properties in AoS and SoA
+   SaveRealProperty(ptile,
+       currSpecies,
+       offset,
+       write_real_comp, real_comp_names);
+}
+
 void
 WarpXOpenPMDPlot::SetupRealProperties(openPMD::ParticleSpecies& currSpecies,
                       const amrex::Vector<int>& write_real_comp,
@@ -413,7 +559,7 @@ WarpXOpenPMDPlot::SetupRealProperties(openPMD::ParticleSpecies& currSpecies,
 }
 
 void
-WarpXOpenPMDPlot::SaveRealProperty(WarpXParIter& pti,
+WarpXOpenPMDPlot::SaveRealProperty(const WarpXParticleContainer::ParticleTileType& ptile,
                        openPMD::ParticleSpecies& currSpecies,
                        unsigned long long const offset,
                        amrex::Vector<int> const& write_real_comp,
@@ -427,10 +573,10 @@ WarpXOpenPMDPlot::SaveRealProperty(WarpXParIter& pti,
     if( write_real_comp[i] )
       ++numOutputReal;
 
-  auto const numParticleOnTile = pti.numParticles();
+  auto const numParticleOnTile = ptile.numParticles();
   uint64_t const numParticleOnTile64 = static_cast<uint64_t>( numParticleOnTile );
-  auto const& aos = pti.GetArrayOfStructs();  // size =  numParticlesOnTile
-  auto const& soa = pti.GetStructOfArrays();
+  auto const& aos = ptile.GetArrayOfStructs();  // size =  numParticlesOnTile
+  auto const& soa = ptile.GetStructOfArrays();
 
   // properties are saved separately
   {
@@ -442,16 +588,11 @@ WarpXOpenPMDPlot::SaveRealProperty(WarpXParIter& pti,
           auto currRecord = currSpecies[record_name];
           auto currRecordComp = currRecord[component_name];
 
-          std::shared_ptr< amrex::ParticleReal > d(
-              new amrex::ParticleReal[numParticleOnTile],
-              [](amrex::ParticleReal const *p){ delete[] p; }
-          );
+          auto d = detail::getChunkBuffer< amrex::ParticleReal >(
+              currRecordComp, offset, numParticleOnTile64);
 
           for( auto kk=0; kk<numParticleOnTile; kk++ )
                d.get()[kk] = aos[kk].m_rdata.arr[AMREX_SPACEDIM+idx];
-
-          currRecordComp.storeChunk(d,
-               {offset}, {numParticleOnTile64});
       }
     }
   }
@@ -714,6 +855,38 @@ WarpXParticleCounter::WarpXParticleCounter(const std::unique_ptr<WarpXParticleCo
 }
 
 
+WarpXParticleCounter::WarpXParticleCounter(const amrex::Vector<long>& np_per_level)
+{
+  m_MPISize = amrex::ParallelDescriptor::NProcs();
+  m_MPIRank = amrex::ParallelDescriptor::MyProc();
+
+  const int nlevs = np_per_level.size();
+  m_ParticleCounterByLevel.resize(nlevs);
+  m_ParticleOffsetAtRank.resize(nlevs);
+  m_ParticleSizeAtRank.resize(nlevs);
+
+  for (auto currentLevel = 0; currentLevel < nlevs; currentLevel++)
+    {
+      long numParticles = np_per_level[currentLevel];
+
+      unsigned long long offset=0; // offset of this level
+      unsigned long long sum=0; // numParticles in this level (sum from all processors)
+
+      GetParticleOffsetOfProcessor(numParticles, offset,  sum);
+
+      m_ParticleCounterByLevel[currentLevel] = sum;
+      m_ParticleOffsetAtRank[currentLevel] = offset;
+      m_ParticleSizeAtRank[currentLevel] = numParticles;
+
+      // adjust offset, it should be numbered after particles from previous levels
+      for (auto lv=0; lv<currentLevel; lv++)
+    m_ParticleOffsetAtRank[currentLevel] += m_ParticleCounterByLevel[lv];
+
+      m_Total += sum;
+    }
+}
+
+
 // get the offset in the overall particle id collection
 //
 // note: this is a MPI-collective operation
@@ -13,6 +13,8 @@
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXUtil.H"
 #include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXThroughputCounters.H"
+#include "Utils/WarpXMemoryMonitor.H"
 #ifdef WARPX_USE_PY
 #   include "Python/WarpX_py.H"
 #endif
@@ -32,6 +34,10 @@ WarpX::Evolve (int numsteps)
 {
     WARPX_PROFILE("WarpX::Evolve()");
 
+    // In a memory dry run nothing was allocated: the report was printed
+    // in InitData and there is nothing to evolve
+    if (MemoryMonitor::DryRun()) return;
+
     Real cur_time = t_new[0];
     static int last_plot_file_step = 0;
     static int last_openPMD_step = 0;
@@ -58,14 +64,27 @@ WarpX::Evolve (int numsteps)
         // Start loop on time steps
         amrex::Print() << "\nSTEP " << step+1 << " starts ...\n";
 #ifdef WARPX_USE_PY
-        if (warpx_py_beforestep) warpx_py_beforestep();
+        if (warpx_py_beforestep) warpx_py_call(warpx_py_beforestep, warpx_py_beforestep_async);
 #endif
 
+        if (maxLevel() > 0 && regrid_int > 0 && step > 0 &&
+            step % regrid_int == 0)
+        {
+            // Re-evaluate the refinement criteria and remake the levels
+            // whose grids changed (AmrCore::regrid only calls RemakeLevel
+            // for those levels); then put the particles onto the new grids
+            regrid(0, cur_time);
+            mypc->Redistribute();
+        }
+
         amrex::Vector<amrex::Real>* cost = WarpX::getCosts(0);
         if (cost) {
 #ifdef WARPX_USE_PSATD
             amrex::Abort("LoadBalance for PSATD: TODO");
 #endif
+            // Number of steps ahead of the load balance at which the
+            // reduction of the costs is started in the background
+            const int lb_decision_lead = 2;
             if (step > 0 && (step+1) % load_balance_int == 0)
             {
                 LoadBalance();
@@ -73,6 +92,13 @@ WarpX::Evolve (int numsteps)
                 // Reset the costs to 0
                 ResetCosts();
             }
+            else if (load_balance_int > lb_decision_lead &&
+                     (step+1+lb_decision_lead) % load_balance_int == 0)
+            {
+                // Start reducing the costs now, so that the decision in
+                // LoadBalance does not block on a global reduction
+                LoadBalanceStartDecision();
+            }
             for (int lev = 0; lev <= finest_level; ++lev)
             {
                 cost = WarpX::getCosts(lev);
@@ -95,8 +121,7 @@ WarpX::Evolve (int numsteps)
         // is_synchronized is true.
         if (is_synchronized) {
             // Not called at each iteration, so exchange all guard cells
-            FillBoundaryE(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
-            FillBoundaryB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
+            FillBoundaryEB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
             UpdateAuxilaryData();
             // on first step, push p by -0.5*dt
             for (int lev = 0; lev <= finest_level; ++lev)
@@ -111,8 +136,7 @@ WarpX::Evolve (int numsteps)
             // Particles have p^{n-1/2} and x^{n}.
 
             // E and B are up-to-date inside the domain only
-            FillBoundaryE(guard_cells.ng_FieldGather, guard_cells.ng_Extra);
-            FillBoundaryB(guard_cells.ng_FieldGather, guard_cells.ng_Extra);
+            FillBoundaryEB(guard_cells.ng_FieldGather, guard_cells.ng_Extra);
             // E and B: enough guard cells to update Aux or call Field Gather in fp and cp
             // Need to update Aux on lower levels, to interpolate to higher levels.
 #ifndef WARPX_USE_PSATD
@@ -140,7 +164,7 @@ WarpX::Evolve (int numsteps)
         }
 
 #ifdef WARPX_USE_PY
-        if (warpx_py_beforeEsolve) warpx_py_beforeEsolve();
+        if (warpx_py_beforeEsolve) warpx_py_call(warpx_py_beforeEsolve, 0);
 #endif
         if (cur_time + dt[0] >= stop_time - 1.e-3*dt[0] || step == numsteps_max-1) {
             // At the end of last step, push p by 0.5*dt to synchronize
@@ -155,7 +179,7 @@ WarpX::Evolve (int numsteps)
             is_synchronized = true;
         }
 #ifdef WARPX_USE_PY
-        if (warpx_py_afterEsolve) warpx_py_afterEsolve();
+        if (warpx_py_afterEsolve) warpx_py_call(warpx_py_afterEsolve, 0);
 #endif
 
         for (int lev = 0; lev <= max_level; ++lev) {
@@ -176,7 +200,12 @@ WarpX::Evolve (int numsteps)
         if (do_back_transformed_diagnostics) {
             std::unique_ptr<MultiFab> cell_centered_data = nullptr;
             if (WarpX::do_back_transformed_fields) {
-                cell_centered_data = GetCellCenteredData();
+                // Only cell-center the slab of cells feeding the slices of
+                // the snapshots active at this step (if any)
+                const Box slab = myBFD->GetZSliceBox(geom[0], cur_time);
+                if (slab.ok()) {
+                    cell_centered_data = GetCellCenteredData(slab);
+                }
             }
             myBFD->writeLabFrameData(cell_centered_data.get(), *mypc, geom[0], cur_time, dt[0]);
         }
@@ -216,7 +245,11 @@ WarpX::Evolve (int numsteps)
         bool to_sort = (sort_int > 0) && ((step+1) % sort_int == 0);
         if (to_sort) {
             amrex::Print() << "re-sorting particles \n";
-            mypc->SortParticlesByBin(sort_bin_size);
+            if (sort_in_place) {
+                mypc->SortParticlesInPlace();
+            } else {
+                mypc->SortParticlesByBin(sort_bin_size);
+            }
         }
 
         amrex::Print()<< "STEP " << step+1 << " ends." << " TIME = " << cur_time
@@ -232,6 +265,22 @@ WarpX::Evolve (int numsteps)
             t_new[i] = cur_time;
         }
 
+        if (MemoryMonitor::Enabled()) {
+            // Sample the local particle footprint once per step (the
+            // fields are accounted at allocation time, but the particles
+            // grow and shrink as they move between ranks)
+            long bytes = 0;
+            for (int i = 0; i < mypc->nSpecies(); ++i) {
+                auto& pc = mypc->GetParticleContainer(i);
+                bytes += pc.TotalNumberOfParticles(false, true)
+                    * static_cast<long>(
+                        sizeof(WarpXParticleContainer::ParticleType)
+                        + pc.NumRealComps()*sizeof(ParticleReal)
+                        + pc.NumIntComps()*sizeof(int));
+            }
+            MemoryMonitor::Set("particles", bytes);
+        }
+
         /// reduced diags
         if (reduced_diags->m_plot_rd != 0)
         {
@@ -241,13 +290,20 @@ WarpX::Evolve (int numsteps)
 
         multi_diags->FilterComputePackFlush( step );
 
+#ifdef WARPX_USE_PY
+        // The diagnostics and checkpoints below communicate collectively:
+        // wait for a possible in-flight asynchronous callback first
+        if (to_make_plot || to_write_openPMD || do_insitu || to_make_slice_plot ||
+            (check_int > 0 && (step+1) % check_int == 0)) {
+            warpx_py_wait_async();
+        }
+#endif
+
         // slice gen //
         if (to_make_plot || to_write_openPMD || do_insitu || to_make_slice_plot)
         {
             // This is probably overkill, but it's not called often
-            FillBoundaryE(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
-            // This is probably overkill, but it's not called often
-            FillBoundaryB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
+            FillBoundaryEB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
             // This is probably overkill, but it's not called often
 #ifndef WARPX_USE_PSATD
             FillBoundaryAux(guard_cells.ng_UpdateAux);
@@ -288,11 +344,16 @@ WarpX::Evolve (int numsteps)
         }
 
 #ifdef WARPX_USE_PY
-        if (warpx_py_afterstep) warpx_py_afterstep();
+        if (warpx_py_afterstep) warpx_py_call(warpx_py_afterstep, warpx_py_afterstep_async);
 #endif
         // End loop on time steps
     }
 
+#ifdef WARPX_USE_PY
+    // Do not return to Python while an asynchronous callback is running
+    warpx_py_wait_async();
+#endif
+
     bool write_plot_file = plot_int > 0 && istep[0] > last_plot_file_step
         && (max_time_reached || istep[0] >= max_step);
     bool write_openPMD = openpmd_int > 0 && istep[0] > last_openPMD_step
@@ -304,9 +365,7 @@ WarpX::Evolve (int numsteps)
     if (write_plot_file || write_openPMD || do_insitu)
     {
         // This is probably overkill, but it's not called often
-        FillBoundaryE(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
-        // This is probably overkill, but it's not called often
-        FillBoundaryB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
+        FillBoundaryEB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
         // This is probably overkill
 #ifndef WARPX_USE_PSATD
         FillBoundaryAux(guard_cells.ng_UpdateAux);
@@ -344,6 +403,12 @@ WarpX::Evolve (int numsteps)
 #ifdef BL_USE_SENSEI_INSITU
     insitu_bridge->finalize();
 #endif
+
+    // Per-kernel throughput table (warpx.do_throughput_counters)
+    ThroughputCounters::Print();
+
+    // Per-subsystem memory table (warpx.do_memory_report)
+    MemoryMonitor::PrintReport();
 }
 
 /* /brief Perform one PIC iteration, without subcycling
@@ -373,14 +438,24 @@ WarpX::OneStep_nosub (Real cur_time)
     // Deposit current j^{n+1/2}
     // Deposit charge density rho^{n}
 #ifdef WARPX_USE_PY
-    if (warpx_py_particleinjection) warpx_py_particleinjection();
-    if (warpx_py_particlescraper) warpx_py_particlescraper();
-    if (warpx_py_beforedeposition) warpx_py_beforedeposition();
+    if (warpx_py_particleinjection) warpx_py_call(warpx_py_particleinjection, 0);
+    if (warpx_py_particlescraper) warpx_py_call(warpx_py_particlescraper, 0);
+    if (warpx_py_beforedeposition) warpx_py_call(warpx_py_beforedeposition, 0);
 #endif
-    PushParticlesandDepose(cur_time);
+    if (m_kernel_autotuner.Measuring()) {
+        // Time this step's push+deposit under the candidate launch
+        // configuration of the autotuner (see Utils/WarpXTuning.H)
+        m_kernel_autotuner.ApplyNextCandidate();
+        Real t_begin = amrex::second();
+        PushParticlesandDepose(cur_time);
+        Gpu::synchronize();
+        m_kernel_autotuner.RecordSample(amrex::second() - t_begin);
+    } else {
+        PushParticlesandDepose(cur_time);
+    }
 
 #ifdef WARPX_USE_PY
-    if (warpx_py_afterdeposition) warpx_py_afterdeposition();
+    if (warpx_py_afterdeposition) warpx_py_call(warpx_py_afterdeposition, 0);
 #endif
 
 #ifdef WARPX_QED
@@ -388,6 +463,17 @@ WarpX::OneStep_nosub (Real cur_time)
     mypc->doQedEvents();
 #endif
 
+#ifndef WARPX_USE_PSATD
+    if (!do_electrostatic) {
+        // The first half-push of B only involves E, not the new current:
+        // issue it before the current synchronization, so that the field
+        // solve overlaps with the exchange of j between boxes. The fields
+        // are only synchronized again right before `EvolveE`, which is the
+        // first update that consumes j.
+        EvolveB(0.5*dt[0]); // We now have B^{n+1/2}
+    }
+#endif
+
     SyncCurrent();
 
     SyncRho();
@@ -411,8 +497,7 @@ WarpX::OneStep_nosub (Real cur_time)
             FillBoundaryE(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
         }
         PushPSATD(dt[0]);
-        FillBoundaryE(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
-        FillBoundaryB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
+        FillBoundaryEB(guard_cells.ng_alloc_EB, guard_cells.ng_Extra);
 
         if (use_hybrid_QED)
         {
@@ -424,14 +509,36 @@ WarpX::OneStep_nosub (Real cur_time)
 #else
         EvolveF(0.5*dt[0], DtType::FirstHalf);
         FillBoundaryF(guard_cells.ng_FieldSolverF);
-        EvolveB(0.5*dt[0]); // We now have B^{n+1/2}
 
-        FillBoundaryB(guard_cells.ng_FieldSolver, IntVect::TheZeroVector());
-        EvolveE(dt[0]); // We now have E^{n+1}
+        // B^{n+1/2} was computed above, overlapped with the current
+        // synchronization ; only exchange its guard cells here.
+#ifndef WARPX_DIM_RZ
+        if (do_overlap_comms && !safe_guard_cells) {
+            // Halo-first scheduling: post the guard cell exchange, update
+            // the interior cells (whose stencil does not need halo data)
+            // while the messages are in flight, and update the remaining
+            // shell of each box once the exchange has completed.
+            FillBoundaryB_nowait(guard_cells.ng_FieldSolver);
+            EvolveE(dt[0], UpdateRegion::Interior);
+            FillBoundaryB_finish();
+            EvolveE(dt[0], UpdateRegion::Exterior); // We now have E^{n+1}
+
+            FillBoundaryE_nowait(guard_cells.ng_FieldSolver);
+            EvolveB(0.5*dt[0], UpdateRegion::Interior);
+            FillBoundaryE_finish();
+            // EvolveF reads the guard cells of E: wait for them
+            EvolveF(0.5*dt[0], DtType::SecondHalf);
+            EvolveB(0.5*dt[0], UpdateRegion::Exterior); // We now have B^{n+1}
+        } else
+#endif
+        {
+            FillBoundaryB(guard_cells.ng_FieldSolver, IntVect::TheZeroVector());
+            EvolveE(dt[0]); // We now have E^{n+1}
 
-        FillBoundaryE(guard_cells.ng_FieldSolver, IntVect::TheZeroVector());
-        EvolveF(0.5*dt[0], DtType::SecondHalf);
-        EvolveB(0.5*dt[0]); // We now have B^{n+1}
+            FillBoundaryE(guard_cells.ng_FieldSolver, IntVect::TheZeroVector());
+            EvolveF(0.5*dt[0], DtType::SecondHalf);
+            EvolveB(0.5*dt[0]); // We now have B^{n+1}
+        }
         if (do_pml) {
             FillBoundaryF(guard_cells.ng_alloc_F);
             DampPML();
@@ -629,6 +736,10 @@ WarpX::PushParticlesandDepose (amrex::Real cur_time)
 void
 WarpX::PushParticlesandDepose (int lev, amrex::Real cur_time, DtType a_dt_type)
 {
+    // The current is zeroed and re-deposited below: start a new set of
+    // per-box deposition flags (sparse-current mode)
+    ResetCurrentDepositionFlags(lev);
+
     mypc->Evolve(lev,
                  *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
                  *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2],
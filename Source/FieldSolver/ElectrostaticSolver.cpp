@@ -30,13 +30,13 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
     for (int ispecies=0; ispecies<mypc->nSpecies(); ispecies++){
         WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
         if (species.initialize_self_fields || do_electrostatic) {
-            AddSpaceChargeField(species);
+            AddSpaceChargeField(species, ispecies);
         }
     }
 }
 
 void
-WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
+WarpX::AddSpaceChargeField (WarpXParticleContainer& pc, int const ispecies)
 {
 
 #ifdef WARPX_DIM_RZ
@@ -67,8 +67,17 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     std::array<Real, 3> beta = pc.meanParticleVelocity(local_average);
     for (Real& beta_comp : beta) beta_comp /= PhysConst::c; // Normalize
 
-    // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision );
+    // Compute the potential phi, by solving the Poisson equation.
+    // In the electrostatic mode, the solve is warm-started from the
+    // potentials of the previous steps.
+    Real required_precision = pc.self_fields_required_precision;
+    if (do_electrostatic) {
+        setPoissonInitialGuess( ispecies, rho, phi, required_precision );
+    }
+    computePhi( rho, phi, beta, required_precision );
+    if (do_electrostatic) {
+        savePoissonSolution( ispecies, rho, phi );
+    }
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -132,6 +141,127 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
     }
 }
 
+/* Set the initial guess of the Poisson solve of the given species,
+   and possibly loosen its tolerance.
+
+   The potential changes little from one step to the next, so the
+   previous solution (linearly extrapolated in time when two previous
+   solutions are available) is a much better starting point for the
+   multigrid iterations than zero. The convergence criterion of the
+   solver is relative to the source, so this does not change the
+   accuracy of the result, only the number of iterations.
+
+   In addition, when the charge density changed by less than
+   `poisson_loose_precision_threshold` (in relative max norm) since the
+   previous solve, the required precision is multiplied by
+   `poisson_loose_precision_factor`.
+
+   \param[in] ispecies index of the species being solved for
+   \param[in] rho The charge density of the species
+   \param[inout] phi The potential, filled with the initial guess
+   \param[inout] required_precision The tolerance of the solve
+*/
+void
+WarpX::setPoissonInitialGuess (int const ispecies,
+                               const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
+                               amrex::Vector<std::unique_ptr<amrex::MultiFab> >& phi,
+                               Real& required_precision)
+{
+    if ( !poisson_warm_start ) return;
+    if ( ispecies >= phi_es_old.size() ) return; // No history yet
+
+    // Check that the history was saved on the current grids
+    for (int lev = 0; lev <= max_level; lev++) {
+        if ( !phi_es_old[ispecies][lev] ||
+             phi_es_old[ispecies][lev]->boxArray() != phi[lev]->boxArray() ||
+             phi_es_old[ispecies][lev]->DistributionMap() != phi[lev]->DistributionMap() ) {
+            return;
+        }
+    }
+
+    for (int lev = 0; lev <= max_level; lev++) {
+        if ( phi_es_old2[ispecies][lev] &&
+             phi_es_old2[ispecies][lev]->boxArray() == phi[lev]->boxArray() &&
+             phi_es_old2[ispecies][lev]->DistributionMap() == phi[lev]->DistributionMap() ) {
+            // Linear extrapolation of the two previous solutions
+            MultiFab::LinComb( *phi[lev],
+                                2._rt, *phi_es_old[ispecies][lev], 0,
+                               -1._rt, *phi_es_old2[ispecies][lev], 0,
+                               0, 1, 0 );
+        } else {
+            MultiFab::Copy( *phi[lev], *phi_es_old[ispecies][lev], 0, 0, 1, 0 );
+        }
+        // The guess is fed to the solver before the normalization that
+        // is applied at the end of computePhi; undo it here
+        phi[lev]->mult(-PhysConst::ep0);
+    }
+
+    // Loosen the tolerance if the charge density changed little
+    if (poisson_loose_precision_threshold > 0.) {
+        Real diff_norm = 0._rt;
+        Real rho_norm = 0._rt;
+        for (int lev = 0; lev <= max_level; lev++) {
+            if ( !rho_es_old[ispecies][lev] ) return;
+            MultiFab drho( rho[lev]->boxArray(), rho[lev]->DistributionMap(), 1, 0 );
+            MultiFab::Copy( drho, *rho[lev], 0, 0, 1, 0 );
+            MultiFab::Subtract( drho, *rho_es_old[ispecies][lev], 0, 0, 1, 0 );
+            diff_norm = std::max( diff_norm, drho.norm0() );
+            rho_norm = std::max( rho_norm, rho[lev]->norm0() );
+        }
+        if ( rho_norm > 0. && diff_norm <= poisson_loose_precision_threshold*rho_norm ) {
+            required_precision *= poisson_loose_precision_factor;
+        }
+    }
+}
+
+/* Save the solution and the charge density of the Poisson solve of the
+   given species, to warm-start the solve of the next step.
+
+   \param[in] ispecies index of the species that was solved for
+   \param[in] rho The charge density of the species
+   \param[in] phi The potential computed by the solve
+*/
+void
+WarpX::savePoissonSolution (int const ispecies,
+                            const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
+                            const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& phi)
+{
+    if ( !poisson_warm_start ) return;
+
+    if ( ispecies >= phi_es_old.size() ) {
+        phi_es_old.resize(ispecies+1);
+        phi_es_old2.resize(ispecies+1);
+        rho_es_old.resize(ispecies+1);
+    }
+    phi_es_old[ispecies].resize(max_level+1);
+    phi_es_old2[ispecies].resize(max_level+1);
+    rho_es_old[ispecies].resize(max_level+1);
+
+    // The previous solution becomes the one before it; its storage is
+    // reused for the new solution
+    std::swap( phi_es_old[ispecies], phi_es_old2[ispecies] );
+
+    for (int lev = 0; lev <= max_level; lev++) {
+        auto& phi_old = phi_es_old[ispecies][lev];
+        if ( !phi_old ||
+             phi_old->boxArray() != phi[lev]->boxArray() ||
+             phi_old->DistributionMap() != phi[lev]->DistributionMap() ) {
+            phi_old.reset( new MultiFab( phi[lev]->boxArray(),
+                                         phi[lev]->DistributionMap(), 1, 0 ) );
+        }
+        MultiFab::Copy( *phi_old, *phi[lev], 0, 0, 1, 0 );
+
+        auto& rho_old = rho_es_old[ispecies][lev];
+        if ( !rho_old ||
+             rho_old->boxArray() != rho[lev]->boxArray() ||
+             rho_old->DistributionMap() != rho[lev]->DistributionMap() ) {
+            rho_old.reset( new MultiFab( rho[lev]->boxArray(),
+                                         rho[lev]->DistributionMap(), 1, 0 ) );
+        }
+        MultiFab::Copy( *rho_old, *rho[lev], 0, 0, 1, 0 );
+    }
+}
+
 /* \bried Compute the electric field that corresponds to `phi`, and
           add it to the set of MultiFab `E`.
 
@@ -7,6 +7,7 @@
 
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "FiniteDifferenceSolver.H"
+#include "WarpX.H"
 #ifdef WARPX_DIM_RZ
 #   include "FiniteDifferenceAlgorithms/CylindricalYeeAlgorithm.H"
 #else
@@ -24,27 +25,31 @@ using namespace amrex;
 void FiniteDifferenceSolver::EvolveB (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    UpdateRegion const region,
+    amrex::Vector<amrex::Real>* cost ) {
 
    // Select algorithm (The choice of algorithm is a runtime option,
    // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
     if (m_fdtd_algo == MaxwellSolverAlgo::Yee){
 
-        EvolveBCylindrical <CylindricalYeeAlgorithm> ( Bfield, Efield, dt );
+        // Note: the cylindrical solver does not support halo-first
+        // scheduling (the `region` argument is always `All` in RZ)
+        EvolveBCylindrical <CylindricalYeeAlgorithm> ( Bfield, Efield, dt, cost );
 
 #else
     if (m_do_nodal) {
 
-        EvolveBCartesian <CartesianNodalAlgorithm> ( Bfield, Efield, dt );
+        EvolveBCartesian <CartesianNodalAlgorithm> ( Bfield, Efield, dt, region, cost );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee) {
 
-        EvolveBCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, dt );
+        EvolveBCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, dt, region, cost );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
 
-        EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, dt );
+        EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, dt, region, cost );
 
 #endif
     } else {
@@ -60,7 +65,9 @@ template<typename T_Algo>
 void FiniteDifferenceSolver::EvolveBCartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    UpdateRegion const region,
+    amrex::Vector<amrex::Real>* cost ) {
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef _OPENMP
@@ -68,6 +75,12 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 #endif
     for ( MFIter mfi(*Bfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = amrex::second();
+
         // Extract field data for this grid/tile
         Array4<Real> const& Bx = Bfield[0]->array(mfi);
         Array4<Real> const& By = Bfield[1]->array(mfi);
@@ -76,38 +89,99 @@ void FiniteDifferenceSolver::EvolveBCartesian (
         Array4<Real> const& Ey = Efield[1]->array(mfi);
         Array4<Real> const& Ez = Efield[2]->array(mfi);
 
-        // Extract stencil coefficients
-        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        // Extract stencil coefficients: by-value copies, so that the
+        // kernels read them from their own arguments (which reside in
+        // constant memory on GPU) instead of from global memory
+        GpuArray<Real, m_max_stencil_coefs> const coefs_x = m_coefs_x;
         int const n_coefs_x = m_stencil_coefs_x.size();
-        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        GpuArray<Real, m_max_stencil_coefs> const coefs_y = m_coefs_y;
         int const n_coefs_y = m_stencil_coefs_y.size();
-        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        GpuArray<Real, m_max_stencil_coefs> const coefs_z = m_coefs_z;
         int const n_coefs_z = m_stencil_coefs_z.size();
 
         // Extract tileboxes for which to loop
-        Box const& tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect());
-        Box const& tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect());
-        Box const& tbz  = mfi.tilebox(Bfield[2]->ixType().toIntVect());
-
-        // Loop over the cells and update the fields
-        amrex::ParallelFor(tbx, tby, tbz,
+        Box tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect());
+        Box tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect());
+        Box tbz  = mfi.tilebox(Bfield[2]->ixType().toIntVect());
+
+        // Halo-first scheduling: an Interior update is restricted to the
+        // cells whose stencil only reads valid data (at least one cell
+        // away from the surface of the box, for the algorithms at hand),
+        // and the corresponding Exterior update skips exactly those cells.
+        Box interior;
+        Box skip_x, skip_y, skip_z; // Remain empty unless region == Exterior
+        if (region != UpdateRegion::All) {
+            interior = amrex::grow( amrex::enclosedCells(mfi.validbox()), -1 );
+            if (region == UpdateRegion::Interior) {
+                tbx &= amrex::convert( interior, tbx.ixType() );
+                tby &= amrex::convert( interior, tby.ixType() );
+                tbz &= amrex::convert( interior, tbz.ixType() );
+            } else {
+                skip_x = amrex::convert( interior, tbx.ixType() );
+                skip_y = amrex::convert( interior, tby.ixType() );
+                skip_z = amrex::convert( interior, tbz.ixType() );
+            }
+        }
+
+        if (m_do_fused_update || region == UpdateRegion::Exterior) {
+
+            // Fused update: one kernel per tile updates the three
+            // components, so that the overlapping E stencil loads are
+            // served from cache instead of being re-read per component.
+            // The loop covers the nodal tilebox, which contains the
+            // tileboxes of the three (staggered) components.
+            Box tb_all = mfi.tilebox(amrex::IntVect::TheNodeVector());
+            if (region == UpdateRegion::Interior) {
+                tb_all &= amrex::convert( interior, IntVect::TheNodeVector() );
+            }
 
+            amrex::ParallelFor(tb_all,
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                Bx(i, j, k) += dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
-                             - dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
-            },
+                const IntVect iv(AMREX_D_DECL(i,j,k));
+                if (tbx.contains(iv) && !skip_x.contains(iv)) {
+                    Bx(i, j, k) += dt * T_Algo::UpwardDz(Ey, coefs_z.data(), n_coefs_z, i, j, k)
+                                 - dt * T_Algo::UpwardDy(Ez, coefs_y.data(), n_coefs_y, i, j, k);
+                }
+                if (tby.contains(iv) && !skip_y.contains(iv)) {
+                    By(i, j, k) += dt * T_Algo::UpwardDx(Ez, coefs_x.data(), n_coefs_x, i, j, k)
+                                 - dt * T_Algo::UpwardDz(Ex, coefs_z.data(), n_coefs_z, i, j, k);
+                }
+                if (tbz.contains(iv) && !skip_z.contains(iv)) {
+                    Bz(i, j, k) += dt * T_Algo::UpwardDy(Ex, coefs_y.data(), n_coefs_y, i, j, k)
+                                 - dt * T_Algo::UpwardDx(Ey, coefs_x.data(), n_coefs_x, i, j, k);
+                }
+            });
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                By(i, j, k) += dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
-                             - dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
-            },
+        } else {
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                Bz(i, j, k) += dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
-                             - dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
-            }
+            // Loop over the cells and update the fields
+            amrex::ParallelFor(tbx, tby, tbz,
 
-        );
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    Bx(i, j, k) += dt * T_Algo::UpwardDz(Ey, coefs_z.data(), n_coefs_z, i, j, k)
+                                 - dt * T_Algo::UpwardDy(Ez, coefs_y.data(), n_coefs_y, i, j, k);
+                },
+
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    By(i, j, k) += dt * T_Algo::UpwardDx(Ez, coefs_x.data(), n_coefs_x, i, j, k)
+                                 - dt * T_Algo::UpwardDz(Ex, coefs_z.data(), n_coefs_z, i, j, k);
+                },
+
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    Bz(i, j, k) += dt * T_Algo::UpwardDy(Ex, coefs_y.data(), n_coefs_y, i, j, k)
+                                 - dt * T_Algo::UpwardDx(Ey, coefs_x.data(), n_coefs_x, i, j, k);
+                }
+
+            );
+
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = amrex::second() - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
 
     }
 
@@ -119,7 +193,8 @@ template<typename T_Algo>
 void FiniteDifferenceSolver::EvolveBCylindrical (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    amrex::Vector<amrex::Real>* cost ) {
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef _OPENMP
@@ -127,6 +202,12 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
 #endif
     for ( MFIter mfi(*Bfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = amrex::second();
+
         // Extract field data for this grid/tile
         Array4<Real> const& Br = Bfield[0]->array(mfi);
         Array4<Real> const& Bt = Bfield[1]->array(mfi);
@@ -214,6 +295,13 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
 
         );
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = amrex::second() - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+
     }
 
 }
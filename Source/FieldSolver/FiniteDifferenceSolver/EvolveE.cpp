@@ -7,6 +7,7 @@
 
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "FiniteDifferenceSolver.H"
+#include "WarpX.H"
 #ifdef WARPX_DIM_RZ
 #   include "FiniteDifferenceAlgorithms/CylindricalYeeAlgorithm.H"
 #else
@@ -28,27 +29,33 @@ void FiniteDifferenceSolver::EvolveE (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    UpdateRegion const region,
+    amrex::Vector<amrex::Real>* cost,
+    const std::vector<char>* j_deposited ) {
 
    // Select algorithm (The choice of algorithm is a runtime option,
    // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
     if (m_fdtd_algo == MaxwellSolverAlgo::Yee){
 
-        EvolveECylindrical <CylindricalYeeAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt );
+        // Note: the cylindrical solver does not support halo-first
+        // scheduling (the `region` argument is always `All` in RZ) nor
+        // the sparse-current flags (`j_deposited` is not used)
+        EvolveECylindrical <CylindricalYeeAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt, cost );
 
 #else
     if (m_do_nodal) {
 
-        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt );
+        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt, region, cost, j_deposited );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee) {
 
-        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt );
+        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt, region, cost, j_deposited );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
 
-        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt );
+        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, Ffield, dt, region, cost, j_deposited );
 
 #endif
     } else {
@@ -66,7 +73,10 @@ void FiniteDifferenceSolver::EvolveECartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    UpdateRegion const region,
+    amrex::Vector<amrex::Real>* cost,
+    const std::vector<char>* j_deposited ) {
 
     Real constexpr c2 = PhysConst::c * PhysConst::c;
 
@@ -76,6 +86,12 @@ void FiniteDifferenceSolver::EvolveECartesian (
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = amrex::second();
+
         // Extract field data for this grid/tile
         Array4<Real> const& Ex = Efield[0]->array(mfi);
         Array4<Real> const& Ey = Efield[1]->array(mfi);
@@ -87,69 +103,137 @@ void FiniteDifferenceSolver::EvolveECartesian (
         Array4<Real> const& jy = Jfield[1]->array(mfi);
         Array4<Real> const& jz = Jfield[2]->array(mfi);
 
-        // Extract stencil coefficients
-        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        // Extract stencil coefficients: by-value copies, so that the
+        // kernels read them from their own arguments (which reside in
+        // constant memory on GPU) instead of from global memory
+        GpuArray<Real, m_max_stencil_coefs> const coefs_x = m_coefs_x;
         int const n_coefs_x = m_stencil_coefs_x.size();
-        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        GpuArray<Real, m_max_stencil_coefs> const coefs_y = m_coefs_y;
         int const n_coefs_y = m_stencil_coefs_y.size();
-        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        GpuArray<Real, m_max_stencil_coefs> const coefs_z = m_coefs_z;
         int const n_coefs_z = m_stencil_coefs_z.size();
 
-        // Extract tileboxes for which to loop
-        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
-        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
-        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+        // If F is not a null pointer, the grad(F) term (hyperbolic
+        // correction for errors in charge conservation) is folded into the
+        // update below: it costs one extra operand in the kernels, instead
+        // of a second read-modify-write pass over the three components of E.
+        const bool do_F = (Ffield != nullptr);
+        Array4<Real> F; // Remains empty unless do_F
+        if (do_F) F = Ffield->array(mfi);
 
-        // Loop over the cells and update the fields
-        amrex::ParallelFor(tex, tey, tez,
+        // In sparse-current mode, the j term (and its three read streams)
+        // is left out of the update on the boxes where the current is
+        // known to be zero
+        const bool do_j = (j_deposited == nullptr) || (*j_deposited)[mfi.index()];
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                Ex(i, j, k) += c2 * dt * (
-                    - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
-                    + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
-                    - PhysConst::mu0 * jx(i, j, k) );
-            },
+        // Extract tileboxes for which to loop
+        Box tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
+        Box tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
+        Box tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+
+        // Halo-first scheduling: an Interior update is restricted to the
+        // cells whose stencil only reads valid data (at least one cell
+        // away from the surface of the box, for the algorithms at hand),
+        // and the corresponding Exterior update skips exactly those cells.
+        Box interior;
+        Box skip_x, skip_y, skip_z; // Remain empty unless region == Exterior
+        if (region != UpdateRegion::All) {
+            interior = amrex::grow( amrex::enclosedCells(mfi.validbox()), -1 );
+            if (region == UpdateRegion::Interior) {
+                tex &= amrex::convert( interior, tex.ixType() );
+                tey &= amrex::convert( interior, tey.ixType() );
+                tez &= amrex::convert( interior, tez.ixType() );
+            } else {
+                skip_x = amrex::convert( interior, tex.ixType() );
+                skip_y = amrex::convert( interior, tey.ixType() );
+                skip_z = amrex::convert( interior, tez.ixType() );
+            }
+        }
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                Ey(i, j, k) += c2 * dt * (
-                    - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
-                    + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
-                    - PhysConst::mu0 * jy(i, j, k) );
-            },
+        if (m_do_fused_update || region == UpdateRegion::Exterior) {
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                Ez(i, j, k) += c2 * dt * (
-                    - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
-                    + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
-                    - PhysConst::mu0 * jz(i, j, k) );
+            // Fused update: one kernel per tile updates the three
+            // components, so that the overlapping B stencil loads are
+            // served from cache instead of being re-read per component.
+            // The loop covers the nodal tilebox, which contains the
+            // tileboxes of the three (staggered) components.
+            Box tb_all = mfi.tilebox(amrex::IntVect::TheNodeVector());
+            if (region == UpdateRegion::Interior) {
+                tb_all &= amrex::convert( interior, IntVect::TheNodeVector() );
             }
 
-        );
-
-        // If F is not a null pointer, further update E using the grad(F) term
-        // (hyperbolic correction for errors in charge conservation)
-        if (Ffield) {
+            amrex::ParallelFor(tb_all,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                const IntVect iv(AMREX_D_DECL(i,j,k));
+                if (tex.contains(iv) && !skip_x.contains(iv)) {
+                    Real dEx =
+                        - T_Algo::DownwardDz(By, coefs_z.data(), n_coefs_z, i, j, k)
+                        + T_Algo::DownwardDy(Bz, coefs_y.data(), n_coefs_y, i, j, k);
+                    if (do_j) dEx -= PhysConst::mu0 * jx(i, j, k);
+                    if (do_F) dEx += T_Algo::UpwardDx(F, coefs_x.data(), n_coefs_x, i, j, k);
+                    Ex(i, j, k) += c2 * dt * dEx;
+                }
+                if (tey.contains(iv) && !skip_y.contains(iv)) {
+                    Real dEy =
+                        - T_Algo::DownwardDx(Bz, coefs_x.data(), n_coefs_x, i, j, k)
+                        + T_Algo::DownwardDz(Bx, coefs_z.data(), n_coefs_z, i, j, k);
+                    if (do_j) dEy -= PhysConst::mu0 * jy(i, j, k);
+                    if (do_F) dEy += T_Algo::UpwardDy(F, coefs_y.data(), n_coefs_y, i, j, k);
+                    Ey(i, j, k) += c2 * dt * dEy;
+                }
+                if (tez.contains(iv) && !skip_z.contains(iv)) {
+                    Real dEz =
+                        - T_Algo::DownwardDy(Bx, coefs_y.data(), n_coefs_y, i, j, k)
+                        + T_Algo::DownwardDx(By, coefs_x.data(), n_coefs_x, i, j, k);
+                    if (do_j) dEz -= PhysConst::mu0 * jz(i, j, k);
+                    if (do_F) dEz += T_Algo::UpwardDz(F, coefs_z.data(), n_coefs_z, i, j, k);
+                    Ez(i, j, k) += c2 * dt * dEz;
+                }
+            });
 
-            // Extract field data for this grid/tile
-            Array4<Real> F = Ffield->array(mfi);
+        } else {
 
             // Loop over the cells and update the fields
             amrex::ParallelFor(tex, tey, tez,
 
                 [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ex(i, j, k) += c2 * dt * T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k);
+                    Real dEx =
+                        - T_Algo::DownwardDz(By, coefs_z.data(), n_coefs_z, i, j, k)
+                        + T_Algo::DownwardDy(Bz, coefs_y.data(), n_coefs_y, i, j, k);
+                    if (do_j) dEx -= PhysConst::mu0 * jx(i, j, k);
+                    if (do_F) dEx += T_Algo::UpwardDx(F, coefs_x.data(), n_coefs_x, i, j, k);
+                    Ex(i, j, k) += c2 * dt * dEx;
                 },
+
                 [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ey(i, j, k) += c2 * dt * T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k);
+                    Real dEy =
+                        - T_Algo::DownwardDx(Bz, coefs_x.data(), n_coefs_x, i, j, k)
+                        + T_Algo::DownwardDz(Bx, coefs_z.data(), n_coefs_z, i, j, k);
+                    if (do_j) dEy -= PhysConst::mu0 * jy(i, j, k);
+                    if (do_F) dEy += T_Algo::UpwardDy(F, coefs_y.data(), n_coefs_y, i, j, k);
+                    Ey(i, j, k) += c2 * dt * dEy;
                 },
+
                 [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ez(i, j, k) += c2 * dt * T_Algo::UpwardDz(F, coefs_z, n_coefs_z, i, j, k);
+                    Real dEz =
+                        - T_Algo::DownwardDy(Bx, coefs_y.data(), n_coefs_y, i, j, k)
+                        + T_Algo::DownwardDx(By, coefs_x.data(), n_coefs_x, i, j, k);
+                    if (do_j) dEz -= PhysConst::mu0 * jz(i, j, k);
+                    if (do_F) dEz += T_Algo::UpwardDz(F, coefs_z.data(), n_coefs_z, i, j, k);
+                    Ez(i, j, k) += c2 * dt * dEz;
                 }
 
             );
 
         }
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = amrex::second() - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+
     }
 
 }
@@ -162,7 +246,8 @@ void FiniteDifferenceSolver::EvolveECylindrical (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    amrex::Vector<amrex::Real>* cost ) {
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef _OPENMP
@@ -170,6 +255,12 @@ void FiniteDifferenceSolver::EvolveECylindrical (
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = amrex::second();
+
         // Extract field data for this grid/tile
         Array4<Real> const& Er = Efield[0]->array(mfi);
         Array4<Real> const& Et = Efield[1]->array(mfi);
@@ -339,6 +430,13 @@ void FiniteDifferenceSolver::EvolveECylindrical (
 
         } // end of if condition for F
 
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = amrex::second() - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+
     } // end of loop over grid/tiles
 
 }
@@ -16,6 +16,8 @@
 #include "FiniteDifferenceSolver.H"
 #include "WarpX.H"
 
+#include <AMReX_ParmParse.H>
+
 /* This function initializes the stencil coefficients for the chosen finite-difference algorithm */
 FiniteDifferenceSolver::FiniteDifferenceSolver (
     int const fdtd_algo,
@@ -26,6 +28,11 @@ FiniteDifferenceSolver::FiniteDifferenceSolver (
     m_fdtd_algo = fdtd_algo;
     m_do_nodal = do_nodal;
 
+    // Runtime option to fuse the component updates of EvolveE/EvolveB
+    // into one kernel per tile
+    amrex::ParmParse pp("warpx");
+    pp.query("do_fused_maxwell_update", m_do_fused_update);
+
     // Calculate coefficients of finite-difference stencil
 #ifdef WARPX_DIM_RZ
     m_dr = cell_size[0];
@@ -55,4 +62,18 @@ FiniteDifferenceSolver::FiniteDifferenceSolver (
     } else {
         amrex::Abort("Unknown algorithm");
     }
+
+#ifndef WARPX_DIM_RZ
+    // Copy the coefficients into the fixed-size arrays that are captured
+    // by value by the E/B update kernels (the cell size never changes
+    // during a run, so the copies remain valid)
+    for (int i = 0; i < m_max_stencil_coefs; i++) {
+        m_coefs_x[i] = (i < static_cast<int>(m_stencil_coefs_x.size())) ?
+            m_stencil_coefs_x[i] : amrex::Real(0.);
+        m_coefs_y[i] = (i < static_cast<int>(m_stencil_coefs_y.size())) ?
+            m_stencil_coefs_y[i] : amrex::Real(0.);
+        m_coefs_z[i] = (i < static_cast<int>(m_stencil_coefs_z.size())) ?
+            m_stencil_coefs_z[i] : amrex::Real(0.);
+    }
+#endif
 };
@@ -8,6 +8,37 @@
 
 using namespace amrex;
 
+namespace {
+
+    // Coefficient sets already computed. The weak references let the
+    // arrays be freed once no solver uses them anymore.
+    amrex::Vector<std::weak_ptr<GalileanAlgorithm::CoefficientSet>> coefficients_cache;
+
+    /* \brief Return the cached coefficient set matching the given
+     * parameters, or a null pointer if none was computed yet. */
+    std::shared_ptr<GalileanAlgorithm::CoefficientSet>
+    GetCachedCoefficients (const BoxArray& ba, const DistributionMapping& dm,
+                           const RealVect& cell_size,
+                           const int norder_x, const int norder_y,
+                           const int norder_z, const bool nodal,
+                           const Array<Real, 3>& v_galilean, const Real dt)
+    {
+        for (auto const& weak_entry : coefficients_cache) {
+            auto entry = weak_entry.lock();
+            if (entry &&
+                entry->ba == ba && entry->dm == dm &&
+                entry->cell_size == cell_size &&
+                entry->norder_x == norder_x && entry->norder_y == norder_y &&
+                entry->norder_z == norder_z && entry->nodal == nodal &&
+                entry->v_galilean == v_galilean && entry->dt == dt) {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+}
+
 /* \brief Initialize coefficients for the update equation */
 GalileanAlgorithm::GalileanAlgorithm(const SpectralKSpace& spectral_kspace,
                          const DistributionMapping& dm,
@@ -21,17 +52,40 @@ GalileanAlgorithm::GalileanAlgorithm(const SpectralKSpace& spectral_kspace,
 {
     const BoxArray& ba = spectral_kspace.spectralspace_ba;
 
+    // Reuse the coefficients when the solver was already built for an
+    // identical k space, v_galilean and dt (e.g. when it is rebuilt
+    // after a moving-window regrid)
+    m_coef = GetCachedCoefficients(ba, dm, spectral_kspace.getCellSize(),
+                                   norder_x, norder_y, norder_z, nodal,
+                                   v_galilean, dt);
+    if (m_coef) return;
+
+    m_coef = std::make_shared<CoefficientSet>();
+
+    // Record the parameters that determine the content of the arrays
+    m_coef->ba = ba;
+    m_coef->dm = dm;
+    m_coef->cell_size = spectral_kspace.getCellSize();
+    m_coef->norder_x = norder_x;
+    m_coef->norder_y = norder_y;
+    m_coef->norder_z = norder_z;
+    m_coef->nodal = nodal;
+    m_coef->v_galilean = v_galilean;
+    m_coef->dt = dt;
+
     // Allocate the arrays of coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    Theta2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    m_coef->C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+    m_coef->S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+    m_coef->X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    m_coef->X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    m_coef->X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    m_coef->X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    m_coef->Theta2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
 
     InitializeSpectralCoefficients(spectral_kspace, dm, v_galilean, dt);
 
+    coefficients_cache.push_back(m_coef);
+
 };
 
 /* Advance the E and B field in spectral space (stored in `f`)
@@ -47,13 +101,13 @@ GalileanAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
         // Extract arrays for the fields to be updated
         Array4<Complex> fields = f.fields[mfi].array();
         // Extract arrays for the coefficients
-        Array4<const Real> C_arr = C_coef[mfi].array();
-        Array4<const Real> S_ck_arr = S_ck_coef[mfi].array();
-        Array4<const Complex> X1_arr = X1_coef[mfi].array();
-        Array4<const Complex> X2_arr = X2_coef[mfi].array();
-        Array4<const Complex> X3_arr = X3_coef[mfi].array();
-        Array4<const Complex> X4_arr = X4_coef[mfi].array();
-        Array4<const Complex> Theta2_arr = Theta2_coef[mfi].array();
+        Array4<const Real> C_arr = m_coef->C_coef[mfi].array();
+        Array4<const Real> S_ck_arr = m_coef->S_ck_coef[mfi].array();
+        Array4<const Complex> X1_arr = m_coef->X1_coef[mfi].array();
+        Array4<const Complex> X2_arr = m_coef->X2_coef[mfi].array();
+        Array4<const Complex> X3_arr = m_coef->X3_coef[mfi].array();
+        Array4<const Complex> X4_arr = m_coef->X4_coef[mfi].array();
+        Array4<const Complex> Theta2_arr = m_coef->Theta2_coef[mfi].array();
 
         // Extract pointers for the k vectors
         const Real* modified_kx_arr = modified_kx_vec[mfi].dataPtr();
@@ -146,13 +200,13 @@ void GalileanAlgorithm::InitializeSpectralCoefficients(const SpectralKSpace& spe
     #endif
         const Real* modified_kz = modified_kz_vec[mfi].dataPtr();
         // Extract arrays for the coefficients
-        Array4<Real> C = C_coef[mfi].array();
-        Array4<Real> S_ck = S_ck_coef[mfi].array();
-        Array4<Complex> X1 = X1_coef[mfi].array();
-        Array4<Complex> X2 = X2_coef[mfi].array();
-        Array4<Complex> X3 = X3_coef[mfi].array();
-        Array4<Complex> X4 = X4_coef[mfi].array();
-        Array4<Complex> Theta2 = Theta2_coef[mfi].array();
+        Array4<Real> C = m_coef->C_coef[mfi].array();
+        Array4<Real> S_ck = m_coef->S_ck_coef[mfi].array();
+        Array4<Complex> X1 = m_coef->X1_coef[mfi].array();
+        Array4<Complex> X2 = m_coef->X2_coef[mfi].array();
+        Array4<Complex> X3 = m_coef->X3_coef[mfi].array();
+        Array4<Complex> X4 = m_coef->X4_coef[mfi].array();
+        Array4<Complex> Theta2 = m_coef->Theta2_coef[mfi].array();
         // Extract reals (for portability on GPU)
         Real vx = v_galilean[0];
 #if (AMREX_SPACEDIM==3)
@@ -7,6 +7,8 @@
 #include "PsatdAlgorithm.H"
 #include "Utils/WarpXConst.H"
 
+#include <AMReX_ParmParse.H>
+
 #include <cmath>
 
 
@@ -24,14 +26,21 @@ PsatdAlgorithm::PsatdAlgorithm(const SpectralKSpace& spectral_kspace,
 {
     const BoxArray& ba = spectral_kspace.spectralspace_ba;
 
-    // Allocate the arrays of coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+    m_dt = dt;
+    // Runtime-selectable compute-vs-cache mode for the update coefficients
+    ParmParse pp("psatd");
+    pp.query("compute_coefficients_on_the_fly", m_compute_coefficients_on_the_fly);
+
+    if (m_compute_coefficients_on_the_fly == 0) {
+        // Allocate the arrays of coefficients
+        C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        X1_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        X2_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        X3_coef = SpectralRealCoefficients(ba, dm, 1, 0);
 
-    InitializeSpectralCoefficients(spectral_kspace, dm, dt);
+        InitializeSpectralCoefficients(spectral_kspace, dm, dt);
+    }
 }
 
 /* Advance the E and B field in spectral space (stored in `f`)
@@ -47,11 +56,19 @@ PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
         // Extract arrays for the fields to be updated
         Array4<Complex> fields = f.fields[mfi].array();
         // Extract arrays for the coefficients
-        Array4<const Real> C_arr = C_coef[mfi].array();
-        Array4<const Real> S_ck_arr = S_ck_coef[mfi].array();
-        Array4<const Real> X1_arr = X1_coef[mfi].array();
-        Array4<const Real> X2_arr = X2_coef[mfi].array();
-        Array4<const Real> X3_arr = X3_coef[mfi].array();
+        // (only if the coefficients are read from the cached tables;
+        // otherwise they are computed on the fly inside the kernel)
+        Array4<const Real> C_arr, S_ck_arr, X1_arr, X2_arr, X3_arr;
+        const bool compute_coefficients =
+            (m_compute_coefficients_on_the_fly != 0);
+        if (compute_coefficients == false) {
+            C_arr = C_coef[mfi].array();
+            S_ck_arr = S_ck_coef[mfi].array();
+            X1_arr = X1_coef[mfi].array();
+            X2_arr = X2_coef[mfi].array();
+            X3_arr = X3_coef[mfi].array();
+        }
+        const Real dt = m_dt;
         // Extract pointers for the k vectors
         const Real* modified_kx_arr = modified_kx_vec[mfi].dataPtr();
 #if (AMREX_SPACEDIM==3)
@@ -86,15 +103,37 @@ PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
             constexpr Real ky = 0;
             const Real kz = modified_kz_arr[j];
 #endif
+            constexpr Real c = PhysConst::c;
             constexpr Real c2 = PhysConst::c*PhysConst::c;
+            constexpr Real ep0 = PhysConst::ep0;
             constexpr Real inv_ep0 = 1./PhysConst::ep0;
             const Complex I = Complex{0,1};
-            const Real C = C_arr(i,j,k);
-            const Real S_ck = S_ck_arr(i,j,k);
-            const Real X1 = X1_arr(i,j,k);
-            const Real X2 = X2_arr(i,j,k);
-            const Real X3 = X3_arr(i,j,k);
-
+            Real C, S_ck, X1, X2, X3;
+            if (compute_coefficients) {
+                // Compute the coefficients on the fly from the modified
+                // k vector: these are cheap transcendentals, compared to
+                // the memory traffic of five coefficient arrays
+                const Real k_norm = std::sqrt(kx*kx + ky*ky + kz*kz);
+                if (k_norm != 0){
+                    C = std::cos(c*k_norm*dt);
+                    S_ck = std::sin(c*k_norm*dt)/(c*k_norm);
+                    X1 = (1. - C)/(ep0 * c*c * k_norm*k_norm);
+                    X2 = (1. - S_ck/dt)/(ep0 * k_norm*k_norm);
+                    X3 = (C - S_ck/dt)/(ep0 * k_norm*k_norm);
+                } else { // Handle k_norm = 0, by using the analytical limit
+                    C = 1.;
+                    S_ck = dt;
+                    X1 = 0.5 * dt*dt / ep0;
+                    X2 = c*c * dt*dt / (6.*ep0);
+                    X3 = - c*c * dt*dt / (3.*ep0);
+                }
+            } else {
+                C = C_arr(i,j,k);
+                S_ck = S_ck_arr(i,j,k);
+                X1 = X1_arr(i,j,k);
+                X2 = X2_arr(i,j,k);
+                X3 = X3_arr(i,j,k);
+            }
 
             // Update E (see WarpX online documentation: theory section)
             fields(i,j,k,Idx::Ex) = C*Ex_old
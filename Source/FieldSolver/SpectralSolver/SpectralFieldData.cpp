@@ -7,6 +7,10 @@
  */
 #include "SpectralFieldData.H"
 
+#include <AMReX_GpuAsyncArray.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
 #include <map>
 
 
@@ -27,6 +31,74 @@ using fftw_precision_complex = fftwf_complex;
 #  else
 using fftw_precision_complex = fftw_complex;
 #  endif
+
+namespace
+{
+    /* \brief Return the FFTW planner rigor flag, as selected by the
+     * input parameter `psatd.fftw_plan_measure` (read on first call) */
+    unsigned FFTWPlannerFlag ()
+    {
+        static int plan_measure = -1;
+        if (plan_measure < 0) {
+            plan_measure = 1;
+            amrex::ParmParse pp("psatd");
+            pp.query("fftw_plan_measure", plan_measure);
+        }
+        return (plan_measure) ? FFTW_MEASURE : FFTW_ESTIMATE;
+    }
+
+    /* \brief Return the name of the persistent FFTW wisdom file, as
+     * selected by the input parameter `psatd.fftw_wisdom_file`
+     * (read on first call; empty when the wisdom cache is disabled) */
+    const std::string& FFTWWisdomFile ()
+    {
+        static bool initialized = false;
+        static std::string wisdom_file;
+        if (!initialized) {
+            initialized = true;
+            amrex::ParmParse pp("psatd");
+            pp.query("fftw_wisdom_file", wisdom_file);
+        }
+        return wisdom_file;
+    }
+
+    /* \brief Import the planner wisdom accumulated by previous runs
+     * from the wisdom file, once per process: for repeated runs of the
+     * same configuration, the planner then finds all box dimensions in
+     * the wisdom and the planning step is skipped entirely */
+    void ImportFFTWWisdom ()
+    {
+        static bool imported = false;
+        if (imported) return;
+        imported = true;
+        const std::string& wisdom_file = FFTWWisdomFile();
+        if (wisdom_file.empty()) return;
+        // A missing file is not an error: the wisdom is exported as
+        // soon as new plans are created (see ExportFFTWWisdom)
+#  ifdef AMREX_USE_FLOAT
+        if (fftwf_import_wisdom_from_filename(wisdom_file.c_str())) {
+#  else
+        if (fftw_import_wisdom_from_filename(wisdom_file.c_str())) {
+#  endif
+            amrex::Print() << "Imported FFTW wisdom from "
+                           << wisdom_file << "\n";
+        }
+    }
+
+    /* \brief Export the accumulated planner wisdom to the wisdom file
+     * (only the I/O rank writes, to avoid races on a shared filesystem) */
+    void ExportFFTWWisdom ()
+    {
+        const std::string& wisdom_file = FFTWWisdomFile();
+        if (wisdom_file.empty()) return;
+        if (!amrex::ParallelDescriptor::IOProcessor()) return;
+#  ifdef AMREX_USE_FLOAT
+        fftwf_export_wisdom_to_filename(wisdom_file.c_str());
+#  else
+        fftw_export_wisdom_to_filename(wisdom_file.c_str());
+#  endif
+    }
+}
 #endif
 
 /* \brief Initialize fields in spectral space, and FFT plans */
@@ -44,10 +116,16 @@ SpectralFieldData::SpectralFieldData( const amrex::BoxArray& realspace_ba,
     // (one component per field)
     fields = SpectralField(spectralspace_ba, dm, n_field_required, 0);
 
-    // Allocate temporary arrays - in real space and spectral space
-    // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // Allocate temporary array - in spectral space only
+    // This array will store the data just before/after the FFT
+    // (one component per field, so that the batched transforms can
+    // process all fields of a box with a single many-FFT; the
+    // non-batched transforms only use the first component)
+    // The FFTs are performed in place: the real-space data is stored
+    // in the same buffer, with the padded layout of the r2c transform,
+    // which eliminates a separate real-space scratch array
+    tmpSpectralField = SpectralField(spectralspace_ba, dm, n_field_required, 0);
+    m_realspace_ba = realspace_ba;
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // It the FFT is performed from/to a cell-centered grid in real space,
@@ -72,132 +150,170 @@ SpectralFieldData::SpectralFieldData( const amrex::BoxArray& realspace_ba,
                                     ShiftType::TransformToCellCentered);
 #endif
 
-    // Allocate and initialize the FFT plans
-    forward_plan = FFTplans(spectralspace_ba, dm);
-    backward_plan = FFTplans(spectralspace_ba, dm);
-    // Loop over boxes and allocate the corresponding plan
-    // for each box owned by the local MPI proc
-    for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
-        // Note: the size of the real-space box and spectral-space box
-        // differ when using real-to-complex FFT. When initializing
-        // the FFT plan, the valid dimensions are those of the real-space box.
-        IntVect fft_size = realspace_ba[mfi].length();
-#ifdef AMREX_USE_GPU
-        // Create cuFFT plans
-        // Creating 3D plan for real to complex -- double precision
-        // Assuming CUDA is used for programming GPU
-        // Note that D2Z is inherently forward plan
-        // and  Z2D is inherently backward plan
-        cufftResult result;
-#  if (AMREX_SPACEDIM == 3)
-        result = cufftPlan3d( &forward_plan[mfi], fft_size[2], fft_size[1],fft_size[0],
-#    ifdef AMREX_USE_FLOAT
-                              CUFFT_R2C);
-#    else
-                              CUFFT_D2Z);
-#    endif
-        if ( result != CUFFT_SUCCESS ) {
-            amrex::Print() << " cufftplan3d forward failed! Error: " <<
-            cufftErrorToString(result) << "\n";
-        }
-
-        result = cufftPlan3d( &backward_plan[mfi], fft_size[2], fft_size[1],fft_size[0],
-#    ifdef AMREX_USE_FLOAT
-                              CUFFT_C2R);
-#    else
-                              CUFFT_Z2D);
-#    endif
-        if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan3d backward failed! Error: " <<
-            cufftErrorToString(result) << "\n";
-        }
-#  else
-        result = cufftPlan2d( &forward_plan[mfi], fft_size[1], fft_size[0],
-#    ifdef AMREX_USE_FLOAT
-                              CUFFT_R2C);
-#    else
-                              CUFFT_D2Z);
-#    endif
-        if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan2d forward failed! Error: " <<
-            cufftErrorToString(result) << "\n";
-        }
+    // All FFT plans (batched or not) are created lazily, on the first
+    // transform of the corresponding batch size (see getManyFFTplan):
+    // no planning time is spent before the first step, and with a
+    // persistent wisdom file (`psatd.fftw_wisdom_file`) repeated runs
+    // of the same configuration skip the planning step entirely
+    forward_plan_many = FFTplanCache(spectralspace_ba, dm);
+    backward_plan_many = FFTplanCache(spectralspace_ba, dm);
+}
 
-        result = cufftPlan2d( &backward_plan[mfi], fft_size[1], fft_size[0],
-#    ifdef AMREX_USE_FLOAT
-                              CUFFT_C2R);
-#    else
-                              CUFFT_Z2D);
-#    endif
-        if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan2d backward failed! Error: " <<
-            cufftErrorToString(result) << "\n";
-        }
-#  endif
 
+SpectralFieldData::~SpectralFieldData()
+{
+    if (tmpSpectralField.size() > 0){
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+#ifdef AMREX_USE_GPU
+            // Destroy cuFFT plans
+            for ( auto& plan : forward_plan_many[mfi] ) {
+                cufftDestroy( plan.second );
+            }
+            for ( auto& plan : backward_plan_many[mfi] ) {
+                cufftDestroy( plan.second );
+            }
 #else
-        // Create FFTW plans
-        forward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#  if (AMREX_SPACEDIM == 3)
-#    ifdef AMREX_USE_FLOAT
-            fftwf_plan_dft_r2c_3d( fft_size[2], fft_size[1], fft_size[0],
-#    else
-            fftw_plan_dft_r2c_3d( fft_size[2], fft_size[1], fft_size[0],
-#    endif
-#  else
-#    ifdef AMREX_USE_FLOAT
-            fftwf_plan_dft_r2c_2d( fft_size[1], fft_size[0],
-#    else
-            fftw_plan_dft_r2c_2d( fft_size[1], fft_size[0],
-#    endif
-#  endif
-            tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<fftw_precision_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            FFTW_ESTIMATE );
-        backward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#  if (AMREX_SPACEDIM == 3)
-#    ifdef AMREX_USE_FLOAT
-            fftwf_plan_dft_c2r_3d( fft_size[2], fft_size[1], fft_size[0],
-#    else
-            fftw_plan_dft_c2r_3d( fft_size[2], fft_size[1], fft_size[0],
-#    endif
+            // Destroy FFTW plans
+#  ifdef AMREX_USE_FLOAT
+            for ( auto& plan : forward_plan_many[mfi] ) {
+                fftwf_destroy_plan( plan.second );
+            }
+            for ( auto& plan : backward_plan_many[mfi] ) {
+                fftwf_destroy_plan( plan.second );
+            }
 #  else
-#    ifdef AMREX_USE_FLOAT
-            fftwf_plan_dft_c2r_2d( fft_size[1], fft_size[0],
-#    else
-            fftw_plan_dft_c2r_2d( fft_size[1], fft_size[0],
-#    endif
+            for ( auto& plan : forward_plan_many[mfi] ) {
+                fftw_destroy_plan( plan.second );
+            }
+            for ( auto& plan : backward_plan_many[mfi] ) {
+                fftw_destroy_plan( plan.second );
+            }
 #  endif
-            reinterpret_cast<fftw_precision_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            tmpRealField[mfi].dataPtr(),
-            FFTW_ESTIMATE );
 #endif
+        }
     }
 }
 
+/* \brief Return an Array4 view of the real-space data of box `mfi`,
+ *  which aliases the padded storage of `tmpSpectralField` */
+Array4<Real>
+SpectralFieldData::realDataView( const MFIter& mfi )
+{
+    // The in-place r2c transform stores the real-space data in the
+    // complex buffer, with each line along x padded to the length
+    // of the spectral data (i.e. 2*(nx/2+1) real values)
+    Box padded_bx = m_realspace_ba[mfi];
+    padded_bx.setBig( 0, padded_bx.smallEnd(0)
+                          + 2*(padded_bx.length(0)/2 + 1) - 1 );
+    const Dim3 lo = amrex::lbound(padded_bx);
+    const Dim3 hi = amrex::ubound(padded_bx);
+    return Array4<Real>(
+        reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ),
+        lo, Dim3{hi.x+1, hi.y+1, hi.z+1}, tmpSpectralField.nComp() );
+}
 
-SpectralFieldData::~SpectralFieldData()
+/* \brief Return the many-FFT plan of box `mfi` for a batch of `howmany`
+ *  fields, creating it on first use */
+SpectralFieldData::FFTplan
+SpectralFieldData::getManyFFTplan( const MFIter& mfi,
+                                   const int howmany, const bool forward )
 {
-    if (tmpRealField.size() > 0){
-        for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
+    auto& cache = forward ? forward_plan_many[mfi] : backward_plan_many[mfi];
+    const auto it = cache.find( howmany );
+    if (it != cache.end()) return it->second;
+
+    // Create a new plan for this batch size
+    // Note: the size of the real-space box and spectral-space box
+    // differ when using real-to-complex FFT; the valid dimensions
+    // are those of the real-space box.
+    const IntVect fft_size = m_realspace_ba[mfi].length();
+    // Swap dimensions: AMReX FAB are Fortran-order
+    // but the FFT libraries are C-order
+    // The transforms are done in place: the real-space data is stored
+    // in the complex buffer, with padded lines along x
+#if (AMREX_SPACEDIM == 3)
+    int fft_dims[3] = { fft_size[2], fft_size[1], fft_size[0] };
+    int real_dims[3] = { fft_size[2], fft_size[1], 2*(fft_size[0]/2 + 1) };
+    int spectral_dims[3] = { fft_size[2], fft_size[1], fft_size[0]/2 + 1 };
+#else
+    int fft_dims[2] = { fft_size[1], fft_size[0] };
+    int real_dims[2] = { fft_size[1], 2*(fft_size[0]/2 + 1) };
+    int spectral_dims[2] = { fft_size[1], fft_size[0]/2 + 1 };
+#endif
+    // Distance between two successive fields within the temporary array
+    // (the components of the temporary array are contiguous in memory)
+    const int spectral_dist = static_cast<int>( tmpSpectralField[mfi].box().numPts() );
+    const int real_dist = 2*spectral_dist;
+
+    FFTplan plan;
 #ifdef AMREX_USE_GPU
-            // Destroy cuFFT plans
-            cufftDestroy( forward_plan[mfi] );
-            cufftDestroy( backward_plan[mfi] );
+    // Create cuFFT plan
+    cufftResult result;
+    if (forward) {
+        result = cufftPlanMany( &plan, AMREX_SPACEDIM, fft_dims,
+                                real_dims, 1, real_dist,
+                                spectral_dims, 1, spectral_dist,
+#  ifdef AMREX_USE_FLOAT
+                                CUFFT_R2C,
+#  else
+                                CUFFT_D2Z,
+#  endif
+                                howmany );
+    } else {
+        result = cufftPlanMany( &plan, AMREX_SPACEDIM, fft_dims,
+                                spectral_dims, 1, spectral_dist,
+                                real_dims, 1, real_dist,
+#  ifdef AMREX_USE_FLOAT
+                                CUFFT_C2R,
+#  else
+                                CUFFT_Z2D,
+#  endif
+                                howmany );
+    }
+    if ( result != CUFFT_SUCCESS ) {
+       amrex::Print() << " cufftPlanMany failed! Error: " <<
+        cufftErrorToString(result) << "\n";
+    }
 #else
-            // Destroy FFTW plans
+    // Create FFTW plan, with the rigor selected by the input parameter
+    // `psatd.fftw_plan_measure`. With FFTW_MEASURE, the planner runs and
+    // times actual transforms (and overwrites the contents of the
+    // transform buffer): this is why all callers obtain their plan
+    // *before* copying data into `tmpSpectralField`. Importing the
+    // persistent wisdom first makes planning a simple lookup when the
+    // box dimensions have already been planned in a previous run.
+    ImportFFTWWisdom();
+    const unsigned planner_flag = FFTWPlannerFlag();
+    if (forward) {
 #  ifdef AMREX_USE_FLOAT
-            fftwf_destroy_plan( forward_plan[mfi] );
-            fftwf_destroy_plan( backward_plan[mfi] );
+        plan = fftwf_plan_many_dft_r2c(
 #  else
-            fftw_destroy_plan( forward_plan[mfi] );
-            fftw_destroy_plan( backward_plan[mfi] );
+        plan = fftw_plan_many_dft_r2c(
 #  endif
-#endif
-        }
+            AMREX_SPACEDIM, fft_dims, howmany,
+            reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ),
+            real_dims, 1, real_dist,
+            reinterpret_cast<fftw_precision_complex*>( tmpSpectralField[mfi].dataPtr() ),
+            spectral_dims, 1, spectral_dist,
+            planner_flag );
+    } else {
+#  ifdef AMREX_USE_FLOAT
+        plan = fftwf_plan_many_dft_c2r(
+#  else
+        plan = fftw_plan_many_dft_c2r(
+#  endif
+            AMREX_SPACEDIM, fft_dims, howmany,
+            reinterpret_cast<fftw_precision_complex*>( tmpSpectralField[mfi].dataPtr() ),
+            spectral_dims, 1, spectral_dist,
+            reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ),
+            real_dims, 1, real_dist,
+            planner_flag );
     }
+    // Keep the on-disk wisdom up to date with the newly created plan
+    ExportFFTWWisdom();
+#endif
+    cache[howmany] = plan;
+    return plan;
 }
 
 /* \brief Transform the component `i_comp` of MultiFab `mf`
@@ -220,8 +336,13 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
     // Loop over boxes
     for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
 
-        // Copy the real-space field `mf` to the temporary field `tmpRealField`
-        // This ensures that all fields have the same number of points
+        // Get the FFT plan first (the non-batched transforms use a batch
+        // of one): on first use, creating a plan with FFTW_MEASURE
+        // overwrites the contents of the transform buffer
+        FFTplan fft_plan = getManyFFTplan( mfi, 1, true );
+
+        // Copy the real-space field `mf` to the real-space view of the
+        // temporary field (the FFT is done in place). This ensures that all fields have the same number of points
         // before the Fourier transform.
         // As a consequence, the copy discards the *last* point of `mf`
         // in any direction that has *nodal* index type.
@@ -233,30 +354,30 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
                 realspace_bx = mf[mfi].box(); // Keep guard cells
             }
             realspace_bx.enclosedCells(); // Discard last point in nodal direction
-            AMREX_ALWAYS_ASSERT( realspace_bx == tmpRealField[mfi].box() );
+            AMREX_ALWAYS_ASSERT( realspace_bx == m_realspace_ba[mfi] );
             Array4<const Real> mf_arr = mf[mfi].array();
-            Array4<Real> tmp_arr = tmpRealField[mfi].array();
+            Array4<Real> tmp_arr = realDataView(mfi);
             ParallelFor( realspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
                 tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
             });
         }
 
-        // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
+        // Perform in-place Fourier transform within `tmpSpectralField`
 #ifdef AMREX_USE_GPU
         // Perform Fast Fourier Transform on GPU using cuFFT
         // make sure that this is done on the same
         // GPU stream as the above copy
         cufftResult result;
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
-        cufftSetStream ( forward_plan[mfi], stream);
+        cufftSetStream ( fft_plan, stream);
 #  ifdef AMREX_USE_FLOAT
         result = cufftExecR2C(
 #  else
         result = cufftExecD2Z(
 #  endif
-            forward_plan[mfi],
-            tmpRealField[mfi].dataPtr(),
+            fft_plan,
+            reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ),
             reinterpret_cast<cuPrecisionComplex*>(
                 tmpSpectralField[mfi].dataPtr()) );
         if ( result != CUFFT_SUCCESS ) {
@@ -266,9 +387,9 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
         }
 #else
 #  ifdef AMREX_USE_FLOAT
-        fftwf_execute( forward_plan[mfi] );
+        fftwf_execute( fft_plan );
 #  else
-        fftw_execute( forward_plan[mfi] );
+        fftw_execute( fft_plan );
 #  endif
 #endif
 
@@ -306,6 +427,154 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
 }
 
 
+/* \brief Transform the components `i_comp` of the MultiFabs `mf`
+ *  to spectral space, and store the corresponding results internally
+ *  (in the spectral fields specified by `field_index`)
+ *
+ *  All fields of a box are transformed by a single many-FFT, and the
+ *  copies from/to the temporary arrays are done by a single fused kernel */
+void
+SpectralFieldData::ForwardTransform( const amrex::Vector<amrex::MultiFab const*>& mf,
+                                     const amrex::Vector<int>& field_index,
+                                     const amrex::Vector<int>& i_comp )
+{
+    const int n_fields = static_cast<int>( mf.size() );
+    AMREX_ALWAYS_ASSERT( field_index.size() == mf.size() );
+    AMREX_ALWAYS_ASSERT( i_comp.size() == mf.size() );
+    AMREX_ALWAYS_ASSERT( n_fields <= tmpSpectralField.nComp() );
+
+    // Check the field index types, in order to apply the proper shifts
+    // in spectral space: for each field, set one bit per direction in
+    // which the real space data comes from a cell-centered grid
+    Vector<int> shift_flag_h(n_fields);
+    for (int n = 0; n < n_fields; n++) {
+        int shift_flag = 0;
+        if (mf[n]->is_nodal(0) == false) shift_flag |= 1;
+#if (AMREX_SPACEDIM == 3)
+        if (mf[n]->is_nodal(1) == false) shift_flag |= 2;
+        if (mf[n]->is_nodal(2) == false) shift_flag |= 4;
+#else
+        if (mf[n]->is_nodal(1) == false) shift_flag |= 4;
+#endif
+        shift_flag_h[n] = shift_flag;
+    }
+    // Copy the per-field metadata to the device
+    AsyncArray<int> i_comp_aa( i_comp.data(), n_fields );
+    AsyncArray<int> field_index_aa( field_index.data(), n_fields );
+    AsyncArray<int> shift_flag_aa( shift_flag_h.data(), n_fields );
+    const int* p_i_comp = i_comp_aa.data();
+    const int* p_field_index = field_index_aa.data();
+    const int* p_shift_flag = shift_flag_aa.data();
+
+    // Loop over boxes
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+
+        // Get the batched plan first: on first use, creating a plan with
+        // FFTW_MEASURE overwrites the contents of the transform buffer
+        FFTplan many_plan = getManyFFTplan( mfi, n_fields, true );
+
+        // Copy the real-space fields `mf` to the real-space view of the
+        // temporary field (the FFT is done in place), with one fused
+        // kernel for all fields.
+        // This ensures that all fields have the same number of points
+        // before the Fourier transform.
+        // As a consequence, the copy discards the *last* point of `mf`
+        // in any direction that has *nodal* index type.
+        {
+            Box realspace_bx;
+            if (m_periodic_single_box) {
+                realspace_bx = mfi.validbox(); // Discard guard cells
+            } else {
+                realspace_bx = (*mf[0])[mfi].box(); // Keep guard cells
+            }
+            realspace_bx.enclosedCells(); // Discard last point in nodal direction
+            AMREX_ALWAYS_ASSERT( realspace_bx == m_realspace_ba[mfi] );
+            Vector<Array4<const Real>> mf_arr_h(n_fields);
+            for (int n = 0; n < n_fields; n++) {
+                // All fields of the batch must cover the same box
+                // (including guard cells) once nodal points are discarded
+                if (m_periodic_single_box == false) {
+                    AMREX_ALWAYS_ASSERT(
+                        amrex::enclosedCells((*mf[n])[mfi].box()) == realspace_bx );
+                }
+                mf_arr_h[n] = (*mf[n])[mfi].array();
+            }
+            AsyncArray<Array4<const Real>> mf_arr_aa( mf_arr_h.data(), n_fields );
+            const Array4<const Real>* p_mf_arr = mf_arr_aa.data();
+            Array4<Real> tmp_arr = realDataView(mfi);
+            ParallelFor( realspace_bx, n_fields,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                tmp_arr(i,j,k,n) = p_mf_arr[n](i,j,k,p_i_comp[n]);
+            });
+        }
+
+        // Perform in-place Fourier transform within `tmpSpectralField`,
+        // transforming all fields with a single batched plan
+#ifdef AMREX_USE_GPU
+        // Perform Fast Fourier Transform on GPU using cuFFT
+        // make sure that this is done on the same
+        // GPU stream as the above copy
+        cufftResult result;
+        cudaStream_t stream = amrex::Gpu::Device::cudaStream();
+        cufftSetStream ( many_plan, stream);
+#  ifdef AMREX_USE_FLOAT
+        result = cufftExecR2C(
+#  else
+        result = cufftExecD2Z(
+#  endif
+            many_plan,
+            reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ),
+            reinterpret_cast<cuPrecisionComplex*>(
+                tmpSpectralField[mfi].dataPtr()) );
+        if ( result != CUFFT_SUCCESS ) {
+           amrex::Print() <<
+           " batched forward transform using cufftExec failed ! Error: " <<
+           cufftErrorToString(result) << "\n";
+        }
+#else
+#  ifdef AMREX_USE_FLOAT
+        fftwf_execute( many_plan );
+#  else
+        fftw_execute( many_plan );
+#  endif
+#endif
+
+        // Copy the spectral-space fields `tmpSpectralField` to the
+        // appropriate indices of the FabArray `fields` (specified by
+        // `field_index`) with one fused kernel, and apply the correcting
+        // shift factor to each field whose real space data comes from a
+        // cell-centered grid in real space instead of a nodal grid.
+        {
+            Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+            Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
+            const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
+#if (AMREX_SPACEDIM == 3)
+            const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
+#endif
+            const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
+            // Loop over indices within one box
+            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+            ParallelFor( spectralspace_bx, n_fields,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = tmp_arr(i,j,k,n);
+                // Apply proper shift in each dimension
+                const int shift_flag = p_shift_flag[n];
+                if (shift_flag & 1) spectral_field_value *= xshift_arr[i];
+#if (AMREX_SPACEDIM == 3)
+                if (shift_flag & 2) spectral_field_value *= yshift_arr[j];
+                if (shift_flag & 4) spectral_field_value *= zshift_arr[k];
+#elif (AMREX_SPACEDIM == 2)
+                if (shift_flag & 4) spectral_field_value *= zshift_arr[j];
+#endif
+                // Copy field into the right index
+                fields_arr(i,j,k,p_field_index[n]) = spectral_field_value;
+            });
+        }
+    }
+}
+
+
 /* \brief Transform spectral field specified by `field_index` back to
  * real space, and store it in the component `i_comp` of `mf` */
 void
@@ -325,6 +594,11 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
     // Loop over boxes
     for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
 
+        // Get the FFT plan first (the non-batched transforms use a batch
+        // of one): on first use, creating a plan with FFTW_MEASURE
+        // overwrites the contents of the transform buffer
+        FFTplan fft_plan = getManyFFTplan( mfi, 1, false );
+
         // Copy the spectral-space field `tmpSpectralField` to the appropriate
         // field (specified by the input argument field_index)
         // and apply correcting shift factor if the field is to be transformed
@@ -357,23 +631,23 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
 
         }
 
-        // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
+        // Perform in-place Fourier transform within `tmpSpectralField`
 #ifdef AMREX_USE_GPU
         // Perform Fast Fourier Transform on GPU using cuFFT.
         // make sure that this is done on the same
         // GPU stream as the above copy
         cufftResult result;
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
-        cufftSetStream ( backward_plan[mfi], stream);
+        cufftSetStream ( fft_plan, stream);
 #  ifdef AMREX_USE_FLOAT
         result = cufftExecC2R(
 #  else
         result = cufftExecZ2D(
 #  endif
-            backward_plan[mfi],
+            fft_plan,
             reinterpret_cast<cuPrecisionComplex*>(
             tmpSpectralField[mfi].dataPtr()),
-            tmpRealField[mfi].dataPtr() );
+            reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ) );
         if ( result != CUFFT_SUCCESS ) {
            amrex::Print() <<
            " Backward transform using cufftexec failed! Error: " <<
@@ -381,21 +655,22 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
         }
 #else
 #  ifdef AMREX_USE_FLOAT
-        fftwf_execute( backward_plan[mfi] );
+        fftwf_execute( fft_plan );
 #  else
-        fftw_execute( backward_plan[mfi] );
+        fftw_execute( fft_plan );
 #  endif
 #endif
 
-        // Copy the temporary field `tmpRealField` to the real-space field `mf`
+        // Copy the real-space view of the temporary field to the
+        // real-space field `mf`
         // (only in the valid cells ; not in the guard cells)
         // Normalize (divide by 1/N) since the FFT+IFFT results in a factor N
         {
             Array4<Real> mf_arr = mf[mfi].array();
-            Array4<const Real> tmp_arr = tmpRealField[mfi].array();
+            Array4<const Real> tmp_arr = realDataView(mfi);
             // Normalization: divide by the number of points in realspace
             // (includes the guard cells)
-            const Box realspace_bx = tmpRealField[mfi].box();
+            const Box realspace_bx = m_realspace_ba[mfi];
             const Real inv_N = 1./realspace_bx.numPts();
 
             if (m_periodic_single_box) {
@@ -430,6 +705,180 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
     }
 }
 
+/* \brief Transform the spectral fields specified by `field_index` back to
+ *  real space, and store them in the components `i_comp` of the
+ *  MultiFabs `mf`
+ *
+ *  All fields of a box are transformed by a single many-FFT, and the
+ *  copies from/to the temporary arrays are done by a single fused kernel */
+void
+SpectralFieldData::BackwardTransform( const amrex::Vector<amrex::MultiFab*>& mf,
+                                      const amrex::Vector<int>& field_index,
+                                      const amrex::Vector<int>& i_comp )
+{
+    const int n_fields = static_cast<int>( mf.size() );
+    AMREX_ALWAYS_ASSERT( field_index.size() == mf.size() );
+    AMREX_ALWAYS_ASSERT( i_comp.size() == mf.size() );
+    AMREX_ALWAYS_ASSERT( n_fields <= tmpSpectralField.nComp() );
+
+    // Check the field index types, in order to apply the proper shifts
+    // in spectral space: for each field, set one bit per direction in
+    // which the field is transformed to a cell-centered grid
+    Vector<int> shift_flag_h(n_fields);
+    for (int n = 0; n < n_fields; n++) {
+        int shift_flag = 0;
+        if (mf[n]->is_nodal(0) == false) shift_flag |= 1;
+#if (AMREX_SPACEDIM == 3)
+        if (mf[n]->is_nodal(1) == false) shift_flag |= 2;
+        if (mf[n]->is_nodal(2) == false) shift_flag |= 4;
+#else
+        if (mf[n]->is_nodal(1) == false) shift_flag |= 4;
+#endif
+        shift_flag_h[n] = shift_flag;
+    }
+    // Copy the per-field metadata to the device
+    AsyncArray<int> i_comp_aa( i_comp.data(), n_fields );
+    AsyncArray<int> field_index_aa( field_index.data(), n_fields );
+    AsyncArray<int> shift_flag_aa( shift_flag_h.data(), n_fields );
+    const int* p_i_comp = i_comp_aa.data();
+    const int* p_field_index = field_index_aa.data();
+    const int* p_shift_flag = shift_flag_aa.data();
+
+    // Loop over boxes
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+
+        // Get the batched plan first: on first use, creating a plan with
+        // FFTW_MEASURE overwrites the contents of the transform buffer
+        FFTplan many_plan = getManyFFTplan( mfi, n_fields, false );
+
+        // Copy the spectral-space fields (specified by the input argument
+        // field_index) to `tmpSpectralField` with one fused kernel,
+        // and apply the correcting shift factor to each field that is to
+        // be transformed to a cell-centered grid in real space instead
+        // of a nodal grid.
+        {
+            Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
+            Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+            const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
+#if (AMREX_SPACEDIM == 3)
+            const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
+#endif
+            const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
+            // Loop over indices within one box
+            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+            ParallelFor( spectralspace_bx, n_fields,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = field_arr(i,j,k,p_field_index[n]);
+                // Apply proper shift in each dimension
+                const int shift_flag = p_shift_flag[n];
+                if (shift_flag & 1) spectral_field_value *= xshift_arr[i];
+#if (AMREX_SPACEDIM == 3)
+                if (shift_flag & 2) spectral_field_value *= yshift_arr[j];
+                if (shift_flag & 4) spectral_field_value *= zshift_arr[k];
+#elif (AMREX_SPACEDIM == 2)
+                if (shift_flag & 4) spectral_field_value *= zshift_arr[j];
+#endif
+                // Copy field into temporary array
+                tmp_arr(i,j,k,n) = spectral_field_value;
+            });
+        }
+
+        // Perform in-place Fourier transform within `tmpSpectralField`,
+        // transforming all fields with a single batched plan
+#ifdef AMREX_USE_GPU
+        // Perform Fast Fourier Transform on GPU using cuFFT.
+        // make sure that this is done on the same
+        // GPU stream as the above copy
+        cufftResult result;
+        cudaStream_t stream = amrex::Gpu::Device::cudaStream();
+        cufftSetStream ( many_plan, stream);
+#  ifdef AMREX_USE_FLOAT
+        result = cufftExecC2R(
+#  else
+        result = cufftExecZ2D(
+#  endif
+            many_plan,
+            reinterpret_cast<cuPrecisionComplex*>(
+            tmpSpectralField[mfi].dataPtr()),
+            reinterpret_cast<Real*>( tmpSpectralField[mfi].dataPtr() ) );
+        if ( result != CUFFT_SUCCESS ) {
+           amrex::Print() <<
+           " batched backward transform using cufftexec failed! Error: " <<
+           cufftErrorToString(result) << "\n";
+        }
+#else
+#  ifdef AMREX_USE_FLOAT
+        fftwf_execute( many_plan );
+#  else
+        fftw_execute( many_plan );
+#  endif
+#endif
+
+        // Copy the real-space view of the temporary field to the
+        // real-space fields `mf` with one fused kernel
+        // (only in the valid cells of each field ; not in the guard cells)
+        // Normalize (divide by 1/N) since the FFT+IFFT results in a factor N
+        {
+            // The valid boxes of the different fields differ along the
+            // nodal directions of each field; the fused kernel covers
+            // the union of the valid boxes and restricts the copy of
+            // each field to its own valid box.
+            Vector<Box> valid_bx_h(n_fields);
+            Vector<Array4<Real>> mf_arr_h(n_fields);
+            for (int n = 0; n < n_fields; n++) {
+                valid_bx_h[n] = mf[n]->boxArray()[mfi.index()];
+                mf_arr_h[n] = (*mf[n])[mfi].array();
+            }
+            AsyncArray<Box> valid_bx_aa( valid_bx_h.data(), n_fields );
+            AsyncArray<Array4<Real>> mf_arr_aa( mf_arr_h.data(), n_fields );
+            const Box* p_valid_bx = valid_bx_aa.data();
+            const Array4<Real>* p_mf_arr = mf_arr_aa.data();
+            const Box bounding_bx = amrex::surroundingNodes(
+                amrex::enclosedCells( valid_bx_h[0] ) );
+            Array4<const Real> tmp_arr = realDataView(mfi);
+            // Normalization: divide by the number of points in realspace
+            // (includes the guard cells)
+            const Box realspace_bx = m_realspace_ba[mfi];
+            const Real inv_N = 1./realspace_bx.numPts();
+
+            if (m_periodic_single_box) {
+                // Enforce periodicity on the nodes, by using modulo in indices
+                // This is because `tmp_arr` is cell-centered while `mf` can be nodal
+                int const nx = realspace_bx.length(0);
+                int const ny = realspace_bx.length(1);
+#if (AMREX_SPACEDIM == 3)
+                int const nz = realspace_bx.length(2);
+#else
+                int constexpr nz = 1;
+#endif
+                ParallelFor(
+                    bounding_bx, n_fields,
+                    /* GCC 8.1-8.2 work-around (ICE):
+                     *   named capture in nonexcept lambda needed for modulo operands
+                     *   https://godbolt.org/z/ppbAzd
+                     */
+                    [p_mf_arr, p_valid_bx, p_i_comp, inv_N, tmp_arr, nx, ny, nz]
+                    AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept {
+                        if (p_valid_bx[n].contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                            p_mf_arr[n](i,j,k,p_i_comp[n]) =
+                                inv_N*tmp_arr(i%nx, j%ny, k%nz, n);
+                        }
+                    });
+            } else {
+                ParallelFor( bounding_bx, n_fields,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                    // Copy and normalize field
+                    if (p_valid_bx[n].contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                        p_mf_arr[n](i,j,k,p_i_comp[n]) = inv_N*tmp_arr(i,j,k,n);
+                    }
+                });
+            }
+
+        }
+    }
+}
+
 #ifdef AMREX_USE_GPU
 std::string
 SpectralFieldData::cufftErrorToString (const cufftResult& err)
@@ -171,9 +171,31 @@ HankelTransform::HankelTransform (int const hankel_order,
 
 }
 
+std::shared_ptr<HankelTransform>
+HankelTransform::GetOrCreate (int const hankel_order,
+                              int const azimuthal_mode,
+                              int const nr,
+                              const amrex::Real rmax)
+{
+    // The weak references let the matrices be freed when all of the
+    // spectral solvers using them have been rebuilt on a new grid.
+    // This is only called from the (serial) loops over boxes.
+    static std::map<std::tuple<int,int,int,amrex::Real>,
+                    std::weak_ptr<HankelTransform>> cache;
+
+    auto const key = std::make_tuple(hankel_order, azimuthal_mode, nr, rmax);
+    std::shared_ptr<HankelTransform> transform = cache[key].lock();
+    if (!transform) {
+        transform = std::make_shared<HankelTransform>(hankel_order, azimuthal_mode, nr, rmax);
+        cache[key] = transform;
+    }
+    return transform;
+}
+
 void
 HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_icomp,
-                                         amrex::FArrayBox      & G, int const G_icomp)
+                                         amrex::FArrayBox      & G, int const G_icomp,
+                                         int const n_comp)
 {
     amrex::Box const& F_box = F.box();
     amrex::Box const& G_box = G.box();
@@ -190,9 +212,11 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 #ifndef AMREX_USE_GPU
     // On CPU, the blas::gemm is significantly faster
 
+    // The components of a FArrayBox are contiguous, so the n_comp
+    // components are transformed as nz*n_comp columns of one gemm
     // Note that M is flagged to be transposed since it has dimensions (m_nr, m_nk)
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nk, nz, m_nr, 1._rt,
+               m_nk, nz*n_comp, m_nr, 1._rt,
                M.dataPtr(), m_nk,
                F.dataPtr(F_icomp)+ngr, nrF, 0._rt,
                G.dataPtr(G_icomp), m_nk);
@@ -208,12 +232,12 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
     int const nr = m_nr;
 
-    ParallelFor(G_box,
-    [=] AMREX_GPU_DEVICE(int ik, int iz, int inotused) noexcept {
-        G_arr(ik,iz,G_icomp) = 0.;
+    ParallelFor(G_box, n_comp,
+    [=] AMREX_GPU_DEVICE(int ik, int iz, int inotused, int icomp) noexcept {
+        G_arr(ik,iz,G_icomp+icomp) = 0.;
         for (int ir=0 ; ir < nr ; ir++) {
             int const ii = ir + ik*nr;
-            G_arr(ik,iz,G_icomp) += M_arr[ii]*F_arr(ir,iz,F_icomp);
+            G_arr(ik,iz,G_icomp+icomp) += M_arr[ii]*F_arr(ir,iz,F_icomp+icomp);
         }
     });
 
@@ -223,7 +247,8 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
 void
 HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_icomp,
-                                         amrex::FArrayBox      & F, int const F_icomp)
+                                         amrex::FArrayBox      & F, int const F_icomp,
+                                         int const n_comp)
 {
     amrex::Box const& G_box = G.box();
     amrex::Box const& F_box = F.box();
@@ -240,9 +265,11 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
 #ifndef AMREX_USE_GPU
     // On CPU, the blas::gemm is significantly faster
 
+    // The components of a FArrayBox are contiguous, so the n_comp
+    // components are transformed as nz*n_comp columns of one gemm
     // Note that invM is flagged to be transposed since it has dimensions (m_nk, m_nr)
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nr, nz, m_nk, 1._rt,
+               m_nr, nz*n_comp, m_nk, 1._rt,
                invM.dataPtr(), m_nr,
                G.dataPtr(G_icomp), m_nk, 0._rt,
                F.dataPtr(F_icomp)+ngr, nrF);
@@ -258,12 +285,12 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
 
     int const nk = m_nk;
 
-    ParallelFor(G_box,
-    [=] AMREX_GPU_DEVICE(int ir, int iz, int inotused) noexcept {
-        F_arr(ir,iz,F_icomp) = 0.;
+    ParallelFor(G_box, n_comp,
+    [=] AMREX_GPU_DEVICE(int ir, int iz, int inotused, int icomp) noexcept {
+        F_arr(ir,iz,F_icomp+icomp) = 0.;
         for (int ik=0 ; ik < nk ; ik++) {
             int const ii = ik + ir*nk;
-            F_arr(ir,iz,F_icomp) += invM_arr[ii]*G_arr(ik,iz,G_icomp);
+            F_arr(ir,iz,F_icomp+icomp) += invM_arr[ii]*G_arr(ik,iz,G_icomp+icomp);
         }
     });
 
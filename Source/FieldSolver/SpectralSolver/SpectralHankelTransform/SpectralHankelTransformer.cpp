@@ -18,9 +18,9 @@ SpectralHankelTransformer::SpectralHankelTransformer (int const nr,
     dhtm.resize(m_n_rz_azimuthal_modes);
 
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
-        dht0[mode].reset( new HankelTransform(mode  , mode, m_nr, rmax) );
-        dhtp[mode].reset( new HankelTransform(mode+1, mode, m_nr, rmax) );
-        dhtm[mode].reset( new HankelTransform(mode-1, mode, m_nr, rmax) );
+        dht0[mode] = HankelTransform::GetOrCreate(mode  , mode, m_nr, rmax);
+        dhtp[mode] = HankelTransform::GetOrCreate(mode+1, mode, m_nr, rmax);
+        dhtm[mode] = HankelTransform::GetOrCreate(mode-1, mode, m_nr, rmax);
     }
 
     ExtractKrArray();
@@ -70,9 +70,9 @@ SpectralHankelTransformer::PhysicalToSpectral_Scalar (amrex::Box const & box,
             dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r);
             G_spectral.setVal<amrex::RunOn::Device>(0., mode_i);
         } else {
+            // The real and imaginary parts are transformed together
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelForwardTransform(F_physical, icomp  , G_spectral, mode_r);
-            dht0[mode]->HankelForwardTransform(F_physical, icomp+1, G_spectral, mode_i);
+            dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r, 2);
         }
     }
 }
@@ -116,10 +116,9 @@ SpectralHankelTransformer::PhysicalToSpectral_Vector (amrex::Box const & box,
 
         amrex::Gpu::streamSynchronize();
 
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r);
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_i, G_p_spectral, mode_i);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_i, G_m_spectral, mode_i);
+        // The real and imaginary parts are transformed together
+        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r, 2);
+        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r, 2);
 
     }
 }
@@ -145,9 +144,9 @@ SpectralHankelTransformer::SpectralToPhysical_Scalar (amrex::Box const & box,
             int const icomp = 0;
             dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
         } else {
+            // The real and imaginary parts are transformed together
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_i, F_physical, icomp+1);
+            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp, 2);
         }
     }
 }
@@ -172,10 +171,9 @@ SpectralHankelTransformer::SpectralToPhysical_Vector (amrex::Box const & box,
 
         amrex::Gpu::streamSynchronize();
 
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r);
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_i, F_r_physical, mode_i);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_i, F_t_physical, mode_i);
+        // The real and imaginary parts are transformed together
+        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r, 2);
+        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r, 2);
 
         amrex::Gpu::streamSynchronize();
 
@@ -87,6 +87,24 @@ SpectralSolver::BackwardTransform( amrex::MultiFab& mf,
     field_data.BackwardTransform( mf, field_index, i_comp );
 }
 
+void
+SpectralSolver::ForwardTransform( const amrex::Vector<amrex::MultiFab const*>& mf,
+                                  const amrex::Vector<int>& field_index,
+                                  const amrex::Vector<int>& i_comp )
+{
+    WARPX_PROFILE("SpectralSolver::ForwardTransform");
+    field_data.ForwardTransform( mf, field_index, i_comp );
+}
+
+void
+SpectralSolver::BackwardTransform( const amrex::Vector<amrex::MultiFab*>& mf,
+                                   const amrex::Vector<int>& field_index,
+                                   const amrex::Vector<int>& i_comp )
+{
+    WARPX_PROFILE("SpectralSolver::BackwardTransform");
+    field_data.BackwardTransform( mf, field_index, i_comp );
+}
+
 void
 SpectralSolver::pushSpectralFields(){
     WARPX_PROFILE("SpectralSolver::pushSpectralFields");
@@ -8,6 +8,7 @@
  */
 #include "WarpX.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXThroughputCounters.H"
 #include "BoundaryConditions/WarpX_PML_kernels.H"
 #include "BoundaryConditions/PML_current.H"
 #include "WarpX_FDTD.H"
@@ -27,6 +28,34 @@ using namespace amrex;
 
 #ifdef WARPX_USE_PSATD
 namespace {
+
+    /** \brief Zero the guard cells of `mf` that lie outside of `ng_keep`
+     * guard cells, in every box.
+     *
+     * This is used when fewer guard cells are exchanged than allocated
+     * (`psatd.nx_comm_guard` etc.): the non-exchanged outer guard cells
+     * then contain stale data, and are zeroed before the field solve so
+     * that the local FFTs see a cleanly windowed field.
+     */
+    void
+    ZeroOuterGuardCells (
+        amrex::MultiFab& mf,
+        const amrex::IntVect& ng_keep ) {
+
+        for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+            const Box gbx = mfi.fabbox();
+            const Box keep_bx = amrex::grow( mfi.validbox(), ng_keep );
+            if (keep_bx.contains(gbx)) continue;
+            Array4<Real> mf_arr = mf[mfi].array();
+            ParallelFor( gbx,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                if (!keep_bx.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                    mf_arr(i,j,k) = 0.;
+                }
+            });
+        }
+    }
+
     void
     PushPSATDSinglePatch (
 #ifdef WARPX_DIM_RZ
@@ -45,48 +74,44 @@ namespace {
 #ifdef WARPX_DIM_RZ
         solver.ForwardTransform(*Efield[0], Idx::Ex,
                                 *Efield[1], Idx::Ey);
-#else
-        solver.ForwardTransform(*Efield[0], Idx::Ex);
-        solver.ForwardTransform(*Efield[1], Idx::Ey);
-#endif
         solver.ForwardTransform(*Efield[2], Idx::Ez);
-#ifdef WARPX_DIM_RZ
         solver.ForwardTransform(*Bfield[0], Idx::Bx,
                                 *Bfield[1], Idx::By);
-#else
-        solver.ForwardTransform(*Bfield[0], Idx::Bx);
-        solver.ForwardTransform(*Bfield[1], Idx::By);
-#endif
         solver.ForwardTransform(*Bfield[2], Idx::Bz);
-#ifdef WARPX_DIM_RZ
         solver.ForwardTransform(*current[0], Idx::Jx,
                                 *current[1], Idx::Jy);
-#else
-        solver.ForwardTransform(*current[0], Idx::Jx);
-        solver.ForwardTransform(*current[1], Idx::Jy);
-#endif
         solver.ForwardTransform(*current[2], Idx::Jz);
         solver.ForwardTransform(*rho, Idx::rho_old, 0);
         solver.ForwardTransform(*rho, Idx::rho_new, 1);
+#else
+        // Batch all fields into a single many-FFT per box
+        solver.ForwardTransform(
+            {Efield[0].get(), Efield[1].get(), Efield[2].get(),
+             Bfield[0].get(), Bfield[1].get(), Bfield[2].get(),
+             current[0].get(), current[1].get(), current[2].get(),
+             rho.get(), rho.get()},
+            {Idx::Ex, Idx::Ey, Idx::Ez, Idx::Bx, Idx::By, Idx::Bz,
+             Idx::Jx, Idx::Jy, Idx::Jz, Idx::rho_old, Idx::rho_new},
+            {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1});
+#endif
         // Advance fields in spectral space
         solver.pushSpectralFields();
         // Perform backward Fourier Transform
 #ifdef WARPX_DIM_RZ
         solver.BackwardTransform(*Efield[0], Idx::Ex,
                                  *Efield[1], Idx::Ey);
-#else
-        solver.BackwardTransform(*Efield[0], Idx::Ex);
-        solver.BackwardTransform(*Efield[1], Idx::Ey);
-#endif
         solver.BackwardTransform(*Efield[2], Idx::Ez);
-#ifdef WARPX_DIM_RZ
         solver.BackwardTransform(*Bfield[0], Idx::Bx,
                                  *Bfield[1], Idx::By);
+        solver.BackwardTransform(*Bfield[2], Idx::Bz);
 #else
-        solver.BackwardTransform(*Bfield[0], Idx::Bx);
-        solver.BackwardTransform(*Bfield[1], Idx::By);
+        // Batch all fields into a single many-FFT per box
+        solver.BackwardTransform(
+            {Efield[0].get(), Efield[1].get(), Efield[2].get(),
+             Bfield[0].get(), Bfield[1].get(), Bfield[2].get()},
+            {Idx::Ex, Idx::Ey, Idx::Ez, Idx::Bx, Idx::By, Idx::Bz},
+            {0, 0, 0, 0, 0, 0});
 #endif
-        solver.BackwardTransform(*Bfield[2], Idx::Bz);
     }
 }
 
@@ -107,6 +132,19 @@ WarpX::PushPSATD (amrex::Real a_dt)
 void
 WarpX::PushPSATD (int lev, amrex::Real /* dt */)
 {
+    // When fewer guard cells are exchanged than allocated
+    // (psatd.nx_comm_guard etc.), window the fields to the exchanged
+    // region by zeroing the stale outer guard cells before the solve
+    if (guard_cells.ng_FieldSolver != guard_cells.ng_alloc_EB) {
+        for (int idim = 0; idim < 3; ++idim) {
+            ZeroOuterGuardCells( *Efield_fp[lev][idim], guard_cells.ng_FieldSolver );
+            ZeroOuterGuardCells( *Bfield_fp[lev][idim], guard_cells.ng_FieldSolver );
+            if (spectral_solver_cp[lev]) {
+                ZeroOuterGuardCells( *Efield_cp[lev][idim], guard_cells.ng_FieldSolver );
+                ZeroOuterGuardCells( *Bfield_cp[lev][idim], guard_cells.ng_FieldSolver );
+            }
+        }
+    }
     // Update the fields on the fine and coarse patch
     PushPSATDSinglePatch( *spectral_solver_fp[lev],
         Efield_fp[lev], Bfield_fp[lev], current_fp[lev], rho_fp[lev] );
@@ -118,34 +156,57 @@ WarpX::PushPSATD (int lev, amrex::Real /* dt */)
 #endif
 
 void
-WarpX::EvolveB (amrex::Real a_dt)
+WarpX::EvolveB (amrex::Real a_dt, UpdateRegion a_region)
 {
     for (int lev = 0; lev <= finest_level; ++lev) {
-        EvolveB(lev, a_dt);
+        EvolveB(lev, a_dt, a_region);
     }
 }
 
 void
-WarpX::EvolveB (int lev, amrex::Real a_dt)
+WarpX::EvolveB (int lev, amrex::Real a_dt, UpdateRegion a_region)
 {
     WARPX_PROFILE("WarpX::EvolveB()");
-    EvolveB(lev, PatchType::fine, a_dt);
+    // Only time full-region pushes: with halo-first scheduling
+    // (warpx.do_overlap_comms) the Interior/Exterior halves would be
+    // counted twice.
+    const Real throughput_t = (a_region == UpdateRegion::All) ?
+        ThroughputCounters::Start() : 0.;
+    EvolveB(lev, PatchType::fine, a_dt, a_region);
     if (lev > 0)
     {
-        EvolveB(lev, PatchType::coarse, a_dt);
+        EvolveB(lev, PatchType::coarse, a_dt, a_region);
+    }
+    if (ThroughputCounters::Enabled() && a_region == UpdateRegion::All) {
+        // Byte model per B grid point (fine patch only): read B and the
+        // four E values of the curl, write B.
+        long npts = 0;
+        for (int dim = 0; dim < 3; ++dim) {
+            npts += Bfield_fp[lev][dim]->boxArray().numPts();
+        }
+        ThroughputCounters::Add("EvolveB", throughput_t,
+                                npts, npts*6*sizeof(Real));
     }
 }
 
 void
-WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, UpdateRegion a_region)
 {
 
+    // Per-box timers feeding the load balancer (when
+    // algo.load_balance_costs_update = timers)
+    amrex::Vector<amrex::Real>* cost = WarpX::getCosts(lev);
+
     if (patch_type == PatchType::fine) {
-        m_fdtd_solver_fp[lev]->EvolveB( Bfield_fp[lev], Efield_fp[lev], a_dt );
+        m_fdtd_solver_fp[lev]->EvolveB( Bfield_fp[lev], Efield_fp[lev], a_dt, a_region, cost );
     } else {
-        m_fdtd_solver_cp[lev]->EvolveB( Bfield_cp[lev], Efield_cp[lev], a_dt );
+        m_fdtd_solver_cp[lev]->EvolveB( Bfield_cp[lev], Efield_cp[lev], a_dt, a_region, cost );
     }
 
+    // With halo-first scheduling, the PML push (which does not depend on
+    // the exchanged guard cells) is performed by the Exterior call only
+    if (a_region == UpdateRegion::Interior) return;
+
     const int patch_level = (patch_type == PatchType::fine) ? lev : lev-1;
     const std::array<Real,3>& dx = WarpX::CellSize(patch_level);
     const Real dtsdx = a_dt/dx[0], dtsdy = a_dt/dx[1], dtsdz = a_dt/dx[2];
@@ -218,37 +279,71 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
 }
 
 void
-WarpX::EvolveE (amrex::Real a_dt)
+WarpX::EvolveE (amrex::Real a_dt, UpdateRegion a_region)
 {
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-        EvolveE(lev, a_dt);
+        EvolveE(lev, a_dt, a_region);
     }
 }
 
 void
-WarpX::EvolveE (int lev, amrex::Real a_dt)
+WarpX::EvolveE (int lev, amrex::Real a_dt, UpdateRegion a_region)
 {
     WARPX_PROFILE("WarpX::EvolveE()");
-    EvolveE(lev, PatchType::fine, a_dt);
+    // Only time full-region pushes: with halo-first scheduling
+    // (warpx.do_overlap_comms) the Interior/Exterior halves would be
+    // counted twice.
+    const Real throughput_t = (a_region == UpdateRegion::All) ?
+        ThroughputCounters::Start() : 0.;
+    EvolveE(lev, PatchType::fine, a_dt, a_region);
     if (lev > 0)
     {
-        EvolveE(lev, PatchType::coarse, a_dt);
+        EvolveE(lev, PatchType::coarse, a_dt, a_region);
+    }
+    if (ThroughputCounters::Enabled() && a_region == UpdateRegion::All) {
+        // Byte model per E grid point (fine patch only): read E, j and the
+        // four B values of the curl, write E.
+        long npts = 0;
+        for (int dim = 0; dim < 3; ++dim) {
+            npts += Efield_fp[lev][dim]->boxArray().numPts();
+        }
+        ThroughputCounters::Add("EvolveE", throughput_t,
+                                npts, npts*7*sizeof(Real));
     }
 }
 
 void
-WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, UpdateRegion a_region)
 {
 
+    // Per-box timers feeding the load balancer (when
+    // algo.load_balance_costs_update = timers)
+    amrex::Vector<amrex::Real>* cost = WarpX::getCosts(lev);
+
+    // In sparse-current mode, skip the j term of the update on the boxes
+    // that the guard-cell sums cannot have filled with nonzero current
+    const std::vector<char>* j_deposited = nullptr;
+    std::vector<char> j_mask;
+    if (do_sparse_current) {
+        j_mask = SummedCurrentMask(lev, patch_type);
+        if (!j_mask.empty()) j_deposited = &j_mask;
+    }
+
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveE( Efield_fp[lev], Bfield_fp[lev],
-                                      current_fp[lev], F_fp[lev], a_dt );
+                                      current_fp[lev], F_fp[lev], a_dt, a_region, cost,
+                                      j_deposited );
     } else {
         m_fdtd_solver_cp[lev]->EvolveE( Efield_cp[lev], Bfield_cp[lev],
-                                      current_cp[lev], F_cp[lev], a_dt );
+                                      current_cp[lev], F_cp[lev], a_dt, a_region, cost,
+                                      j_deposited );
     }
 
+    // With halo-first scheduling, the PML push (which does not depend on
+    // the exchanged guard cells) is performed by the Exterior call only
+    if (a_region == UpdateRegion::Interior) return;
+
     const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * a_dt;
     const Real c2dt = (PhysConst::c*PhysConst::c) * a_dt;
 
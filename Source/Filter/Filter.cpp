@@ -37,6 +37,13 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, int scomp, int dco
         const Box& tbx = mfi.growntilebox();
         const Box& gbx = amrex::grow(tbx,stencil_length_each_dir-1);
 
+        // If the source data already covers the grown box, apply the stencil
+        // to it directly instead of going through a zero-padded temporary copy
+        if (srcmf[mfi].box().contains(gbx)) {
+            DoFilter(tbx, src, dst, scomp, dcomp, ncomp);
+            continue;
+        }
+
         // tmpfab has enough ghost cells for the stencil
         FArrayBox tmp_fab(gbx,ncomp);
         Elixir tmp_eli = tmp_fab.elixir();  // Prevent the tmp data from being deleted too early
@@ -76,6 +83,14 @@ Filter::ApplyStencil (FArrayBox& dstfab, const FArrayBox& srcfab,
     const auto& dst = dstfab.array();
     const Box& gbx = amrex::grow(tbx,stencil_length_each_dir-1);
 
+    // If the source data already covers the grown box (e.g. filtering a fab
+    // whose guard cells have been filled beforehand), apply the stencil to it
+    // directly instead of going through a zero-padded temporary copy
+    if (srcfab.box().contains(gbx)) {
+        DoFilter(tbx, src, dst, scomp, dcomp, ncomp);
+        return;
+    }
+
     // tmpfab has enough ghost cells for the stencil
     FArrayBox tmp_fab(gbx,ncomp);
     Elixir tmp_eli = tmp_fab.elixir();  // Prevent the tmp data from being deleted too early
@@ -96,7 +111,13 @@ Filter::ApplyStencil (FArrayBox& dstfab, const FArrayBox& srcfab,
     DoFilter(tbx, tmp, dst, 0, dcomp, ncomp);
 }
 
-/* \brief Apply stencil (2D/3D, CPU/GPU)
+/* \brief Apply stencil (2D/3D, GPU)
+ *
+ * The stencil is separable (a tensor product of one 1D stencil per
+ * direction), so it is applied as successive 1D sweeps rather than by
+ * looping over the full multi-dimensional stencil at every point: the work
+ * per point drops from slen.x*slen.y*slen.z to slen.x+slen.y+slen.z
+ * coefficients, which matters for the wide composed multi-pass stencils.
  */
 void Filter::DoFilter (const Box& tbx,
                        Array4<Real const> const& tmp,
@@ -109,39 +130,65 @@ void Filter::DoFilter (const Box& tbx,
 #endif
     amrex::Real const* AMREX_RESTRICT sz = stencil_z.data();
     Dim3 slen_local = slen;
-    AMREX_PARALLEL_FOR_4D ( tbx, ncomp, i, j, k, n,
-    {
-        Real d = 0.0;
 
-        for         (int iz=0; iz < slen_local.z; ++iz){
-            for     (int iy=0; iy < slen_local.y; ++iy){
-                for (int ix=0; ix < slen_local.x; ++ix){
+    // Result of the sweep along x, on a box grown by the stencil extent
+    // in the directions that remain to be filtered
+    Box bx1 = tbx;
+    bx1.grow(1, slen.y-1);
 #if (AMREX_SPACEDIM == 3)
-                    Real sss = sx[ix]*sy[iy]*sz[iz];
-#else
-                    Real sss = sx[ix]*sz[iy];
+    bx1.grow(2, slen.z-1);
 #endif
+    FArrayBox tmp1_fab(bx1, ncomp);
+    Elixir tmp1_eli = tmp1_fab.elixir();
+    auto const& t1 = tmp1_fab.array();
+
+    // Sweep along x
+    AMREX_PARALLEL_FOR_4D ( bx1, ncomp, i, j, k, n,
+    {
+        Real d = 0.0;
+        for (int ix=0; ix < slen_local.x; ++ix){
+            d += sx[ix]*( tmp(i-ix,j,k,scomp+n) + tmp(i+ix,j,k,scomp+n) );
+        }
+        t1(i,j,k,n) = d;
+    });
+
 #if (AMREX_SPACEDIM == 3)
-                    d += sss*( tmp(i-ix,j-iy,k-iz,scomp+n)
-                              +tmp(i+ix,j-iy,k-iz,scomp+n)
-                              +tmp(i-ix,j+iy,k-iz,scomp+n)
-                              +tmp(i+ix,j+iy,k-iz,scomp+n)
-                              +tmp(i-ix,j-iy,k+iz,scomp+n)
-                              +tmp(i+ix,j-iy,k+iz,scomp+n)
-                              +tmp(i-ix,j+iy,k+iz,scomp+n)
-                              +tmp(i+ix,j+iy,k+iz,scomp+n));
-#else
-                    d += sss*( tmp(i-ix,j-iy,k,scomp+n)
-                              +tmp(i+ix,j-iy,k,scomp+n)
-                              +tmp(i-ix,j+iy,k,scomp+n)
-                              +tmp(i+ix,j+iy,k,scomp+n));
-#endif
-                }
-            }
+    Box bx2 = tbx;
+    bx2.grow(2, slen.z-1);
+    FArrayBox tmp2_fab(bx2, ncomp);
+    Elixir tmp2_eli = tmp2_fab.elixir();
+    auto const& t2 = tmp2_fab.array();
+
+    // Sweep along y
+    AMREX_PARALLEL_FOR_4D ( bx2, ncomp, i, j, k, n,
+    {
+        Real d = 0.0;
+        for (int iy=0; iy < slen_local.y; ++iy){
+            d += sy[iy]*( t1(i,j-iy,k,n) + t1(i,j+iy,k,n) );
         }
+        t2(i,j,k,n) = d;
+    });
 
+    // Sweep along z
+    AMREX_PARALLEL_FOR_4D ( tbx, ncomp, i, j, k, n,
+    {
+        Real d = 0.0;
+        for (int iz=0; iz < slen_local.z; ++iz){
+            d += sz[iz]*( t2(i,j,k-iz,n) + t2(i,j,k+iz,n) );
+        }
+        dst(i,j,k,dcomp+n) = d;
+    });
+#else
+    // Sweep along z (the second direction in 2D)
+    AMREX_PARALLEL_FOR_4D ( tbx, ncomp, i, j, k, n,
+    {
+        Real d = 0.0;
+        for (int iy=0; iy < slen_local.y; ++iy){
+            d += sz[iy]*( t1(i,j-iy,k,n) + t1(i,j+iy,k,n) );
+        }
         dst(i,j,k,dcomp+n) = d;
     });
+#endif
 }
 
 #else
@@ -168,6 +215,15 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, int
             auto& dstfab = dstmf[mfi];
             const Box& tbx = mfi.growntilebox();
             const Box& gbx = amrex::grow(tbx,stencil_length_each_dir-1);
+
+            // If the source data already covers the grown box, apply the
+            // stencil to it directly instead of going through a zero-padded
+            // temporary copy
+            if (srcfab.box().contains(gbx)) {
+                DoFilter(tbx, srcfab.array(), dstfab.array(), scomp, dcomp, ncomp);
+                continue;
+            }
+
             // tmpfab has enough ghost cells for the stencil
             tmpfab.resize(gbx,ncomp);
             tmpfab.setVal(0.0, gbx, 0, ncomp);
@@ -196,6 +252,15 @@ Filter::ApplyStencil (amrex::FArrayBox& dstfab, const amrex::FArrayBox& srcfab,
     ncomp = std::min(ncomp, srcfab.nComp());
     FArrayBox tmpfab;
     const Box& gbx = amrex::grow(tbx,stencil_length_each_dir-1);
+
+    // If the source data already covers the grown box (e.g. filtering a fab
+    // whose guard cells have been filled beforehand), apply the stencil to it
+    // directly instead of going through a zero-padded temporary copy
+    if (srcfab.box().contains(gbx)) {
+        DoFilter(tbx, srcfab.array(), dstfab.array(), scomp, dcomp, ncomp);
+        return;
+    }
+
     // tmpfab has enough ghost cells for the stencil
     tmpfab.resize(gbx,ncomp);
     tmpfab.setVal(0.0, gbx, 0, ncomp);
@@ -206,63 +271,109 @@ Filter::ApplyStencil (amrex::FArrayBox& dstfab, const amrex::FArrayBox& srcfab,
     DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
 }
 
+/* \brief Apply stencil (2D/3D, CPU)
+ *
+ * The stencil is separable (a tensor product of one 1D stencil per
+ * direction), so it is applied as successive 1D sweeps rather than by
+ * looping over the full multi-dimensional stencil at every point: the work
+ * per point drops from slen.x*slen.y*slen.z to slen.x+slen.y+slen.z
+ * coefficients, which matters for the wide composed multi-pass stencils.
+ */
 void Filter::DoFilter (const Box& tbx,
                        Array4<Real const> const& tmp,
                        Array4<Real      > const& dst,
                        int scomp, int dcomp, int ncomp)
 {
-    const auto lo = amrex::lbound(tbx);
-    const auto hi = amrex::ubound(tbx);
     // tmp and dst are of type Array4 (Fortran ordering)
     amrex::Real const* AMREX_RESTRICT sx = stencil_x.data();
 #if (AMREX_SPACEDIM == 3)
     amrex::Real const* AMREX_RESTRICT sy = stencil_y.data();
 #endif
     amrex::Real const* AMREX_RESTRICT sz = stencil_z.data();
+
+    // Result of the sweep along x, on a box grown by the stencil extent
+    // in the directions that remain to be filtered
+    Box bx1 = tbx;
+    bx1.grow(1, slen.y-1);
+#if (AMREX_SPACEDIM == 3)
+    bx1.grow(2, slen.z-1);
+#endif
+    FArrayBox tmp1_fab(bx1, ncomp);
+    auto const& t1 = tmp1_fab.array();
+#if (AMREX_SPACEDIM == 3)
+    Box bx2 = tbx;
+    bx2.grow(2, slen.z-1);
+    FArrayBox tmp2_fab(bx2, ncomp);
+    auto const& t2 = tmp2_fab.array();
+#endif
+
+    const auto lo = amrex::lbound(tbx);
+    const auto hi = amrex::ubound(tbx);
+    const auto lo1 = amrex::lbound(bx1);
+    const auto hi1 = amrex::ubound(bx1);
+
     for (int n = 0; n < ncomp; ++n) {
-        // Set dst value to 0.
+        // Sweep along x
+        for         (int k = lo1.z; k <= hi1.z; ++k) {
+            for     (int j = lo1.y; j <= hi1.y; ++j) {
+                AMREX_PRAGMA_SIMD
+                for (int i = lo1.x; i <= hi1.x; ++i) {
+                    Real d = 0.0;
+                    for (int ix=0; ix < slen.x; ++ix){
+                        d += sx[ix]*( tmp(i-ix,j,k,scomp+n)
+                                     +tmp(i+ix,j,k,scomp+n) );
+                    }
+                    t1(i,j,k,n) = d;
+                }
+            }
+        }
+#if (AMREX_SPACEDIM == 3)
+        // Sweep along y
+        const auto lo2 = amrex::lbound(bx2);
+        const auto hi2 = amrex::ubound(bx2);
+        for         (int k = lo2.z; k <= hi2.z; ++k) {
+            for     (int j = lo2.y; j <= hi2.y; ++j) {
+                AMREX_PRAGMA_SIMD
+                for (int i = lo2.x; i <= hi2.x; ++i) {
+                    Real d = 0.0;
+                    for (int iy=0; iy < slen.y; ++iy){
+                        d += sy[iy]*( t1(i,j-iy,k,n)
+                                     +t1(i,j+iy,k,n) );
+                    }
+                    t2(i,j,k,n) = d;
+                }
+            }
+        }
+        // Sweep along z
         for         (int k = lo.z; k <= hi.z; ++k) {
             for     (int j = lo.y; j <= hi.y; ++j) {
+                AMREX_PRAGMA_SIMD
                 for (int i = lo.x; i <= hi.x; ++i) {
-                    dst(i,j,k,dcomp+n) = 0.0;
+                    Real d = 0.0;
+                    for (int iz=0; iz < slen.z; ++iz){
+                        d += sz[iz]*( t2(i,j,k-iz,n)
+                                     +t2(i,j,k+iz,n) );
+                    }
+                    dst(i,j,k,dcomp+n) = d;
                 }
             }
         }
-        // 3 nested loop on 3D stencil
-        for         (int iz=0; iz < slen.z; ++iz){
-            for     (int iy=0; iy < slen.y; ++iy){
-                for (int ix=0; ix < slen.x; ++ix){
-#if (AMREX_SPACEDIM == 3)
-                    Real sss = sx[ix]*sy[iy]*sz[iz];
 #else
-                    Real sss = sx[ix]*sz[iy];
-#endif
-                    // 3 nested loop on 3D array
-                    for         (int k = lo.z; k <= hi.z; ++k) {
-                        for     (int j = lo.y; j <= hi.y; ++j) {
-                            AMREX_PRAGMA_SIMD
-                            for (int i = lo.x; i <= hi.x; ++i) {
-#if (AMREX_SPACEDIM == 3)
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-ix,j-iy,k-iz,scomp+n)
-                                                          +tmp(i+ix,j-iy,k-iz,scomp+n)
-                                                          +tmp(i-ix,j+iy,k-iz,scomp+n)
-                                                          +tmp(i+ix,j+iy,k-iz,scomp+n)
-                                                          +tmp(i-ix,j-iy,k+iz,scomp+n)
-                                                          +tmp(i+ix,j-iy,k+iz,scomp+n)
-                                                          +tmp(i-ix,j+iy,k+iz,scomp+n)
-                                                          +tmp(i+ix,j+iy,k+iz,scomp+n));
-#else
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-ix,j-iy,k,scomp+n)
-                                                          +tmp(i+ix,j-iy,k,scomp+n)
-                                                          +tmp(i-ix,j+iy,k,scomp+n)
-                                                          +tmp(i+ix,j+iy,k,scomp+n));
-#endif
-                            }
-                        }
+        // Sweep along z (the second direction in 2D)
+        for         (int k = lo.z; k <= hi.z; ++k) {
+            for     (int j = lo.y; j <= hi.y; ++j) {
+                AMREX_PRAGMA_SIMD
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    Real d = 0.0;
+                    for (int iy=0; iy < slen.y; ++iy){
+                        d += sz[iy]*( t1(i,j-iy,k,n)
+                                     +t1(i,j+iy,k,n) );
                     }
+                    dst(i,j,k,dcomp+n) = d;
                 }
             }
         }
+#endif
     }
 }
 
@@ -12,9 +12,23 @@
 #   include <omp.h>
 #endif
 
+#include <array>
+#include <map>
+#include <utility>
 
 using namespace amrex;
 
+namespace
+{
+    // Stencils already computed, keyed by (c*dt/dz, nodal_gather). Both
+    // coefficient sets (Ex_Ey_Bz and Bx_By_Ez) are computed together on a
+    // cache miss, so that the other filters built with the same parameters
+    // -- including all filters rebuilt after a regrid or a load balance --
+    // reuse the interpolated coefficients instead of redoing the table work.
+    std::map< std::pair<amrex::Real,bool>,
+              std::array<std::array<amrex::Real,5>,2> > godfrey_stencil_cache;
+}
+
 NCIGodfreyFilter::NCIGodfreyFilter(godfrey_coeff_set coeff_set, amrex::Real cdtodz, bool nodal_gather){
     // Store parameters into class data members
     m_coeff_set = coeff_set;
@@ -41,54 +55,68 @@ void NCIGodfreyFilter::ComputeStencils(){
 #endif
         "ERROR: NCI filter requires 5 points in z");
 
-    // Interpolate coefficients from the table, and store into prestencil.
-    auto index = static_cast<int>(tab_length*m_cdtodz);
-    index = min(index, tab_length-2);
-    index = max(index, 0);
-    Real weight_right = m_cdtodz - index/tab_length;
-    Real prestencil[4];
-
-    // read prestencil coefficients from table (the stencil is computed from
-    // these coefficients)
-    for(int i=0; i<tab_width; i++){
-        if (!m_nodal_gather)
-        {
-            // If gather from staggered grid, use coefficients for Galerkin gather
-            if        (m_coeff_set == godfrey_coeff_set::Ex_Ey_Bz){
-                // Set of coefficients for Ex, Ey and Bz
-                prestencil[i] = (1-weight_right)*table_nci_godfrey_galerkin_Ex_Ey_Bz[index  ][i] +
-                                    weight_right*table_nci_godfrey_galerkin_Ex_Ey_Bz[index+1][i];
-            } else if (m_coeff_set == godfrey_coeff_set::Bx_By_Ez){
-                // Set of coefficients for Bx, By and Ez
-                prestencil[i] = (1-weight_right)*table_nci_godfrey_galerkin_Bx_By_Ez[index  ][i] +
-                                    weight_right*table_nci_godfrey_galerkin_Bx_By_Ez[index+1][i];
-            } else {
-                amrex::Abort("m_coeff_set must be godfrey_coeff_set::Ex_Ey_Bz or godfrey_coeff_set::Bx_By_Ez");
+    if (m_coeff_set != godfrey_coeff_set::Ex_Ey_Bz &&
+        m_coeff_set != godfrey_coeff_set::Bx_By_Ez){
+        amrex::Abort("m_coeff_set must be godfrey_coeff_set::Ex_Ey_Bz or godfrey_coeff_set::Bx_By_Ez");
+    }
+
+    const auto key = std::make_pair(m_cdtodz, m_nodal_gather);
+    auto cached = godfrey_stencil_cache.find(key);
+    if (cached == godfrey_stencil_cache.end())
+    {
+        // Interpolate coefficients from the table, and store into prestencil.
+        auto index = static_cast<int>(tab_length*m_cdtodz);
+        index = min(index, tab_length-2);
+        index = max(index, 0);
+        Real weight_right = m_cdtodz - index/tab_length;
+
+        // Compute the stencils for both coefficient sets at once, so that
+        // the filter for the other set of fields finds them in the cache.
+        std::array<std::array<Real,5>,2> stencils;
+        for (int iset=0; iset<2; iset++){
+            // Select the table for this coefficient set (different fields
+            // require to read different coefficients from the table)
+            const Real (*table)[tab_width];
+            if (!m_nodal_gather)
+            {
+                // If gather from staggered grid, use coefficients for Galerkin gather
+                table = (iset == static_cast<int>(godfrey_coeff_set::Ex_Ey_Bz))
+                    ? table_nci_godfrey_galerkin_Ex_Ey_Bz
+                    : table_nci_godfrey_galerkin_Bx_By_Ez;
             }
-        }
-        else
-        {
-            // If gather from node-centered grid, use coefficients for momentum-conserving gather
-            if        (m_coeff_set == godfrey_coeff_set::Ex_Ey_Bz){
-                // Set of coefficients for Ex, Ey and Bz
-                prestencil[i] = (1-weight_right)*table_nci_godfrey_momentum_Ex_Ey_Bz[index  ][i] +
-                                    weight_right*table_nci_godfrey_momentum_Ex_Ey_Bz[index+1][i];
-            } else if (m_coeff_set == godfrey_coeff_set::Bx_By_Ez) {
-                // Set of coefficients for Bx, By and Ez
-                prestencil[i] = (1-weight_right)*table_nci_godfrey_momentum_Bx_By_Ez[index  ][i] +
-                                    weight_right*table_nci_godfrey_momentum_Bx_By_Ez[index+1][i];
-            } else {
-                amrex::Abort("m_coeff_set must be godfrey_coeff_set::Ex_Ey_Bz or godfrey_coeff_set::Bx_By_Ez");
+            else
+            {
+                // If gather from node-centered grid, use coefficients for momentum-conserving gather
+                table = (iset == static_cast<int>(godfrey_coeff_set::Ex_Ey_Bz))
+                    ? table_nci_godfrey_momentum_Ex_Ey_Bz
+                    : table_nci_godfrey_momentum_Bx_By_Ez;
             }
+
+            // read prestencil coefficients from table (the stencil is
+            // computed from these coefficients)
+            Real prestencil[4];
+            for(int i=0; i<tab_width; i++){
+                prestencil[i] = (1-weight_right)*table[index  ][i] +
+                                    weight_right*table[index+1][i];
+            }
+
+            // Compute the stencil along z
+            auto& sz = stencils[iset];
+            sz[0] =  (256 + 128*prestencil[0] + 96*prestencil[1] + 80*prestencil[2] + 70*prestencil[3]) / 256;
+            sz[1] = -(       64*prestencil[0] + 64*prestencil[1] + 60*prestencil[2] + 56*prestencil[3]) / 256;
+            sz[2] =  (                          16*prestencil[1] + 24*prestencil[2] + 28*prestencil[3]) / 256;
+            sz[3] = -(                                              4*prestencil[2] +  8*prestencil[3]) / 256;
+            sz[4] =  (                                                                 1*prestencil[3]) / 256;
         }
+        cached = godfrey_stencil_cache.emplace(key, stencils).first;
     }
-    // Compute stencil_z
+
+    // Copy the cached stencil into stencil_z
+    const auto& sz = cached->second[static_cast<int>(m_coeff_set)];
     stencil_z.resize( 5 );
-    stencil_z[0] =  (256 + 128*prestencil[0] + 96*prestencil[1] + 80*prestencil[2] + 70*prestencil[3]) / 256;
-    stencil_z[1] = -(       64*prestencil[0] + 64*prestencil[1] + 60*prestencil[2] + 56*prestencil[3]) / 256;
-    stencil_z[2] =  (                          16*prestencil[1] + 24*prestencil[2] + 28*prestencil[3]) / 256;
-    stencil_z[3] = -(                                              4*prestencil[2] +  8*prestencil[3]) / 256;
-    stencil_z[4] =  (                                                                 1*prestencil[3]) / 256;
+    for (int i=0; i<5; i++){
+        stencil_z[i] = sz[i];
+    }
 
     // Compute stencil_x and stencil_y (no filter in these directions,
     // so only 1 coeff, equal to 1)
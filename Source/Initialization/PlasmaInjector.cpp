@@ -404,7 +404,9 @@ void PlasmaInjector::parseMomentum (ParmParse& pp)
 
 XDim3 PlasmaInjector::getMomentum (Real x, Real y, Real z) const noexcept
 {
-    return inj_mom->getMomentum(x, y, z); // gamma*beta
+    // On the host, the engine simply forwards to the AMReX generator.
+    WarpXRandomEngine engine;
+    return inj_mom->getMomentum(x, y, z, engine); // gamma*beta
 }
 
 bool PlasmaInjector::insideBounds (Real x, Real y, Real z) const noexcept
@@ -14,7 +14,9 @@
 #include "Parser/GpuParser.H"
 #include "Utils/WarpXUtil.H"
 #include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXMemoryMonitor.H"
 
+#include <AMReX_Arena.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 
@@ -30,6 +32,23 @@ WarpX::InitData ()
 {
     WARPX_PROFILE("WarpX::InitData()");
 
+#ifdef AMREX_USE_GPU
+    if (staging_buffer_mb > 0) {
+        // Grow the device and pinned-memory pools once, to the expected
+        // high-water mark of the particle communication buffers (e.g. as
+        // read off a profile of a previous run). The pools are persistent,
+        // so the staging buffers used by Redistribute are then recycled
+        // across steps instead of being allocated and freed on the device
+        // at every step.
+        const std::size_t nbytes =
+            static_cast<std::size_t>(staging_buffer_mb) * 1024*1024;
+        void* device_buffer = amrex::The_Arena()->alloc(nbytes);
+        void* pinned_buffer = amrex::The_Pinned_Arena()->alloc(nbytes);
+        amrex::The_Arena()->free(device_buffer);
+        amrex::The_Pinned_Arena()->free(pinned_buffer);
+    }
+#endif
+
     if (restart_chkfile.empty())
     {
         ComputeDt();
@@ -37,6 +56,8 @@ WarpX::InitData ()
     }
     else
     {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!MemoryMonitor::DryRun(),
+            "warpx.dry_run_memory can only be used for a fresh start, not with a restart");
         InitFromCheckpoint();
         if (is_synchronized) {
             ComputeDt();
@@ -44,6 +65,14 @@ WarpX::InitData ()
         PostRestart();
     }
 
+    if (MemoryMonitor::DryRun()) {
+        // Print the predicted footprint and stop: nothing was allocated,
+        // so none of the initialization below can run (and Evolve
+        // returns immediately)
+        MemoryMonitor::PrintReport();
+        return;
+    }
+
     ComputePMLFactors();
 
     if (WarpX::use_fdtd_nci_corr) {
@@ -58,6 +87,9 @@ WarpX::InitData ()
 
     InitDiagnostics();
 
+    // Load or plan the kernel launch autotuning (warpx.do_kernel_autotune)
+    m_kernel_autotuner.InitData();
+
     if (ParallelDescriptor::IOProcessor()) {
         std::cout << "\nGrids Summary:\n";
         printGridSummary(std::cout, 0, finestLevel());
@@ -133,6 +165,11 @@ WarpX::InitFromScratch ()
 
     AmrCore::InitFromScratch(time);  // This will call MakeNewLevelFromScratch
 
+    // In the memory dry run the field footprint has been accounted but
+    // nothing has been allocated: stop here, before the particles are
+    // initialized (InitData prints the report and returns early)
+    if (MemoryMonitor::DryRun()) return;
+
     mypc->AllocData();
     mypc->InitData();
 
@@ -300,22 +337,23 @@ WarpX::InitLevelData (int lev, Real /*time*/)
     // provided in the input file.
     if (B_ext_grid_s == "parse_b_ext_grid_function") {
 
-#ifdef WARPX_DIM_RZ
-       amrex::Abort("E and B parser for external fields does not work with RZ -- TO DO");
-#endif
-       Store_parserString(pp, "Bx_external_grid_function(x,y,z)",
-                                                    str_Bx_ext_grid_function);
-       Store_parserString(pp, "By_external_grid_function(x,y,z)",
-                                                    str_By_ext_grid_function);
-       Store_parserString(pp, "Bz_external_grid_function(x,y,z)",
-                                                    str_Bz_ext_grid_function);
-
-       Bxfield_parser.reset(new ParserWrapper<3>(
-                                makeParser(str_Bx_ext_grid_function,{"x","y","z"})));
-       Byfield_parser.reset(new ParserWrapper<3>(
-                                makeParser(str_By_ext_grid_function,{"x","y","z"})));
-       Bzfield_parser.reset(new ParserWrapper<3>(
-                                makeParser(str_Bz_ext_grid_function,{"x","y","z"})));
+       // The parsed expressions do not depend on the level: build the
+       // parsers (and upload their evaluation tapes) only once
+       if (!Bxfield_parser) {
+           Store_parserString(pp, "Bx_external_grid_function(x,y,z)",
+                                                        str_Bx_ext_grid_function);
+           Store_parserString(pp, "By_external_grid_function(x,y,z)",
+                                                        str_By_ext_grid_function);
+           Store_parserString(pp, "Bz_external_grid_function(x,y,z)",
+                                                        str_Bz_ext_grid_function);
+
+           Bxfield_parser.reset(new ParserWrapper<3>(
+                                    makeParser(str_Bx_ext_grid_function,{"x","y","z"})));
+           Byfield_parser.reset(new ParserWrapper<3>(
+                                    makeParser(str_By_ext_grid_function,{"x","y","z"})));
+           Bzfield_parser.reset(new ParserWrapper<3>(
+                                    makeParser(str_Bz_ext_grid_function,{"x","y","z"})));
+       }
 
        // Initialize Bfield_fp with external function
        InitializeExternalFieldsOnGridUsingParser(Bfield_fp[lev][0].get(),
@@ -352,22 +390,23 @@ WarpX::InitLevelData (int lev, Real /*time*/)
     // provided in the input file.
     if (E_ext_grid_s == "parse_e_ext_grid_function") {
 
-#ifdef WARPX_DIM_RZ
-       amrex::Abort("E and B parser for external fields does not work with RZ -- TO DO");
-#endif
-       Store_parserString(pp, "Ex_external_grid_function(x,y,z)",
-                                                    str_Ex_ext_grid_function);
-       Store_parserString(pp, "Ey_external_grid_function(x,y,z)",
-                                                    str_Ey_ext_grid_function);
-       Store_parserString(pp, "Ez_external_grid_function(x,y,z)",
-                                                    str_Ez_ext_grid_function);
-
-       Exfield_parser.reset(new ParserWrapper<3>(
-                                makeParser(str_Ex_ext_grid_function,{"x","y","z"})));
-       Eyfield_parser.reset(new ParserWrapper<3>(
-                                makeParser(str_Ey_ext_grid_function,{"x","y","z"})));
-       Ezfield_parser.reset(new ParserWrapper<3>(
-                                makeParser(str_Ez_ext_grid_function,{"x","y","z"})));
+       // The parsed expressions do not depend on the level: build the
+       // parsers (and upload their evaluation tapes) only once
+       if (!Exfield_parser) {
+           Store_parserString(pp, "Ex_external_grid_function(x,y,z)",
+                                                        str_Ex_ext_grid_function);
+           Store_parserString(pp, "Ey_external_grid_function(x,y,z)",
+                                                        str_Ey_ext_grid_function);
+           Store_parserString(pp, "Ez_external_grid_function(x,y,z)",
+                                                        str_Ez_ext_grid_function);
+
+           Exfield_parser.reset(new ParserWrapper<3>(
+                                    makeParser(str_Ex_ext_grid_function,{"x","y","z"})));
+           Eyfield_parser.reset(new ParserWrapper<3>(
+                                    makeParser(str_Ey_ext_grid_function,{"x","y","z"})));
+           Ezfield_parser.reset(new ParserWrapper<3>(
+                                    makeParser(str_Ez_ext_grid_function,{"x","y","z"})));
+       }
 
        // Initialize Efield_fp with external function
        InitializeExternalFieldsOnGridUsingParser(Efield_fp[lev][0].get(),
@@ -433,6 +472,16 @@ WarpX::InitializeExternalFieldsOnGridUsingParser (
 
     const auto dx_lev = geom[lev].CellSizeArray();
     const RealBox& real_box = geom[lev].ProbDomain();
+#ifdef WARPX_DIM_RZ
+    // In RZ the expressions are evaluated at theta = 0 (x = r, y = 0):
+    // the external field is assumed to be axisymmetric, so the kernels
+    // below fill only the mode-0 component and the higher azimuthal
+    // modes are zeroed here. At theta = 0, "Ex" is the radial and "Ey"
+    // the azimuthal component.
+    mfx->setVal(0.0);
+    mfy->setVal(0.0);
+    mfz->setVal(0.0);
+#endif
     for ( MFIter mfi(*mfx, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
        const Box& tbx = convert(mfi.growntilebox(),x_nodal_flag);
@@ -386,7 +386,8 @@ LaserParticleContainer::Evolve (int lev,
                                 MultiFab* rho, MultiFab* crho,
                                 const MultiFab*, const MultiFab*, const MultiFab*,
                                 const MultiFab*, const MultiFab*, const MultiFab*,
-                                Real t, Real dt, DtType /*a_dt_type*/)
+                                Real t, Real dt, DtType /*a_dt_type*/,
+                                const GatherContext* /*a_gather_ctx*/)
 {
     WARPX_PROFILE("Laser::Evolve()");
     WARPX_PROFILE_VAR_NS("Laser::Evolve::Copy", blp_copy);
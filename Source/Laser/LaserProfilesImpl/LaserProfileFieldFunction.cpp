@@ -44,7 +44,5 @@ WarpXLaserProfiles::FieldFunctionLaserProfile::fill_amplitude (
     const int np, Real const * AMREX_RESTRICT const Xp, Real const * AMREX_RESTRICT const Yp,
     Real t, Real * AMREX_RESTRICT const amplitude) const
 {
-    for (int i = 0; i < np; ++i) {
-        amplitude[i] = m_parser.eval(Xp[i], Yp[i], t);
-    }
+    m_parser.eval(np, Xp, Yp, t, amplitude);
 }
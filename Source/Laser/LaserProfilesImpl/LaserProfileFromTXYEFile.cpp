@@ -52,10 +52,31 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::init (
         Abort("Error! time_chunk_size must be >= 2!");
     }
 
-    //Allocate memory for E_data Vector
+    //Allocate memory for the field data
     const int data_size = m_params.time_chunk_size*
             m_params.nx*m_params.ny;
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    //Keep a single copy of the field data per node, in an MPI shared memory
+    //window. The first rank of each node reads its data chunks directly from
+    //the file, while the other ranks of the node only read from the window.
+    MPI_Comm_split_type(ParallelDescriptor::Communicator(),
+        MPI_COMM_TYPE_SHARED, ParallelDescriptor::MyProc(),
+        MPI_INFO_NULL, &m_node_comm);
+    MPI_Comm_rank(m_node_comm, &m_node_rank);
+    const MPI_Aint win_size = (m_node_rank == 0) ?
+        static_cast<MPI_Aint>(data_size)*sizeof(amrex::Real) : 0;
+    void* baseptr = nullptr;
+    MPI_Win_allocate_shared(win_size, sizeof(amrex::Real),
+        MPI_INFO_NULL, m_node_comm, &baseptr, &m_e_data_win);
+    if(m_node_rank != 0){
+        MPI_Aint sz; int disp;
+        MPI_Win_shared_query(m_e_data_win, 0, &sz, &disp, &baseptr);
+    }
+    m_e_data_shared = static_cast<amrex::Real*>(baseptr);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, m_e_data_win);
+#else
     m_params.E_data = Gpu::ManagedVector<amrex::Real>(data_size);
+#endif
 
     //Read first time chunck
     read_data_t_chuck(0, m_params.time_chunk_size);
@@ -64,6 +85,19 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::init (
     m_common_params = params;
 }
 
+WarpXLaserProfiles::FromTXYEFileLaserProfile::~FromTXYEFileLaserProfile ()
+{
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    if(m_e_data_win != MPI_WIN_NULL){
+        MPI_Win_unlock_all(m_e_data_win);
+        MPI_Win_free(&m_e_data_win);
+    }
+    if(m_node_comm != MPI_COMM_NULL){
+        MPI_Comm_free(&m_node_comm);
+    }
+#endif
+}
+
 void
 WarpXLaserProfiles::FromTXYEFileLaserProfile::update (amrex::Real t)
 {
@@ -76,7 +110,27 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::update (amrex::Real t)
 
     //Load data chunck if needed
     if(idx_t_right >  m_params.last_time_index){
-        read_data_t_chuck(idx_t_left, idx_t_left+m_params.time_chunk_size);
+        if(m_prefetch_active && idx_t_left == m_prefetch_i_first){
+            //The chunk has already been read in the background
+            commit_prefetch_t_chuck();
+        }
+        else{
+            //Discard a stale prefetch (if any) and read synchronously
+            if(m_prefetch_active){
+                if(is_data_reader())
+                    m_prefetch_future.wait();
+                m_prefetch_active = false;
+            }
+            read_data_t_chuck(idx_t_left, idx_t_left+m_params.time_chunk_size);
+        }
+    }
+    else if(idx_t_right == m_params.last_time_index &&
+        !m_prefetch_active &&
+        m_params.last_time_index < m_params.nt-1){
+        //The simulation is about to cross the end of the current chunk:
+        //start reading the next chunk in the background.
+        start_prefetch_t_chuck(m_params.last_time_index,
+            m_params.last_time_index + m_params.time_chunk_size);
     }
 }
 
@@ -254,10 +308,10 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::read_data_t_chuck(int t_begin, int
     //Indices of the first and last timestep to read
     auto i_first = max(0, t_begin);
     auto i_last = min(t_end-1, m_params.nt-1);
-    if(i_last-i_first+1 > m_params.E_data.size())
+    if(i_last-i_first+1 > m_params.time_chunk_size)
         Abort("Data chunk to read from file is too large");
 
-    if(ParallelDescriptor::IOProcessor()){
+    if(is_data_reader()){
         //Read data chunk
         std::ifstream inp(m_params.txye_file_name, std::ios::binary);
         if(!inp) Abort("Failed to open txye file");
@@ -274,18 +328,128 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::read_data_t_chuck(int t_begin, int
         Vector<double> buf_e(read_size);
         inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), read_size*sizeof(double));
         if(!inp) Abort("Failed to read field data from txye file");
-        std::transform(buf_e.begin(), buf_e.end(), m_params.E_data.begin(),
+        std::transform(buf_e.begin(), buf_e.end(), e_data_write_ptr(),
             [](auto x) {return static_cast<amrex::Real>(x);} );
     }
 
+    //Make the chunk visible to all ranks
+    publish_e_data();
+
+    //Update first and last indices
+    m_params.first_time_index = i_first;
+    m_params.last_time_index = i_last;
+}
+
+bool
+WarpXLaserProfiles::FromTXYEFileLaserProfile::is_data_reader () const
+{
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    return m_node_rank == 0;
+#else
+    return ParallelDescriptor::IOProcessor();
+#endif
+}
+
+void
+WarpXLaserProfiles::FromTXYEFileLaserProfile::publish_e_data ()
+{
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    //Each node reader has filled its own node's copy: only memory ordering
+    //within the node is needed (unified memory model pattern for shared
+    //memory windows).
+    MPI_Win_sync(m_e_data_win);
+    MPI_Barrier(m_node_comm);
+    MPI_Win_sync(m_e_data_win);
+#else
     //Broadcast E_data
     ParallelDescriptor::Bcast(m_params.E_data.dataPtr(),
         m_params.E_data.size(), ParallelDescriptor::IOProcessorNumber());
     ParallelDescriptor::Barrier();
+#endif
+}
+
+amrex::Real*
+WarpXLaserProfiles::FromTXYEFileLaserProfile::e_data_write_ptr ()
+{
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    return m_e_data_shared;
+#else
+    return m_params.E_data.dataPtr();
+#endif
+}
+
+const amrex::Real*
+WarpXLaserProfiles::FromTXYEFileLaserProfile::e_data_ptr () const
+{
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    return m_e_data_shared;
+#else
+    return m_params.E_data.dataPtr();
+#endif
+}
+
+void
+WarpXLaserProfiles::FromTXYEFileLaserProfile::start_prefetch_t_chuck(int t_begin, int t_end)
+{
+    //Indices of the first and last timestep to read
+    m_prefetch_i_first = max(0, t_begin);
+    m_prefetch_i_last = min(t_end-1, m_params.nt-1);
+    if(m_prefetch_i_last-m_prefetch_i_first+1 > m_params.time_chunk_size)
+        Abort("Data chunk to read from file is too large");
+
+    m_prefetch_active = true;
+
+    //Only the reader ranks open the file. The background task performs
+    //file I/O exclusively: no MPI calls are made from the thread.
+    if(!is_data_reader())
+        return;
+
+    const int read_size = (m_prefetch_i_last - m_prefetch_i_first + 1)*
+        m_params.nx*m_params.ny;
+    m_prefetch_buf.resize(read_size);
+    const auto skip_amount = 1 +
+        3*sizeof(uint32_t) +
+        m_params.t_coords.size()*sizeof(double) +
+        m_params.x_coords.size()*sizeof(double) +
+        m_params.y_coords.size()*sizeof(double) +
+        sizeof(double)*t_begin*m_params.nx*m_params.ny;
+    const auto file_name = m_params.txye_file_name;
+    double* const p_buf = m_prefetch_buf.dataPtr();
+
+    m_prefetch_future = std::async(std::launch::async,
+        [file_name, skip_amount, read_size, p_buf](){
+            std::ifstream inp(file_name, std::ios::binary);
+            if(!inp) Abort("Failed to open txye file");
+            inp.ignore(skip_amount);
+            if(!inp) Abort("Failed to read field data from txye file");
+            inp.read(reinterpret_cast<char*>(p_buf), read_size*sizeof(double));
+            if(!inp) Abort("Failed to read field data from txye file");
+        });
+}
+
+void
+WarpXLaserProfiles::FromTXYEFileLaserProfile::commit_prefetch_t_chuck()
+{
+    amrex::Print() <<
+        "Using prefetched [" << m_prefetch_i_first << ", " <<
+        m_prefetch_i_last+1 << ") data chunk from " <<
+        m_params.txye_file_name << "\n";
+
+    if(is_data_reader()){
+        //Wait for the background read and convert from double to amrex::Real
+        m_prefetch_future.get();
+        std::transform(m_prefetch_buf.begin(), m_prefetch_buf.end(),
+            e_data_write_ptr(),
+            [](auto x) {return static_cast<amrex::Real>(x);} );
+    }
+
+    //Make the chunk visible to all ranks
+    publish_e_data();
 
     //Update first and last indices
-    m_params.first_time_index = i_first;
-    m_params.last_time_index = i_last;
+    m_params.first_time_index = m_prefetch_i_first;
+    m_params.last_time_index = m_prefetch_i_last;
+    m_prefetch_active = false;
 }
 
 void
@@ -308,7 +472,7 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_uniform(
 #if (AMREX_SPACEDIM == 3)
     const auto tmp_ny = m_params.ny;
 #endif
-    const auto p_E_data = m_params.E_data.dataPtr();
+    const auto p_E_data = e_data_ptr();
     const auto tmp_idx_first_time = m_params.first_time_index;
     const int idx_t_right = idx_t_left+1;
     const auto t_left = idx_t_left*
@@ -416,7 +580,7 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_nonuniform
     const auto p_y_coords = m_params.y_coords.dataPtr();
     const int tmp_y_coords_size = static_cast<int>(m_params.y_coords.size());
 #endif
-    const auto p_E_data = m_params.E_data.dataPtr();
+    const auto p_E_data = e_data_ptr();
     const auto tmp_idx_first_time = m_params.first_time_index;
     const int idx_t_right = idx_t_left+1;
     const auto t_left = m_params.t_coords[idx_t_left];
@@ -0,0 +1,86 @@
+/* Copyright 2020 Maxence Thevenet, Michael Rowan
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CommTrace.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+int CommTrace::m_enabled = 0;
+Real CommTrace::m_seconds[CommTrace::nphases] = {0.};
+long CommTrace::m_bytes[CommTrace::nphases] = {0};
+
+Real
+CommTrace::Start ()
+{
+    if (!m_enabled) return 0.;
+    // Do not count pending kernels of the compute phase as
+    // communication time
+    Gpu::synchronize();
+    return amrex::second();
+}
+
+void
+CommTrace::Record (Phase phase, const Real t_start, const long bytes)
+{
+    if (!m_enabled) return;
+    Gpu::synchronize();
+    m_seconds[phase] += amrex::second() - t_start;
+    m_bytes[phase] += bytes;
+}
+
+long
+CommTrace::GuardBytes (const MultiFab& mf, const IntVect& ng)
+{
+    // Guard points of the boxes owned by this rank: an estimate (not a
+    // count of the posted messages) that scales like the data volume
+    // this rank receives
+    long npts = 0;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx = mfi.validbox();
+        npts += amrex::grow(vbx, ng).numPts() - vbx.numPts();
+    }
+    return npts * mf.nComp() * static_cast<long>(sizeof(Real));
+}
+
+long
+CommTrace::GuardBytes (const std::array<std::unique_ptr<MultiFab>,3>& mf,
+                       const IntVect& ng)
+{
+    return GuardBytes(*mf[0], ng) + GuardBytes(*mf[1], ng)
+         + GuardBytes(*mf[2], ng);
+}
+
+void
+CommTrace::FetchAndReset (std::vector<Real>& data)
+{
+    data.resize(2*nphases);
+    for (int i = 0; i < nphases; ++i)
+    {
+        data[i] = m_seconds[i];
+        data[nphases+i] = static_cast<Real>(m_bytes[i]);
+        m_seconds[i] = 0.;
+        m_bytes[i] = 0;
+    }
+}
+
+std::string
+CommTrace::PhaseName (int phase)
+{
+    switch (phase)
+    {
+        case FillBoundaryE_post: return "FillBoundaryE_post";
+        case FillBoundaryE_wait: return "FillBoundaryE_wait";
+        case FillBoundaryB_post: return "FillBoundaryB_post";
+        case FillBoundaryB_wait: return "FillBoundaryB_wait";
+        case FillBoundaryEB_wait: return "FillBoundaryEB";
+        case SyncCurrent_wait: return "SyncCurrent";
+        default: return "unknown";
+    }
+}
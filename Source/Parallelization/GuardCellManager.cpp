@@ -43,19 +43,37 @@ guardCellManager::Init(
       ngz_tmp += 1;
     }
 
+    // With warpx.minimal_guard_cells, only allocate the guard cells that
+    // the enabled algorithms actually require, per direction: the
+    // moving-window widening is restricted to the window direction, and
+    // the rounding to even numbers is skipped in single-level runs.
+    // Guard cells are a large fraction of the field memory on small
+    // boxes, and most of the uniform maxima below are direction-specific
+    // in reality. Off by default (the conservative uniform maxima are
+    // kept), and ignored with warpx.safe_guard_cells.
+    bool minimal_guard_cells = false;
+    ParmParse pp_warpx("warpx");
+    pp_warpx.query("minimal_guard_cells", minimal_guard_cells);
+    if (safe_guard_cells) minimal_guard_cells = false;
+
     // Ex, Ey, Ez, Bx, By, and Bz have the same number of ghost cells.
     // jx, jy, jz and rho have the same number of ghost cells.
     // E and B have the same number of ghost cells as j and rho if NCI filter is not used,
     // but different number of ghost cells in z-direction if NCI filter is used.
     // The number of cells should be even, in order to easily perform the
-    // interpolation from coarse grid to fine grid.
-    int ngx = (ngx_tmp % 2) ? ngx_tmp+1 : ngx_tmp;  // Always even number
-    int ngy = (ngy_tmp % 2) ? ngy_tmp+1 : ngy_tmp;  // Always even number
-    int ngz_nonci = (ngz_tmp % 2) ? ngz_tmp+1 : ngz_tmp;  // Always even number
+    // interpolation from coarse grid to fine grid. This is only needed
+    // with mesh refinement: the minimal-guard analysis keeps the odd
+    // values in single-level runs.
+    const bool round_to_even = !(minimal_guard_cells && max_level == 0);
+    auto even = [round_to_even](int ng) {
+        return (round_to_even && ng % 2) ? ng+1 : ng;
+    };
+    int ngx = even(ngx_tmp);
+    int ngy = even(ngy_tmp);
+    int ngz_nonci = even(ngz_tmp);
     int ngz;
     if (do_fdtd_nci_corr) {
-        int ng = ngz_tmp + nci_corr_stencil;
-        ngz = (ng % 2) ? ng+1 : ng;
+        ngz = even(ngz_tmp + nci_corr_stencil);
     } else {
         ngz = ngz_nonci;
     }
@@ -66,18 +84,6 @@ guardCellManager::Init(
     int ngJy = ngy_tmp;
     int ngJz = ngz_tmp;
 
-    // When calling the moving window (with one level of refinement),  we shift
-    // the fine grid by 2 cells ; therefore, we need at least 2 guard cells
-    // on level 1. This may not be necessary for level 0.
-    if (do_moving_window) {
-        ngx = std::max(ngx,2);
-        ngy = std::max(ngy,2);
-        ngz = std::max(ngz,2);
-        ngJx = std::max(ngJx,2);
-        ngJy = std::max(ngJy,2);
-        ngJz = std::max(ngJz,2);
-    }
-
 #if (AMREX_SPACEDIM == 3)
     ng_alloc_EB = IntVect(ngx,ngy,ngz);
     ng_alloc_J = IntVect(ngJx,ngJy,ngJz);
@@ -86,6 +92,18 @@ guardCellManager::Init(
     ng_alloc_J = IntVect(ngJx,ngJz);
 #endif
 
+    // When calling the moving window (with one level of refinement),  we shift
+    // the fine grid by 2 cells ; therefore, we need at least 2 guard cells
+    // on level 1. This may not be necessary for level 0.
+    if (do_moving_window) {
+        for (int i_dim = 0; i_dim < AMREX_SPACEDIM; ++i_dim) {
+            // The shift only happens along the moving window direction
+            if (minimal_guard_cells && i_dim != moving_window_dir) continue;
+            ng_alloc_EB[i_dim] = std::max(ng_alloc_EB[i_dim],2);
+            ng_alloc_J[i_dim] = std::max(ng_alloc_J[i_dim],2);
+        }
+    }
+
     ng_alloc_Rho = ng_alloc_J+1; //One extra ghost cell, so that it's safe to deposit charge density
     // after pushing particle.
     int ng_alloc_F_int = (do_moving_window) ? 2 : 0;
@@ -136,6 +154,23 @@ guardCellManager::Init(
 #ifdef WARPX_USE_PSATD
     ng_FieldSolver = ng_alloc_EB;
     ng_FieldSolverF = ng_alloc_EB;
+    // The spectral solver can exchange fewer guard cells than allocated
+    // (psatd.nx_comm_guard etc.), in order to reduce the communication
+    // volume: the non-exchanged outer guard cells are then zeroed before
+    // the field solve (see WarpX::PushPSATD), which windows the local
+    // FFTs to the exchanged region. The resulting truncation error is
+    // bounded by the decay of the finite-order spectral stencil.
+    // (Ignored when running with `warpx.safe_guard_cells`.)
+    IntVect ng_comm = ng_FieldSolver;
+    pp.query("nx_comm_guard", ng_comm[0]);
+#if (AMREX_SPACEDIM == 3)
+    pp.query("ny_comm_guard", ng_comm[1]);
+    pp.query("nz_comm_guard", ng_comm[2]);
+#else
+    pp.query("nz_comm_guard", ng_comm[1]);
+#endif
+    ng_FieldSolver = ng_comm.min(ng_FieldSolver);
+    ng_FieldSolverF = ng_FieldSolver;
 #else
     ng_FieldSolver = IntVect(AMREX_D_DECL(1,1,1));
     ng_FieldSolverF = IntVect(AMREX_D_DECL(1,1,1));
@@ -143,11 +178,14 @@ guardCellManager::Init(
 
     if (safe_guard_cells){
         // Run in safe mode: exchange all allocated guard cells at each
-        // call of FillBoundary
+        // call of FillBoundary, and sum all allocated guard cells of the
+        // sources J and Rho
         ng_FieldSolver = ng_alloc_EB;
         ng_FieldSolverF = ng_alloc_F;
         ng_FieldGather = ng_alloc_EB;
         ng_UpdateAux = ng_alloc_EB;
+        ng_depos_J = ng_alloc_J;
+        ng_depos_rho = ng_alloc_Rho;
         if (do_moving_window){
             ng_MovingWindow = ng_alloc_EB;
         }
@@ -175,6 +213,31 @@ guardCellManager::Init(
         // Not sure why there is a 2* here...
         ng_UpdateAux = 2*ng_FieldGather_noNCI + ng_NCIFilter;
 
+        // Compute the number of guard cells that the deposition can write
+        // into. The particles deposit after being pushed (but before being
+        // redistributed), so they can be up to one cell outside of the
+        // valid box (one more with subcycling, and one more with the
+        // Galilean algorithm). The shape factor then extends at most
+        // DepCell[nox] cells away from the cell that contains the particle,
+        // and the charge-conserving (Esirkepov) current deposition uses a
+        // shifted shape factor that reaches one more cell. Only these cells
+        // carry deposited charge/current and need to be summed across boxes
+        // (the remaining allocated guard cells of J and Rho are zero).
+        int DepCell[4] = {0,1,2,2}; // Index is nox
+        int n_cells_pushed = (max_level > 0 && do_subcycling == 1) ? 2 : 1;
+        if ((v_galilean[0]!=0) or (v_galilean[1]!=0) or (v_galilean[2]!=0)){
+            n_cells_pushed += 1;
+        }
+        ng_depos_J = IntVect(AMREX_D_DECL(n_cells_pushed + DepCell[nox] + 1,
+                                          n_cells_pushed + DepCell[nox] + 1,
+                                          n_cells_pushed + DepCell[nox] + 1));
+        ng_depos_rho = IntVect(AMREX_D_DECL(n_cells_pushed + DepCell[nox],
+                                            n_cells_pushed + DepCell[nox],
+                                            n_cells_pushed + DepCell[nox]));
+        // Make sure we do not sum more guard cells than allocated.
+        ng_depos_J = ng_depos_J.min(ng_alloc_J);
+        ng_depos_rho = ng_depos_rho.min(ng_alloc_Rho);
+
         // Make sure we do not exchange more guard cells than allocated.
         ng_FieldGather = ng_FieldGather.min(ng_alloc_EB);
         ng_UpdateAux = ng_UpdateAux.min(ng_alloc_EB);
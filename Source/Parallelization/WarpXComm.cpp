@@ -8,11 +8,14 @@
  */
 #include "WarpXComm.H"
 #include "WarpXComm_K.H"
+#include "CommTrace.H"
 #include "WarpX.H"
 #include "WarpXSumGuardCells.H"
 #include "InterpolateCurrentFineToCoarse.H"
 #include "InterpolateDensityFineToCoarse.H"
 
+#include <AMReX_ParallelReduce.H>
+
 #include <algorithm>
 #include <cstdlib>
 
@@ -62,6 +65,10 @@ WarpX::UpdateAuxilaryData ()
     WARPX_PROFILE("UpdateAuxilaryData()");
 
     if (Bfield_aux[0][0]->ixType() == Bfield_fp[0][0]->ixType()) {
+        // At level 0 the aux MultiFabs are aliases of the fine patch
+        // (see AllocLevelMFs), so without mesh refinement there is
+        // nothing to update
+        if (finest_level == 0) return;
         UpdateAuxilaryDataSameType();
     } else {
         UpdateAuxilaryDataStagToNodal();
@@ -357,8 +364,14 @@ WarpX::FillBoundaryF (IntVect ng)
 void
 WarpX::FillBoundaryE(int lev, IntVect ng, IntVect ng_extra_fine)
 {
+    const Real trace_t = CommTrace::Start();
     FillBoundaryE(lev, PatchType::fine, ng+ng_extra_fine);
     if (lev > 0) FillBoundaryE(lev, PatchType::coarse, ng);
+    if (CommTrace::Enabled()) {
+        long bytes = CommTrace::GuardBytes(Efield_fp[lev], ng+ng_extra_fine);
+        if (lev > 0) bytes += CommTrace::GuardBytes(Efield_cp[lev], ng);
+        CommTrace::Record(CommTrace::FillBoundaryE_wait, trace_t, bytes);
+    }
 }
 
 void
@@ -419,8 +432,14 @@ WarpX::FillBoundaryE (int lev, PatchType patch_type, IntVect ng)
 void
 WarpX::FillBoundaryB (int lev, IntVect ng, IntVect ng_extra_fine)
 {
+    const Real trace_t = CommTrace::Start();
     FillBoundaryB(lev, PatchType::fine, ng + ng_extra_fine);
     if (lev > 0) FillBoundaryB(lev, PatchType::coarse, ng);
+    if (CommTrace::Enabled()) {
+        long bytes = CommTrace::GuardBytes(Bfield_fp[lev], ng+ng_extra_fine);
+        if (lev > 0) bytes += CommTrace::GuardBytes(Bfield_cp[lev], ng);
+        CommTrace::Record(CommTrace::FillBoundaryB_wait, trace_t, bytes);
+    }
 }
 
 void
@@ -476,6 +495,206 @@ WarpX::FillBoundaryB (int lev, PatchType patch_type, IntVect ng)
     }
 }
 
+void
+WarpX::FillBoundaryEB (IntVect ng, IntVect ng_extra_fine)
+{
+    const Real trace_t = CommTrace::Start();
+    long bytes = 0;
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryEB(lev, PatchType::fine, ng+ng_extra_fine);
+        if (lev > 0) FillBoundaryEB(lev, PatchType::coarse, ng);
+        if (CommTrace::Enabled()) {
+            bytes += CommTrace::GuardBytes(Efield_fp[lev], ng+ng_extra_fine)
+                   + CommTrace::GuardBytes(Bfield_fp[lev], ng+ng_extra_fine);
+            if (lev > 0) {
+                bytes += CommTrace::GuardBytes(Efield_cp[lev], ng)
+                       + CommTrace::GuardBytes(Bfield_cp[lev], ng);
+            }
+        }
+    }
+    CommTrace::Record(CommTrace::FillBoundaryEB_wait, trace_t, bytes);
+}
+
+void
+WarpX::FillBoundaryEB (int lev, PatchType patch_type, IntVect ng)
+{
+    // Aggregated exchange: the guard cell exchanges of all six E and B
+    // components are posted together and completed together, so that a
+    // single exchange phase (one round of message latencies, paid
+    // concurrently) covers all components, instead of six consecutive
+    // blocking FillBoundary operations.
+    const auto& efield = (patch_type == PatchType::fine) ?
+        Efield_fp[lev] : Efield_cp[lev];
+    const auto& bfield = (patch_type == PatchType::fine) ?
+        Bfield_fp[lev] : Bfield_cp[lev];
+
+    if (do_pml && pml[lev]->ok())
+    {
+        pml[lev]->ExchangeE(patch_type,
+                            { efield[0].get(),
+                              efield[1].get(),
+                              efield[2].get() },
+                            do_pml_in_domain);
+        pml[lev]->FillBoundaryE(patch_type);
+        pml[lev]->ExchangeB(patch_type,
+                            { bfield[0].get(),
+                              bfield[1].get(),
+                              bfield[2].get() },
+                            do_pml_in_domain);
+        pml[lev]->FillBoundaryB(patch_type);
+    }
+
+    const int period_level = (patch_type == PatchType::fine) ? lev : lev-1;
+    const auto& period = Geom(period_level).periodicity();
+    Vector<MultiFab*> mf{efield[0].get(), efield[1].get(), efield[2].get(),
+                         bfield[0].get(), bfield[1].get(), bfield[2].get()};
+    if ( safe_guard_cells ) {
+        amrex::FillBoundary(mf, period);
+    } else {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng <= efield[0]->nGrowVect() && ng <= bfield[0]->nGrowVect(),
+            "Error: in FillBoundaryEB, requested more guard cells than allocated");
+        for (MultiFab* f : mf) {
+            f->FillBoundary_nowait(ng, period);
+        }
+        for (MultiFab* f : mf) {
+            f->FillBoundary_finish();
+        }
+    }
+}
+
+void
+WarpX::FillBoundaryE_nowait (IntVect ng)
+{
+    const Real trace_t = CommTrace::Start();
+    long bytes = 0;
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryE_nowait(lev, PatchType::fine, ng);
+        if (lev > 0) FillBoundaryE_nowait(lev, PatchType::coarse, ng);
+        if (CommTrace::Enabled()) {
+            bytes += CommTrace::GuardBytes(Efield_fp[lev], ng);
+            if (lev > 0) bytes += CommTrace::GuardBytes(Efield_cp[lev], ng);
+        }
+    }
+    CommTrace::Record(CommTrace::FillBoundaryE_post, trace_t, bytes);
+}
+
+void
+WarpX::FillBoundaryE_finish ()
+{
+    const Real trace_t = CommTrace::Start();
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryE_finish(lev, PatchType::fine);
+        if (lev > 0) FillBoundaryE_finish(lev, PatchType::coarse);
+    }
+    // the volume is counted by the matching post
+    CommTrace::Record(CommTrace::FillBoundaryE_wait, trace_t, 0);
+}
+
+void
+WarpX::FillBoundaryB_nowait (IntVect ng)
+{
+    const Real trace_t = CommTrace::Start();
+    long bytes = 0;
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryB_nowait(lev, PatchType::fine, ng);
+        if (lev > 0) FillBoundaryB_nowait(lev, PatchType::coarse, ng);
+        if (CommTrace::Enabled()) {
+            bytes += CommTrace::GuardBytes(Bfield_fp[lev], ng);
+            if (lev > 0) bytes += CommTrace::GuardBytes(Bfield_cp[lev], ng);
+        }
+    }
+    CommTrace::Record(CommTrace::FillBoundaryB_post, trace_t, bytes);
+}
+
+void
+WarpX::FillBoundaryB_finish ()
+{
+    const Real trace_t = CommTrace::Start();
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryB_finish(lev, PatchType::fine);
+        if (lev > 0) FillBoundaryB_finish(lev, PatchType::coarse);
+    }
+    // the volume is counted by the matching post
+    CommTrace::Record(CommTrace::FillBoundaryB_wait, trace_t, 0);
+}
+
+void
+WarpX::FillBoundaryE_nowait (int lev, PatchType patch_type, IntVect ng)
+{
+    // The PML exchanges involve parallel copies and are performed
+    // up front ; only the guard cell exchanges of the regular fields
+    // are posted without blocking.
+    const auto& efield = (patch_type == PatchType::fine) ?
+        Efield_fp[lev] : Efield_cp[lev];
+    if (do_pml && pml[lev]->ok())
+    {
+        pml[lev]->ExchangeE(patch_type,
+                            { efield[0].get(),
+                              efield[1].get(),
+                              efield[2].get() },
+                            do_pml_in_domain);
+        pml[lev]->FillBoundaryE(patch_type);
+    }
+    const int period_level = (patch_type == PatchType::fine) ? lev : lev-1;
+    const auto& period = Geom(period_level).periodicity();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ng <= efield[0]->nGrowVect(),
+        "Error: in FillBoundaryE, requested more guard cells than allocated");
+    efield[0]->FillBoundary_nowait(ng, period);
+    efield[1]->FillBoundary_nowait(ng, period);
+    efield[2]->FillBoundary_nowait(ng, period);
+}
+
+void
+WarpX::FillBoundaryE_finish (int lev, PatchType patch_type)
+{
+    const auto& efield = (patch_type == PatchType::fine) ?
+        Efield_fp[lev] : Efield_cp[lev];
+    efield[0]->FillBoundary_finish();
+    efield[1]->FillBoundary_finish();
+    efield[2]->FillBoundary_finish();
+}
+
+void
+WarpX::FillBoundaryB_nowait (int lev, PatchType patch_type, IntVect ng)
+{
+    const auto& bfield = (patch_type == PatchType::fine) ?
+        Bfield_fp[lev] : Bfield_cp[lev];
+    if (do_pml && pml[lev]->ok())
+    {
+        pml[lev]->ExchangeB(patch_type,
+                            { bfield[0].get(),
+                              bfield[1].get(),
+                              bfield[2].get() },
+                            do_pml_in_domain);
+        pml[lev]->FillBoundaryB(patch_type);
+    }
+    const int period_level = (patch_type == PatchType::fine) ? lev : lev-1;
+    const auto& period = Geom(period_level).periodicity();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ng <= bfield[0]->nGrowVect(),
+        "Error: in FillBoundaryB, requested more guard cells than allocated");
+    bfield[0]->FillBoundary_nowait(ng, period);
+    bfield[1]->FillBoundary_nowait(ng, period);
+    bfield[2]->FillBoundary_nowait(ng, period);
+}
+
+void
+WarpX::FillBoundaryB_finish (int lev, PatchType patch_type)
+{
+    const auto& bfield = (patch_type == PatchType::fine) ?
+        Bfield_fp[lev] : Bfield_cp[lev];
+    bfield[0]->FillBoundary_finish();
+    bfield[1]->FillBoundary_finish();
+    bfield[2]->FillBoundary_finish();
+}
+
 void
 WarpX::FillBoundaryF (int lev, IntVect ng)
 {
@@ -552,6 +771,8 @@ WarpX::SyncCurrent ()
 {
     WARPX_PROFILE("SyncCurrent()");
 
+    const Real trace_t = CommTrace::Start();
+
     // Restrict fine patch current onto the coarse patch, before
     // summing the guard cells of the fine patch
     for (int lev = 1; lev <= finest_level; ++lev)
@@ -568,7 +789,13 @@ WarpX::SyncCurrent ()
         std::array<      MultiFab*,3> crse { current_cp[lev][0].get(),
                                              current_cp[lev][1].get(),
                                              current_cp[lev][2].get() };
-        interpolateCurrentFineToCoarse(fine, crse, refinement_ratio[0]);
+        // In sparse-current mode, restrict only the boxes holding current
+        const std::vector<char>* deposited = nullptr;
+        if (do_sparse_current) {
+            const std::vector<char>& flags = CurrentDepositionFlags(lev);
+            if (flags.size() == static_cast<std::size_t>(fine[0]->size())) deposited = &flags;
+        }
+        interpolateCurrentFineToCoarse(fine, crse, refinement_ratio[0], deposited);
     }
 
     // For each level
@@ -578,12 +805,65 @@ WarpX::SyncCurrent ()
     for (int lev=0; lev <= finest_level; ++lev) {
         AddCurrentFromFineLevelandSumBoundary(lev);
     }
+
+    if (CommTrace::Enabled()) {
+        // The guard cell sums move the full allocated guard region
+        long bytes = 0;
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            bytes += CommTrace::GuardBytes(current_fp[lev],
+                                           current_fp[lev][0]->nGrowVect());
+            if (lev > 0) {
+                bytes += CommTrace::GuardBytes(current_cp[lev],
+                                               current_cp[lev][0]->nGrowVect());
+            }
+        }
+        CommTrace::Record(CommTrace::SyncCurrent_wait, trace_t, bytes);
+    }
+}
+
+namespace
+{
+    /** Run the fine-to-coarse interpolation of one current component
+     *
+     * The loop box is decomposed into an interior part, for which the whole
+     * stencil footprint is known to be contained in the fine array (so the
+     * per-access bounds checks of the functor are compiled out), and a thin
+     * boundary shell which keeps the checks (out-of-bounds reads count as
+     * zero there).
+     *
+     * @tparam IDim j-field component on which the averaging is performed
+     * @param[in] bx loop box (grown tilebox of the coarse patch)
+     * @param[in] safe interior part of `bx`; must be contained in `bx`
+     * @param[in] fine read-only fine patch values
+     * @param[in,out] coarse overwritten coarse patch values
+     * @param[in] refinement_ratio ratio between coarse and fine granularity
+     */
+    template< int IDim >
+    void
+    InterpolateCurrentComponent ( Box const & bx, Box const & safe,
+                                  Array4<Real const> const & fine,
+                                  Array4<Real      > const & coarse,
+                                  int const refinement_ratio )
+    {
+        if (safe.ok()) {
+            amrex::ParallelFor( safe,
+                InterpolateCurrentFineToCoarse<IDim, false>(fine, coarse, refinement_ratio) );
+            for (Box const & b : amrex::boxDiff(bx, safe)) {
+                amrex::ParallelFor( b,
+                    InterpolateCurrentFineToCoarse<IDim>(fine, coarse, refinement_ratio) );
+            }
+        } else {
+            amrex::ParallelFor( bx,
+                InterpolateCurrentFineToCoarse<IDim>(fine, coarse, refinement_ratio) );
+        }
+    }
 }
 
 void
 interpolateCurrentFineToCoarse ( std::array< amrex::MultiFab const *, 3 > const & fine,
                                  std::array< amrex::MultiFab       *, 3 > const & coarse,
-                                 int const refinement_ratio)
+                                 int const refinement_ratio,
+                                 const std::vector<char>* deposited)
 {
     WARPX_PROFILE("interpolateCurrentFineToCoarse()");
     BL_ASSERT(refinement_ratio == 2);
@@ -598,17 +878,29 @@ interpolateCurrentFineToCoarse ( std::array< amrex::MultiFab const *, 3 > const
             // OMP in-box decomposition of coarse into tilebox
             for (MFIter mfi(*coarse[idim], TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
+                // Sparse-current mode: the fine patch of this box holds
+                // only zeros, and the coarse patch has been zeroed already
+                if (deposited && !(*deposited)[mfi.index()]) continue;
+
                 const Box& bx = mfi.growntilebox(ng); // only grow to outer directions of tileboxes for filling guards
 
                 auto const & arrFine = fine[idim]->const_array(mfi);
                 auto const & arrCoarse = coarse[idim]->array(mfi);
 
+                // Interior part of `bx`: the stencil reads the refined box
+                // grown by one fine cell, so shrinking the fine array box by
+                // two fine cells before coarsening keeps all accesses in
+                // bounds (for interior tiles, this covers the whole tilebox)
+                Box safe = amrex::coarsen(
+                    amrex::grow( (*fine[idim])[mfi].box(), -2 ), refinement_ratio );
+                safe &= bx;
+
                 if( idim == 0 )
-                    amrex::ParallelFor( bx, InterpolateCurrentFineToCoarse<0>(arrFine, arrCoarse, refinement_ratio) );
+                    InterpolateCurrentComponent<0>(bx, safe, arrFine, arrCoarse, refinement_ratio);
                 else if( idim == 1 )
-                    amrex::ParallelFor( bx, InterpolateCurrentFineToCoarse<1>(arrFine, arrCoarse, refinement_ratio) );
+                    InterpolateCurrentComponent<1>(bx, safe, arrFine, arrCoarse, refinement_ratio);
                 else if( idim == 2 )
-                    amrex::ParallelFor( bx, InterpolateCurrentFineToCoarse<2>(arrFine, arrCoarse, refinement_ratio) );
+                    InterpolateCurrentComponent<2>(bx, safe, arrFine, arrCoarse, refinement_ratio);
             }
         }
     }
@@ -683,7 +975,112 @@ WarpX::RestrictCurrentFromFineToCoarsePatch (int lev)
     std::array<      MultiFab*,3> crse { current_cp[lev][0].get(),
                                          current_cp[lev][1].get(),
                                          current_cp[lev][2].get() };
-    interpolateCurrentFineToCoarse(fine, crse, refinement_ratio[0]);
+    // In sparse-current mode, restrict only the boxes holding current
+    const std::vector<char>* deposited = nullptr;
+    if (do_sparse_current) {
+        const std::vector<char>& flags = CurrentDepositionFlags(lev);
+        if (flags.size() == static_cast<std::size_t>(fine[0]->size())) deposited = &flags;
+    }
+    interpolateCurrentFineToCoarse(fine, crse, refinement_ratio[0], deposited);
+}
+
+void
+WarpX::ResetCurrentDepositionFlags (int lev)
+{
+    if (!do_sparse_current) return;
+    current_deposition_flags[lev].assign(boxArray(lev).size(), 0);
+    current_deposition_flags_reduced[lev] = 0;
+}
+
+void
+WarpX::RecordCurrentDeposition (int lev, int gid)
+{
+    // Concurrent tiles of the same grid all store the same value, so the
+    // unsynchronized writes are benign
+    current_deposition_flags[lev][gid] = 1;
+}
+
+const std::vector<char>&
+WarpX::CurrentDepositionFlags (int lev)
+{
+    if (!current_deposition_flags_reduced[lev] &&
+        !current_deposition_flags[lev].empty()) {
+        // Make the flags globally consistent: every rank needs to know
+        // about every box holding current, in order to take part in the
+        // corresponding guard-cell sums
+        ParallelAllReduce::Max(current_deposition_flags[lev].data(),
+                               static_cast<int>(current_deposition_flags[lev].size()),
+                               ParallelDescriptor::Communicator());
+        current_deposition_flags_reduced[lev] = 1;
+    }
+    return current_deposition_flags[lev];
+}
+
+std::vector<char>
+WarpX::SummedCurrentMask (int lev, PatchType patch_type)
+{
+    const std::vector<char>& deposited = CurrentDepositionFlags(lev);
+    if (deposited.empty()) return std::vector<char>();
+
+    // The fine patch of a level below the finest also receives the current
+    // added down from the coarse patch of `lev+1`, which the flags of `lev`
+    // do not cover: no mask there (i.e. keep the j term everywhere)
+    if (patch_type == PatchType::fine && lev < finest_level) {
+        return std::vector<char>();
+    }
+
+    const int glev = (patch_type == PatchType::fine) ? lev : lev-1;
+    const auto& j = (patch_type == PatchType::fine) ? current_fp[lev] : current_cp[lev];
+
+    // Guard cells that the sum can have pushed into the neighbors of a
+    // deposited box (widened by the filter stencil, when it is used)
+    IntVect ng = guard_cells.ng_depos_J;
+    if (use_filter) ng += bilinear_filter.stencil_length_each_dir-1;
+
+    // The adjacency test is made on the cell-centered boxes, grown by one
+    // extra cell so that it covers the three staggerings of j at once
+    const BoxArray ba = amrex::convert(j[0]->boxArray(), IntVect::TheZeroVector());
+    // Contributions can wrap around the domain under periodic boundaries
+    const auto& shifts = Geom(glev).periodicity().shiftIntVect();
+
+    std::vector<char> mask(deposited.size(), 0);
+    std::vector< std::pair<int,Box> > isects;
+    for (int i = 0, n = static_cast<int>(ba.size()); i < n; ++i) {
+        if (!deposited[i]) continue;
+        const Box gbx = amrex::grow(ba[i], ng+1);
+        for (const auto& s : shifts) {
+            ba.intersections(gbx+s, isects);
+            for (const auto& is : isects) {
+                mask[is.first] = 1;
+            }
+        }
+    }
+    return mask;
+}
+
+namespace
+{
+    /** \brief Build a MultiFab holding only the boxes of `mf` flagged in
+     * `deposited` (with `ng` guard cells, uninitialized), on the same ranks
+     * as in `mf`. `gid` returns the index, in `mf`, of each kept box.
+     */
+    MultiFab
+    MakeSparseCurrent (const MultiFab& mf, const std::vector<char>& deposited,
+                       const IntVect& ng, Vector<int>& gid)
+    {
+        BoxList bl(mf.boxArray().ixType());
+        Vector<int> procs;
+        gid.clear();
+        for (int i = 0, n = static_cast<int>(mf.size()); i < n; ++i) {
+            if (deposited[i]) {
+                bl.push_back(mf.boxArray()[i]);
+                procs.push_back(mf.DistributionMap()[i]);
+                gid.push_back(i);
+            }
+        }
+        return MultiFab(BoxArray(std::move(bl)), DistributionMapping(std::move(procs)),
+                        mf.nComp(), ng);
+    }
 }
 
 void
@@ -692,15 +1089,79 @@ WarpX::ApplyFilterandSumBoundaryJ (int lev, PatchType patch_type)
     const int glev = (patch_type == PatchType::fine) ? lev : lev-1;
     const auto& period = Geom(glev).periodicity();
     auto& j = (patch_type == PatchType::fine) ? current_fp[lev] : current_cp[lev];
+
+    // In sparse-current mode, only the boxes on which some particle has
+    // deposited hold a nonzero current: the filter and the guard-cell sum
+    // only run over (and only communicate) those boxes
+    const std::vector<char>* deposited = nullptr;
+    if (do_sparse_current) {
+        const std::vector<char>& flags = CurrentDepositionFlags(lev);
+        if (flags.size() == static_cast<std::size_t>(j[0]->size())) deposited = &flags;
+    }
+
     for (int idim = 0; idim < 3; ++idim) {
-        if (use_filter) {
+        const int ncomp = j[idim]->nComp();
+        if (deposited) {
+            // The filter widens the deposited region by its stencil
+            IntVect ng_depos = guard_cells.ng_depos_J;
+            if (use_filter) ng_depos += bilinear_filter.stencil_length_each_dir-1;
+
+            // Gather the deposited boxes (filtering them on the way when
+            // the filter is on) into a temporary restricted to those boxes
+            Vector<int> gid;
+            MultiFab jf = MakeSparseCurrent(*j[idim], *deposited, ng_depos, gid);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(jf, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.growntilebox();
+                if (use_filter) {
+                    bilinear_filter.ApplyStencil(jf[mfi], (*j[idim])[gid[mfi.index()]],
+                                                 bx, 0, 0, ncomp);
+                } else {
+                    auto const& src = j[idim]->const_array(gid[mfi.index()]);
+                    auto const& dst = jf.array(mfi);
+                    amrex::ParallelFor(bx, ncomp,
+                    [=] AMREX_GPU_DEVICE (int i, int jj, int k, int n) {
+                        dst(i,jj,k,n) = src(i,jj,k,n);
+                    });
+                }
+            }
+
+#ifdef WARPX_USE_PSATD
+            // Update both valid cells and guard cells
+            const IntVect n_updated_guards = j[idim]->nGrowVect();
+#else
+            // Update only the valid cells
+            const IntVect n_updated_guards = IntVect::TheZeroVector();
+#endif
+            // Zero the deposited boxes before adding back the summed
+            // values (the other boxes are still zero and only receive the
+            // contributions that reach into them)
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(*j[idim], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                if (!(*deposited)[mfi.index()]) continue;
+                const Box& bx = mfi.growntilebox(n_updated_guards);
+                auto const& arr = j[idim]->array(mfi);
+                amrex::ParallelFor(bx, ncomp,
+                [=] AMREX_GPU_DEVICE (int i, int jj, int k, int n) {
+                    arr(i,jj,k,n) = 0.;
+                });
+            }
+            j[idim]->ParallelAdd(jf, 0, 0, ncomp, ng_depos, n_updated_guards, period);
+        } else if (use_filter) {
             IntVect ng = j[idim]->nGrowVect();
             ng += bilinear_filter.stencil_length_each_dir-1;
+            // The filter widens the deposited region by its stencil
+            IntVect ng_depos = guard_cells.ng_depos_J;
+            ng_depos += bilinear_filter.stencil_length_each_dir-1;
             MultiFab jf(j[idim]->boxArray(), j[idim]->DistributionMap(), j[idim]->nComp(), ng);
             bilinear_filter.ApplyStencil(jf, *j[idim]);
-            WarpXSumGuardCells(*(j[idim]), jf, period, 0, (j[idim])->nComp());
+            WarpXSumGuardCells(*(j[idim]), jf, period, ng_depos, 0, (j[idim])->nComp());
         } else {
-            WarpXSumGuardCells(*(j[idim]), period, 0, (j[idim])->nComp());
+            WarpXSumGuardCells(*(j[idim]), period, guard_cells.ng_depos_J, 0, (j[idim])->nComp());
         }
     }
 }
@@ -737,6 +1198,8 @@ WarpX::AddCurrentFromFineLevelandSumBoundary (int lev)
                 // coarse patch of fine level
                 IntVect ng = current_cp[lev+1][idim]->nGrowVect();
                 ng += bilinear_filter.stencil_length_each_dir-1;
+                IntVect ng_depos = guard_cells.ng_depos_J;
+                ng_depos += bilinear_filter.stencil_length_each_dir-1;
                 MultiFab jfc(current_cp[lev+1][idim]->boxArray(),
                              current_cp[lev+1][idim]->DistributionMap(), current_cp[lev+1][idim]->nComp(), ng);
                 bilinear_filter.ApplyStencil(jfc, *current_cp[lev+1][idim]);
@@ -749,18 +1212,20 @@ WarpX::AddCurrentFromFineLevelandSumBoundary (int lev)
                 MultiFab::Add(jfb, jfc, 0, 0, current_buf[lev+1][idim]->nComp(), ng);
                 mf.ParallelAdd(jfb, 0, 0, current_buf[lev+1][idim]->nComp(), ng, IntVect::TheZeroVector(), period);
 
-                WarpXSumGuardCells(*current_cp[lev+1][idim], jfc, period, 0, current_cp[lev+1][idim]->nComp());
+                WarpXSumGuardCells(*current_cp[lev+1][idim], jfc, period, ng_depos, 0, current_cp[lev+1][idim]->nComp());
             }
             else if (use_filter) // but no buffer
             {
                 // coarse patch of fine level
                 IntVect ng = current_cp[lev+1][idim]->nGrowVect();
                 ng += bilinear_filter.stencil_length_each_dir-1;
+                IntVect ng_depos = guard_cells.ng_depos_J;
+                ng_depos += bilinear_filter.stencil_length_each_dir-1;
                 MultiFab jf(current_cp[lev+1][idim]->boxArray(),
                             current_cp[lev+1][idim]->DistributionMap(), current_cp[lev+1][idim]->nComp(), ng);
                 bilinear_filter.ApplyStencil(jf, *current_cp[lev+1][idim]);
                 mf.ParallelAdd(jf, 0, 0, current_cp[lev+1][idim]->nComp(), ng, IntVect::TheZeroVector(), period);
-                WarpXSumGuardCells(*current_cp[lev+1][idim], jf, period, 0, current_cp[lev+1][idim]->nComp());
+                WarpXSumGuardCells(*current_cp[lev+1][idim], jf, period, ng_depos, 0, current_cp[lev+1][idim]->nComp());
             }
             else if (current_buf[lev+1][idim]) // but no filter
             {
@@ -770,14 +1235,14 @@ WarpX::AddCurrentFromFineLevelandSumBoundary (int lev)
                 mf.ParallelAdd(*current_buf[lev+1][idim], 0, 0, current_buf[lev+1][idim]->nComp(),
                                current_buf[lev+1][idim]->nGrowVect(), IntVect::TheZeroVector(),
                                period);
-                WarpXSumGuardCells(*(current_cp[lev+1][idim]), period, 0, current_cp[lev+1][idim]->nComp());
+                WarpXSumGuardCells(*(current_cp[lev+1][idim]), period, guard_cells.ng_depos_J, 0, current_cp[lev+1][idim]->nComp());
             }
             else // no filter, no buffer
             {
                 mf.ParallelAdd(*current_cp[lev+1][idim], 0, 0, current_cp[lev+1][idim]->nComp(),
                                current_cp[lev+1][idim]->nGrowVect(), IntVect::TheZeroVector(),
                                period);
-                WarpXSumGuardCells(*(current_cp[lev+1][idim]), period, 0, current_cp[lev+1][idim]->nComp());
+                WarpXSumGuardCells(*(current_cp[lev+1][idim]), period, guard_cells.ng_depos_J, 0, current_cp[lev+1][idim]->nComp());
             }
             MultiFab::Add(*current_fp[lev][idim], mf, 0, 0, current_fp[lev+1][idim]->nComp(), 0);
         }
@@ -806,11 +1271,14 @@ WarpX::ApplyFilterandSumBoundaryRho (int lev, PatchType patch_type, int icomp, i
     if (use_filter) {
         IntVect ng = r->nGrowVect();
         ng += bilinear_filter.stencil_length_each_dir-1;
+        // The filter widens the deposited region by its stencil
+        IntVect ng_depos = guard_cells.ng_depos_rho;
+        ng_depos += bilinear_filter.stencil_length_each_dir-1;
         MultiFab rf(r->boxArray(), r->DistributionMap(), ncomp, ng);
         bilinear_filter.ApplyStencil(rf, *r, icomp, 0, ncomp);
-        WarpXSumGuardCells(*r, rf, period, icomp, ncomp );
+        WarpXSumGuardCells(*r, rf, period, ng_depos, icomp, ncomp );
     } else {
-        WarpXSumGuardCells(*r, period, icomp, ncomp);
+        WarpXSumGuardCells(*r, period, guard_cells.ng_depos_rho, icomp, ncomp);
     }
 }
 
@@ -846,6 +1314,8 @@ WarpX::AddRhoFromFineLevelandSumBoundary(int lev, int icomp, int ncomp)
             // coarse patch of fine level
             IntVect ng = rho_cp[lev+1]->nGrowVect();
             ng += bilinear_filter.stencil_length_each_dir-1;
+            IntVect ng_depos = guard_cells.ng_depos_rho;
+            ng_depos += bilinear_filter.stencil_length_each_dir-1;
             MultiFab rhofc(rho_cp[lev+1]->boxArray(),
                          rho_cp[lev+1]->DistributionMap(), ncomp, ng);
             bilinear_filter.ApplyStencil(rhofc, *rho_cp[lev+1], icomp, 0, ncomp);
@@ -857,16 +1327,18 @@ WarpX::AddRhoFromFineLevelandSumBoundary(int lev, int icomp, int ncomp)
 
             MultiFab::Add(rhofb, rhofc, 0, 0, ncomp, ng);
             mf.ParallelAdd(rhofb, 0, 0, ncomp, ng, IntVect::TheZeroVector(), period);
-            WarpXSumGuardCells( *rho_cp[lev+1], rhofc, period, icomp, ncomp );
+            WarpXSumGuardCells( *rho_cp[lev+1], rhofc, period, ng_depos, icomp, ncomp );
         }
         else if (use_filter) // but no buffer
         {
             IntVect ng = rho_cp[lev+1]->nGrowVect();
             ng += bilinear_filter.stencil_length_each_dir-1;
+            IntVect ng_depos = guard_cells.ng_depos_rho;
+            ng_depos += bilinear_filter.stencil_length_each_dir-1;
             MultiFab rf(rho_cp[lev+1]->boxArray(), rho_cp[lev+1]->DistributionMap(), ncomp, ng);
             bilinear_filter.ApplyStencil(rf, *rho_cp[lev+1], icomp, 0, ncomp);
             mf.ParallelAdd(rf, 0, 0, ncomp, ng, IntVect::TheZeroVector(), period);
-            WarpXSumGuardCells( *rho_cp[lev+1], rf, period, icomp, ncomp );
+            WarpXSumGuardCells( *rho_cp[lev+1], rf, period, ng_depos, icomp, ncomp );
         }
         else if (charge_buf[lev+1]) // but no filter
         {
@@ -877,14 +1349,14 @@ WarpX::AddRhoFromFineLevelandSumBoundary(int lev, int icomp, int ncomp)
                            ncomp,
                            charge_buf[lev+1]->nGrowVect(), IntVect::TheZeroVector(),
                            period);
-            WarpXSumGuardCells(*(rho_cp[lev+1]), period, icomp, ncomp);
+            WarpXSumGuardCells(*(rho_cp[lev+1]), period, guard_cells.ng_depos_rho, icomp, ncomp);
         }
         else // no filter, no buffer
         {
             mf.ParallelAdd(*rho_cp[lev+1], icomp, 0, ncomp,
                            rho_cp[lev+1]->nGrowVect(), IntVect::TheZeroVector(),
                            period);
-            WarpXSumGuardCells(*(rho_cp[lev+1]), period, icomp, ncomp);
+            WarpXSumGuardCells(*(rho_cp[lev+1]), period, guard_cells.ng_depos_rho, icomp, ncomp);
         }
         MultiFab::Add(*rho_fp[lev], mf, 0, icomp, ncomp, 0);
         NodalSyncRho(lev+1, PatchType::coarse, icomp, ncomp);
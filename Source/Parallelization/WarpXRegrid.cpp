@@ -11,8 +11,106 @@
 
 #include <AMReX_BLProfiler.H>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace amrex;
 
+namespace
+{
+    /** \brief Build a node-aware distribution mapping.
+     *
+     * The boxes are first partitioned along the space filling curve into
+     * groups of consecutive node-sized chunks, and each group is then
+     * balanced over the ranks of its node. Boxes that are neighbors
+     * along the curve (and thus exchange guard cells) preferentially
+     * land on the same node, where the links are faster; the intra-node
+     * placement does not matter for locality, so it only aims at
+     * balancing the cost.
+     *
+     * This assumes that consecutive ranks are placed on the same node,
+     * which is how MPI ranks are mapped on the machines we run on.
+     */
+    DistributionMapping
+    makeHierarchicalSFC (const amrex::Vector<amrex::Real>& cost,
+                         const BoxArray& ba,
+                         const int node_size,
+                         amrex::Real& proposedEfficiency)
+    {
+        const int nprocs = ParallelContext::NProcsSub();
+        const int nboxes = cost.size();
+
+        // SFC partition over the ranks, without sorting the ranks by
+        // cost: the r-th rank receives the r-th contiguous chunk of the
+        // curve, so that grouping consecutive ranks groups contiguous
+        // portions of the curve
+        amrex::Real sfcEfficiency = 0.0;
+        const DistributionMapping sfcdm =
+            DistributionMapping::makeSFC(cost, ba, sfcEfficiency, false);
+
+        // Collect the boxes of each node-sized group of consecutive ranks
+        const int nnodes = (nprocs + node_size - 1) / node_size;
+        Vector<Vector<int> > node_boxes(nnodes);
+        for (int i = 0; i < nboxes; ++i) {
+            node_boxes[sfcdm[i]/node_size].push_back(i);
+        }
+
+        // Balance each group over the ranks of its node, assigning the
+        // most expensive boxes first to the least loaded rank
+        Vector<int> pmap(nboxes);
+        Vector<Real> load(nprocs, 0.0);
+        for (int n = 0; n < nnodes; ++n) {
+            Vector<int>& boxes = node_boxes[n];
+            std::sort(boxes.begin(), boxes.end(),
+                      [&cost](int i, int j) { return cost[i] > cost[j]; });
+            const int rank_begin = n*node_size;
+            const int rank_end = std::min((n+1)*node_size, nprocs);
+            for (int i : boxes) {
+                int target = rank_begin;
+                for (int r = rank_begin+1; r < rank_end; ++r) {
+                    if (load[r] < load[target]) target = r;
+                }
+                pmap[i] = target;
+                load[target] += cost[i];
+            }
+        }
+
+        // Efficiency of the proposed mapping: average load over maximum load
+        const Real maxLoad = *std::max_element(load.begin(), load.end());
+        const Real avgLoad = std::accumulate(load.begin(), load.end(), 0.0) / nprocs;
+        proposedEfficiency = (maxLoad > 0.) ? avgLoad/maxLoad : 1.0;
+
+        return DistributionMapping(std::move(pmap));
+    }
+}
+
+void
+WarpX::LoadBalanceStartDecision ()
+{
+#ifdef AMREX_USE_MPI
+    // The heuristic costs are only computed at the load balance step itself
+    if (WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Timers) return;
+
+    WARPX_PROFILE("WarpX::LoadBalanceStartDecision()");
+
+    const int nLevels = finestLevel();
+    costs_reduced.resize(nLevels+1);
+    costs_reduction_requests.resize(nLevels+1, MPI_REQUEST_NULL);
+    for (int lev = 0; lev <= nLevels; ++lev)
+    {
+        if (costs[lev] == nullptr) continue;
+        // Work on a snapshot of the costs: they keep being decayed and
+        // accumulated while the reduction progresses in the background
+        costs_reduced[lev].reset(new amrex::Vector<Real>(*costs[lev]));
+        MPI_Iallreduce(MPI_IN_PLACE, costs_reduced[lev]->data(),
+                       costs_reduced[lev]->size(),
+                       ParallelDescriptor::Mpi_typemap<Real>::type(),
+                       MPI_SUM, ParallelContext::CommunicatorSub(),
+                       &costs_reduction_requests[lev]);
+    }
+#endif
+}
+
 void
 WarpX::LoadBalance ()
 {
@@ -33,40 +131,85 @@ WarpX::LoadBalance ()
     const int nLevels = finestLevel();
     for (int lev = 0; lev <= nLevels; ++lev)
     {
+        // Costs to base the decision on
+        amrex::Vector<Real>* lb_costs = costs[lev].get();
 #ifdef AMREX_USE_MPI
-        // Parallel reduce the costs
-        amrex::Vector<Real>::iterator it = (*costs[lev]).begin();
-        amrex::Real* itAddr = &(*it);
-        ParallelAllReduce::Sum(itAddr, costs[lev]->size(), ParallelContext::CommunicatorSub());
-#endif
-        // To store efficiency (meaning, the  average 'cost' over all ranks, normalized to the
-        // max cost) for current distribution mapping
-        amrex::Real currentEfficiency = 0.0;
-
-        // Compute efficiency for the current distribution mapping
-        const DistributionMapping& currentdm = DistributionMap(lev);
-        if (load_balance_efficiency_ratio_threshold > 0.0)
+        if (lev < static_cast<int>(costs_reduced.size()) && costs_reduced[lev] != nullptr)
         {
-            ComputeDistributionMappingEfficiency(currentdm, *costs[lev],
-                                                 currentEfficiency);
+            // A background reduction was started a few steps ahead
+            // (LoadBalanceStartDecision): wait for it and decide on the
+            // (slightly older) reduced snapshot
+            MPI_Wait(&costs_reduction_requests[lev], MPI_STATUS_IGNORE);
+            lb_costs = costs_reduced[lev].get();
         }
-
-        const amrex::Real nboxes = costs[lev]->size();
+        else
+        {
+            // Parallel reduce the costs
+            amrex::Vector<Real>::iterator it = (*costs[lev]).begin();
+            amrex::Real* itAddr = &(*it);
+            ParallelAllReduce::Sum(itAddr, costs[lev]->size(), ParallelContext::CommunicatorSub());
+        }
+#endif
+        const amrex::Real nboxes = lb_costs->size();
         const amrex::Real nprocs = ParallelContext::NProcsSub();
         const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
 
-        // To store efficiency for proposed distribution mapping
-        amrex::Real proposedEfficiency = 0.0;
+        const DistributionMapping& currentdm = DistributionMap(lev);
+
+        // The proposed distribution mapping and the efficiency test are
+        // computed on the I/O rank only (every rank holds the reduced
+        // costs and would compute the exact same mapping); the other
+        // ranks only synchronize when a migration is actually triggered
+        int doRemake = 0;
+        Vector<int> pmap(lb_costs->size());
+        if (ParallelContext::MyProcSub() == ParallelContext::IOProcessorNumberSub())
+        {
+            // To store efficiency (meaning, the  average 'cost' over all ranks,
+            // normalized to the max cost) for current distribution mapping
+            amrex::Real currentEfficiency = 0.0;
+            if (load_balance_efficiency_ratio_threshold > 0.0)
+            {
+                ComputeDistributionMappingEfficiency(currentdm, *lb_costs,
+                                                     currentEfficiency);
+            }
+
+            // To store efficiency for proposed distribution mapping
+            amrex::Real proposedEfficiency = 0.0;
+
+            DistributionMapping newdm;
+            if (load_balance_with_sfc && load_balance_node_size > 0) {
+                newdm = makeHierarchicalSFC(*lb_costs, boxArray(lev),
+                                            load_balance_node_size, proposedEfficiency);
+            } else if (load_balance_with_sfc) {
+                newdm = DistributionMapping::makeSFC(*lb_costs, boxArray(lev), proposedEfficiency, false);
+            } else {
+                newdm = DistributionMapping::makeKnapSack(*lb_costs, proposedEfficiency, nmax);
+            }
 
-        const DistributionMapping newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev], boxArray(lev), proposedEfficiency, false)
-            : DistributionMapping::makeKnapSack(*costs[lev], proposedEfficiency, nmax);
+            if (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency)
+            {
+                doRemake = 1;
+                pmap = newdm.ProcessorMap();
+            }
+        }
+        ParallelDescriptor::Bcast(&doRemake, 1,
+                                  ParallelContext::IOProcessorNumberSub(),
+                                  ParallelContext::CommunicatorSub());
 
-        if (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency)
+        if (doRemake)
         {
-            RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+            ParallelDescriptor::Bcast(pmap.data(), pmap.size(),
+                                      ParallelContext::IOProcessorNumberSub(),
+                                      ParallelContext::CommunicatorSub());
+            RemakeLevel(lev, t_new[lev], boxArray(lev), DistributionMapping(std::move(pmap)));
             doRedistribute = true;
         }
+
+#ifdef AMREX_USE_MPI
+        if (lev < static_cast<int>(costs_reduced.size())) {
+            costs_reduced[lev].reset();
+        }
+#endif
     }
     if (doRedistribute)
     {
@@ -75,8 +218,87 @@ WarpX::LoadBalance ()
 }
 
 
+
+namespace
+{
+    /** \brief Remake a MultiFab with a new distribution mapping, moving
+     * only the boxes whose owner changed.
+     *
+     * The fabs of the boxes that keep their owner are moved into the new
+     * MultiFab, without allocating or copying anything ; fabs are only
+     * allocated for the reassigned boxes and (when `redistribute` is
+     * true) only the data of those boxes is communicated. The cost of a
+     * load-balance event is thus proportional to the number of
+     * reassigned boxes, instead of the total number of boxes.
+     */
+    template <typename MF>
+    std::unique_ptr<MF> RemakeMultiFab (MF& mf, const DistributionMapping& dm,
+                                        const bool redistribute)
+    {
+        using FAB = typename MF::FABType::value_type;
+
+        const BoxArray& ba = mf.boxArray();
+        const DistributionMapping& olddm = mf.DistributionMap();
+        const int ncomp = mf.nComp();
+        const IntVect& ng = mf.nGrowVect();
+
+        auto pmf = std::unique_ptr<MF>(new MF(ba, dm, ncomp, ng,
+                                              MFInfo().SetAlloc(false)));
+
+        // Indices of the boxes whose owner changed (the distribution
+        // mappings are known on every rank, so this list is global)
+        Vector<int> moved_boxes;
+        for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+            if (dm[i] != olddm[i]) moved_boxes.push_back(i);
+        }
+
+        const int myproc = ParallelDescriptor::MyProc();
+        for (MFIter mfi(*pmf); mfi.isValid(); ++mfi) {
+            const int i = mfi.index();
+            if (olddm[i] == myproc) {
+                // The box stays on this rank: keep its fab
+                pmf->setFab(i, std::move(mf[i]));
+            } else {
+                pmf->setFab(i, FAB(mf.fabbox(i), ncomp));
+            }
+        }
+
+        if (redistribute && !moved_boxes.empty()) {
+            // Build views of the reassigned boxes only, aliasing the
+            // data of the old and of the new MultiFab, and move their
+            // data (including the guard cells, as Redistribute did) in
+            // a single ParallelCopy
+            BoxList bl(ba.ixType());
+            Vector<int> src_pmap, dst_pmap;
+            for (int i : moved_boxes) {
+                bl.push_back(ba[i]);
+                src_pmap.push_back(olddm[i]);
+                dst_pmap.push_back(dm[i]);
+            }
+            BoxArray moved_ba(std::move(bl));
+            MF src_view(moved_ba, DistributionMapping(std::move(src_pmap)),
+                        ncomp, ng, MFInfo().SetAlloc(false));
+            MF dst_view(moved_ba, DistributionMapping(std::move(dst_pmap)),
+                        ncomp, ng, MFInfo().SetAlloc(false));
+            for (MFIter mfi(src_view); mfi.isValid(); ++mfi) {
+                const int i = moved_boxes[mfi.index()];
+                src_view.setFab(mfi.index(),
+                                FAB(mf.fabbox(i), ncomp, mf[i].dataPtr()));
+            }
+            for (MFIter mfi(dst_view); mfi.isValid(); ++mfi) {
+                const int i = moved_boxes[mfi.index()];
+                dst_view.setFab(mfi.index(),
+                                FAB((*pmf)[i].box(), ncomp, (*pmf)[i].dataPtr()));
+            }
+            dst_view.ParallelCopy(src_view, 0, 0, ncomp, ng, ng);
+        }
+
+        return pmf;
+    }
+}
+
 void
-WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
+WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapping& dm)
 {
     if (ba == boxArray(lev))
     {
@@ -85,50 +307,23 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         // Fine patch
         for (int idim=0; idim < 3; ++idim)
         {
-            {
-                const IntVect& ng = Bfield_fp[lev][idim]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_fp[lev][idim]->boxArray(),
-                                                                  dm, Bfield_fp[lev][idim]->nComp(), ng));
-                pmf->Redistribute(*Bfield_fp[lev][idim], 0, 0, Bfield_fp[lev][idim]->nComp(), ng);
-                Bfield_fp[lev][idim] = std::move(pmf);
-            }
-            {
-                const IntVect& ng = Efield_fp[lev][idim]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_fp[lev][idim]->boxArray(),
-                                                                  dm, Efield_fp[lev][idim]->nComp(), ng));
-                pmf->Redistribute(*Efield_fp[lev][idim], 0, 0, Efield_fp[lev][idim]->nComp(), ng);
-                Efield_fp[lev][idim] = std::move(pmf);
-            }
-            {
-                const IntVect& ng = current_fp[lev][idim]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(current_fp[lev][idim]->boxArray(),
-                                                                  dm, current_fp[lev][idim]->nComp(), ng));
-                current_fp[lev][idim] = std::move(pmf);
-            }
+            Bfield_fp[lev][idim] = RemakeMultiFab( *Bfield_fp[lev][idim], dm, true );
+            Efield_fp[lev][idim] = RemakeMultiFab( *Efield_fp[lev][idim], dm, true );
+            // no need to redistribute j (it is recomputed at each step)
+            current_fp[lev][idim] = RemakeMultiFab( *current_fp[lev][idim], dm, false );
             if (current_store[lev][idim])
             {
-                const IntVect& ng = current_store[lev][idim]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(current_store[lev][idim]->boxArray(),
-                                                                  dm, current_store[lev][idim]->nComp(), ng));
                 // no need to redistribute
-                current_store[lev][idim] = std::move(pmf);
+                current_store[lev][idim] = RemakeMultiFab( *current_store[lev][idim], dm, false );
             }
         }
 
         if (F_fp[lev] != nullptr) {
-            const IntVect& ng = F_fp[lev]->nGrowVect();
-            auto pmf = std::unique_ptr<MultiFab>(new MultiFab(F_fp[lev]->boxArray(),
-                                                              dm, F_fp[lev]->nComp(), ng));
-            pmf->Redistribute(*F_fp[lev], 0, 0, F_fp[lev]->nComp(), ng);
-            F_fp[lev] = std::move(pmf);
+            F_fp[lev] = RemakeMultiFab( *F_fp[lev], dm, true );
         }
 
         if (rho_fp[lev] != nullptr) {
-            const int nc = rho_fp[lev]->nComp();
-            const IntVect& ng = rho_fp[lev]->nGrowVect();
-            auto pmf = std::unique_ptr<MultiFab>(new MultiFab(rho_fp[lev]->boxArray(),
-                                                              dm, nc, ng));
-            rho_fp[lev] = std::move(pmf);
+            rho_fp[lev] = RemakeMultiFab( *rho_fp[lev], dm, false );
         }
 
         // Aux patch
@@ -141,20 +336,9 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         } else {
             for (int idim=0; idim < 3; ++idim)
             {
-                {
-                    const IntVect& ng = Bfield_aux[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_aux[lev][idim]->boxArray(),
-                                                                      dm, Bfield_aux[lev][idim]->nComp(), ng));
-                    // pmf->Redistribute(*Bfield_aux[lev][idim], 0, 0, Bfield_aux[lev][idim]->nComp(), ng);
-                    Bfield_aux[lev][idim] = std::move(pmf);
-                }
-                {
-                    const IntVect& ng = Efield_aux[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_aux[lev][idim]->boxArray(),
-                                                                      dm, Efield_aux[lev][idim]->nComp(), ng));
-                    // pmf->Redistribute(*Efield_aux[lev][idim], 0, 0, Efield_aux[lev][idim]->nComp(), ng);
-                    Efield_aux[lev][idim] = std::move(pmf);
-                }
+                // the aux fields are recomputed before the next use
+                Bfield_aux[lev][idim] = RemakeMultiFab( *Bfield_aux[lev][idim], dm, false );
+                Efield_aux[lev][idim] = RemakeMultiFab( *Efield_aux[lev][idim], dm, false );
             }
         }
 
@@ -162,42 +346,17 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         if (lev > 0) {
             for (int idim=0; idim < 3; ++idim)
             {
-                {
-                    const IntVect& ng = Bfield_cp[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_cp[lev][idim]->boxArray(),
-                                                                      dm, Bfield_cp[lev][idim]->nComp(), ng));
-                    pmf->Redistribute(*Bfield_cp[lev][idim], 0, 0, Bfield_cp[lev][idim]->nComp(), ng);
-                    Bfield_cp[lev][idim] = std::move(pmf);
-                }
-                {
-                    const IntVect& ng = Efield_cp[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_cp[lev][idim]->boxArray(),
-                                                                      dm, Efield_cp[lev][idim]->nComp(), ng));
-                    pmf->Redistribute(*Efield_cp[lev][idim], 0, 0, Efield_cp[lev][idim]->nComp(), ng);
-                    Efield_cp[lev][idim] = std::move(pmf);
-                }
-                {
-                    const IntVect& ng = current_cp[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>( new MultiFab(current_cp[lev][idim]->boxArray(),
-                                                                       dm, current_cp[lev][idim]->nComp(), ng));
-                    current_cp[lev][idim] = std::move(pmf);
-                }
+                Bfield_cp[lev][idim] = RemakeMultiFab( *Bfield_cp[lev][idim], dm, true );
+                Efield_cp[lev][idim] = RemakeMultiFab( *Efield_cp[lev][idim], dm, true );
+                current_cp[lev][idim] = RemakeMultiFab( *current_cp[lev][idim], dm, false );
             }
 
             if (F_cp[lev] != nullptr) {
-                const IntVect& ng = F_cp[lev]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(F_cp[lev]->boxArray(),
-                                                                  dm, F_cp[lev]->nComp(), ng));
-                pmf->Redistribute(*F_cp[lev], 0, 0, F_cp[lev]->nComp(), ng);
-                F_cp[lev] = std::move(pmf);
+                F_cp[lev] = RemakeMultiFab( *F_cp[lev], dm, true );
             }
 
             if (rho_cp[lev] != nullptr) {
-                const int nc = rho_cp[lev]->nComp();
-                const IntVect& ng = rho_cp[lev]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(rho_cp[lev]->boxArray(),
-                                                                  dm, nc, ng));
-                rho_cp[lev] = std::move(pmf);
+                rho_cp[lev] = RemakeMultiFab( *rho_cp[lev], dm, false );
             }
         }
 
@@ -206,52 +365,28 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
             {
                 if (Bfield_cax[lev][idim])
                 {
-                    const IntVect& ng = Bfield_cax[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_cax[lev][idim]->boxArray(),
-                                                                      dm, Bfield_cax[lev][idim]->nComp(), ng));
-                    // pmf->ParallelCopy(*Bfield_cax[lev][idim], 0, 0, Bfield_cax[lev][idim]->nComp(), ng, ng);
-                    Bfield_cax[lev][idim] = std::move(pmf);
+                    Bfield_cax[lev][idim] = RemakeMultiFab( *Bfield_cax[lev][idim], dm, false );
                 }
                 if (Efield_cax[lev][idim])
                 {
-                    const IntVect& ng = Efield_cax[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_cax[lev][idim]->boxArray(),
-                                                                      dm, Efield_cax[lev][idim]->nComp(), ng));
-                    // pmf->ParallelCopy(*Efield_cax[lev][idim], 0, 0, Efield_cax[lev][idim]->nComp(), ng, ng);
-                    Efield_cax[lev][idim] = std::move(pmf);
+                    Efield_cax[lev][idim] = RemakeMultiFab( *Efield_cax[lev][idim], dm, false );
                 }
                 if (current_buf[lev][idim])
                 {
-                    const IntVect& ng = current_buf[lev][idim]->nGrowVect();
-                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(current_buf[lev][idim]->boxArray(),
-                                                                      dm, current_buf[lev][idim]->nComp(), ng));
-                    // pmf->ParallelCopy(*current_buf[lev][idim], 0, 0, current_buf[lev][idim]->nComp(), ng, ng);
-                    current_buf[lev][idim] = std::move(pmf);
+                    current_buf[lev][idim] = RemakeMultiFab( *current_buf[lev][idim], dm, false );
                 }
             }
             if (charge_buf[lev])
             {
-                const IntVect& ng = charge_buf[lev]->nGrowVect();
-                auto pmf = std::unique_ptr<MultiFab>(new MultiFab(charge_buf[lev]->boxArray(),
-                                                                  dm, charge_buf[lev]->nComp(), ng));
-                // pmf->ParallelCopy(*charge_buf[lev][idim], 0, 0, charge_buf[lev]->nComp(), ng, ng);
-                charge_buf[lev] = std::move(pmf);
+                charge_buf[lev] = RemakeMultiFab( *charge_buf[lev], dm, false );
             }
             if (current_buffer_masks[lev])
             {
-                const IntVect& ng = current_buffer_masks[lev]->nGrowVect();
-                auto pmf = std::unique_ptr<iMultiFab>(new iMultiFab(current_buffer_masks[lev]->boxArray(),
-                                                                    dm, current_buffer_masks[lev]->nComp(), ng));
-                // pmf->ParallelCopy(*current_buffer_masks[lev], 0, 0, current_buffer_masks[lev]->nComp(), ng, ng);
-                current_buffer_masks[lev] = std::move(pmf);
+                current_buffer_masks[lev] = RemakeMultiFab( *current_buffer_masks[lev], dm, false );
             }
             if (gather_buffer_masks[lev])
             {
-                const IntVect& ng = gather_buffer_masks[lev]->nGrowVect();
-                auto pmf = std::unique_ptr<iMultiFab>(new iMultiFab(gather_buffer_masks[lev]->boxArray(),
-                                                                    dm, gather_buffer_masks[lev]->nComp(), ng));
-                // pmf->ParallelCopy(*gather_buffer_masks[lev], 0, 0, gather_buffer_masks[lev]->nComp(), ng, ng);
-                gather_buffer_masks[lev] = std::move(pmf);
+                gather_buffer_masks[lev] = RemakeMultiFab( *gather_buffer_masks[lev], dm, false );
             }
         }
 
@@ -266,10 +401,88 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
 
     } else
     {
-        amrex::Abort("RemakeLevel: to be implemented");
+        // The grids of this level changed (dynamic regrid driven by the
+        // refinement criteria): save the old field solution, re-allocate
+        // all the level data on the new grids, initialize it like a new
+        // level and copy the old solution back wherever the old and new
+        // grids overlap. The cells that newly entered the level keep the
+        // initial (external) field values until the field solve and the
+        // auxiliary-field update reach them. The particles are
+        // redistributed onto the new grids by the caller.
+        std::array<std::unique_ptr<MultiFab>,3> old_Efield_fp, old_Bfield_fp;
+        std::array<std::unique_ptr<MultiFab>,3> old_Efield_cp, old_Bfield_cp;
+        for (int idim=0; idim < 3; ++idim)
+        {
+            old_Efield_fp[idim] = std::move(Efield_fp[lev][idim]);
+            old_Bfield_fp[idim] = std::move(Bfield_fp[lev][idim]);
+            if (lev > 0)
+            {
+                old_Efield_cp[idim] = std::move(Efield_cp[lev][idim]);
+                old_Bfield_cp[idim] = std::move(Bfield_cp[lev][idim]);
+            }
+        }
+
+        ClearLevel(lev);
+        SetDistributionMap(lev, dm);
+        AllocLevelData(lev, ba, dm);
+        InitLevelData(lev, time);
+
+        const auto& period = Geom(lev).periodicity();
+        for (int idim=0; idim < 3; ++idim)
+        {
+            Efield_fp[lev][idim]->ParallelCopy( *old_Efield_fp[idim], 0, 0,
+                old_Efield_fp[idim]->nComp(), old_Efield_fp[idim]->nGrowVect(),
+                Efield_fp[lev][idim]->nGrowVect(), period );
+            Bfield_fp[lev][idim]->ParallelCopy( *old_Bfield_fp[idim], 0, 0,
+                old_Bfield_fp[idim]->nComp(), old_Bfield_fp[idim]->nGrowVect(),
+                Bfield_fp[lev][idim]->nGrowVect(), period );
+            if (lev > 0)
+            {
+                const auto& cperiod = Geom(lev-1).periodicity();
+                Efield_cp[lev][idim]->ParallelCopy( *old_Efield_cp[idim], 0, 0,
+                    old_Efield_cp[idim]->nComp(), old_Efield_cp[idim]->nGrowVect(),
+                    Efield_cp[lev][idim]->nGrowVect(), cperiod );
+                Bfield_cp[lev][idim]->ParallelCopy( *old_Bfield_cp[idim], 0, 0,
+                    old_Bfield_cp[idim]->nComp(), old_Bfield_cp[idim]->nGrowVect(),
+                    Bfield_cp[lev][idim]->nGrowVect(), cperiod );
+            }
+        }
+
+        // The PML is attached to the grids of the level: remake it too
+        if (do_pml && pml[lev])
+        {
+            amrex::IntVect do_pml_Lo_MR = amrex::IntVect::TheUnitVector();
+#ifdef WARPX_DIM_RZ
+            //In cylindrical geometry, if the edge of the patch is at r=0, do not add PML
+            if ((max_level > 0) && (fine_tag_lo[0]==0.)) {
+                do_pml_Lo_MR[0] = 0;
+            }
+#endif
+            pml[lev].reset(new PML(ba, dm, &Geom(lev), &Geom(lev-1),
+                                   pml_ncell, pml_delta, refRatio(lev-1)[0],
+#ifdef WARPX_USE_PSATD
+                                   dt[lev], nox_fft, noy_fft, noz_fft, do_nodal,
+#endif
+                                   do_dive_cleaning, do_moving_window,
+                                   pml_has_particles, do_pml_in_domain,
+                                   do_pml_Lo_MR, amrex::IntVect::TheUnitVector()));
+            pml[lev]->ComputePMLFactors(dt[lev]);
+        }
     }
 }
 
+void
+WarpX::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
+                               const DistributionMapping& dm)
+{
+    // A level that appears during a dynamic regrid starts from the
+    // initial (external) field values, like a level made from scratch;
+    // the particles are redistributed onto it by the caller and deposit
+    // their current on the new grids from the next step on.
+    AllocLevelData(lev, ba, dm);
+    InitLevelData(lev, time);
+}
+
 void
 WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::Vector<amrex::Real> > >& a_costs)
 {
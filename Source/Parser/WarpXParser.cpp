@@ -28,6 +28,8 @@ WarpXParser::define (std::string const& func_body)
     int nthreads = omp_get_max_threads();
     m_variables.resize(nthreads);
     m_varnames.resize(nthreads);
+    m_tape.resize(nthreads);
+    m_tape_built.assign(nthreads, 0);
     m_parser.resize(nthreads);
     m_parser[0] = wp_c_parser_new(f.c_str());
 #pragma omp parallel
@@ -67,11 +69,15 @@ WarpXParser::clear ()
     }
     m_parser.clear();
     m_variables.clear();
+    m_tape.clear();
+    m_tape_built.clear();
 
 #else
 
     if (m_parser) wp_parser_delete(m_parser);
     m_parser = nullptr;
+    m_tape.clear();
+    m_tape_built = 0;
 
 #endif
 }
@@ -126,11 +132,13 @@ WarpXParser::setConstant (std::string const& name, amrex::Real c)
 #pragma omp parallel if (!in_parallel)
     {
         wp_parser_setconst(m_parser[omp_get_thread_num()], name.c_str(), c);
+        m_tape_built[omp_get_thread_num()] = 0; // the AST has changed
     }
 
 #else
 
     wp_parser_setconst(m_parser, name.c_str(), c);
+    m_tape_built = 0; // the AST has changed
 
 #endif
 }
@@ -163,3 +171,90 @@ WarpXParser::symbols () const
 #endif
     return results;
 }
+
+void
+WarpXParser::buildTape () const
+{
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+    struct wp_parser* parser = m_parser[tid];
+    auto const& varnames = m_varnames[tid];
+    auto& tape = m_tape[tid];
+    m_tape_built[tid] = 1;
+#else
+    struct wp_parser* parser = m_parser;
+    auto const& varnames = m_varnames;
+    auto& tape = m_tape;
+    m_tape_built = 1;
+#endif
+    tape.clear();
+
+    // The tape resolves symbols against the registered variables; any
+    // other symbol (e.g. a constant that was never set) means the
+    // expression cannot be compiled, and the batched eval falls back to
+    // the recursive evaluation of the AST.
+    std::set<std::string> symbols;
+    wp_ast_get_symbols(parser->ast, symbols);
+    for (auto const& s : symbols) {
+        if (std::find(varnames.begin(), varnames.end(), s) == varnames.end()) {
+            return;
+        }
+    }
+
+    int depth = 0;
+    int max_depth = 0;
+    wp_ast_to_tape(parser->ast, varnames, tape, depth, max_depth);
+    if (max_depth > WP_TAPE_MAX_STACK) {
+        tape.clear(); // too deeply nested: fall back to the AST
+    }
+}
+
+void
+WarpXParser::eval (int n, amrex::Real const* x, amrex::Real const* y,
+                   amrex::Real const* z, amrex::Real* result) const noexcept
+{
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+    if (!m_tape_built[tid]) buildTape();
+    auto const& tape = m_tape[tid];
+    const bool use_tape = (!tape.empty() && m_varnames[tid].size() == 3);
+#else
+    if (!m_tape_built) buildTape();
+    auto const& tape = m_tape;
+    const bool use_tape = (!tape.empty() && m_varnames.size() == 3);
+#endif
+    if (use_tape) {
+        wp_tape_var const vars[3] = {{x,1}, {y,1}, {z,1}};
+        wp_tape_eval_batch(tape.data(), static_cast<int>(tape.size()),
+                           n, vars, result);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            result[i] = eval(x[i], y[i], z[i]);
+        }
+    }
+}
+
+void
+WarpXParser::eval (int n, amrex::Real const* x, amrex::Real const* y,
+                   amrex::Real z, amrex::Real* result) const noexcept
+{
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+    if (!m_tape_built[tid]) buildTape();
+    auto const& tape = m_tape[tid];
+    const bool use_tape = (!tape.empty() && m_varnames[tid].size() == 3);
+#else
+    if (!m_tape_built) buildTape();
+    auto const& tape = m_tape;
+    const bool use_tape = (!tape.empty() && m_varnames.size() == 3);
+#endif
+    if (use_tape) {
+        wp_tape_var const vars[3] = {{x,1}, {y,1}, {&z,0}};
+        wp_tape_eval_batch(tape.data(), static_cast<int>(tape.size()),
+                           n, vars, result);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            result[i] = eval(x[i], y[i], z);
+        }
+    }
+}
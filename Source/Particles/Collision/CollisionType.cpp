@@ -29,6 +29,15 @@ CollisionType::CollisionType(
     m_CoulombLog = -1.0;
     pp.query("CoulombLog", m_CoulombLog);
 
+    // adaptive mode: cells whose expected scattering parameter stays
+    // small are collided less often, with an accordingly larger
+    // effective time step
+    pp.query("adaptive", m_adaptive);
+    m_s_threshold = 0.01;
+    pp.query("adaptive_s_threshold", m_s_threshold);
+    m_refresh_int = 10;
+    pp.query("adaptive_refresh_int", m_refresh_int);
+
     for (int i=0; i<species_names.size(); i++)
     {
         if (species_names[i] == collision_species[0])
@@ -48,16 +57,14 @@ using namespace amrex;
 // Define shortcuts for frequently-used type names
 using ParticleType = WarpXParticleContainer::ParticleType;
 using ParticleTileType = WarpXParticleContainer::ParticleTileType;
-using ParticleBins = DenseBins<ParticleType>;
+using ParticleBins = CollisionType::CollisionBins;
 using index_type = ParticleBins::index_type;
 
-namespace {
-
-    /* Find the particles and count the particles that are in each cell.
-       Note that this does *not* rearrange particle arrays */
-    ParticleBins
-    findParticlesInEachCell( int const lev, MFIter const& mfi,
-                             ParticleTileType const& ptile) {
+/* Find the particles and count the particles that are in each cell.
+   Note that this does *not* rearrange particle arrays */
+ParticleBins
+CollisionType::findParticlesInEachCell( int const lev, MFIter const& mfi,
+                                        ParticleTileType const& ptile) {
 
         // Extract particle structures for this tile
         int const np = ptile.numParticles();
@@ -85,6 +92,45 @@ namespace {
         return bins;
     }
 
+/** Create or resize the per-cell caches of the adaptive mode for one tile
+ *
+ * @param lev AMR level of the tile
+ * @param mfi iterator for multifab
+ *
+ */
+void CollisionType::prepareAdaptiveCache
+    ( int const lev, MFIter const& mfi )
+{
+    if ( !m_adaptive ) { return; }
+
+    if ( static_cast<int>(m_s_rate.size()) <= lev )
+    {
+        m_s_rate.resize(lev+1);
+        m_pending_dt.resize(lev+1);
+    }
+
+    Box const& cbx = mfi.tilebox(IntVect::TheZeroVector()); //Cell-centered box
+    int const n_cells = static_cast<int>(cbx.numPts());
+    auto const index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+    auto& s_rate = m_s_rate[lev][index];
+    auto& pending_dt = m_pending_dt[lev][index];
+    if ( static_cast<int>(s_rate.size()) != n_cells )
+    {
+        // First visit of this tile, or the grids have changed:
+        // (re)build the cache. An unknown s rate (negative value)
+        // makes the first collision call unconditional.
+        s_rate.resize(n_cells);
+        pending_dt.resize(n_cells);
+        Real* const AMREX_RESTRICT p_s_rate = s_rate.dataPtr();
+        Real* const AMREX_RESTRICT p_pending = pending_dt.dataPtr();
+        amrex::ParallelFor( n_cells,
+            [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                p_s_rate[i] = Real(-1.0);
+                p_pending[i] = Real(0.0);
+            }
+        );
+    }
 }
 
 /** Perform all binary collisions within a tile
@@ -92,25 +138,38 @@ namespace {
  * @param lev AMR level of the tile
  * @param mfi iterator for multifab
  * @param species1/2 pointer to species container
- * @param isSameSpecies true if collision is between same species
- * @param CoulombLog user input Coulomb logrithm
+ * @param bins_1/2 cell ranges of the particles of each species
  *
  */
 void CollisionType::doCoulombCollisionsWithinTile
     ( int const lev, MFIter const& mfi,
     std::unique_ptr<WarpXParticleContainer>& species_1,
     std::unique_ptr<WarpXParticleContainer>& species_2,
-    bool const isSameSpecies, Real const CoulombLog )
+    ParticleBins& bins_1, ParticleBins& bins_2 )
 {
 
+    bool const isSameSpecies = m_isSameSpecies;
+    Real const CoulombLog = m_CoulombLog;
+
+    // Adaptive-mode per-cell cache of this tile, prepared by
+    // prepareAdaptiveCache (null pointers when the mode is off)
+    int const adaptive = m_adaptive;
+    Real const s_threshold = m_s_threshold;
+    int const refresh_int = m_refresh_int;
+    Real* AMREX_RESTRICT p_s_rate = nullptr;
+    Real* AMREX_RESTRICT p_pending = nullptr;
+    if ( adaptive )
+    {
+        auto const index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+        p_s_rate = m_s_rate[lev].at(index).dataPtr();
+        p_pending = m_pending_dt[lev].at(index).dataPtr();
+    }
+
     if ( isSameSpecies ) // species_1 == species_2
     {
         // Extract particles in the tile that `mfi` points to
         ParticleTileType& ptile_1 = species_1->ParticlesAt(lev, mfi);
 
-        // Find the particles that are in each cell of this tile
-        ParticleBins bins_1 = findParticlesInEachCell( lev, mfi, ptile_1 );
-
         // Loop over cells, and collide the particles in each cell
 
         // Extract low-level data
@@ -137,6 +196,7 @@ void CollisionType::doCoulombCollisionsWithinTile
         #elif (AMREX_SPACEDIM == 3)
         auto dV = geom.CellSize(0) * geom.CellSize(1) * geom.CellSize(2);
         #endif
+        const Real max_pending = refresh_int * dt;
 
         // Loop over cells
         amrex::ParallelFor( n_cells,
@@ -151,18 +211,39 @@ void CollisionType::doCoulombCollisionsWithinTile
                 // Do not collide if there is only one particle in the cell
                 if ( cell_stop_1 - cell_start_1 >= 2 )
                 {
+                    // Adaptive mode: if the expected scattering in this
+                    // cell is still small, accumulate the time step and
+                    // skip; otherwise collide over the accumulated time.
+                    Real dt_eff = dt;
+                    if ( adaptive )
+                    {
+                        Real const pending = p_pending[i_cell] + dt;
+                        if ( p_s_rate[i_cell] >= Real(0.0) &&
+                             p_s_rate[i_cell]*pending < s_threshold &&
+                             pending < max_pending )
+                        {
+                            p_pending[i_cell] = pending;
+                            return;
+                        }
+                        dt_eff = pending;
+                        p_pending[i_cell] = Real(0.0);
+                    }
+
                     // shuffle
                     ShuffleFisherYates(
                         indices_1, cell_start_1, cell_half_1 );
 
                     // Call the function in order to perform collisions
+                    Real mean_s = Real(0.0);
                     ElasticCollisionPerez(
                         cell_start_1, cell_half_1,
                         cell_half_1, cell_stop_1,
                         indices_1, indices_1,
                         ux_1, uy_1, uz_1, ux_1, uy_1, uz_1, w_1, w_1,
                         q1, q1, m1, m1, Real(-1.0), Real(-1.0),
-                        dt, CoulombLog, dV );
+                        dt_eff, CoulombLog, dV,
+                        adaptive ? &mean_s : nullptr );
+                    if ( adaptive ) { p_s_rate[i_cell] = mean_s / dt_eff; }
                 }
             }
         );
@@ -173,10 +254,6 @@ void CollisionType::doCoulombCollisionsWithinTile
         ParticleTileType& ptile_1 = species_1->ParticlesAt(lev, mfi);
         ParticleTileType& ptile_2 = species_2->ParticlesAt(lev, mfi);
 
-        // Find the particles that are in each cell of this tile
-        ParticleBins bins_1 = findParticlesInEachCell( lev, mfi, ptile_1 );
-        ParticleBins bins_2 = findParticlesInEachCell( lev, mfi, ptile_2 );
-
         // Loop over cells, and collide the particles in each cell
 
         // Extract low-level data
@@ -213,6 +290,7 @@ void CollisionType::doCoulombCollisionsWithinTile
         #elif (AMREX_SPACEDIM == 3)
         auto dV = geom.CellSize(0) * geom.CellSize(1) * geom.CellSize(2);
         #endif
+        const Real max_pending = refresh_int * dt;
 
         // Loop over cells
         amrex::ParallelFor( n_cells,
@@ -234,17 +312,38 @@ void CollisionType::doCoulombCollisionsWithinTile
                 if ( cell_stop_1 - cell_start_1 >= 1 &&
                      cell_stop_2 - cell_start_2 >= 1 )
                 {
+                    // Adaptive mode: if the expected scattering in this
+                    // cell is still small, accumulate the time step and
+                    // skip; otherwise collide over the accumulated time.
+                    Real dt_eff = dt;
+                    if ( adaptive )
+                    {
+                        Real const pending = p_pending[i_cell] + dt;
+                        if ( p_s_rate[i_cell] >= Real(0.0) &&
+                             p_s_rate[i_cell]*pending < s_threshold &&
+                             pending < max_pending )
+                        {
+                            p_pending[i_cell] = pending;
+                            return;
+                        }
+                        dt_eff = pending;
+                        p_pending[i_cell] = Real(0.0);
+                    }
+
                     // shuffle
                     ShuffleFisherYates(indices_1, cell_start_1, cell_stop_1);
                     ShuffleFisherYates(indices_2, cell_start_2, cell_stop_2);
 
                     // Call the function in order to perform collisions
+                    Real mean_s = Real(0.0);
                     ElasticCollisionPerez(
                         cell_start_1, cell_stop_1, cell_start_2, cell_stop_2,
                         indices_1, indices_2,
                         ux_1, uy_1, uz_1, ux_2, uy_2, uz_2, w_1, w_2,
                         q1, q2, m1, m2, Real(-1.0), Real(-1.0),
-                        dt, CoulombLog, dV );
+                        dt_eff, CoulombLog, dV,
+                        adaptive ? &mean_s : nullptr );
+                    if ( adaptive ) { p_s_rate[i_cell] = mean_s / dt_eff; }
                 }
             }
         );
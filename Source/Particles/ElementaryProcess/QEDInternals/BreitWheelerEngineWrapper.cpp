@@ -142,6 +142,7 @@ BreitWheelerEngine::init_lookup_tables_from_raw_data (
         cum_tab_data.begin(), cum_tab_data.end());
 
     //___________________________
+    m_innards.CopyTablesToDevice();
     m_lookup_tables_initialized = true;
 
     return true;
@@ -166,6 +167,7 @@ void BreitWheelerEngine::init_dummy_tables()
         QedUtils::BreitWheelerEngineInnardsDummy.cum_distrib_data.begin(),
         QedUtils::BreitWheelerEngineInnardsDummy.cum_distrib_data.end());
 
+    m_innards.CopyTablesToDevice();
     m_lookup_tables_initialized = true;
 }
 
@@ -216,6 +218,7 @@ void BreitWheelerEngine::compute_lookup_tables (
 {
 #ifdef WARPX_QED_TABLE_GEN
     m_table_builder.compute_table(ctrl, m_innards);
+    m_innards.CopyTablesToDevice();
     m_lookup_tables_initialized = true;
 #endif
 }
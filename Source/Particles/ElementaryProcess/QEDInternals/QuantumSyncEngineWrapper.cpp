@@ -141,6 +141,7 @@ QuantumSynchrotronEngine::init_lookup_tables_from_raw_data (
         cum_tab_data.begin(), cum_tab_data.end());
 
     //___________________________
+    m_innards.CopyTablesToDevice();
     m_lookup_tables_initialized = true;
 
     return true;
@@ -165,6 +166,7 @@ void QuantumSynchrotronEngine::init_dummy_tables()
         QedUtils::QuantumSyncEngineInnardsDummy.cum_distrib_data.begin(),
         QedUtils::QuantumSyncEngineInnardsDummy.cum_distrib_data.end());
 
+    m_innards.CopyTablesToDevice();
     m_lookup_tables_initialized = true;
 }
 
@@ -215,6 +217,7 @@ void QuantumSynchrotronEngine::compute_lookup_tables (
 {
 #ifdef WARPX_QED_TABLE_GEN
     m_table_builder.compute_table(ctrl, m_innards);
+    m_innards.CopyTablesToDevice();
     m_lookup_tables_initialized = true;
 #endif
 }
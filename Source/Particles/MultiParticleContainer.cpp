@@ -14,14 +14,35 @@
 #include "WarpX.H"
 
 #include <AMReX_Vector.H>
+#include <AMReX_Utility.H>
 
 #include <limits>
 #include <algorithm>
+#include <map>
 #include <string>
 
 
 using namespace amrex;
 
+namespace
+{
+    /** Reserve capacity in every component of a particle tile, so that a
+     *  subsequent resize up to n particles does not reallocate. */
+    template <typename PTile>
+    void reserveParticleTileCapacity (PTile& ptile, long n,
+                                      int nreal, int nint)
+    {
+        ptile.GetArrayOfStructs()().reserve(n);
+        auto& soa = ptile.GetStructOfArrays();
+        for (int i = 0; i < nreal; ++i) {
+            soa.GetRealData(i).reserve(n);
+        }
+        for (int i = 0; i < nint; ++i) {
+            soa.GetIntData(i).reserve(n);
+        }
+    }
+}
+
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
 {
 
@@ -62,6 +83,30 @@ MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
         }
     }
 
+    // Per-species temporal subcycling: species with push_interval > 1 are
+    // pushed every push_interval-th step only, against fields averaged
+    // over the interval. The average is accumulated once per step (see
+    // Evolve), so all subcycled species must share one interval.
+    for (int i = 0; i < nspecies; ++i) {
+        const int interval = allcontainers[i]->push_interval;
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(interval >= 1,
+            "<species>.push_interval must be >= 1");
+        if (interval > 1) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+                m_subcycling_interval == 1 || m_subcycling_interval == interval,
+                "all species with push_interval > 1 must use the same interval");
+            m_subcycling_interval = interval;
+        }
+    }
+    if (m_subcycling_interval > 1) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(amr_core->maxLevel() == 0,
+            "<species>.push_interval > 1 does not work with mesh refinement");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::do_subcycling == 0,
+            "<species>.push_interval > 1 cannot be combined with warpx.do_subcycling");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::do_moving_window == 0,
+            "<species>.push_interval > 1 does not work with the moving window");
+    }
+
     // collision
     allcollisions.resize(ncollisions);
     for (int i = 0; i < ncollisions; ++i) {
@@ -250,6 +295,10 @@ MultiParticleContainer::ReadParameters ()
         pp.query("use_fdtd_nci_corr", WarpX::use_fdtd_nci_corr);
         pp.query("l_lower_order_in_v", WarpX::l_lower_order_in_v);
 
+        pp.query("ionization_reserve_factor", m_ionization_reserve_factor);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_ionization_reserve_factor >= 1.,
+            "particles.ionization_reserve_factor must be >= 1");
+
         ParmParse ppl("lasers");
         ppl.query("nlasers", nlasers);
         AMREX_ALWAYS_ASSERT(nlasers >= 0);
@@ -321,9 +370,125 @@ MultiParticleContainer::Evolve (int lev,
     if (cjz) cjz->setVal(0.0);
     if (rho) rho->setVal(0.0);
     if (crho) crho->setVal(0.0);
+
+    // Temporal subcycling: accumulate the fields passed in every step, so
+    // that the subcycled species can gather the average of the fields over
+    // their push interval instead of an instantaneous snapshot.
+    bool subcycled_push_step = false;
+    if (m_subcycling_interval > 1)
+    {
+        const std::array<const MultiFab*,6> fields
+            {&Ex, &Ey, &Ez, &Bx, &By, &Bz};
+        if (m_avg_fields[0] == nullptr) {
+            for (int i = 0; i < 6; ++i) {
+                m_avg_fields[i].reset(new MultiFab(fields[i]->boxArray(),
+                                                   fields[i]->DistributionMap(),
+                                                   fields[i]->nComp(),
+                                                   fields[i]->nGrow()));
+                m_avg_fields[i]->setVal(0.0);
+            }
+        }
+        for (int i = 0; i < 6; ++i) {
+            MultiFab::Add(*m_avg_fields[i], *fields[i], 0, 0,
+                          fields[i]->nComp(), fields[i]->nGrow());
+        }
+        const int step = WarpX::GetInstance().getistep(lev);
+        subcycled_push_step = ((step+1) % m_subcycling_interval == 0);
+        if (subcycled_push_step) {
+            for (auto& f : m_avg_fields) {
+                f->mult(Real(1.)/m_subcycling_interval, 0, f->nComp(), f->nGrow());
+            }
+        }
+    }
+
+    // Build the gather context once per step: all species are defined on
+    // the same grids, so the per-box views of the fields and the parts of
+    // the gather set-up that do not depend on the species can be shared,
+    // instead of being re-derived by each species for each tile.
+    auto fill_gather_fields = [](GatherContext& ctx,
+                                 const MultiFab& ex, const MultiFab& ey,
+                                 const MultiFab& ez, const MultiFab& bx,
+                                 const MultiFab& by, const MultiFab& bz)
+    {
+        ctx.fields.resize(ex.local_size());
+        for (MFIter mfi(ex); mfi.isValid(); ++mfi) {
+            auto& box_fields = ctx.fields[mfi.LocalIndex()];
+            box_fields.ex = &(ex[mfi]);
+            box_fields.ey = &(ey[mfi]);
+            box_fields.ez = &(ez[mfi]);
+            box_fields.bx = &(bx[mfi]);
+            box_fields.by = &(by[mfi]);
+            box_fields.bz = &(bz[mfi]);
+        }
+    };
+    GatherContext gather_ctx;
+    fill_gather_fields(gather_ctx, Ex, Ey, Ez, Bx, By, Bz);
+    if (cEx) {
+        gather_ctx.cfields.resize(cEx->local_size());
+        for (MFIter mfi(*cEx); mfi.isValid(); ++mfi) {
+            auto& box_cfields = gather_ctx.cfields[mfi.LocalIndex()];
+            box_cfields.ex = &((*cEx)[mfi]);
+            box_cfields.ey = &((*cEy)[mfi]);
+            box_cfields.ez = &((*cEz)[mfi]);
+            box_cfields.bx = &((*cBx)[mfi]);
+            box_cfields.by = &((*cBy)[mfi]);
+            box_cfields.bz = &((*cBz)[mfi]);
+        }
+    }
+    gather_ctx.dx = WarpX::CellSize(lev);
+    gather_ctx.cdx = WarpX::CellSize(std::max(lev-1,0));
+    gather_ctx.time_shift = WarpX::GetInstance().gett_new(lev)
+                          - WarpX::GetInstance().time_of_last_gal_shift;
+
     for (auto& pc : allcontainers) {
+        // Subcycled species are handled after this loop: they advance
+        // only on their push step, against the time-averaged fields.
+        if (pc->push_interval > 1) continue;
+        // Species without particles on this level and rank (e.g. the
+        // product species of ionization or QED processes before any
+        // particle has been created, or laser antennas owned by other
+        // ranks) contribute nothing, but their Evolve still pays the
+        // per-species set-up and kernel-launch overhead, serialized
+        // across species. Skip them entirely. Species that do splitting
+        // cannot be skipped on a per-rank basis, because their
+        // splitting step is collective.
+        if (!pc->do_splitting &&
+            pc->NumberOfParticlesAtLevel(lev, true, true) == 0) continue;
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
-                   rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type);
+                   rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type,
+                   &gather_ctx);
+    }
+
+    if (subcycled_push_step)
+    {
+        // Advance the subcycled species over the whole interval at once:
+        // gather from the time-averaged fields and push with the
+        // accumulated dt. The current they deposit is scaled by the
+        // interval in DepositCurrent, so that its time integral over the
+        // interval as seen by the field update is preserved.
+        GatherContext avg_ctx;
+        fill_gather_fields(avg_ctx, *m_avg_fields[0], *m_avg_fields[1],
+                           *m_avg_fields[2], *m_avg_fields[3],
+                           *m_avg_fields[4], *m_avg_fields[5]);
+        avg_ctx.dx = gather_ctx.dx;
+        avg_ctx.cdx = gather_ctx.cdx;
+        avg_ctx.time_shift = gather_ctx.time_shift;
+        const Real sub_dt = dt*m_subcycling_interval;
+        for (auto& pc : allcontainers) {
+            if (pc->push_interval <= 1) continue;
+            if (!pc->do_splitting &&
+                pc->NumberOfParticlesAtLevel(lev, true, true) == 0) continue;
+            pc->Evolve(lev, *m_avg_fields[0], *m_avg_fields[1],
+                       *m_avg_fields[2], *m_avg_fields[3],
+                       *m_avg_fields[4], *m_avg_fields[5],
+                       jx, jy, jz, cjx, cjy, cjz, rho, crho,
+                       cEx, cEy, cEz, cBx, cBy, cBz, t, sub_dt, a_dt_type,
+                       &avg_ctx);
+        }
+        // Start accumulating the next interval from zero
+        for (auto& f : m_avg_fields) {
+            f->setVal(0.0);
+        }
     }
 }
 
@@ -368,6 +533,14 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
     }
 }
 
+void
+MultiParticleContainer::SortParticlesInPlace ()
+{
+    for (auto& pc : allcontainers) {
+        pc->SortParticlesInPlace();
+    }
+}
+
 void
 MultiParticleContainer::Redistribute ()
 {
@@ -376,6 +549,16 @@ MultiParticleContainer::Redistribute ()
     }
 }
 
+void
+MultiParticleContainer::PruneOutOfWindowParticles (int dir,
+                                                   amrex::Real window_lo,
+                                                   amrex::Real window_hi)
+{
+    for (auto& pc : allcontainers) {
+        pc->PruneOutOfWindowParticles(dir, window_lo, window_hi);
+    }
+}
+
 void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
@@ -510,6 +693,22 @@ MultiParticleContainer::ContinuousInjection (const RealBox& injection_box) const
     }
 }
 
+/* \brief Pre-generate the particles of the next continuous injection.
+ * \param injection_box: Domain where new particles are predicted to be
+ * injected. Loop over all WarpXParticleContainer in MultiParticleContainer
+ * and calls virtual function StageContinuousInjection.
+ */
+void
+MultiParticleContainer::StageContinuousInjection (const RealBox& injection_box) const
+{
+    for (int i=0; i<nspecies+nlasers; i++){
+        auto& pc = allcontainers[i];
+        if (pc->do_continuous_injection){
+            pc->StageContinuousInjection(injection_box);
+        }
+    }
+}
+
 /* \brief Update position of continuous injection parameters.
  * \param dt: simulation time step (level 0)
  * All classes inherited from WarpXParticleContainer do not have
@@ -631,6 +830,27 @@ MultiParticleContainer::doFieldIonization ()
         {
             const auto info = getMFItInfo(*pc_source, *pc_product);
 
+            // Serial pass: reserve capacity in the product tiles from the
+            // rolling yield estimates, so that the resize inside the
+            // particle creation does not reallocate in the middle of an
+            // ionization burst. This also creates the map entries, so the
+            // parallel loop below only updates existing values and never
+            // rehashes the map concurrently.
+            const int nreal = pc_product->NumRealComps();
+            const int nint = pc_product->NumIntComps();
+            for (MFIter mfi = pc_source->MakeMFIter(lev, info); mfi.isValid(); ++mfi)
+            {
+                const std::array<int,4> key
+                    {pc_source->species_id, lev, mfi.index(), mfi.LocalTileIndex()};
+                const long yield = m_ionization_yield[key];
+                if (yield > 0) {
+                    auto& dst_tile = pc_product->ParticlesAt(lev, mfi);
+                    const long target = dst_tile.numParticles()
+                        + static_cast<long>(m_ionization_reserve_factor*yield);
+                    reserveParticleTileCapacity(dst_tile, target, nreal, nint);
+                }
+            }
+
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -639,11 +859,27 @@ MultiParticleContainer::doFieldIonization ()
                 auto& src_tile = pc_source ->ParticlesAt(lev, mfi);
                 auto& dst_tile = pc_product->ParticlesAt(lev, mfi);
 
+                const std::array<int,4> key
+                    {pc_source->species_id, lev, mfi.index(), mfi.LocalTileIndex()};
+                auto& yield = m_ionization_yield.find(key)->second;
+
+                // In weakly ionized regions most tiles have no field
+                // above the ionization threshold: skip the filter and
+                // the particle-creation machinery for them, and let the
+                // yield estimate decay.
+                if (!phys_pc_ptr->TileHasIonizingField(src_tile)) {
+                    yield /= 2;
+                    continue;
+                }
+
                 const auto np_dst = dst_tile.numParticles();
                 const auto num_added = filterCopyTransformParticles<1>(dst_tile, src_tile, np_dst,
                                                                  Filter, Copy, Transform);
 
                 setNewParticleIDs(dst_tile, np_dst, num_added);
+
+                // Rolling average of this tile's yield
+                yield = (yield + static_cast<long>(num_added)) / 2;
             }
         }
     }
@@ -654,30 +890,63 @@ MultiParticleContainer::doCoulombCollisions ()
 {
     WARPX_PROFILE("MPC::doCoulombCollisions");
 
-    for (int i = 0; i < ncollisions; ++i)
-    {
-        auto& species1 = allcontainers[ allcollisions[i]->m_species1_index ];
-        auto& species2 = allcontainers[ allcollisions[i]->m_species2_index ];
+    if (ncollisions == 0) return;
+
+    // All species share the same grids, so a single tile loop serves
+    // every collision pair.
+    auto& species0 = allcontainers[ allcollisions[0]->m_species1_index ];
+
+    // Enable tiling
+    MFItInfo info;
+    if (Gpu::notInLaunchRegion()) info.EnableTiling(species0->tile_size);
 
-        // Enable tiling
-        MFItInfo info;
-        if (Gpu::notInLaunchRegion()) info.EnableTiling(species1->tile_size);
+    // Loop over refinement levels
+    for (int lev = 0; lev <= species0->finestLevel(); ++lev){
 
-        // Loop over refinement levels
-        for (int lev = 0; lev <= species1->finestLevel(); ++lev){
+        // Create/resize the adaptive-mode per-cell caches in a serial
+        // pass: the tiled loop below distributes tiles among threads.
+        for (MFIter mfi = species0->MakeMFIter(lev, info); mfi.isValid(); ++mfi){
+            for (int i = 0; i < ncollisions; ++i){
+                allcollisions[i]->prepareAdaptiveCache(lev, mfi);
+            }
+        }
 
-            // Loop over all grids/tiles at this level
+        // Loop over all grids/tiles at this level
 #ifdef _OPENMP
-            info.SetDynamic(true);
+        info.SetDynamic(true);
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-            for (MFIter mfi = species1->MakeMFIter(lev, info); mfi.isValid(); ++mfi){
+        for (MFIter mfi = species0->MakeMFIter(lev, info); mfi.isValid(); ++mfi){
+
+            // A species usually takes part in several collision pairs:
+            // find the particles that are in each cell of this tile only
+            // once per species, and reuse the cell ranges for every pair.
+            std::map<int, CollisionType::CollisionBins> bins_map;
+            auto GetBins = [&] (int const species_index)
+                -> CollisionType::CollisionBins&
+            {
+                auto it = bins_map.find(species_index);
+                if (it == bins_map.end()) {
+                    it = bins_map.emplace(species_index,
+                        CollisionType::findParticlesInEachCell(
+                            lev, mfi,
+                            allcontainers[species_index]->ParticlesAt(lev, mfi))
+                        ).first;
+                }
+                return it->second;
+            };
+
+            for (int i = 0; i < ncollisions; ++i)
+            {
+                auto& species1 = allcontainers[ allcollisions[i]->m_species1_index ];
+                auto& species2 = allcontainers[ allcollisions[i]->m_species2_index ];
 
-                CollisionType::doCoulombCollisionsWithinTile
-                    ( lev, mfi, species1, species2,
-                      allcollisions[i]->m_isSameSpecies,
-                      allcollisions[i]->m_CoulombLog );
+                auto& bins1 = GetBins(allcollisions[i]->m_species1_index);
+                auto& bins2 = allcollisions[i]->m_isSameSpecies ?
+                    bins1 : GetBins(allcollisions[i]->m_species2_index);
 
+                allcollisions[i]->doCoulombCollisionsWithinTile
+                    ( lev, mfi, species1, species2, bins1, bins2 );
             }
         }
     }
@@ -819,6 +1088,66 @@ void MultiParticleContainer::InitBreitWheeler ()
     }
 }
 
+namespace
+{
+    /**
+     * Checks if two sets of Quantum Synchrotron table generation parameters
+     * are identical, to determine if a table found on disk can be reused
+     * instead of being regenerated.
+     */
+    bool
+    IsSameQedCtrl (
+        const PicsarQuantumSynchrotronCtrl& ctrl_1,
+        const PicsarQuantumSynchrotronCtrl& ctrl_2)
+    {
+        return
+            ctrl_1.chi_part_min == ctrl_2.chi_part_min &&
+            ctrl_1.chi_part_tdndt_min == ctrl_2.chi_part_tdndt_min &&
+            ctrl_1.chi_part_tdndt_max == ctrl_2.chi_part_tdndt_max &&
+            ctrl_1.chi_part_tdndt_how_many == ctrl_2.chi_part_tdndt_how_many &&
+            ctrl_1.chi_part_tem_min == ctrl_2.chi_part_tem_min &&
+            ctrl_1.chi_part_tem_max == ctrl_2.chi_part_tem_max &&
+            ctrl_1.chi_part_tem_how_many == ctrl_2.chi_part_tem_how_many &&
+            ctrl_1.prob_tem_how_many == ctrl_2.prob_tem_how_many;
+    }
+
+    /**
+     * Checks if two sets of Breit Wheeler table generation parameters
+     * are identical, to determine if a table found on disk can be reused
+     * instead of being regenerated.
+     */
+    bool
+    IsSameQedCtrl (
+        const PicsarBreitWheelerCtrl& ctrl_1,
+        const PicsarBreitWheelerCtrl& ctrl_2)
+    {
+        return
+            ctrl_1.chi_phot_min == ctrl_2.chi_phot_min &&
+            ctrl_1.chi_phot_tdndt_min == ctrl_2.chi_phot_tdndt_min &&
+            ctrl_1.chi_phot_tdndt_max == ctrl_2.chi_phot_tdndt_max &&
+            ctrl_1.chi_phot_tdndt_how_many == ctrl_2.chi_phot_tdndt_how_many &&
+            ctrl_1.chi_phot_tpair_min == ctrl_2.chi_phot_tpair_min &&
+            ctrl_1.chi_phot_tpair_max == ctrl_2.chi_phot_tpair_max &&
+            ctrl_1.chi_phot_tpair_how_many == ctrl_2.chi_phot_tpair_how_many &&
+            ctrl_1.chi_frac_tpair_how_many == ctrl_2.chi_frac_tpair_how_many;
+    }
+
+    /**
+     * Broadcasts raw lookup table data from the I/O processor
+     * to all the other processors.
+     */
+    void
+    BcastTableData (amrex::Vector<char>& table_data)
+    {
+        auto data_size = static_cast<unsigned long>(table_data.size());
+        ParallelDescriptor::Bcast(&data_size, 1,
+            ParallelDescriptor::IOProcessorNumber());
+        table_data.resize(data_size);
+        ParallelDescriptor::Bcast(table_data.data(), data_size,
+            ParallelDescriptor::IOProcessorNumber());
+    }
+}
+
 void
 MultiParticleContainer::QuantumSyncGenerateTable ()
 {
@@ -828,75 +1157,100 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     if(table_name.empty())
         amrex::Abort("qed_qs.save_table_in should be provided!");
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSynchrotronCtrl ctrl;
-        int t_int;
-
-        // Engine paramenter: chi_part_min is the minium chi parameter to be
-        // considered by the engine. If a lepton has chi < chi_part_min,
-        // the optical depth is not evolved and photon generation is ignored
-        if(!pp.query("chi_min", ctrl.chi_part_min))
-            amrex::Abort("qed_qs.chi_min should be provided!");
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a lepton has chi < chi_part_tdndt_min,
-        //chi is considered as it were equal to chi_part_tdndt_min
-        if(!pp.query("tab_dndt_chi_min", ctrl.chi_part_tdndt_min))
-            amrex::Abort("qed_qs.tab_dndt_chi_min should be provided!");
-
-        //Maximum chi for the table. If a lepton has chi > chi_part_tdndt_max,
-        //chi is considered as it were equal to chi_part_tdndt_max
-        if(!pp.query("tab_dndt_chi_max", ctrl.chi_part_tdndt_max))
-            amrex::Abort("qed_qs.tab_dndt_chi_max should be provided!");
-
-        //How many points should be used for chi in the table
-        if(!pp.query("tab_dndt_how_many", t_int))
-            amrex::Abort("qed_qs.tab_dndt_how_many should be provided!");
-        ctrl.chi_part_tdndt_how_many = t_int;
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
-
-        //Minimun chi for the table. If a lepton has chi < chi_part_tem_min,
-        //chi is considered as it were equal to chi_part_tem_min
-        if(!pp.query("tab_em_chi_min", ctrl.chi_part_tem_min))
-            amrex::Abort("qed_qs.tab_em_chi_min should be provided!");
-
-        //Maximum chi for the table. If a lepton has chi > chi_part_tem_max,
-        //chi is considered as it were equal to chi_part_tem_max
-        if(!pp.query("tab_em_chi_max", ctrl.chi_part_tem_max))
-            amrex::Abort("qed_qs.tab_em_chi_max should be provided!");
-
-        //How many points should be used for chi in the table
-        if(!pp.query("tab_em_chi_how_many", t_int))
-            amrex::Abort("qed_qs.tab_em_chi_how_many should be provided!");
-        ctrl.chi_part_tem_how_many = t_int;
-
-        //The other axis of the table is a cumulative probability distribution
-        //(corresponding to different energies of the generated particles)
-        //This parameter is the number of different points to consider
-        if(!pp.query("tab_em_prob_how_many", t_int))
-            amrex::Abort("qed_qs.tab_em_prob_how_many should be provided!");
-        ctrl.prob_tem_how_many = t_int;
-        //====================
+    PicsarQuantumSynchrotronCtrl ctrl;
+    int t_int;
+
+    // Engine paramenter: chi_part_min is the minium chi parameter to be
+    // considered by the engine. If a lepton has chi < chi_part_min,
+    // the optical depth is not evolved and photon generation is ignored
+    if(!pp.query("chi_min", ctrl.chi_part_min))
+        amrex::Abort("qed_qs.chi_min should be provided!");
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a lepton has chi < chi_part_tdndt_min,
+    //chi is considered as it were equal to chi_part_tdndt_min
+    if(!pp.query("tab_dndt_chi_min", ctrl.chi_part_tdndt_min))
+        amrex::Abort("qed_qs.tab_dndt_chi_min should be provided!");
+
+    //Maximum chi for the table. If a lepton has chi > chi_part_tdndt_max,
+    //chi is considered as it were equal to chi_part_tdndt_max
+    if(!pp.query("tab_dndt_chi_max", ctrl.chi_part_tdndt_max))
+        amrex::Abort("qed_qs.tab_dndt_chi_max should be provided!");
+
+    //How many points should be used for chi in the table
+    if(!pp.query("tab_dndt_how_many", t_int))
+        amrex::Abort("qed_qs.tab_dndt_how_many should be provided!");
+    ctrl.chi_part_tdndt_how_many = t_int;
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
+
+    //Minimun chi for the table. If a lepton has chi < chi_part_tem_min,
+    //chi is considered as it were equal to chi_part_tem_min
+    if(!pp.query("tab_em_chi_min", ctrl.chi_part_tem_min))
+        amrex::Abort("qed_qs.tab_em_chi_min should be provided!");
+
+    //Maximum chi for the table. If a lepton has chi > chi_part_tem_max,
+    //chi is considered as it were equal to chi_part_tem_max
+    if(!pp.query("tab_em_chi_max", ctrl.chi_part_tem_max))
+        amrex::Abort("qed_qs.tab_em_chi_max should be provided!");
+
+    //How many points should be used for chi in the table
+    if(!pp.query("tab_em_chi_how_many", t_int))
+        amrex::Abort("qed_qs.tab_em_chi_how_many should be provided!");
+    ctrl.chi_part_tem_how_many = t_int;
+
+    //The other axis of the table is a cumulative probability distribution
+    //(corresponding to different energies of the generated particles)
+    //This parameter is the number of different points to consider
+    if(!pp.query("tab_em_prob_how_many", t_int))
+        amrex::Abort("qed_qs.tab_em_prob_how_many should be provided!");
+    ctrl.prob_tem_how_many = t_int;
+    //====================
+
+    //If a table generated with exactly the same parameters is already
+    //on disk, load it instead of regenerating it (table generation can
+    //take a very long time).
+    int table_exists = 0;
+    if(ParallelDescriptor::IOProcessor())
+        table_exists = FileExists(table_name);
+    ParallelDescriptor::Bcast(&table_exists, 1,
+        ParallelDescriptor::IOProcessorNumber());
+
+    if(table_exists){
+        Vector<char> table_data;
+        ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
+        ParallelDescriptor::Barrier();
+        if(m_shr_p_qs_engine->init_lookup_tables_from_raw_data(table_data) &&
+            IsSameQedCtrl(m_shr_p_qs_engine->get_ref_ctrl(), ctrl)){
+            amrex::Print() << "Reusing Quantum Synchrotron table found in " <<
+                table_name << "\n";
+            return;
+        }
+        amrex::Print() << "Table in " << table_name <<
+            " does not match the requested parameters: regenerating it. \n";
+    }
 
+    if(ParallelDescriptor::IOProcessor()){
         m_shr_p_qs_engine->compute_lookup_tables(ctrl);
         WarpXUtilIO::WriteBinaryDataOnFile(table_name,
             m_shr_p_qs_engine->export_lookup_tables_data());
     }
 
-    ParallelDescriptor::Barrier();
+    //Broadcast the freshly generated table directly, instead of having
+    //every processor read it back from the filesystem.
     Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    if(ParallelDescriptor::IOProcessor())
+        table_data = m_shr_p_qs_engine->export_lookup_tables_data();
+    BcastTableData(table_data);
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
@@ -914,75 +1268,100 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     if(table_name.empty())
         amrex::Abort("qed_bw.save_table_in should be provided!");
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
-        int t_int;
-
-        // Engine paramenter: chi_phot_min is the minium chi parameter to be
-        // considered by the engine. If a photon has chi < chi_phot_min,
-        // the optical depth is not evolved and pair generation is ignored
-        if(!pp.query("chi_min", ctrl.chi_phot_min))
-            amrex::Abort("qed_bw.chi_min should be provided!");
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a photon has chi < chi_phot_tdndt_min,
-        //an analytical approximation is used.
-        if(!pp.query("tab_dndt_chi_min", ctrl.chi_phot_tdndt_min))
-            amrex::Abort("qed_bw.tab_dndt_chi_min should be provided!");
-
-        //Maximum chi for the table. If a photon has chi > chi_phot_tdndt_min,
-        //an analytical approximation is used.
-        if(!pp.query("tab_dndt_chi_max", ctrl.chi_phot_tdndt_max))
-            amrex::Abort("qed_bw.tab_dndt_chi_max should be provided!");
-
-        //How many points should be used for chi in the table
-        if(!pp.query("tab_dndt_how_many", t_int))
-            amrex::Abort("qed_bw.tab_dndt_how_many should be provided!");
-        ctrl.chi_phot_tdndt_how_many = t_int;
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
-
-        //Minimun chi for the table. If a photon has chi < chi_phot_tpair_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        if(!pp.query("tab_pair_chi_min", ctrl.chi_phot_tpair_min))
-            amrex::Abort("qed_bw.tab_pair_chi_min should be provided!");
-
-        //Maximum chi for the table. If a photon has chi > chi_phot_tpair_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        if(!pp.query("tab_pair_chi_max", ctrl.chi_phot_tpair_max))
-            amrex::Abort("qed_bw.tab_pair_chi_max should be provided!");
-
-        //How many points should be used for chi in the table
-        if(!pp.query("tab_pair_chi_how_many", t_int))
-            amrex::Abort("qed_bw.tab_pair_chi_how_many should be provided!");
-        ctrl.chi_phot_tpair_how_many = t_int;
-
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        if(!pp.query("tab_pair_frac_how_many", t_int))
-            amrex::Abort("qed_bw.tab_pair_frac_how_many should be provided!");
-        ctrl.chi_frac_tpair_how_many = t_int;
-        //====================
+    PicsarBreitWheelerCtrl ctrl;
+    int t_int;
+
+    // Engine paramenter: chi_phot_min is the minium chi parameter to be
+    // considered by the engine. If a photon has chi < chi_phot_min,
+    // the optical depth is not evolved and pair generation is ignored
+    if(!pp.query("chi_min", ctrl.chi_phot_min))
+        amrex::Abort("qed_bw.chi_min should be provided!");
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a photon has chi < chi_phot_tdndt_min,
+    //an analytical approximation is used.
+    if(!pp.query("tab_dndt_chi_min", ctrl.chi_phot_tdndt_min))
+        amrex::Abort("qed_bw.tab_dndt_chi_min should be provided!");
+
+    //Maximum chi for the table. If a photon has chi > chi_phot_tdndt_min,
+    //an analytical approximation is used.
+    if(!pp.query("tab_dndt_chi_max", ctrl.chi_phot_tdndt_max))
+        amrex::Abort("qed_bw.tab_dndt_chi_max should be provided!");
+
+    //How many points should be used for chi in the table
+    if(!pp.query("tab_dndt_how_many", t_int))
+        amrex::Abort("qed_bw.tab_dndt_how_many should be provided!");
+    ctrl.chi_phot_tdndt_how_many = t_int;
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
+
+    //Minimun chi for the table. If a photon has chi < chi_phot_tpair_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    if(!pp.query("tab_pair_chi_min", ctrl.chi_phot_tpair_min))
+        amrex::Abort("qed_bw.tab_pair_chi_min should be provided!");
+
+    //Maximum chi for the table. If a photon has chi > chi_phot_tpair_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    if(!pp.query("tab_pair_chi_max", ctrl.chi_phot_tpair_max))
+        amrex::Abort("qed_bw.tab_pair_chi_max should be provided!");
+
+    //How many points should be used for chi in the table
+    if(!pp.query("tab_pair_chi_how_many", t_int))
+        amrex::Abort("qed_bw.tab_pair_chi_how_many should be provided!");
+    ctrl.chi_phot_tpair_how_many = t_int;
+
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    if(!pp.query("tab_pair_frac_how_many", t_int))
+        amrex::Abort("qed_bw.tab_pair_frac_how_many should be provided!");
+    ctrl.chi_frac_tpair_how_many = t_int;
+    //====================
+
+    //If a table generated with exactly the same parameters is already
+    //on disk, load it instead of regenerating it (table generation can
+    //take a very long time).
+    int table_exists = 0;
+    if(ParallelDescriptor::IOProcessor())
+        table_exists = FileExists(table_name);
+    ParallelDescriptor::Bcast(&table_exists, 1,
+        ParallelDescriptor::IOProcessorNumber());
+
+    if(table_exists){
+        Vector<char> table_data;
+        ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
+        ParallelDescriptor::Barrier();
+        if(m_shr_p_bw_engine->init_lookup_tables_from_raw_data(table_data) &&
+            IsSameQedCtrl(m_shr_p_bw_engine->get_ref_ctrl(), ctrl)){
+            amrex::Print() << "Reusing Breit Wheeler table found in " <<
+                table_name << "\n";
+            return;
+        }
+        amrex::Print() << "Table in " << table_name <<
+            " does not match the requested parameters: regenerating it. \n";
+    }
 
+    if(ParallelDescriptor::IOProcessor()){
         m_shr_p_bw_engine->compute_lookup_tables(ctrl);
         WarpXUtilIO::WriteBinaryDataOnFile(table_name,
             m_shr_p_bw_engine->export_lookup_tables_data());
     }
 
-    ParallelDescriptor::Barrier();
+    //Broadcast the freshly generated table directly, instead of having
+    //every processor read it back from the filesystem.
     Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    if(ParallelDescriptor::IOProcessor())
+        table_data = m_shr_p_bw_engine->export_lookup_tables_data();
+    BcastTableData(table_data);
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
@@ -7,6 +7,7 @@
  */
 #include "PhotonParticleContainer.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 // Import low-level single-particle kernels
@@ -81,6 +82,49 @@ PhotonParticleContainer::PushPX(WarpXParIter& pti, Real dt, DtType /*a_dt_type*/
     const auto GetPosition = GetParticlePosition(pti);
           auto SetPosition = SetParticlePosition(pti);
 
+#ifdef WARPX_QED
+    if (has_breit_wheeler())
+    {
+        // Evolve the Breit-Wheeler optical depth in the same loop as the
+        // position update, so that each photon is read only once per step
+        const ParticleReal* const AMREX_RESTRICT Ex = attribs[PIdx::Ex].dataPtr();
+        const ParticleReal* const AMREX_RESTRICT Ey = attribs[PIdx::Ey].dataPtr();
+        const ParticleReal* const AMREX_RESTRICT Ez = attribs[PIdx::Ez].dataPtr();
+        const ParticleReal* const AMREX_RESTRICT Bx = attribs[PIdx::Bx].dataPtr();
+        const ParticleReal* const AMREX_RESTRICT By = attribs[PIdx::By].dataPtr();
+        const ParticleReal* const AMREX_RESTRICT Bz = attribs[PIdx::Bz].dataPtr();
+
+        BreitWheelerEvolveOpticalDepth evolve_opt =
+            m_shr_p_bw_engine->build_evolve_functor();
+
+        amrex::Real* AMREX_RESTRICT p_optical_depth_BW =
+            pti.GetAttribs(particle_comps["optical_depth_BW"]).dataPtr();
+
+        const auto me = PhysConst::m_e;
+
+        amrex::ParallelFor(
+            pti.numParticles(),
+            [=] AMREX_GPU_DEVICE (long i) {
+                ParticleReal x, y, z;
+                GetPosition(i, x, y, z);
+                UpdatePositionPhoton( x, y, z, ux[i], uy[i], uz[i], dt );
+                SetPosition(i, x, y, z);
+
+                const ParticleReal px = me * ux[i];
+                const ParticleReal py = me * uy[i];
+                const ParticleReal pz = me * uz[i];
+
+                bool has_event_happened = evolve_opt(
+                    px, py, pz,
+                    Ex[i], Ey[i], Ez[i],
+                    Bx[i], By[i], Bz[i],
+                    dt, p_optical_depth_BW[i]);
+            }
+        );
+        return;
+    }
+#endif
+
     amrex::ParallelFor(
         pti.numParticles(),
         [=] AMREX_GPU_DEVICE (long i) {
@@ -101,65 +145,69 @@ PhotonParticleContainer::Evolve (int lev,
                                  MultiFab* rho, MultiFab* crho,
                                  const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                  const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                 Real t, Real dt, DtType /*a_dt_type*/)
+                                 Real t, Real dt, DtType a_dt_type,
+                                 const GatherContext* a_gather_ctx)
 {
-    // This does gather, push and depose.
-    // Push and depose have been re-written for photon,
-    // so they do not do anything.
-    PhysicalParticleContainer::Evolve (lev,
-                                       Ex, Ey, Ez,
-                                       Bx, By, Bz,
-                                       jx, jy, jz,
-                                       cjx, cjy, cjz,
-                                       rho, crho,
-                                       cEx, cEy, cEz,
-                                       cBx, cBy, cBz,
-                                       t, dt);
-
-}
-
 #ifdef WARPX_QED
-
-void
-PhotonParticleContainer::EvolveOpticalDepth(
-    WarpXParIter& pti,amrex::Real dt)
-{
-    if(!has_breit_wheeler())
+    if (has_breit_wheeler()) {
+        // Photons subject to Breit-Wheeler pair production need the fields
+        // gathered to their positions: use the generic path, where the
+        // photon PushPX fuses the optical depth evolution with the
+        // position update (push and depose still do not do anything).
+        PhysicalParticleContainer::Evolve (lev,
+                                           Ex, Ey, Ez,
+                                           Bx, By, Bz,
+                                           jx, jy, jz,
+                                           cjx, cjy, cjz,
+                                           rho, crho,
+                                           cEx, cEy, cEz,
+                                           cBx, cBy, cBz,
+                                           t, dt, DtType::Full, a_gather_ctx);
         return;
+    }
+#endif
 
-    auto& attribs = pti.GetAttribs();
-    ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
-    ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
-    ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ex = attribs[PIdx::Ex].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ey = attribs[PIdx::Ey].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ez = attribs[PIdx::Ez].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Bx = attribs[PIdx::Bx].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT By = attribs[PIdx::By].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Bz = attribs[PIdx::Bz].dataPtr();
-
-    BreitWheelerEvolveOpticalDepth evolve_opt =
-        m_shr_p_bw_engine->build_evolve_functor();
+    // Without QED effects, photons do not see the fields and deposit no
+    // current or charge: the only remaining work is the ballistic position
+    // update, done here in a dedicated loop with no field gather, no
+    // buffer partitioning and no deposition.
+    WARPX_PROFILE("PhotonPC::Evolve()");
 
-    amrex::Real* AMREX_RESTRICT p_optical_depth_BW =
-        pti.GetAttribs(particle_comps["optical_depth_BW"]).dataPtr();
+    if (do_not_push) return;
 
-    const auto me = PhysConst::m_e;
+    amrex::Vector<amrex::Real>* cost = WarpX::getCosts(lev);
 
-    amrex::ParallelFor(
-        pti.numParticles(),
-        [=] AMREX_GPU_DEVICE (long i) {
-            const ParticleReal px = me * ux[i];
-            const ParticleReal py = me * uy[i];
-            const ParticleReal pz = me * uz[i];
-
-            bool has_event_happened = evolve_opt(
-                px, py, pz,
-                Ex[i], Ey[i], Ez[i],
-                Bx[i], By[i], Bz[i],
-                dt, p_optical_depth_BW[i]);
+    if (WarpX::do_back_transformed_diagnostics && do_back_transformed_diagnostics)
+    {
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const auto np = pti.numParticles();
+            const auto t_lev = pti.GetLevel();
+            const auto index = pti.GetPairIndex();
+            tmp_particle_data.resize(finestLevel()+1);
+            for (int i = 0; i < TmpIdx::nattribs; ++i)
+                tmp_particle_data[t_lev][index][i].resize(np);
         }
-        );
-}
+    }
 
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
+    for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+    {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = amrex::second();
+
+        PushPX(pti, dt, a_dt_type);
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = amrex::second() - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+        }
+    }
+}
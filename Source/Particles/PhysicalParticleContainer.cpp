@@ -13,10 +13,14 @@
 #include "MultiParticleContainer.H"
 #include "WarpX.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXRandomPool.H"
+#include "Utils/WarpXThroughputCounters.H"
 #include "Utils/WarpXUtil.H"
 #include "Python/WarpXWrappers.h"
 #include "Utils/IonizationEnergiesTable.H"
 #include "Particles/Gather/FieldGather.H"
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Filter/FilterFunctors.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
 
 #include "Utils/WarpXAlgorithmSelection.H"
@@ -28,6 +32,8 @@
 #include "Particles/Pusher/UpdateMomentumBorisWithRadiationReaction.H"
 #include "Particles/Pusher/UpdateMomentumHigueraCary.H"
 
+#include <AMReX_GpuContainers.H>
+
 #include <limits>
 #include <sstream>
 #include <string>
@@ -56,6 +62,10 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp.query("do_not_deposit", do_not_deposit);
     pp.query("do_not_gather", do_not_gather);
     pp.query("do_not_push", do_not_push);
+    // Temporal subcycling: push this species only every push_interval-th step
+    pp.query("push_interval", push_interval);
+
+    pp.query("do_injection_culling", do_injection_culling);
 
     pp.query("do_continuous_injection", do_continuous_injection);
     pp.query("initialize_self_fields", initialize_self_fields);
@@ -559,6 +569,18 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         // discaded
         int max_new_particles = overlap_box.numPts() * num_ppc;
 
+        // Injection-region culling (<species>.do_injection_culling):
+        // probe the density profile once per cell and list only the
+        // cells where it is nonzero, so that the creation kernel below
+        // runs over the compressed cell list instead of the whole
+        // overlap box. Not combined with refined injection, which
+        // builds its own cell list.
+        bool do_culling = do_injection_culling and not refine_injection;
+#ifdef WARPX_DIM_RZ
+        // In RZ the density is sampled at an angle drawn per particle
+        do_culling = false;
+#endif
+
         // If refine injection, build pointer dp_cellid that holds pointer to
         // array of refined cell IDs.
         Vector<int> cellid_v;
@@ -580,6 +602,75 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                 }
             }
         }
+        else if (do_culling)
+        {
+            // A cell is kept when the density at one of its corners or at
+            // its center is nonzero (and above the density_min cutoff, so
+            // that every particle drawn in a dropped cell would have been
+            // discarded by the kernel below anyway). The density is probed
+            // at the same position the kernel evaluates it at, including
+            // the ballistic correction and the boosted-frame mapping.
+            auto probe = [&] (Real x, Real y, Real z) -> bool
+            {
+                Real z0;
+                if (gamma_boost == 1._rt) {
+                    const XDim3 u_bulk = inj_mom->getBulkMomentum(x, y, z);
+                    const Real gamma_bulk = std::sqrt(1._rt +
+                        (u_bulk.x*u_bulk.x+u_bulk.y*u_bulk.y+u_bulk.z*u_bulk.z));
+                    z0 = z - PhysConst::c*t*(u_bulk.z/gamma_bulk);
+                } else {
+                    const XDim3 u_bulk = inj_mom->getBulkMomentum(x, y, 0.);
+                    const Real gamma_lab_bulk = std::sqrt(1._rt +
+                        (u_bulk.x*u_bulk.x+u_bulk.y*u_bulk.y+u_bulk.z*u_bulk.z));
+                    const Real betaz_lab_bulk = u_bulk.z/gamma_lab_bulk;
+                    z0 = gamma_boost * ( z*(1._rt-beta_boost*betaz_lab_bulk)
+                        - PhysConst::c*t*(betaz_lab_bulk-beta_boost) );
+                }
+                const Real dens = inj_rho->getDensity(x, y, z0);
+                return (dens > 0._rt) and (dens >= density_min);
+            };
+            for (int icell = 0, ncells = overlap_box.numPts(); icell < ncells; ++icell)
+            {
+                const IntVect iv = overlap_box.atOffset(icell);
+                bool occupied = false;
+#if (AMREX_SPACEDIM == 3)
+                for (int kk = 0; kk <= 1 and not occupied; ++kk) {
+                for (int jj = 0; jj <= 1 and not occupied; ++jj) {
+                for (int ii = 0; ii <= 1 and not occupied; ++ii) {
+                    occupied = probe(overlap_realbox.lo(0) + (iv[0]+ii)*dx[0],
+                                     overlap_realbox.lo(1) + (iv[1]+jj)*dx[1],
+                                     overlap_realbox.lo(2) + (iv[2]+kk)*dx[2]);
+                }}}
+                if (not occupied) {
+                    occupied = probe(overlap_realbox.lo(0) + (iv[0]+0.5_rt)*dx[0],
+                                     overlap_realbox.lo(1) + (iv[1]+0.5_rt)*dx[1],
+                                     overlap_realbox.lo(2) + (iv[2]+0.5_rt)*dx[2]);
+                }
+#else
+                for (int jj = 0; jj <= 1 and not occupied; ++jj) {
+                for (int ii = 0; ii <= 1 and not occupied; ++ii) {
+                    occupied = probe(overlap_realbox.lo(0) + (iv[0]+ii)*dx[0],
+                                     0.0,
+                                     overlap_realbox.lo(1) + (iv[1]+jj)*dx[1]);
+                }}
+                if (not occupied) {
+                    occupied = probe(overlap_realbox.lo(0) + (iv[0]+0.5_rt)*dx[0],
+                                     0.0,
+                                     overlap_realbox.lo(1) + (iv[1]+0.5_rt)*dx[1]);
+                }
+#endif
+                if (occupied) {
+                    for (int i_part = 0; i_part < num_ppc; ++i_part) {
+                        cellid_v.push_back(icell);
+                        cellid_v.push_back(i_part);
+                    }
+                }
+            }
+            max_new_particles = static_cast<int>(cellid_v.size()) / 2;
+            if (max_new_particles == 0) {
+                continue; // No occupied cell overlaps this tile
+            }
+        }
         int const* hp_cellid = (cellid_v.empty()) ? nullptr : cellid_v.data();
         amrex::AsyncArray<int> cellid_aa(hp_cellid, cellid_v.size());
         int const* dp_cellid = cellid_aa.data();
@@ -595,9 +686,20 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         }
         const int cpuid = ParallelDescriptor::MyProc();
 
-        auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
+        // Pool of per-thread random-number engines: each generated particle
+        // gets its own engine below, keyed by its (unique) particle ID, so
+        // that random sampling does not contend on shared generator state.
+        const WarpXRandomPool rand_pool = WarpXRandomPool::GetPool();
 
-        if ( (NumRuntimeRealComps()>0) || (NumRuntimeIntComps()>0) ) {
+        // When staging the next continuous injection, the new particles go
+        // into the staging buffer (whose tiles were defined beforehand)
+        // instead of the valid particle tiles.
+        auto& particle_tile = (m_inject_into_staging) ?
+            m_staged_injection[std::make_pair(grid_id,tile_id)] :
+            GetParticles(lev)[std::make_pair(grid_id,tile_id)];
+
+        if ( !m_inject_into_staging &&
+             ((NumRuntimeRealComps()>0) || (NumRuntimeIntComps()>0)) ) {
             DefineAndReturnParticleTile(lev, grid_id, tile_id);
         }
 
@@ -666,6 +768,8 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
             p.id() = pid+ip;
             p.cpu() = cpuid;
 
+            WarpXRandomEngine engine = rand_pool.Engine(pid+ip);
+
             int cellid, i_part;
             Real fac;
             if (dp_cellid == nullptr) {
@@ -681,7 +785,8 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
             IntVect iv = overlap_box.atOffset(cellid);
 
             const XDim3 r =
-                inj_pos->getPositionUnitBox(i_part, static_cast<int>(fac));
+                inj_pos->getPositionUnitBox(i_part, static_cast<int>(fac),
+                                            engine);
 #if (AMREX_SPACEDIM == 3)
             Real x = overlap_corner[0] + (iv[0]+r.x)*dx[0];
             Real y = overlap_corner[1] + (iv[1]+r.y)*dx[1];
@@ -721,7 +826,7 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
             if (nmodes == 1) {
                 // With only 1 mode, the angle doesn't matter so
                 // choose it randomly.
-                theta = 2.*MathConst::pi*amrex::Random();
+                theta = 2.*MathConst::pi*engine.Random();
             } else {
                 theta = 2.*MathConst::pi*r.y;
             }
@@ -748,7 +853,7 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                     return;
                 }
 
-                u = inj_mom->getMomentum(x, y, z0);
+                u = inj_mom->getMomentum(x, y, z0, engine);
                 dens = inj_rho->getDensity(x, y, z0);
                 // Remove particle if density below threshold
                 if ( dens < density_min ){
@@ -795,7 +900,7 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                 dens = amrex::min(dens, density_max);
 
                 // get the full momentum, including thermal motion
-                u = inj_mom->getMomentum(x, y, 0.);
+                u = inj_mom->getMomentum(x, y, 0., engine);
                 const Real gamma_lab = std::sqrt( 1.+(u.x*u.x+u.y*u.y+u.z*u.z) );
                 const Real betaz_lab = u.z/(gamma_lab);
 
@@ -811,11 +916,11 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
 
 #ifdef WARPX_QED
             if(loc_has_quantum_sync){
-                p_optical_depth_QSR[ip] = quantum_sync_get_opt();
+                p_optical_depth_QSR[ip] = quantum_sync_get_opt(engine);
             }
 
             if(loc_has_breit_wheeler){
-                p_optical_depth_BW[ip] = breit_wheeler_get_opt();
+                p_optical_depth_BW[ip] = breit_wheeler_get_opt(engine);
             }
 #endif
 
@@ -999,7 +1104,8 @@ PhysicalParticleContainer::Evolve (int lev,
                                    MultiFab* rho, MultiFab* crho,
                                    const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                    const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                   Real /*t*/, Real dt, DtType a_dt_type)
+                                   Real /*t*/, Real dt, DtType a_dt_type,
+                                   const GatherContext* a_gather_ctx)
 {
     WARPX_PROFILE("PPC::Evolve()");
     WARPX_PROFILE_VAR_NS("PPC::Evolve::Copy", blp_copy);
@@ -1029,6 +1135,28 @@ PhysicalParticleContainer::Evolve (int lev,
         }
     }
 
+    // With dynamic scheduling, tiles are handed out to threads one by one,
+    // in enumeration order. Tiles can have very different particle counts
+    // (e.g. with moving-window injection), and a dense tile handed out last
+    // leaves the other threads idle until it is done. Therefore the tiles
+    // are processed in two sweeps: the tiles with more particles than the
+    // average first, the remaining tiles second. The particle counts are
+    // read from the particle tiles before entering the parallel region.
+#ifdef _OPENMP
+    const int n_sweeps = (WarpX::do_dynamic_scheduling) ? 2 : 1;
+#else
+    const int n_sweeps = 1;
+#endif
+    long np_heavy = 0;
+    if (n_sweeps > 1) {
+        long n_tiles = 0;
+        for (const auto& kv : GetParticles(lev)) {
+            np_heavy += kv.second.numParticles();
+            n_tiles += 1;
+        }
+        if (n_tiles > 0) np_heavy /= n_tiles;
+    }
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1042,8 +1170,14 @@ PhysicalParticleContainer::Evolve (int lev,
         FArrayBox filtered_Ex, filtered_Ey, filtered_Ez;
         FArrayBox filtered_Bx, filtered_By, filtered_Bz;
 
+        for (int isweep = 0; isweep < n_sweeps; isweep++)
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
+            // Process the denser-than-average tiles in the first sweep,
+            // and the other tiles in the second sweep
+            if ( n_sweeps > 1 &&
+                (pti.numParticles() > np_heavy) != (isweep == 0) ) continue;
+
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
@@ -1067,13 +1201,30 @@ PhysicalParticleContainer::Evolve (int lev,
 
             const long np = pti.numParticles();
 
-            // Data on the grid
-            FArrayBox const* exfab = &(Ex[pti]);
-            FArrayBox const* eyfab = &(Ey[pti]);
-            FArrayBox const* ezfab = &(Ez[pti]);
-            FArrayBox const* bxfab = &(Bx[pti]);
-            FArrayBox const* byfab = &(By[pti]);
-            FArrayBox const* bzfab = &(Bz[pti]);
+            // Data on the grid: reuse the views of the gather context when
+            // it was built by MultiParticleContainer::Evolve
+            FArrayBox const* exfab;
+            FArrayBox const* eyfab;
+            FArrayBox const* ezfab;
+            FArrayBox const* bxfab;
+            FArrayBox const* byfab;
+            FArrayBox const* bzfab;
+            if (a_gather_ctx) {
+                auto const& box_fields = a_gather_ctx->fields[pti.LocalIndex()];
+                exfab = box_fields.ex;
+                eyfab = box_fields.ey;
+                ezfab = box_fields.ez;
+                bxfab = box_fields.bx;
+                byfab = box_fields.by;
+                bzfab = box_fields.bz;
+            } else {
+                exfab = &(Ex[pti]);
+                eyfab = &(Ey[pti]);
+                ezfab = &(Ez[pti]);
+                bxfab = &(Bx[pti]);
+                byfab = &(By[pti]);
+                bzfab = &(Bz[pti]);
+            }
 
             Elixir exeli, eyeli, ezeli, bxeli, byeli, bzeli;
 
@@ -1131,14 +1282,39 @@ PhysicalParticleContainer::Evolve (int lev,
 
                 int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
 
+                // Check whether the fused gather+push+deposit loop applies:
+                // direct deposition, all particles of the tile gather and
+                // deposit on this level, and no process in between the
+                // stages needs the gathered fields in the particle arrays.
+                bool do_fused = WarpX::do_fused_push_deposit
+                    && SupportsFusedPushDeposit()
+                    && (np_current == np) && (np_gather == np)
+                    && (!WarpX::do_electrostatic)
+                    && (WarpX::current_deposition_algo == CurrentDepositionAlgo::Direct)
+                    && (!do_classical_radiation_reaction)
+                    && (!do_not_deposit) && (!do_not_gather)
+                    && (push_interval == 1); // subcycled species scale their
+                                             // deposited current, but not the
+                                             // charge used by the push
+#ifdef WARPX_QED
+                do_fused = do_fused && !m_do_qed_quantum_sync;
+#endif
+                if (do_fused)
+                {
+                    GatherPushDeposit(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                      jx, jy, jz, Ex.nGrow(), dt, lev,
+                                      thread_num, a_dt_type);
+                } else {
+
                 //
                 // Field Gather of Aux Data (i.e., the full solution)
                 //
+                const Real throughput_t_fg = ThroughputCounters::Start();
                 WARPX_PROFILE_VAR_START(blp_fg);
                 FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                             exfab, eyfab, ezfab, bxfab, byfab, bzfab,
                             Ex.nGrow(), e_is_nodal,
-                            0, np_gather, lev, lev);
+                            0, np_gather, lev, lev, a_gather_ctx);
 
                 if (np_gather < np)
                 {
@@ -1146,12 +1322,28 @@ PhysicalParticleContainer::Evolve (int lev,
                     const Box& cbox = amrex::coarsen(box,ref_ratio);
 
                     // Data on the grid
-                    FArrayBox const* cexfab = &(*cEx)[pti];
-                    FArrayBox const* ceyfab = &(*cEy)[pti];
-                    FArrayBox const* cezfab = &(*cEz)[pti];
-                    FArrayBox const* cbxfab = &(*cBx)[pti];
-                    FArrayBox const* cbyfab = &(*cBy)[pti];
-                    FArrayBox const* cbzfab = &(*cBz)[pti];
+                    FArrayBox const* cexfab;
+                    FArrayBox const* ceyfab;
+                    FArrayBox const* cezfab;
+                    FArrayBox const* cbxfab;
+                    FArrayBox const* cbyfab;
+                    FArrayBox const* cbzfab;
+                    if (a_gather_ctx) {
+                        auto const& box_cfields = a_gather_ctx->cfields[pti.LocalIndex()];
+                        cexfab = box_cfields.ex;
+                        ceyfab = box_cfields.ey;
+                        cezfab = box_cfields.ez;
+                        cbxfab = box_cfields.bx;
+                        cbyfab = box_cfields.by;
+                        cbzfab = box_cfields.bz;
+                    } else {
+                        cexfab = &(*cEx)[pti];
+                        ceyfab = &(*cEy)[pti];
+                        cezfab = &(*cEz)[pti];
+                        cbxfab = &(*cBx)[pti];
+                        cbyfab = &(*cBy)[pti];
+                        cbzfab = &(*cBz)[pti];
+                    }
 
                     if (WarpX::use_fdtd_nci_corr)
                     {
@@ -1174,10 +1366,22 @@ PhysicalParticleContainer::Evolve (int lev,
                                 cbxfab, cbyfab, cbzfab,
                                 cEx->nGrow(), e_is_nodal,
                                 nfine_gather, np-nfine_gather,
-                                lev, lev-1);
+                                lev, lev-1, a_gather_ctx);
                 }
 
                 WARPX_PROFILE_VAR_STOP(blp_fg);
+                if (ThroughputCounters::Enabled()) {
+                    // Byte model: read the particle struct and the support
+                    // of the six field components, write Exp...Bzp.
+                    const long support = AMREX_D_TERM(
+                        (WarpX::nox+1), *(WarpX::noy+1), *(WarpX::noz+1));
+                    const long bytes = np*(
+                        sizeof(ParticleType)
+                        + 6*support*sizeof(Real)
+                        + 6*sizeof(ParticleReal));
+                    ThroughputCounters::Add("FieldGather", throughput_t_fg,
+                                            np, bytes);
+                }
 
 #ifdef WARPX_QED
                 //
@@ -1191,9 +1395,19 @@ PhysicalParticleContainer::Evolve (int lev,
                 //
                 // Particle Push
                 //
+                const Real throughput_t_pp = ThroughputCounters::Start();
                 WARPX_PROFILE_VAR_START(blp_ppc_pp);
                 PushPX(pti, dt, a_dt_type);
                 WARPX_PROFILE_VAR_STOP(blp_ppc_pp);
+                if (ThroughputCounters::Enabled()) {
+                    // Byte model: read and write the particle struct and
+                    // the momenta, read the gathered fields.
+                    const long bytes = np*(
+                        2*sizeof(ParticleType)
+                        + (3*2 + 6)*sizeof(ParticleReal));
+                    ThroughputCounters::Add("ParticlePush", throughput_t_pp,
+                                            np, bytes);
+                }
 
                 //
                 // Current Deposition (only needed for electromagnetic solver)
@@ -1216,6 +1430,7 @@ PhysicalParticleContainer::Evolve (int lev,
                                        lev, lev-1, dt);
                     }
                 } // end of "if !do_electrostatic"
+                } // end of "if do_fused"
             } // end of "if do_not_push"
 
             if (rho) {
@@ -1328,15 +1543,16 @@ PhysicalParticleContainer::applyNCIFilter (
 
 // Loop over all particles in the particle container and
 // split particles tagged with p.id()=DoSplitParticleID
+//
+// The daughter particles are written in place: tagged particles are
+// counted with a scan, the tile arrays are grown once, and a device
+// kernel writes the daughters at the end of the tile, so that no
+// temporary container or per-particle host allocation is involved.
+// Redistribute is only called if a daughter actually left its tile.
 void
 PhysicalParticleContainer::SplitParticles (int lev)
 {
-    auto& mypc = WarpX::GetInstance().GetPartContainer();
-    auto& pctmp_split = mypc.GetPCtmp();
-    RealVector psplit_x, psplit_y, psplit_z, psplit_w;
-    RealVector psplit_ux, psplit_uy, psplit_uz;
-    long np_split_to_add = 0;
-    long np_split;
+    int np_split;
     if(split_type==0)
     {
         np_split = pow(2, AMREX_SPACEDIM);
@@ -1344,154 +1560,298 @@ PhysicalParticleContainer::SplitParticles (int lev)
         np_split = 2*AMREX_SPACEDIM;
     }
 
+    const amrex::Vector<int> ppc_nd = plasma_injector->num_particles_per_cell_each_dim;
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    amrex::Vector<Real> split_offset = {dx[0]/2._rt,
+                                        dx[1]/2._rt,
+                                        dx[2]/2._rt};
+    if (ppc_nd[0] > 0){
+        // offset for split particles is computed as a function of cell size
+        // and number of particles per cell, so that a uniform distribution
+        // before splitting results in a uniform distribution after splitting
+        split_offset[0] /= ppc_nd[0];
+        split_offset[1] /= ppc_nd[1];
+        split_offset[2] /= ppc_nd[2];
+    }
+
+    // Tabulate the position offsets of the np_split daughters
+    // (at most 8, in 3d with split_type=0)
+    amrex::GpuArray<Real,24> offsets;
+    int n_daughters = 0;
+    auto add_offset = [&] (Real ox, Real oy, Real oz) {
+        offsets[3*n_daughters  ] = ox;
+        offsets[3*n_daughters+1] = oy;
+        offsets[3*n_daughters+2] = oz;
+        n_daughters++;
+    };
+#if (AMREX_SPACEDIM==2)
+    if (split_type==0){
+        // Split particle in two along each diagonals
+        // 4 particles in 2d
+        for (int ishift = -1; ishift < 2; ishift +=2 ){
+            for (int kshift = -1; kshift < 2; kshift +=2 ){
+                add_offset(ishift*split_offset[0], 0._rt, kshift*split_offset[2]);
+            }
+        }
+    } else {
+        // Split particle in two along each axis
+        // 4 particles in 2d
+        for (int ishift = -1; ishift < 2; ishift +=2 ){
+            add_offset(ishift*split_offset[0], 0._rt, 0._rt);
+            add_offset(0._rt, 0._rt, ishift*split_offset[2]);
+        }
+    }
+#elif (AMREX_SPACEDIM==3)
+    if (split_type==0){
+        // Split particle in two along each diagonals
+        // 8 particles in 3d
+        for (int ishift = -1; ishift < 2; ishift +=2 ){
+            for (int jshift = -1; jshift < 2; jshift +=2 ){
+                for (int kshift = -1; kshift < 2; kshift +=2 ){
+                    add_offset(ishift*split_offset[0],
+                               jshift*split_offset[1],
+                               kshift*split_offset[2]);
+                }
+            }
+        }
+    } else {
+        // Split particle in two along each axis
+        // 6 particles in 3d
+        for (int ishift = -1; ishift < 2; ishift +=2 ){
+            add_offset(ishift*split_offset[0], 0._rt, 0._rt);
+            add_offset(0._rt, ishift*split_offset[1], 0._rt);
+            add_offset(0._rt, 0._rt, ishift*split_offset[2]);
+        }
+    }
+#endif
+    AMREX_ALWAYS_ASSERT(n_daughters == np_split);
+
+    const auto problo = Geom(lev).ProbLoArray();
+    const auto dx_arr = Geom(lev).CellSizeArray();
+
+    // set to 1 if a daughter is written outside its parent's tile
+    Gpu::DeviceVector<int> LeftTile(1);
+    int* const AMREX_RESTRICT pleft = LeftTile.dataPtr();
+    amrex::ParallelFor( 1,
+        [=] AMREX_GPU_DEVICE (long /*i*/) noexcept { pleft[0] = 0; });
+
     // Loop over particle interator
     for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
     {
+        const long np = pti.numParticles();
+        if (np == 0) continue;
+
+        auto& ptile = pti.GetParticleTile();
+        ParticleType* AMREX_RESTRICT pstruct =
+            ptile.GetArrayOfStructs()().data();
+
+        // Count the tagged particles of the tile with a scan
+        Gpu::DeviceVector<int> Flag(np);
+        Gpu::DeviceVector<int> IndexLocation(np);
+        int* const AMREX_RESTRICT pFlag = Flag.dataPtr();
+        int* const AMREX_RESTRICT pIndex = IndexLocation.dataPtr();
+        amrex::ParallelFor(np,
+        [=] AMREX_GPU_DEVICE (long i) {
+            pFlag[i] = (pstruct[i].id() == DoSplitParticleID) ? 1 : 0;
+        });
+        amrex::Gpu::exclusive_scan(Flag.begin(), Flag.end(),
+                                   IndexLocation.begin());
+        int last_flag, last_index;
+        Gpu::copyAsync(Gpu::deviceToHost, Flag.begin()+np-1, Flag.end(),
+                       &last_flag);
+        Gpu::copyAsync(Gpu::deviceToHost, IndexLocation.begin()+np-1,
+                       IndexLocation.end(), &last_index);
+        Gpu::streamSynchronize();
+        const int n_tagged = last_flag + last_index;
+        if (n_tagged == 0) continue;
+
+        // Grow the tile arrays once and write the daughters in place,
+        // np_split of them at the end of the tile per tagged particle
+        const long new_np = np + static_cast<long>(n_tagged)*np_split;
+        ptile.resize(new_np);
+        pstruct = ptile.GetArrayOfStructs()().data();
+        auto& soa = ptile.GetStructOfArrays();
+        ParticleReal* const AMREX_RESTRICT wp  = soa.GetRealData(PIdx::w ).dataPtr();
+        ParticleReal* const AMREX_RESTRICT uxp = soa.GetRealData(PIdx::ux).dataPtr();
+        ParticleReal* const AMREX_RESTRICT uyp = soa.GetRealData(PIdx::uy).dataPtr();
+        ParticleReal* const AMREX_RESTRICT uzp = soa.GetRealData(PIdx::uz).dataPtr();
+#ifdef WARPX_DIM_RZ
+        ParticleReal* const AMREX_RESTRICT thetap = soa.GetRealData(PIdx::theta).dataPtr();
+#endif
         const auto GetPosition = GetParticlePosition(pti);
 
-        const amrex::Vector<int> ppc_nd = plasma_injector->num_particles_per_cell_each_dim;
-        const std::array<Real,3>& dx = WarpX::CellSize(lev);
-        amrex::Vector<Real> split_offset = {dx[0]/2._rt,
-                                            dx[1]/2._rt,
-                                            dx[2]/2._rt};
-        if (ppc_nd[0] > 0){
-            // offset for split particles is computed as a function of cell size
-            // and number of particles per cell, so that a uniform distribution
-            // before splitting results in a uniform distribution after splitting
-            split_offset[0] /= ppc_nd[0];
-            split_offset[1] /= ppc_nd[1];
-            split_offset[2] /= ppc_nd[2];
+        // Real bounds of the tile, to detect daughters that leave it
+        const Box& tbx = pti.tilebox();
+        amrex::GpuArray<Real,AMREX_SPACEDIM> tile_lo, tile_hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            tile_lo[idim] = problo[idim] + tbx.smallEnd(idim) *dx_arr[idim];
+            tile_hi[idim] = problo[idim] + (tbx.bigEnd(idim)+1)*dx_arr[idim];
         }
-        // particle Array Of Structs data
-        auto& particles = pti.GetArrayOfStructs();
-        // particle Struct Of Arrays data
-        auto& attribs = pti.GetAttribs();
-        auto& wp  = attribs[PIdx::w ];
-        auto& uxp = attribs[PIdx::ux];
-        auto& uyp = attribs[PIdx::uy];
-        auto& uzp = attribs[PIdx::uz];
-        const long np = pti.numParticles();
-        for(int i=0; i<np; i++){
+
+        const int l_np_split = np_split;
+        const auto l_offsets = offsets;
+        amrex::ParallelFor(np,
+        [=] AMREX_GPU_DEVICE (long i) {
+            if (pFlag[i] == 0) return;
             ParticleReal xp, yp, zp;
             GetPosition(i, xp, yp, zp);
-            auto& p = particles[i];
-            if (p.id() == DoSplitParticleID){
-                // If particle is tagged, split it and put the
-                // split particles in local arrays psplit_x etc.
-                np_split_to_add += np_split;
-#if (AMREX_SPACEDIM==2)
-                if (split_type==0){
-                    // Split particle in two along each diagonals
-                    // 4 particles in 2d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        for (int kshift = -1; kshift < 2; kshift +=2 ){
-                            // Add one particle with offset in x and z
-                            psplit_x.push_back( xp + ishift*split_offset[0] );
-                            psplit_y.push_back( yp );
-                            psplit_z.push_back( zp + kshift*split_offset[2] );
-                            psplit_ux.push_back( uxp[i] );
-                            psplit_uy.push_back( uyp[i] );
-                            psplit_uz.push_back( uzp[i] );
-                            psplit_w.push_back( wp[i]/np_split );
-                        }
-                    }
-                } else {
-                    // Split particle in two along each axis
-                    // 4 particles in 2d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        // Add one particle with offset in x
-                        psplit_x.push_back( xp + ishift*split_offset[0] );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                        // Add one particle with offset in z
-                        psplit_x.push_back( xp );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp + ishift*split_offset[2] );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                    }
-                }
-#elif (AMREX_SPACEDIM==3)
-                if (split_type==0){
-                    // Split particle in two along each diagonals
-                    // 8 particles in 3d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        for (int jshift = -1; jshift < 2; jshift +=2 ){
-                            for (int kshift = -1; kshift < 2; kshift +=2 ){
-                                // Add one particle with offset in x, y and z
-                                psplit_x.push_back( xp + ishift*split_offset[0] );
-                                psplit_y.push_back( yp + jshift*split_offset[1] );
-                                psplit_z.push_back( zp + kshift*split_offset[2] );
-                                psplit_ux.push_back( uxp[i] );
-                                psplit_uy.push_back( uyp[i] );
-                                psplit_uz.push_back( uzp[i] );
-                                psplit_w.push_back( wp[i]/np_split );
-                            }
-                        }
-                    }
-                } else {
-                    // Split particle in two along each axis
-                    // 6 particles in 3d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        // Add one particle with offset in x
-                        psplit_x.push_back( xp + ishift*split_offset[0] );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                        // Add one particle with offset in y
-                        psplit_x.push_back( xp );
-                        psplit_y.push_back( yp + ishift*split_offset[1] );
-                        psplit_z.push_back( zp );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                        // Add one particle with offset in z
-                        psplit_x.push_back( xp );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp + ishift*split_offset[2] );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
+            const long ibase = np + static_cast<long>(pIndex[i])*l_np_split;
+            for (int j = 0; j < l_np_split; ++j) {
+                const long inew = ibase + j;
+                ParticleType& d = pstruct[inew];
+                // Daughters are tagged with id=NoSplitParticleID so that
+                // they are not re-split when entering a higher level
+                d.id() = NoSplitParticleID;
+                d.cpu() = pstruct[i].cpu();
+                const Real xd = xp + l_offsets[3*j  ];
+                const Real yd = yp + l_offsets[3*j+1];
+                const Real zd = zp + l_offsets[3*j+2];
+#if (AMREX_SPACEDIM == 3)
+                d.pos(0) = xd;
+                d.pos(1) = yd;
+                d.pos(2) = zd;
+#elif (defined WARPX_DIM_RZ)
+                thetap[inew] = std::atan2(yd, xd);
+                d.pos(0) = std::sqrt(xd*xd + yd*yd);
+                d.pos(1) = zd;
+#else
+                d.pos(0) = xd;
+                d.pos(1) = zd;
+                (void) yd;
+#endif
+                wp [inew] = wp [i]/l_np_split;
+                uxp[inew] = uxp[i];
+                uyp[inew] = uyp[i];
+                uzp[inew] = uzp[i];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    if (d.pos(idim) <  tile_lo[idim] ||
+                        d.pos(idim) >= tile_hi[idim]) {
+                        *pleft = 1;
                     }
                 }
-#endif
-                // invalidate the particle
-                p.m_idata.id = -p.m_idata.id;
             }
+            // invalidate the parent
+            pstruct[i].id() = -pstruct[i].id();
+        });
+
+        // The remaining components of the daughters (gathered fields,
+        // runtime components) start from zero, as with AddNParticles
+        for (int comp = PIdx::uz+1; comp < NumRealComps(); ++comp)
+        {
+#ifdef WARPX_DIM_RZ
+            if (comp == PIdx::theta) continue;
+#endif
+            ParticleReal* const AMREX_RESTRICT parr =
+                soa.GetRealData(comp).dataPtr();
+            amrex::ParallelFor(new_np-np,
+            [=] AMREX_GPU_DEVICE (long i) { parr[np+i] = 0._rt; });
+        }
+        for (int comp = 0; comp < NumIntComps(); ++comp)
+        {
+            int* const AMREX_RESTRICT parr = soa.GetIntData(comp).dataPtr();
+            amrex::ParallelFor(new_np-np,
+            [=] AMREX_GPU_DEVICE (long i) { parr[np+i] = 0; });
+        }
+
+        // make sure the temporaries of this tile are no longer in use
+        amrex::Gpu::streamSynchronize();
+    }
+
+    // Redistribute only if a daughter was written outside its tile
+    // (the invalidated parents are cleaned up by the same call, or by
+    // the next regular Redistribute otherwise)
+    int left_tile;
+    Gpu::copyAsync(Gpu::deviceToHost, LeftTile.begin(), LeftTile.end(),
+                   &left_tile);
+    Gpu::streamSynchronize();
+    ParallelDescriptor::ReduceIntMax(left_tile);
+    if (left_tile) {
+        Redistribute();
+    }
+}
+
+namespace {
+    /* \brief Momentum pusher selected at compile time, so that the
+     * per-particle loops below inline a single pusher instead of
+     * branching on WarpX::particle_pusher_algo at run time. Each pusher
+     * also returns the inverse Lorentz factor of the updated momentum,
+     * which the position push (and, in the fused path, the current
+     * deposition) of the same loop iteration reuses. */
+    template <int pusher_algo> struct MomentumPusher;
+
+    template <> struct MomentumPusher<ParticlePusherAlgo::Boris>
+    {
+        AMREX_GPU_HOST_DEVICE AMREX_INLINE static void
+        Push (ParticleReal& ux, ParticleReal& uy, ParticleReal& uz,
+              const ParticleReal Ex, const ParticleReal Ey, const ParticleReal Ez,
+              const ParticleReal Bx, const ParticleReal By, const ParticleReal Bz,
+              const Real q, const Real m, const Real dt, Real& inv_gamma)
+        {
+            UpdateMomentumBoris(ux, uy, uz, Ex, Ey, Ez, Bx, By, Bz,
+                                q, m, dt, inv_gamma);
+        }
+    };
+
+    template <> struct MomentumPusher<ParticlePusherAlgo::Vay>
+    {
+        AMREX_GPU_HOST_DEVICE AMREX_INLINE static void
+        Push (ParticleReal& ux, ParticleReal& uy, ParticleReal& uz,
+              const ParticleReal Ex, const ParticleReal Ey, const ParticleReal Ez,
+              const ParticleReal Bx, const ParticleReal By, const ParticleReal Bz,
+              const Real q, const Real m, const Real dt, Real& inv_gamma)
+        {
+            UpdateMomentumVay(ux, uy, uz, Ex, Ey, Ez, Bx, By, Bz,
+                              q, m, dt, inv_gamma);
+        }
+    };
+
+    template <> struct MomentumPusher<ParticlePusherAlgo::HigueraCary>
+    {
+        AMREX_GPU_HOST_DEVICE AMREX_INLINE static void
+        Push (ParticleReal& ux, ParticleReal& uy, ParticleReal& uz,
+              const ParticleReal Ex, const ParticleReal Ey, const ParticleReal Ez,
+              const ParticleReal Bx, const ParticleReal By, const ParticleReal Bz,
+              const Real q, const Real m, const Real dt, Real& inv_gamma)
+        {
+            UpdateMomentumHigueraCary(ux, uy, uz, Ex, Ey, Ez, Bx, By, Bz,
+                                      q, m, dt, inv_gamma);
         }
+    };
+
+    /* \brief Momentum and position push of the particles of one tile,
+     * with the pusher resolved at compile time (see MomentumPusher) */
+    template <int pusher_algo>
+    void doParticlePush (const long np,
+                         const GetParticlePosition& GetPosition,
+                         const SetParticlePosition& SetPosition,
+                         ParticleReal* const AMREX_RESTRICT ux,
+                         ParticleReal* const AMREX_RESTRICT uy,
+                         ParticleReal* const AMREX_RESTRICT uz,
+                         const ParticleReal* const AMREX_RESTRICT Ex,
+                         const ParticleReal* const AMREX_RESTRICT Ey,
+                         const ParticleReal* const AMREX_RESTRICT Ez,
+                         const ParticleReal* const AMREX_RESTRICT Bx,
+                         const ParticleReal* const AMREX_RESTRICT By,
+                         const ParticleReal* const AMREX_RESTRICT Bz,
+                         const int* const AMREX_RESTRICT ion_lev,
+                         const Real q, const Real m, const Real dt)
+    {
+        amrex::ParallelFor(
+            np,
+            [=] AMREX_GPU_DEVICE (long i) {
+                Real qp = q;
+                if (ion_lev){ qp *= ion_lev[i]; }
+                Real inv_gamma;
+                MomentumPusher<pusher_algo>::Push( ux[i], uy[i], uz[i],
+                                   Ex[i], Ey[i], Ez[i], Bx[i],
+                                   By[i], Bz[i], qp, m, dt, inv_gamma);
+                ParticleReal x, y, z;
+                GetPosition(i, x, y, z);
+                UpdatePosition(x, y, z, ux[i], uy[i], uz[i], inv_gamma, dt );
+                SetPosition(i, x, y, z);
+            }
+        );
     }
-    // Add local arrays psplit_x etc. to the temporary
-    // particle container pctmp_split. Split particles
-    // are tagged with p.id()=NoSplitParticleID so that
-    // they are not re-split when entering a higher level
-    // AddNParticles calls Redistribute, so that particles
-    // in pctmp_split are in the proper grids and tiles
-    pctmp_split.AddNParticles(lev,
-                              np_split_to_add,
-                              psplit_x.dataPtr(),
-                              psplit_y.dataPtr(),
-                              psplit_z.dataPtr(),
-                              psplit_ux.dataPtr(),
-                              psplit_uy.dataPtr(),
-                              psplit_uz.dataPtr(),
-                              1,
-                              psplit_w.dataPtr(),
-                              1, NoSplitParticleID);
-    // Copy particles from tmp to current particle container
-    addParticles(pctmp_split,1);
-    // Clear tmp container
-    pctmp_split.clearParticles();
 }
 
 void
@@ -1587,55 +1947,349 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti, Real dt, DtType a_dt_type)
         );
 #endif
     } else if (WarpX::particle_pusher_algo == ParticlePusherAlgo::Boris){
-        amrex::ParallelFor(
-            pti.numParticles(),
-            [=] AMREX_GPU_DEVICE (long i) {
-                Real qp = q;
-                if (ion_lev){ qp *= ion_lev[i]; }
-                UpdateMomentumBoris( ux[i], uy[i], uz[i],
-                                     Ex[i], Ey[i], Ez[i], Bx[i],
-                                     By[i], Bz[i], qp, m, dt);
-                ParticleReal x, y, z;
-                GetPosition(i, x, y, z);
-                UpdatePosition(x, y, z, ux[i], uy[i], uz[i], dt );
-                SetPosition(i, x, y, z);
-            }
-        );
+        doParticlePush<ParticlePusherAlgo::Boris>(
+            pti.numParticles(), GetPosition, SetPosition, ux, uy, uz,
+            Ex, Ey, Ez, Bx, By, Bz, ion_lev, q, m, dt);
     } else if (WarpX::particle_pusher_algo == ParticlePusherAlgo::Vay) {
-        amrex::ParallelFor(
-            pti.numParticles(),
-            [=] AMREX_GPU_DEVICE (long i) {
-                Real qp = q;
-                if (ion_lev){ qp *= ion_lev[i]; }
-                UpdateMomentumVay( ux[i], uy[i], uz[i],
-                                   Ex[i], Ey[i], Ez[i], Bx[i],
-                                   By[i], Bz[i], qp, m, dt);
-                ParticleReal x, y, z;
-                GetPosition(i, x, y, z);
-                UpdatePosition(x, y, z, ux[i], uy[i], uz[i], dt );
-                SetPosition(i, x, y, z);
-            }
-        );
+        doParticlePush<ParticlePusherAlgo::Vay>(
+            pti.numParticles(), GetPosition, SetPosition, ux, uy, uz,
+            Ex, Ey, Ez, Bx, By, Bz, ion_lev, q, m, dt);
     } else if (WarpX::particle_pusher_algo == ParticlePusherAlgo::HigueraCary) {
-        amrex::ParallelFor(
-            pti.numParticles(),
-            [=] AMREX_GPU_DEVICE (long i) {
-                Real qp = q;
-                if (ion_lev){ qp *= ion_lev[i]; }
-                UpdateMomentumHigueraCary( ux[i], uy[i], uz[i],
-                                   Ex[i], Ey[i], Ez[i], Bx[i],
-                                   By[i], Bz[i], qp, m, dt);
-                ParticleReal x, y, z;
-                GetPosition(i, x, y, z);
-                UpdatePosition(x, y, z, ux[i], uy[i], uz[i], dt );
-                SetPosition(i, x, y, z);
-            }
-        );
+        doParticlePush<ParticlePusherAlgo::HigueraCary>(
+            pti.numParticles(), GetPosition, SetPosition, ux, uy, uz,
+            Ex, Ey, Ez, Bx, By, Bz, ion_lev, q, m, dt);
     } else {
       amrex::Abort("Unknown particle pusher");
     };
 }
 
+namespace {
+    /* \brief Single loop over particles performing field gather, momentum and
+     * position push, and direct current deposition, for the fused Evolve path
+     * (see PhysicalParticleContainer::GatherPushDeposit). The gathered fields
+     * are kept in registers and not stored back in Exp-Bzp; Exp-Bzp only
+     * provide the externally applied fields as starting values.
+     */
+    template <int depos_order, int lower_in_v>
+    void doGatherPushDepositShapeN (const GetParticlePosition& GetPosition,
+                                    const SetParticlePosition& SetPosition,
+                                    ParticleReal* const AMREX_RESTRICT ux,
+                                    ParticleReal* const AMREX_RESTRICT uy,
+                                    ParticleReal* const AMREX_RESTRICT uz,
+                                    const ParticleReal* const AMREX_RESTRICT wp,
+                                    const ParticleReal* const AMREX_RESTRICT Exp,
+                                    const ParticleReal* const AMREX_RESTRICT Eyp,
+                                    const ParticleReal* const AMREX_RESTRICT Ezp,
+                                    const ParticleReal* const AMREX_RESTRICT Bxp,
+                                    const ParticleReal* const AMREX_RESTRICT Byp,
+                                    const ParticleReal* const AMREX_RESTRICT Bzp,
+                                    const int* const AMREX_RESTRICT ion_lev,
+                                    Array4<const Real> const& ex_arr,
+                                    Array4<const Real> const& ey_arr,
+                                    Array4<const Real> const& ez_arr,
+                                    Array4<const Real> const& bx_arr,
+                                    Array4<const Real> const& by_arr,
+                                    Array4<const Real> const& bz_arr,
+                                    const IntVect ex_type, const IntVect ey_type,
+                                    const IntVect ez_type, const IntVect bx_type,
+                                    const IntVect by_type, const IntVect bz_type,
+                                    Array4<Real> const& jx_arr,
+                                    Array4<Real> const& jy_arr,
+                                    Array4<Real> const& jz_arr,
+                                    const IntVect jx_type, const IntVect jy_type,
+                                    const IntVect jz_type,
+                                    const GpuArray<Real, 3>& dx_arr,
+                                    const GpuArray<Real, 3>& xyzmin_gather,
+                                    const Dim3 lo_gather,
+                                    const GpuArray<Real, 3>& xyzmin_depos,
+                                    const Dim3 lo_depos,
+                                    const long np, const Real q, const Real m,
+                                    const Real dt, const int pusher_algo,
+                                    const long n_rz_azimuthal_modes)
+    {
+        amrex::ParallelFor( np,
+            [=] AMREX_GPU_DEVICE (long ip) {
+                ParticleReal xp, yp, zp;
+                GetPosition(ip, xp, yp, zp);
+
+                // Field gather, starting from the externally applied fields
+                ParticleReal Ex = Exp[ip];
+                ParticleReal Ey = Eyp[ip];
+                ParticleReal Ez = Ezp[ip];
+                ParticleReal Bx = Bxp[ip];
+                ParticleReal By = Byp[ip];
+                ParticleReal Bz = Bzp[ip];
+                doGatherShapeN<depos_order,lower_in_v>(
+                    xp, yp, zp, Ex, Ey, Ez, Bx, By, Bz,
+                    ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                    ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                    dx_arr, xyzmin_gather, lo_gather, n_rz_azimuthal_modes);
+
+                // Momentum and position push. The branch on the pusher is
+                // the same for all particles and does not cause divergence.
+                // The pushers return the inverse Lorentz factor of the new
+                // momentum, which the position push and the deposition
+                // below reuse instead of recomputing it.
+                Real qp = q;
+                if (ion_lev){ qp *= ion_lev[ip]; }
+                Real gaminv;
+                if (pusher_algo == ParticlePusherAlgo::Boris){
+                    UpdateMomentumBoris( ux[ip], uy[ip], uz[ip],
+                                         Ex, Ey, Ez, Bx, By, Bz, qp, m, dt,
+                                         gaminv);
+                } else if (pusher_algo == ParticlePusherAlgo::Vay){
+                    UpdateMomentumVay( ux[ip], uy[ip], uz[ip],
+                                       Ex, Ey, Ez, Bx, By, Bz, qp, m, dt,
+                                       gaminv);
+                } else { // ParticlePusherAlgo::HigueraCary
+                    UpdateMomentumHigueraCary( ux[ip], uy[ip], uz[ip],
+                                               Ex, Ey, Ez, Bx, By, Bz, qp, m, dt,
+                                               gaminv);
+                }
+                UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], gaminv, dt);
+                SetPosition(ip, xp, yp, zp);
+
+                // Direct current deposition at the new position
+                Real wq = q*wp[ip];
+                if (ion_lev){ wq *= ion_lev[ip]; }
+                doDepositionShapeN<depos_order>(
+                    xp, yp, zp, wq,
+                    ux[ip]*gaminv, uy[ip]*gaminv, uz[ip]*gaminv,
+                    jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                    dt, dx_arr, xyzmin_depos, lo_depos, n_rz_azimuthal_modes);
+            }
+            );
+    }
+}
+
+void
+PhysicalParticleContainer::GatherPushDeposit (WarpXParIter& pti,
+                                              amrex::FArrayBox const * exfab,
+                                              amrex::FArrayBox const * eyfab,
+                                              amrex::FArrayBox const * ezfab,
+                                              amrex::FArrayBox const * bxfab,
+                                              amrex::FArrayBox const * byfab,
+                                              amrex::FArrayBox const * bzfab,
+                                              MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                              const int ngE, Real dt, int lev,
+                                              int thread_num, DtType a_dt_type)
+{
+    WARPX_PROFILE("PPC::GatherPushDeposit()");
+
+    const long np = pti.numParticles();
+    if (np == 0) return;
+
+    auto& attribs = pti.GetAttribs();
+    auto& wp  = attribs[PIdx::w];
+    auto& Exp = attribs[PIdx::Ex];
+    auto& Eyp = attribs[PIdx::Ey];
+    auto& Ezp = attribs[PIdx::Ez];
+    auto& Bxp = attribs[PIdx::Bx];
+    auto& Byp = attribs[PIdx::By];
+    auto& Bzp = attribs[PIdx::Bz];
+
+    // Initialize the field arrays to the externally applied field: the fused
+    // kernel uses them as starting values of the gathered field.
+    AssignExternalFieldOnParticles(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp, lev);
+
+    if (WarpX::do_back_transformed_diagnostics && do_back_transformed_diagnostics
+        && (a_dt_type!=DtType::SecondHalf))
+    {
+        copy_attribs(pti);
+    }
+
+    int* AMREX_RESTRICT ion_lev = nullptr;
+    if (do_field_ionization){
+        ion_lev = pti.GetiAttribs(particle_icomps["ionization_level"]).dataPtr();
+    }
+
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    const GpuArray<Real, 3> dx_arr = {dx[0], dx[1], dx[2]};
+
+    Real cur_time = WarpX::GetInstance().gett_new(lev);
+    const auto& time_of_last_gal_shift = WarpX::GetInstance().time_of_last_gal_shift;
+
+    // Set-up of the field gather: box grown by ngE (cf. FieldGather)
+    Box box = pti.tilebox();
+    box.grow(ngE);
+    Real time_shift = (cur_time - time_of_last_gal_shift);
+    amrex::Array<amrex::Real,3> galilean_shift = {
+        v_galilean[0]*time_shift, v_galilean[1]*time_shift, v_galilean[2]*time_shift };
+    const std::array<Real, 3>& xyzmin_g = WarpX::LowerCorner(box, galilean_shift, lev);
+    const GpuArray<Real, 3> xyzmin_gather = {xyzmin_g[0], xyzmin_g[1], xyzmin_g[2]};
+    const Dim3 lo_gather = lbound(box);
+
+    // Set-up of the current deposition: tile box grown by ngJ
+    // (cf. WarpXParticleContainer::DepositCurrent)
+    const long ngJ = jx.nGrow();
+    Box tilebox = pti.tilebox();
+    Box tbx = convert(tilebox, WarpX::jx_nodal_flag);
+    Box tby = convert(tilebox, WarpX::jy_nodal_flag);
+    Box tbz = convert(tilebox, WarpX::jz_nodal_flag);
+    tilebox.grow(ngJ);
+
+#ifdef AMREX_USE_GPU
+    // No tiling on GPU: deposit directly in jx/jy/jz
+    Array4<Real> const& jx_arr = jx.array(pti);
+    Array4<Real> const& jy_arr = jy.array(pti);
+    Array4<Real> const& jz_arr = jz.array(pti);
+#else
+    // Tiling is on: deposit into local_jx/local_jy/local_jz
+    tbx.grow(ngJ);
+    tby.grow(ngJ);
+    tbz.grow(ngJ);
+
+    local_jx[thread_num].resize(tbx, jx.nComp());
+    local_jy[thread_num].resize(tby, jy.nComp());
+    local_jz[thread_num].resize(tbz, jz.nComp());
+
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+
+    Array4<Real> const& jx_arr = local_jx[thread_num].array();
+    Array4<Real> const& jy_arr = local_jy[thread_num].array();
+    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+#endif
+    IntVect const jx_type = jx[pti].box().type();
+    IntVect const jy_type = jy[pti].box().type();
+    IntVect const jz_type = jz[pti].box().type();
+
+    Real time_shift_depos = (cur_time + 0.5*dt - time_of_last_gal_shift);
+    amrex::Array<amrex::Real,3> galilean_shift_depos = {
+        v_galilean[0]*time_shift_depos, v_galilean[1]*time_shift_depos,
+        v_galilean[2]*time_shift_depos };
+    const std::array<Real, 3>& xyzmin_d =
+        WarpX::LowerCorner(tilebox, galilean_shift_depos, lev);
+    const GpuArray<Real, 3> xyzmin_depos = {xyzmin_d[0], xyzmin_d[1], xyzmin_d[2]};
+    const Dim3 lo_depos = lbound(tilebox);
+
+    const auto GetPosition = GetParticlePosition(pti);
+          auto SetPosition = SetParticlePosition(pti);
+
+    ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
+
+    Array4<const Real> const& ex_arr = exfab->array();
+    Array4<const Real> const& ey_arr = eyfab->array();
+    Array4<const Real> const& ez_arr = ezfab->array();
+    Array4<const Real> const& bx_arr = bxfab->array();
+    Array4<const Real> const& by_arr = byfab->array();
+    Array4<const Real> const& bz_arr = bzfab->array();
+
+    IntVect const ex_type = exfab->box().type();
+    IntVect const ey_type = eyfab->box().type();
+    IntVect const ez_type = ezfab->box().type();
+    IntVect const bx_type = bxfab->box().type();
+    IntVect const by_type = byfab->box().type();
+    IntVect const bz_type = bzfab->box().type();
+
+    const Real q = this->charge;
+    const Real m = this->mass;
+    const int pusher_algo = WarpX::particle_pusher_algo;
+
+    // Depending on l_lower_in_v and WarpX::nox, call
+    // different versions of template function doGatherPushDepositShapeN
+    if (WarpX::l_lower_order_in_v){
+#ifdef WARPX_PARTICLE_SHAPE
+        doGatherPushDepositShapeN<WARPX_PARTICLE_SHAPE,1>(
+            GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+            Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+            Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+            ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+            ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+            jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+            dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+            np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+#else
+        if        (WarpX::nox == 1){
+            doGatherPushDepositShapeN<1,1>(
+                GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+                Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+                np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+        } else if (WarpX::nox == 2){
+            doGatherPushDepositShapeN<2,1>(
+                GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+                Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+                np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+        } else if (WarpX::nox == 3){
+            doGatherPushDepositShapeN<3,1>(
+                GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+                Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+                np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+        }
+#endif
+    } else {
+#ifdef WARPX_PARTICLE_SHAPE
+        doGatherPushDepositShapeN<WARPX_PARTICLE_SHAPE,0>(
+            GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+            Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+            Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+            ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+            ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+            jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+            dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+            np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+#else
+        if        (WarpX::nox == 1){
+            doGatherPushDepositShapeN<1,0>(
+                GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+                Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+                np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+        } else if (WarpX::nox == 2){
+            doGatherPushDepositShapeN<2,0>(
+                GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+                Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+                np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+        } else if (WarpX::nox == 3){
+            doGatherPushDepositShapeN<3,0>(
+                GetPosition, SetPosition, ux, uy, uz, wp.dataPtr(),
+                Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), ion_lev,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dx_arr, xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+                np, q, m, dt, pusher_algo, WarpX::n_rz_azimuthal_modes);
+        }
+#endif
+    }
+
+#ifndef AMREX_USE_GPU
+    // CPU, tiling: atomicAdd local_jx into jx
+    // (same for jy and jz)
+    jx[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx.nComp());
+    jy[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy.nComp());
+    jz[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz.nComp());
+#endif
+}
+
 #ifdef WARPX_QED
 void PhysicalParticleContainer::EvolveOpticalDepth(
     WarpXParIter& pti, amrex::Real dt)
@@ -1865,6 +2519,12 @@ PhysicalParticleContainer::GetParticleSlice (
 
     diagnostic_particles.resize(finestLevel()+1);
 
+    // Dump-time particle selection: the same per-species filters that are
+    // applied to the standard particle output.
+    const RandomFilter random_filter(m_do_random_filter, m_random_fraction);
+    const UniformFilter uniform_filter(m_do_uniform_filter, m_uniform_stride);
+    const ParserFilter parser_filter(m_do_parser_filter, species_id);
+
     for (int lev = 0; lev < nlevs; ++lev) {
 
         const Real* dx  = Geom(lev).CellSize();
@@ -1911,19 +2571,23 @@ PhysicalParticleContainer::GetParticleSlice (
                   uzpold = tmp_particle_data[lev][index][TmpIdx::uzold].dataPtr();
 
                 const long np = pti.numParticles();
+                if (np == 0) continue;
 
                 Real uzfrm = -WarpX::gamma_boost*WarpX::beta_boost*PhysConst::c;
                 Real inv_c2 = 1.0/PhysConst::c/PhysConst::c;
 
+                const auto ptd = pti.GetParticleTile().getParticleTileData();
+
                 // temporary arrays to store copy_flag and copy_index
                 // for particles that cross the z-slice
-                amrex::Gpu::ManagedDeviceVector<int> FlagForPartCopy(np);
-                amrex::Gpu::ManagedDeviceVector<int> IndexForPartCopy(np);
+                amrex::Gpu::DeviceVector<int> FlagForPartCopy(np);
+                amrex::Gpu::DeviceVector<int> IndexForPartCopy(np);
 
                 int* const AMREX_RESTRICT Flag = FlagForPartCopy.dataPtr();
                 int* const AMREX_RESTRICT IndexLocation = IndexForPartCopy.dataPtr();
 
-                //Flag particles that need to be copied if they cross the z_slice
+                // Flag particles that need to be copied: those that cross the
+                // z_slice and pass the dump-time species filters
                 amrex::ParallelFor(np,
                 [=] AMREX_GPU_DEVICE(int i)
                 {
@@ -1933,7 +2597,9 @@ PhysicalParticleContainer::GetParticleSlice (
                     if ( (((zp >= z_new) && (zpold[i] <= z_old)) ||
                           ((zp <= z_new) && (zpold[i] >= z_old))) )
                     {
-                        Flag[i] = 1;
+                        const SuperParticleType p = ptd.getSuperParticle(i);
+                        Flag[i] = random_filter(p) * uniform_filter(p)
+                                * parser_filter(p);
                     }
                 });
 
@@ -1942,10 +2608,28 @@ PhysicalParticleContainer::GetParticleSlice (
                 // src to dst when the copy-flag is set to 1.
                 amrex::Gpu::exclusive_scan(Flag,Flag+np,IndexLocation);
 
-                const int total_partdiag_size = IndexLocation[np-1] + Flag[np-1];
+                int last_flag, last_index;
+                amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                                      Flag+np-1, Flag+np, &last_flag);
+                amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                                      IndexLocation+np-1, IndexLocation+np,
+                                      &last_index);
+                amrex::Gpu::streamSynchronize();
+                const int total_partdiag_size = last_index + last_flag;
 
                 // allocate array size for diagnostic particle array
                 diagnostic_particles[lev][index].resize(total_partdiag_size);
+                if (total_partdiag_size == 0) continue;
+
+                // stage the indices of the survivors, so that the lab-frame
+                // transform below only loops over them
+                amrex::Gpu::DeviceVector<int> SurvivorIndex(total_partdiag_size);
+                int* const AMREX_RESTRICT SrcIndex = SurvivorIndex.dataPtr();
+                amrex::ParallelFor(np,
+                [=] AMREX_GPU_DEVICE(int i)
+                {
+                    if (Flag[i] == 1) SrcIndex[IndexLocation[i]] = i;
+                });
 
                 amrex::Real gammaboost = WarpX::gamma_boost;
                 amrex::Real betaboost = WarpX::beta_boost;
@@ -1966,14 +2650,14 @@ PhysicalParticleContainer::GetParticleSlice (
                 Real* const AMREX_RESTRICT diag_uzp =
                 diagnostic_particles[lev][index].GetRealData(DiagIdx::uz).data();
 
-                // Copy particle data to diagnostic particle array on the GPU
-                //  using flag and index values
-                amrex::ParallelFor(np,
-                [=] AMREX_GPU_DEVICE(int i)
+                // Transform the surviving particles to the lab frame and copy
+                // them to the diagnostic particle array on the GPU
+                amrex::ParallelFor(total_partdiag_size,
+                [=] AMREX_GPU_DEVICE(int loc)
                 {
+                    const int i = SrcIndex[loc];
                     ParticleReal xp_new, yp_new, zp_new;
                     GetPosition(i, xp_new, yp_new, zp_new);
-                    if (Flag[i] == 1)
                     {
                          // Lorentz Transform particles to lab-frame
                          const Real gamma_new_p = std::sqrt(1.0 + inv_c2*
@@ -2012,7 +2696,6 @@ PhysicalParticleContainer::GetParticleSlice (
                          const Real uzp = uz_old_p*weight_old
                                         + uz_new_p  *weight_new;
 
-                         const int loc = IndexLocation[i];
                          diag_wp[loc] = wpnew[i];
                          diag_xp[loc] = xp;
                          diag_yp[loc] = yp;
@@ -2022,6 +2705,9 @@ PhysicalParticleContainer::GetParticleSlice (
                          diag_uzp[loc] = uzp;
                     }
                 });
+                // the temporary flag and index vectors are freed at the end
+                // of this scope
+                amrex::Gpu::streamSynchronize();
             }
         }
     }
@@ -2035,7 +2721,125 @@ PhysicalParticleContainer::ContinuousInjection (const RealBox& injection_box)
 {
     // Inject plasma on level 0. Paticles will be redistributed.
     const int lev=0;
+    if (m_has_staged_injection) {
+        // Particles for this injection were pre-generated during the
+        // previous step: splice them in, unless the moving window did not
+        // advance as predicted (in which case fall back to a regular,
+        // synchronous injection).
+        if (SpliceStagedInjection(lev, injection_box)) return;
+    }
+    AddPlasma(lev, injection_box);
+}
+
+/* \brief Pre-generate the particles of the next continuous injection into
+ * a staging buffer, so that the injection itself reduces to a cheap append
+ * (see SpliceStagedInjection).
+ * \param injection_box: domain where particles are predicted to be injected.
+ */
+void
+PhysicalParticleContainer::StageContinuousInjection (const RealBox& injection_box)
+{
+    WARPX_PROFILE("PPC::StageContinuousInjection");
+
+    // Staging happens on level 0, like the injection itself.
+    const int lev=0;
+
+    // Define the staging tiles up-front (serially): AddPlasma fills the
+    // buffer from an OpenMP-parallel MFIter loop, which must not insert
+    // into the map concurrently.
+    m_staged_injection.clear();
+    MFItInfo info;
+    if (do_tiling && Gpu::notInLaunchRegion()) {
+        info.EnableTiling(tile_size);
+    }
+    for (MFIter mfi = MakeMFIter(lev, info); mfi.isValid(); ++mfi) {
+        auto& ptile = m_staged_injection[std::make_pair(mfi.index(),
+                                                        mfi.LocalTileIndex())];
+        ptile.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+    }
+
+    m_inject_into_staging = 1;
     AddPlasma(lev, injection_box);
+    m_inject_into_staging = 0;
+
+    // Record what the buffer was generated for, so that SpliceStagedInjection
+    // can check that the moving window advanced as predicted.
+    m_staged_injection_box = injection_box;
+    m_staged_prob_domain = Geom(lev).ProbDomain();
+    m_has_staged_injection = 1;
+}
+
+/* \brief Append the staged particles to the valid particle tiles.
+ * \param lev: refinement level (continuous injection happens on level 0).
+ * \param injection_box: domain where particles should be injected.
+ * Returns 1 if the staged buffer matched injection_box and the current
+ * problem domain (in which case the particles were spliced in), 0 otherwise.
+ */
+int
+PhysicalParticleContainer::SpliceStagedInjection (int lev, const RealBox& injection_box)
+{
+    WARPX_PROFILE("PPC::SpliceStagedInjection");
+
+    m_has_staged_injection = 0;
+
+    // The staged particles are only valid if the moving window advanced
+    // exactly as predicted when the buffer was generated: check both the
+    // injection box and the problem domain (which determines the particle
+    // positions, via the tile boxes in AddPlasma).
+    const RealBox& prob_domain = Geom(lev).ProbDomain();
+    for (int dir=0; dir<AMREX_SPACEDIM; dir++) {
+        if ( (injection_box.lo(dir) != m_staged_injection_box.lo(dir)) ||
+             (injection_box.hi(dir) != m_staged_injection_box.hi(dir)) ||
+             (prob_domain.lo(dir)   != m_staged_prob_domain.lo(dir)  ) ||
+             (prob_domain.hi(dir)   != m_staged_prob_domain.hi(dir)  ) ) {
+            m_staged_injection.clear();
+            return 0;
+        }
+    }
+
+    const int nattr_real = PIdx::nattribs + NumRuntimeRealComps();
+    const int nattr_int  = NumRuntimeIntComps();
+
+    for (auto& kv : m_staged_injection) {
+        auto& src = kv.second;
+        const int np = static_cast<int>(src.GetArrayOfStructs().size());
+        if (np == 0) continue;
+
+        auto& dst = DefineAndReturnParticleTile(lev, kv.first.first,
+                                                kv.first.second);
+        const auto old_size = dst.GetArrayOfStructs().size();
+        dst.resize(old_size + np);
+
+        ParticleType const* src_aos = src.GetArrayOfStructs()().data();
+        ParticleType* dst_aos = dst.GetArrayOfStructs()().data() + old_size;
+        amrex::For(np, [=] AMREX_GPU_DEVICE (int ip) noexcept
+        {
+            dst_aos[ip] = src_aos[ip];
+        });
+
+        for (int ia = 0; ia < nattr_real; ++ia) {
+            ParticleReal const* src_attr =
+                src.GetStructOfArrays().GetRealData(ia).data();
+            ParticleReal* dst_attr =
+                dst.GetStructOfArrays().GetRealData(ia).data() + old_size;
+            amrex::For(np, [=] AMREX_GPU_DEVICE (int ip) noexcept
+            {
+                dst_attr[ip] = src_attr[ip];
+            });
+        }
+        for (int ia = 0; ia < nattr_int; ++ia) {
+            int const* src_attr = src.GetStructOfArrays().GetIntData(ia).data();
+            int* dst_attr =
+                dst.GetStructOfArrays().GetIntData(ia).data() + old_size;
+            amrex::For(np, [=] AMREX_GPU_DEVICE (int ip) noexcept
+            {
+                dst_attr[ip] = src_attr[ip];
+            });
+        }
+    }
+
+    m_staged_injection.clear();
+    return 1;
 }
 
 /* \brief Gather fields from FArrayBox exfab, eyfab, ezfab, bxfab, byfab,
@@ -2068,7 +2872,8 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                         const long offset,
                                         const long np_to_gather,
                                         int lev,
-                                        int gather_lev)
+                                        int gather_lev,
+                                        const GatherContext* gather_ctx)
 {
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE((gather_lev==(lev-1)) ||
                                      (gather_lev==(lev  )),
@@ -2082,8 +2887,13 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
     AssignExternalFieldOnParticles(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp, lev);
 
 
-    // Get cell size on gather_lev
-    const std::array<Real,3>& dx = WarpX::CellSize(std::max(gather_lev,0));
+    // Get cell size on gather_lev (from the gather context if available)
+    std::array<Real,3> dx;
+    if (gather_ctx) {
+        dx = (gather_lev == lev) ? gather_ctx->dx : gather_ctx->cdx;
+    } else {
+        dx = WarpX::CellSize(std::max(gather_lev,0));
+    }
 
     // Get box from which field is gathered.
     // If not gathering from the finest level, the box is coarsened.
@@ -2101,9 +2911,14 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
     const auto GetPosition = GetParticlePosition(pti, offset);
 
     // Lower corner of tile box physical domain (take into account Galilean shift)
-    Real cur_time = WarpX::GetInstance().gett_new(lev);
-    const auto& time_of_last_gal_shift = WarpX::GetInstance().time_of_last_gal_shift;
-    Real time_shift = (cur_time - time_of_last_gal_shift);
+    Real time_shift;
+    if (gather_ctx) {
+        time_shift = gather_ctx->time_shift;
+    } else {
+        Real cur_time = WarpX::GetInstance().gett_new(lev);
+        const auto& time_of_last_gal_shift = WarpX::GetInstance().time_of_last_gal_shift;
+        time_shift = (cur_time - time_of_last_gal_shift);
+    }
     amrex::Array<amrex::Real,3> galilean_shift = { v_galilean[0]*time_shift, v_galilean[1]*time_shift, v_galilean[2]*time_shift };
     const std::array<Real, 3>& xyzmin = WarpX::LowerCorner(box, galilean_shift, gather_lev);
 
@@ -2111,7 +2926,99 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
 
     // Depending on l_lower_in_v and WarpX::nox, call
     // different versions of template function doGatherShapeN
-    if (WarpX::l_lower_order_in_v){
+    if (WarpX::do_shared_mem_field_gather) {
+        // Version with block-local caching of the fields in shared memory
+        if (WarpX::l_lower_order_in_v){
+#ifdef WARPX_PARTICLE_SHAPE
+            doGatherSharedShapeN<WARPX_PARTICLE_SHAPE,1>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+#else
+            if        (WarpX::nox == 1){
+                doGatherSharedShapeN<1,1>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+            } else if (WarpX::nox == 2){
+                doGatherSharedShapeN<2,1>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+            } else if (WarpX::nox == 3){
+                doGatherSharedShapeN<3,1>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+            }
+#endif
+        } else {
+#ifdef WARPX_PARTICLE_SHAPE
+            doGatherSharedShapeN<WARPX_PARTICLE_SHAPE,0>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+#else
+            if        (WarpX::nox == 1){
+                doGatherSharedShapeN<1,0>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+            } else if (WarpX::nox == 2){
+                doGatherSharedShapeN<2,0>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+            } else if (WarpX::nox == 3){
+                doGatherSharedShapeN<3,0>(GetPosition,
+                                Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                                Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                                Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                np_to_gather, dx, xyzmin, lo,
+                                WarpX::n_rz_azimuthal_modes, WarpX::sort_bin_size,
+                                WarpX::shared_mem_gather_np_per_block);
+            }
+#endif
+        }
+    } else if (WarpX::l_lower_order_in_v){
+#ifdef WARPX_PARTICLE_SHAPE
+        doGatherShapeN<WARPX_PARTICLE_SHAPE,1>(GetPosition,
+                            Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                            Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                            Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                            exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                            np_to_gather, dx,
+                            xyzmin, lo, WarpX::n_rz_azimuthal_modes);
+#else
         if        (WarpX::nox == 1){
             doGatherShapeN<1,1>(GetPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
@@ -2137,7 +3044,17 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                 np_to_gather, dx,
                                 xyzmin, lo, WarpX::n_rz_azimuthal_modes);
         }
+#endif
     } else {
+#ifdef WARPX_PARTICLE_SHAPE
+        doGatherShapeN<WARPX_PARTICLE_SHAPE,0>(GetPosition,
+                            Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
+                            Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
+                            Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
+                            exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                            np_to_gather, dx,
+                            xyzmin, lo, WarpX::n_rz_azimuthal_modes);
+#else
         if        (WarpX::nox == 1){
             doGatherShapeN<1,0>(GetPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
@@ -2163,6 +3080,7 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                 np_to_gather, dx,
                                 xyzmin, lo, WarpX::n_rz_azimuthal_modes);
         }
+#endif
     }
 }
 
@@ -2214,6 +3132,64 @@ PhysicalParticleContainer::InitIonizationModule ()
             * std::pow(2*std::pow((Uion/UH),3./2)*Ea,2*n_eff - 1);
         adk_exp_prefactor[i] = -2./3 * std::pow( Uion/UH,3./2) * Ea;
     }
+
+    // Tabulate the ionization rate per level,
+    //     w*dtau = adk_prefactor * E^adk_power * exp(adk_exp_prefactor/E)
+    // (at gamma=1), so that the ionization functor replaces the pow/exp
+    // chain by one linear interpolation. The rate is sampled uniformly
+    // in u=1/E, in which log(w) is nearly linear, between the field
+    // below which the rate is negligible and the field at which the ADK
+    // rate peaks. The rate is computed in log space to avoid
+    // overflow/underflow of the separate factors, and capped at a value
+    // far above anything that matters for the ionization probability.
+    adk_table_size = 1024;
+    adk_rate_table.resize(ion_atomic_number*adk_table_size);
+    adk_E_threshold.resize(ion_atomic_number);
+    adk_table_u0.resize(ion_atomic_number);
+    adk_table_du_inv.resize(ion_atomic_number);
+    const Real log_w_min = std::log(1.e-16);
+    const Real log_w_max = std::log(1.e30);
+    for (int i=0; i<ion_atomic_number; ++i){
+        auto log_w_dtau = [&](Real E) -> Real {
+            return std::log(adk_prefactor[i]) + adk_power[i]*std::log(E)
+                + adk_exp_prefactor[i]/E;
+        };
+        // The ADK rate increases monotonically up to E_peak.
+        const Real E_peak = adk_exp_prefactor[i]/adk_power[i];
+        if (log_w_dtau(E_peak) <= log_w_min) {
+            // This level cannot ionize within one time step at any
+            // field: an infinite threshold makes the functor skip it.
+            adk_E_threshold[i] = std::numeric_limits<Real>::max();
+            adk_table_u0[i] = 0.;
+            adk_table_du_inv[i] = 0.;
+            for (int j=0; j<adk_table_size; ++j) {
+                adk_rate_table[i*adk_table_size+j] = 0.;
+            }
+            continue;
+        }
+        // Bisect for the threshold field below which the rate is
+        // negligible (w*dtau < 1.e-16).
+        Real E_lo = E_peak*1.e-12;
+        Real E_hi = E_peak;
+        for (int it=0; it<100; ++it) {
+            const Real E_mid = 0.5*(E_lo+E_hi);
+            if (log_w_dtau(E_mid) < log_w_min) {
+                E_lo = E_mid;
+            } else {
+                E_hi = E_mid;
+            }
+        }
+        adk_E_threshold[i] = E_lo;
+        const Real u0 = 1./E_peak;
+        const Real du = (1./E_lo - u0)/(adk_table_size-1);
+        adk_table_u0[i] = u0;
+        adk_table_du_inv[i] = 1./du;
+        for (int j=0; j<adk_table_size; ++j) {
+            Real log_w = log_w_dtau(1./(u0+j*du));
+            if (log_w > log_w_max) log_w = log_w_max;
+            adk_rate_table[i*adk_table_size+j] = std::exp(log_w);
+        }
+    }
 }
 
 IonizationFilterFunc
@@ -2221,12 +3197,69 @@ PhysicalParticleContainer::getIonizationFunc ()
 {
     WARPX_PROFILE("PPC::getIonizationFunc");
 
-    return IonizationFilterFunc{ionization_energies.dataPtr(),
-                                adk_prefactor.dataPtr(),
-                                adk_exp_prefactor.dataPtr(),
-                                adk_power.dataPtr(),
+    return IonizationFilterFunc{adk_rate_table.dataPtr(),
+                                adk_E_threshold.dataPtr(),
+                                adk_table_u0.dataPtr(),
+                                adk_table_du_inv.dataPtr(),
                                 particle_icomps["ionization_level"],
-                                ion_atomic_number};
+                                ion_atomic_number,
+                                adk_table_size,
+                                WarpXRandomPool::GetPool()};
+}
+
+int
+PhysicalParticleContainer::TileHasIonizingField (ParticleTileType& ptile)
+{
+    const long np = ptile.numParticles();
+    if (np == 0) return 0;
+
+    const auto& soa = ptile.GetStructOfArrays();
+    const ParticleReal* const AMREX_RESTRICT uxp = soa.GetRealData(PIdx::ux).data();
+    const ParticleReal* const AMREX_RESTRICT uyp = soa.GetRealData(PIdx::uy).data();
+    const ParticleReal* const AMREX_RESTRICT uzp = soa.GetRealData(PIdx::uz).data();
+    const ParticleReal* const AMREX_RESTRICT Exp = soa.GetRealData(PIdx::Ex).data();
+    const ParticleReal* const AMREX_RESTRICT Eyp = soa.GetRealData(PIdx::Ey).data();
+    const ParticleReal* const AMREX_RESTRICT Ezp = soa.GetRealData(PIdx::Ez).data();
+    const ParticleReal* const AMREX_RESTRICT Bxp = soa.GetRealData(PIdx::Bx).data();
+    const ParticleReal* const AMREX_RESTRICT Byp = soa.GetRealData(PIdx::By).data();
+    const ParticleReal* const AMREX_RESTRICT Bzp = soa.GetRealData(PIdx::Bz).data();
+    const int* const AMREX_RESTRICT p_ion_lev =
+        soa.GetIntData(particle_icomps["ionization_level"]).data();
+    const Real* const AMREX_RESTRICT p_E_threshold = adk_E_threshold.dataPtr();
+    const int atomic_number = ion_atomic_number;
+
+    // Maximum, over the particles of the tile, of the electric field in
+    // the particle's frame of reference minus the ionization threshold
+    // of the particle's current ionization level.
+    ReduceOps<ReduceOpMax> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(np, reduce_data,
+                   [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                   {
+                       const int ion_lev = p_ion_lev[i];
+                       if (ion_lev >= atomic_number) {
+                           return {-1.}; // fully ionized
+                       }
+                       constexpr Real c = PhysConst::c;
+                       constexpr Real c2_inv = 1./c/c;
+                       const Real ga = std::sqrt(1. + (uxp[i]*uxp[i] + uyp[i]*uyp[i]
+                                                       + uzp[i]*uzp[i]) * c2_inv);
+                       const Real E = std::sqrt(
+                           - ( uxp[i]*Exp[i] + uyp[i]*Eyp[i] + uzp[i]*Ezp[i] )
+                           * ( uxp[i]*Exp[i] + uyp[i]*Eyp[i] + uzp[i]*Ezp[i] ) * c2_inv
+                           + ( ga*Exp[i] + uyp[i]*Bzp[i] - uzp[i]*Byp[i] )
+                           * ( ga*Exp[i] + uyp[i]*Bzp[i] - uzp[i]*Byp[i] )
+                           + ( ga*Eyp[i] + uzp[i]*Bxp[i] - uxp[i]*Bzp[i] )
+                           * ( ga*Eyp[i] + uzp[i]*Bxp[i] - uxp[i]*Bzp[i] )
+                           + ( ga*Ezp[i] + uxp[i]*Byp[i] - uyp[i]*Bxp[i] )
+                           * ( ga*Ezp[i] + uxp[i]*Byp[i] - uyp[i]*Bxp[i] )
+                           );
+                       return {E - p_E_threshold[ion_lev]};
+                   });
+
+    const Real max_margin = amrex::get<0>(reduce_data.value());
+    return (max_margin >= 0.);
 }
 
 #ifdef WARPX_QED
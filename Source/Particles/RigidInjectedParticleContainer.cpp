@@ -250,7 +250,38 @@ RigidInjectedParticleContainer::PushPX (WarpXParIter& pti, Real dt, DtType a_dt_
     ParticleReal* const AMREX_RESTRICT Byp = attribs[PIdx::By].dataPtr();
     ParticleReal* const AMREX_RESTRICT Bzp = attribs[PIdx::Bz].dataPtr();
 
-    if (!done_injecting_lev)
+    bool injecting_tile = !done_injecting_lev;
+
+    if (injecting_tile)
+    {
+        // The criterion used for done_injecting_lev (the plane has left
+        // the domain) is coarse: the plane can stay inside the domain
+        // long after the last particle has crossed it, in which case the
+        // save/scale/undo machinery below runs every step for nothing.
+        // Check the particle positions directly: if every particle of
+        // the tile is already ahead of the previous plane position (and
+        // the particles drift towards the plane, so that none can cross
+        // it again), neither the field scaling nor the undo below can
+        // apply, and the whole machinery is skipped.
+        const Real vz_rel = vzbeam_ave_boosted + WarpX::beta_boost*PhysConst::c;
+        if (vz_rel > 0.)
+        {
+            ReduceOps<ReduceOpMin> reduce_op;
+            ReduceData<ParticleReal> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            reduce_op.eval(pti.numParticles(), reduce_data,
+                           [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                           {
+                               ParticleReal xp, yp, zp;
+                               GetPosition(i, xp, yp, zp);
+                               return {zp};
+                           });
+            const ParticleReal zmin = amrex::get<0>(reduce_data.value());
+            injecting_tile = (zmin <= zinject_plane_lev_previous);
+        }
+    }
+
+    if (injecting_tile)
     {
         // If the old values are not already saved, create copies here.
         const auto np = pti.numParticles();
@@ -309,7 +340,7 @@ RigidInjectedParticleContainer::PushPX (WarpXParIter& pti, Real dt, DtType a_dt_
 
     PhysicalParticleContainer::PushPX(pti, dt, a_dt_type);
 
-    if (!done_injecting_lev) {
+    if (injecting_tile) {
 
         ParticleReal* AMREX_RESTRICT x_save = xp_save.dataPtr();
         ParticleReal* AMREX_RESTRICT y_save = yp_save.dataPtr();
@@ -356,7 +387,8 @@ RigidInjectedParticleContainer::Evolve (int lev,
                                         MultiFab* rho, MultiFab* crho,
                                         const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                         const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                        Real t, Real dt, DtType a_dt_type)
+                                        Real t, Real dt, DtType a_dt_type,
+                                        const GatherContext* a_gather_ctx)
 {
 
     // Update location of injection plane in the boosted frame
@@ -383,7 +415,7 @@ RigidInjectedParticleContainer::Evolve (int lev,
                                        rho, crho,
                                        cEx, cEy, cEz,
                                        cBx, cBy, cBz,
-                                       t, dt, a_dt_type);
+                                       t, dt, a_dt_type, a_gather_ctx);
 }
 
 void
@@ -68,7 +68,17 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
     // - Find the indices that reorder particles so that the last particles
     //   are in the larger buffer
     fillWithConsecutiveIntegers( pid );
-    auto const sep = stablePartition( pid.begin(), pid.end(), inexflag );
+    // Particles cross the buffer band slowly (less than one cell per step),
+    // so when this function has reordered them at a previous step, they are
+    // usually still partitioned. In that case, the indices can be left
+    // as consecutive integers and the partition can be skipped.
+    auto sep = pid.begin();
+    long const n_true = countAlreadyPartitioned( inexflag );
+    if (n_true >= 0) {
+        std::advance( sep, n_true );
+    } else {
+        sep = stablePartition( pid.begin(), pid.end(), inexflag );
+    }
     // At the end of this step, `pid` contains the indices that should be used to
     // reorder the particles, and `sep` is the position in the array that
     // separates the particles that deposit/gather on the fine patch (first part)
@@ -120,8 +130,11 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
         nfine_gather = 0;
     }
 
-    // Reorder the actual particle array, using the `pid` indices
-    if (nfine_current != np || nfine_gather != np)
+    // Reorder the actual particle array, using the `pid` indices.
+    // The reorder is skipped if `pid` is the identity permutation,
+    // i.e. if the particles were found to be already partitioned.
+    if ((nfine_current != np || nfine_gather != np)
+        && !isIdentityPermutation( pid ))
     {
         // Temporary array for particle AoS
         ParticleVector particle_tmp;
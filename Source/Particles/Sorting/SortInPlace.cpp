@@ -0,0 +1,116 @@
+/* Copyright 2020 Remi Lehe
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "SortingUtils.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "WarpX.H"
+
+#include <AMReX_Particles.H>
+
+
+using namespace amrex;
+
+/* \brief Sort the particles of each tile by cell, in place
+ *
+ * The particles are reordered with a counting sort, so that particles of
+ * the same cell are contiguous and the cells are visited in Fortran order
+ * (which is also the order in which the deposition and gather kernels
+ * sweep the grid data). The sort is stable: the relative order of the
+ * particles within one cell is preserved.
+ *
+ * The reordering is applied as an in-place permutation of the particle
+ * struct and of each of the attribute arrays, following the cycles of the
+ * permutation: contrary to `SortParticlesByBin`, no second copy of the
+ * particle data is allocated. The permutation is sequential within a tile,
+ * so on GPU the standard (copy-based) cell sort is used instead.
+ */
+void
+WarpXParticleContainer::SortParticlesInPlace ()
+{
+    WARPX_PROFILE("WPC::SortParticlesInPlace()");
+
+#ifdef AMREX_USE_GPU
+    SortParticlesByBin( IntVect(AMREX_D_DECL(1,1,1)) );
+#else
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const Geometry& geom = Geom(lev);
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        const Box& domain = geom.Domain();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Temporary arrays of one element per particle (but never a
+            // second copy of the particle data itself)
+            amrex::Vector<long> cell_of_particle;
+            amrex::Vector<long> offsets;
+            amrex::Vector<long> perm;
+
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+            {
+                auto& aos = pti.GetArrayOfStructs();
+                const long np = aos.numParticles();
+                if (np == 0) continue;
+
+                const Box box = pti.tilebox();
+                const auto lo = amrex::lbound(box);
+                const auto hi = amrex::ubound(box);
+                const long ncells = box.numPts();
+
+                // Find the cell of each particle, as a linear (Fortran
+                // order) index within the tile box
+                cell_of_particle.resize(np);
+                ParticleType const* const AMREX_RESTRICT particles = &(aos[0]);
+                for (long i = 0; i < np; i++) {
+                    IntVect iv = amrex::getParticleCell(
+                        particles[i], plo, dxi, domain );
+                    // Guard against round-off: a particle is always
+                    // counted in a cell of its own tile box
+                    iv.max( box.smallEnd() );
+                    iv.min( box.bigEnd() );
+#if (AMREX_SPACEDIM == 3)
+                    cell_of_particle[i] = (iv[0]-lo.x) + (hi.x-lo.x+1)*
+                        ( (iv[1]-lo.y) + (hi.y-lo.y+1)*(long)(iv[2]-lo.z) );
+#else
+                    cell_of_particle[i] = (iv[0]-lo.x)
+                        + (hi.x-lo.x+1)*(long)(iv[1]-lo.y);
+#endif
+                }
+
+                // Counting sort: count the particles of each cell and
+                // accumulate the counts into the offset of each cell...
+                offsets.assign(ncells+1, 0);
+                for (long i = 0; i < np; i++) {
+                    offsets[ cell_of_particle[i]+1 ] += 1;
+                }
+                for (long icell = 0; icell < ncells; icell++) {
+                    offsets[icell+1] += offsets[icell];
+                }
+                // ... then fill `perm` with the indices that reorder the
+                // particles by cell, preserving the order within a cell
+                perm.resize(np);
+                for (long i = 0; i < np; i++) {
+                    perm[ offsets[ cell_of_particle[i] ]++ ] = i;
+                }
+
+                // Apply the permutation to the particle struct and to
+                // each of the attribute arrays
+                inPlaceReorder( aos(), perm );
+                auto& soa = pti.GetStructOfArrays();
+                for (auto& attribute : soa.GetRealData()) {
+                    inPlaceReorder( attribute, perm );
+                }
+                for (auto& attribute : soa.GetIntData()) {
+                    inPlaceReorder( attribute, perm );
+                }
+            }
+        }
+    }
+#endif // AMREX_USE_GPU
+}
@@ -17,8 +17,10 @@
 #include "Pusher/UpdatePosition.H"
 #include "Deposition/CurrentDeposition.H"
 #include "Deposition/ChargeDeposition.H"
+#include "Utils/WarpXThroughputCounters.H"
 
 #include <AMReX_AmrParGDB.H>
+#include <AMReX_GpuContainers.H>
 
 #include <limits>
 
@@ -237,6 +239,10 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
     const long ngJ = jx->nGrow();
     const std::array<Real,3>& dx = WarpX::CellSize(std::max(depos_lev,0));
     Real q = this->charge;
+    // A subcycled species deposits only on its push step: scale its
+    // current so that the time integral of j seen by the field update
+    // over the push interval is preserved.
+    q *= static_cast<Real>(push_interval);
 
     WARPX_PROFILE_VAR_NS("PPC::Evolve::Accumulate", blp_accumulate);
     WARPX_PROFILE_VAR_NS("PPC::CurrentDeposition", blp_deposit);
@@ -314,8 +320,16 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
         }
     }
 
+    const Real throughput_t = ThroughputCounters::Start();
     WARPX_PROFILE_VAR_START(blp_deposit);
     if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
+#ifdef WARPX_PARTICLE_SHAPE
+        doEsirkepovDepositionShapeN<WARPX_PARTICLE_SHAPE>(
+            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+            jx_arr, jy_arr, jz_arr, np_to_depose, dt, dx, xyzmin, lo, q,
+            WarpX::n_rz_azimuthal_modes);
+#else
         if        (WarpX::nox == 1){
             doEsirkepovDepositionShapeN<1>(
                 GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
@@ -335,7 +349,79 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
                 jx_arr, jy_arr, jz_arr, np_to_depose, dt, dx, xyzmin, lo, q,
                 WarpX::n_rz_azimuthal_modes);
         }
+#endif
+    } else if (WarpX::do_shared_mem_current_deposition) {
+#ifdef WARPX_PARTICLE_SHAPE
+        doDepositionSharedShapeN<WARPX_PARTICLE_SHAPE>(
+            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+            jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+            WarpX::sort_bin_size,
+            WarpX::shared_mem_depo_np_per_block);
+#else
+        if        (WarpX::nox == 1){
+            doDepositionSharedShapeN<1>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                WarpX::sort_bin_size,
+                WarpX::shared_mem_depo_np_per_block);
+        } else if (WarpX::nox == 2){
+            doDepositionSharedShapeN<2>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                WarpX::sort_bin_size,
+                WarpX::shared_mem_depo_np_per_block);
+        } else if (WarpX::nox == 3){
+            doDepositionSharedShapeN<3>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                WarpX::sort_bin_size,
+                WarpX::shared_mem_depo_np_per_block);
+        }
+#endif
+    } else if (WarpX::do_vectorized_deposition) {
+#ifdef WARPX_PARTICLE_SHAPE
+        doDepositionShapeNVect<WARPX_PARTICLE_SHAPE>(
+            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+            jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+#else
+        if        (WarpX::nox == 1){
+            doDepositionShapeNVect<1>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+        } else if (WarpX::nox == 2){
+            doDepositionShapeNVect<2>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+        } else if (WarpX::nox == 3){
+            doDepositionShapeNVect<3>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+        }
+#endif
     } else {
+#ifdef WARPX_PARTICLE_SHAPE
+        doDepositionShapeN<WARPX_PARTICLE_SHAPE>(
+            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+            jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
+            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+#else
         if        (WarpX::nox == 1){
             doDepositionShapeN<1>(
                 GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
@@ -355,8 +441,22 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
                 jx_fab, jy_fab, jz_fab, np_to_depose, dt, dx,
                 xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
         }
+#endif
     }
     WARPX_PROFILE_VAR_STOP(blp_deposit);
+    if (ThroughputCounters::Enabled()) {
+        // Byte model: read the particle struct, the weight and the three
+        // momenta (plus the ionization level, if present), and update the
+        // support of the three current components.
+        const long support = AMREX_D_TERM(
+            (WarpX::nox+1), *(WarpX::noy+1), *(WarpX::noz+1));
+        const long bytes = np_to_depose*(
+            sizeof(ParticleType) + 4*sizeof(ParticleReal)
+            + (ion_lev ? sizeof(int) : 0)
+            + 2*3*support*sizeof(Real));
+        ThroughputCounters::Add("CurrentDeposition", throughput_t,
+                                np_to_depose, bytes);
+    }
 
 #ifndef AMREX_USE_GPU
     WARPX_PROFILE_VAR_START(blp_accumulate);
@@ -367,6 +467,12 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
     (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
     WARPX_PROFILE_VAR_STOP(blp_accumulate);
 #endif
+
+    // Sparse-current mode: record that this grid received current (the flag
+    // covers the fine patch, the coarse patch and the buffers of `lev` alike)
+    if (WarpX::do_sparse_current) {
+        warpx_instance.RecordCurrentDeposition(lev, pti.index());
+    }
 }
 
 /* \brief Charge Deposition for thread thread_num
@@ -466,21 +572,70 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector& wp,
     // Indices of the lower bound
     const Dim3 lo = lbound(tilebox);
 
+    const Real throughput_t = ThroughputCounters::Start();
     WARPX_PROFILE_VAR_START(blp_ppc_chd);
+    if (WarpX::do_vectorized_deposition) {
+#ifdef WARPX_PARTICLE_SHAPE
+        doChargeDepositionShapeNVect<WARPX_PARTICLE_SHAPE>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                    rho_fab, np_to_depose, dx, xyzmin, lo, q,
+                                    WarpX::n_rz_azimuthal_modes,
+                                    WarpX::do_warp_aggregated_rho_depo);
+#else
+        if        (WarpX::nox == 1){
+            doChargeDepositionShapeNVect<1>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                        rho_fab, np_to_depose, dx, xyzmin, lo, q,
+                                        WarpX::n_rz_azimuthal_modes,
+                                        WarpX::do_warp_aggregated_rho_depo);
+        } else if (WarpX::nox == 2){
+            doChargeDepositionShapeNVect<2>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                        rho_fab, np_to_depose, dx, xyzmin, lo, q,
+                                        WarpX::n_rz_azimuthal_modes,
+                                        WarpX::do_warp_aggregated_rho_depo);
+        } else if (WarpX::nox == 3){
+            doChargeDepositionShapeNVect<3>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                        rho_fab, np_to_depose, dx, xyzmin, lo, q,
+                                        WarpX::n_rz_azimuthal_modes,
+                                        WarpX::do_warp_aggregated_rho_depo);
+        }
+#endif
+    } else {
+#ifdef WARPX_PARTICLE_SHAPE
+    doChargeDepositionShapeN<WARPX_PARTICLE_SHAPE>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                rho_fab, np_to_depose, dx, xyzmin, lo, q,
+                                WarpX::n_rz_azimuthal_modes,
+                                WarpX::do_warp_aggregated_rho_depo);
+#else
     if        (WarpX::nox == 1){
         doChargeDepositionShapeN<1>(GetPosition, wp.dataPtr()+offset, ion_lev,
                                     rho_fab, np_to_depose, dx, xyzmin, lo, q,
-                                    WarpX::n_rz_azimuthal_modes);
+                                    WarpX::n_rz_azimuthal_modes,
+                                    WarpX::do_warp_aggregated_rho_depo);
     } else if (WarpX::nox == 2){
         doChargeDepositionShapeN<2>(GetPosition, wp.dataPtr()+offset, ion_lev,
                                     rho_fab, np_to_depose, dx, xyzmin, lo, q,
-                                    WarpX::n_rz_azimuthal_modes);
+                                    WarpX::n_rz_azimuthal_modes,
+                                    WarpX::do_warp_aggregated_rho_depo);
     } else if (WarpX::nox == 3){
         doChargeDepositionShapeN<3>(GetPosition, wp.dataPtr()+offset, ion_lev,
                                     rho_fab, np_to_depose, dx, xyzmin, lo, q,
-                                    WarpX::n_rz_azimuthal_modes);
+                                    WarpX::n_rz_azimuthal_modes,
+                                    WarpX::do_warp_aggregated_rho_depo);
+    }
+#endif
     }
     WARPX_PROFILE_VAR_STOP(blp_ppc_chd);
+    if (ThroughputCounters::Enabled()) {
+        // Byte model: read the particle struct and the weight (plus the
+        // ionization level, if present), update the support of rho.
+        const long support = AMREX_D_TERM(
+            (WarpX::nox+1), *(WarpX::noy+1), *(WarpX::noz+1));
+        const long bytes = np_to_depose*(
+            sizeof(ParticleType) + sizeof(ParticleReal)
+            + (ion_lev ? sizeof(int) : 0)
+            + 2*support*sizeof(Real));
+        ThroughputCounters::Add("ChargeDeposition", throughput_t,
+                                np_to_depose, bytes);
+    }
 
 #ifndef AMREX_USE_GPU
     WARPX_PROFILE_VAR_START(blp_accumulate);
@@ -813,6 +968,115 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
     }
 }
 
+namespace {
+    /* \brief Copy all the attributes of particle i_src of a tile onto
+     * particle i_dst of the same tile. */
+    struct CopyParticleAttribs
+    {
+        template <typename PData>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void operator() (PData const& data, int i_src, int i_dst) const noexcept
+        {
+            data.m_aos[i_dst] = data.m_aos[i_src];
+            for (int j = 0; j < PData::NAR; ++j)
+                data.m_rdata[j][i_dst] = data.m_rdata[j][i_src];
+            for (int j = 0; j < data.m_num_runtime_real; ++j)
+                data.m_runtime_rdata[j][i_dst] = data.m_runtime_rdata[j][i_src];
+            for (int j = 0; j < PData::NAI; ++j)
+                data.m_idata[j][i_dst] = data.m_idata[j][i_src];
+            for (int j = 0; j < data.m_num_runtime_int; ++j)
+                data.m_runtime_idata[j][i_dst] = data.m_runtime_idata[j][i_src];
+        }
+    };
+}
+
+void
+WarpXParticleContainer::PruneOutOfWindowParticles (int dir,
+                                                   amrex::Real window_lo,
+                                                   amrex::Real window_hi)
+{
+    WARPX_PROFILE("WPC::PruneOutOfWindowParticles()");
+
+    const int nLevels = finestLevel();
+    for (int lev = 0; lev <= nLevels; ++lev)
+    {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            auto& ptile = pti.GetParticleTile();
+            const int np = ptile.numParticles();
+            if (np == 0) continue;
+
+            const auto GetPosition = GetParticlePosition(pti);
+
+            // Mark the particles that stay within the window
+            Gpu::DeviceVector<int> keep(np);
+            int* AMREX_RESTRICT p_keep = keep.dataPtr();
+            amrex::ParallelFor( np,
+                [=] AMREX_GPU_DEVICE (int i) noexcept
+                {
+                    ParticleReal x, y, z;
+                    GetPosition(i, x, y, z);
+#if (AMREX_SPACEDIM == 3)
+                    const ParticleReal pos = (dir==0) ? x : ((dir==1) ? y : z);
+#else
+                    // In 2D, dir=0 corresponds to x and dir=1 corresponds to z
+                    const ParticleReal pos = (dir==0) ? x : z;
+#endif
+                    p_keep[i] = (pos >= window_lo and pos < window_hi) ? 1 : 0;
+                });
+
+            Gpu::DeviceVector<int> offsets(np);
+            const int* p_offsets = offsets.dataPtr();
+            Gpu::exclusive_scan(keep.begin(), keep.end(), offsets.begin());
+
+            int last_keep, last_offset;
+            Gpu::copyAsync(Gpu::deviceToHost, p_keep+np-1, p_keep+np, &last_keep);
+            Gpu::copyAsync(Gpu::deviceToHost, p_offsets+np-1, p_offsets+np, &last_offset);
+            Gpu::streamSynchronize();
+            const int new_np = last_keep + last_offset;
+            if (new_np == np) continue;
+
+            if (new_np > 0)
+            {
+                // Number of surviving particles below new_np
+                int n_keep_head;
+                Gpu::copyAsync(Gpu::deviceToHost,
+                               p_offsets+new_np, p_offsets+new_np+1, &n_keep_head);
+                Gpu::streamSynchronize();
+
+                // Collect the indices of the holes left below new_np
+                Gpu::DeviceVector<int> holes(new_np - n_keep_head);
+                int* AMREX_RESTRICT p_holes = holes.dataPtr();
+                amrex::ParallelFor( new_np,
+                    [=] AMREX_GPU_DEVICE (int i) noexcept
+                    {
+                        if (!p_keep[i]) { p_holes[i - p_offsets[i]] = i; }
+                    });
+
+                // Move the surviving particles of the tail into the holes:
+                // the r-th surviving particle at or above new_np fills the
+                // r-th hole, so that the first new_np slots end up dense
+                auto data = ptile.getParticleTileData();
+                constexpr CopyParticleAttribs copy_attribs {};
+                amrex::ParallelFor( np - new_np,
+                    [=] AMREX_GPU_DEVICE (int ii) noexcept
+                    {
+                        const int i = new_np + ii;
+                        if (p_keep[i]) {
+                            copy_attribs(data, i, p_holes[p_offsets[i] - n_keep_head]);
+                        }
+                    });
+                Gpu::streamSynchronize();
+            }
+
+            ptile.resize(new_np);
+        }
+    }
+}
+
 // When using runtime components, AMReX requires to touch all tiles
 // in serial and create particles tiles with runtime components if
 // they do not exist (or if they were defined by default, i.e.,
@@ -42,6 +42,41 @@ namespace
         }
         return data;
     }
+    amrex::Real** getMultiFabViews(const amrex::MultiFab* mfs[], int nmfs, int *num_boxes, int *ncomps, int *ngrow, int **shapes, int **lovects)
+    {
+        /* Batched version of getMultiFabPointers/getMultiFabLoVects: return
+         * the data pointers, shapes and lo vectors of several MultiFabs
+         * (e.g. the three components of a vector field) in a single call,
+         * so that callers reading fields every step do not pay the
+         * per-component call and iteration overhead. The data pointers are
+         * not copies: they point to the Fab data itself (device data when
+         * running on GPU). */
+        const amrex::MultiFab& mf0 = *mfs[0];
+        *ncomps = mf0.nComp();
+        *ngrow = mf0.nGrow();
+        *num_boxes = mf0.local_size();
+        int shapesize = AMREX_SPACEDIM;
+        if (mf0.nComp() > 1) shapesize += 1;
+        *shapes = static_cast<int*>(malloc(sizeof(int)*shapesize * nmfs * (*num_boxes)));
+        *lovects = static_cast<int*>(malloc(sizeof(int)*AMREX_SPACEDIM * nmfs * (*num_boxes)));
+        auto data =
+            static_cast<amrex::Real**>(malloc(nmfs * (*num_boxes) * sizeof(amrex::Real*)));
+
+        for (int imf = 0; imf < nmfs; ++imf) {
+            const amrex::MultiFab& mf = *mfs[imf];
+            for ( amrex::MFIter mfi(mf, false); mfi.isValid(); ++mfi ) {
+                int i = imf*(*num_boxes) + mfi.LocalIndex();
+                data[i] = (amrex::Real*) mf[mfi].dataPtr();
+                const int* loVect = mf[mfi].loVect();
+                for (int j = 0; j < AMREX_SPACEDIM; ++j) {
+                    (*shapes)[shapesize*i+j] = mf[mfi].box().length(j);
+                    (*lovects)[AMREX_SPACEDIM*i+j] = loVect[j];
+                }
+                if (mf.nComp() > 1) (*shapes)[shapesize*i+AMREX_SPACEDIM] = mf.nComp();
+            }
+        }
+        return data;
+    }
     int* getMultiFabLoVects(const amrex::MultiFab& mf, int *num_boxes, int *ngrow)
     {
         *ngrow = mf.nGrow();
@@ -190,6 +225,15 @@ extern "C"
         warpx_py_appliedfields = callback;
     }
 
+    void warpx_set_callback_py_beforestep_async (int async)
+    {
+        warpx_py_beforestep_async = async;
+    }
+    void warpx_set_callback_py_afterstep_async (int async)
+    {
+        warpx_py_afterstep_async = async;
+    }
+
     void warpx_evolve (int numsteps)
     {
         WarpX& warpx = WarpX::GetInstance();
@@ -275,6 +319,33 @@ extern "C"
     WARPX_GET_LOVECTS(warpx_getCurrentDensityCPLoVects, WarpX::GetInstance().getcurrent_cp);
     WARPX_GET_LOVECTS(warpx_getCurrentDensityFPLoVects, WarpX::GetInstance().getcurrent_fp);
 
+// Batched query: return the data pointers, shapes and lo vectors of all
+// three components of a vector field in one call. The returned array holds
+// 3*return_size pointers, ordered by direction first.
+#define WARPX_GET_FIELD_VIEWS(FIELD, GETTER) \
+    amrex::Real** FIELD(int lev, \
+                        int *return_size, int *ncomps, int *ngrow, int **shapes, int **lovects) { \
+        const amrex::MultiFab* mfs[3] = { &GETTER(lev, 0), &GETTER(lev, 1), &GETTER(lev, 2) }; \
+        return getMultiFabViews(mfs, 3, return_size, ncomps, ngrow, shapes, lovects); \
+    }
+
+    WARPX_GET_FIELD_VIEWS(warpx_getEfieldViews, WarpX::GetInstance().getEfield);
+    WARPX_GET_FIELD_VIEWS(warpx_getEfieldCPViews, WarpX::GetInstance().getEfield_cp);
+    WARPX_GET_FIELD_VIEWS(warpx_getEfieldFPViews, WarpX::GetInstance().getEfield_fp);
+
+    WARPX_GET_FIELD_VIEWS(warpx_getBfieldViews, WarpX::GetInstance().getBfield);
+    WARPX_GET_FIELD_VIEWS(warpx_getBfieldCPViews, WarpX::GetInstance().getBfield_cp);
+    WARPX_GET_FIELD_VIEWS(warpx_getBfieldFPViews, WarpX::GetInstance().getBfield_fp);
+
+    WARPX_GET_FIELD_VIEWS(warpx_getCurrentDensityViews, WarpX::GetInstance().getcurrent);
+    WARPX_GET_FIELD_VIEWS(warpx_getCurrentDensityCPViews, WarpX::GetInstance().getcurrent_cp);
+    WARPX_GET_FIELD_VIEWS(warpx_getCurrentDensityFPViews, WarpX::GetInstance().getcurrent_fp);
+
+    // Snapshots of the fine-patch fields taken when an asynchronous
+    // beforestep/afterstep callback is launched (see WarpX_py.H)
+    WARPX_GET_FIELD_VIEWS(warpx_getEfieldSnapshotViews, warpx_py_getEfieldSnapshot);
+    WARPX_GET_FIELD_VIEWS(warpx_getBfieldSnapshotViews, warpx_py_getBfieldSnapshot);
+
     int* warpx_getEx_nodal_flag() {return getFieldNodalFlagData(WarpX::Ex_nodal_flag);}
     int* warpx_getEy_nodal_flag() {return getFieldNodalFlagData(WarpX::Ey_nodal_flag);}
     int* warpx_getEz_nodal_flag() {return getFieldNodalFlagData(WarpX::Ez_nodal_flag);}
@@ -387,6 +458,35 @@ extern "C"
         return data;
     }
 
+    amrex::ParticleReal** warpx_getParticleSoA(int speciesnumber, int lev,
+                                               int* num_tiles, int* num_comps, int** particles_per_tile) {
+        /* Batched version of warpx_getParticleArrays: return the data
+         * pointers of all real components on all tiles in one call. The
+         * returned array holds num_comps*num_tiles pointers, ordered by
+         * component first. The pointers are not copies: they point to the
+         * particle data itself. */
+        auto & mypc = WarpX::GetInstance().GetPartContainer();
+        auto & myspc = mypc.GetParticleContainer(speciesnumber);
+
+        int i = 0;
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti, ++i) {}
+
+        *num_tiles = i;
+        *num_comps = myspc.NumRealComps();
+        *particles_per_tile = (int*) malloc(*num_tiles*sizeof(int));
+
+        amrex::ParticleReal** data = (amrex::ParticleReal**) malloc((*num_comps)*(*num_tiles)*sizeof(amrex::ParticleReal*));
+        i = 0;
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti, ++i) {
+            auto& soa = pti.GetStructOfArrays();
+            for (int comp = 0; comp < *num_comps; ++comp) {
+                data[comp*(*num_tiles) + i] = (amrex::ParticleReal*) soa.GetRealData(comp).dataPtr();
+            }
+            (*particles_per_tile)[i] = pti.numParticles();
+        }
+        return data;
+    }
+
     void warpx_ComputeDt () {
         WarpX& warpx = WarpX::GetInstance();
         warpx.ComputeDt ();
@@ -62,6 +62,12 @@ extern "C" {
     void warpx_set_callback_py_particleinjection (WARPX_CALLBACK_PY_FUNC_0);
     void warpx_set_callback_py_appliedfields (WARPX_CALLBACK_PY_FUNC_0);
 
+    /** Declare whether the beforestep/afterstep callback mutates the
+     * simulation state (async = 0, the default) or not (async = 1), in
+     * which case it is run on a worker thread overlapping the time loop */
+    void warpx_set_callback_py_beforestep_async (int async);
+    void warpx_set_callback_py_afterstep_async (int async);
+
     void warpx_evolve (int numsteps);  // -1 means the inputs parameter will be used.
 
     void warpx_addNParticles(int speciesnumber,
@@ -90,6 +96,9 @@ extern "C" {
     amrex::ParticleReal** warpx_getParticleArrays(int speciesnumber, int comp, int lev,
                                                   int* num_tiles, int** particles_per_tile);
 
+    amrex::ParticleReal** warpx_getParticleSoA(int speciesnumber, int lev,
+                                               int* num_tiles, int* num_comps, int** particles_per_tile);
+
   void warpx_ComputeDt ();
   void warpx_MoveWindow ();
 
@@ -6,6 +6,11 @@
  * License: BSD-3-Clause-LBNL
  */
 #include "WarpX_py.H"
+#include "WarpX.H"
+
+#include <array>
+#include <memory>
+#include <thread>
 
 
 extern "C" {
@@ -23,5 +28,72 @@ extern "C" {
     WARPX_CALLBACK_PY_FUNC_0 warpx_py_particleinjection = nullptr;
     WARPX_CALLBACK_PY_FUNC_0 warpx_py_appliedfields = nullptr;
 
+    int warpx_py_beforestep_async = 0;
+    int warpx_py_afterstep_async = 0;
+
 }
 
+namespace
+{
+    // Worker thread running the current asynchronous callback, if any
+    std::thread callback_thread;
+
+    // Copies of the fine-patch E and B fields, taken right before an
+    // asynchronous callback is launched, so that the callback reads a
+    // consistent snapshot while the time loop updates the live fields
+    amrex::Vector< std::array<std::unique_ptr<amrex::MultiFab>,3> > E_snapshot;
+    amrex::Vector< std::array<std::unique_ptr<amrex::MultiFab>,3> > B_snapshot;
+
+    void takeFieldSnapshot ()
+    {
+        WarpX& warpx = WarpX::GetInstance();
+        const int nlevs = warpx.finestLevel() + 1;
+        E_snapshot.resize(nlevs);
+        B_snapshot.resize(nlevs);
+        for (int lev = 0; lev < nlevs; ++lev) {
+            for (int dir = 0; dir < 3; ++dir) {
+                const amrex::MultiFab& Ef = warpx.getEfield_fp(lev, dir);
+                const amrex::MultiFab& Bf = warpx.getBfield_fp(lev, dir);
+                auto& Es = E_snapshot[lev][dir];
+                auto& Bs = B_snapshot[lev][dir];
+                if (!Es || Es->boxArray() != Ef.boxArray() ||
+                    Es->DistributionMap() != Ef.DistributionMap()) {
+                    Es.reset(new amrex::MultiFab(Ef.boxArray(), Ef.DistributionMap(),
+                                                 Ef.nComp(), Ef.nGrow()));
+                    Bs.reset(new amrex::MultiFab(Bf.boxArray(), Bf.DistributionMap(),
+                                                 Bf.nComp(), Bf.nGrow()));
+                }
+                amrex::MultiFab::Copy(*Es, Ef, 0, 0, Ef.nComp(), Ef.nGrow());
+                amrex::MultiFab::Copy(*Bs, Bf, 0, 0, Bf.nComp(), Bf.nGrow());
+            }
+        }
+    }
+}
+
+void warpx_py_call (WARPX_CALLBACK_PY_FUNC_0 callback, int run_async)
+{
+    // Only one callback is in flight at a time, and callbacks always run
+    // in the order in which they are triggered
+    warpx_py_wait_async();
+    if (run_async) {
+        takeFieldSnapshot();
+        callback_thread = std::thread(callback);
+    } else {
+        callback();
+    }
+}
+
+void warpx_py_wait_async ()
+{
+    if (callback_thread.joinable()) callback_thread.join();
+}
+
+amrex::MultiFab& warpx_py_getEfieldSnapshot (int lev, int direction)
+{
+    return *E_snapshot[lev][direction];
+}
+
+amrex::MultiFab& warpx_py_getBfieldSnapshot (int lev, int direction)
+{
+    return *B_snapshot[lev][direction];
+}
@@ -9,7 +9,8 @@ Average::CoarsenAndInterpolateLoop ( MultiFab& mf_dst,
                                      const int scomp,
                                      const int ncomp,
                                      const int ngrow,
-                                     const IntVect crse_ratio )
+                                     const IntVect crse_ratio,
+                                     const Box& region )
 {
     // Staggering of source fine MultiFab and destination coarse MultiFab
     const IntVect stag_src = mf_src.boxArray().ixType().toIntVect();
@@ -57,10 +58,12 @@ Average::CoarsenAndInterpolateLoop ( MultiFab& mf_dst,
     int const* const AMREX_RESTRICT cr = cr_gpuarr.data();
     int      * const AMREX_RESTRICT np = np_gpuarr.data();
 
-    // Compute number of points to loop over (either 1 or 2) in each direction
+    // Compute number of points to loop over in each direction:
+    // 1 or 2 without coarsening, the full coarse cell (cr cells, or
+    // cr+1 nodes) with coarsening
     for ( int l = 0; l < 3; ++l ) {
         if ( cr[l] == 1 ) np[l] = 1+abs(sf[l]-sc[l]); // no coarsening
-        else              np[l] = 2-sf[l];
+        else              np[l] = cr[l]+sf[l];
     }
 
 #ifdef _OPENMP
@@ -69,8 +72,11 @@ Average::CoarsenAndInterpolateLoop ( MultiFab& mf_dst,
     // Loop over boxes (or tiles if not on GPU)
     for (MFIter mfi( mf_dst, TilingIfNotGPU() ); mfi.isValid(); ++mfi)
     {
-        // Tiles defined at the coarse level
-        const Box& bx = mfi.growntilebox( ngrow );
+        // Tiles defined at the coarse level, restricted to the region
+        // of interest (if any)
+        Box bx = mfi.growntilebox( ngrow );
+        if ( region.ok() ) bx &= region;
+        if ( bx.isEmpty() ) continue;
         Array4<Real> const& arr_dst = mf_dst.array( mfi );
         Array4<Real const> const& arr_src = mf_src.const_array( mfi );
         ParallelFor( bx, ncomp,
@@ -89,7 +95,8 @@ Average::CoarsenAndInterpolate ( MultiFab& mf_dst,
                                  const int scomp,
                                  const int ncomp,
                                  const int ngrow,
-                                 const IntVect crse_ratio )
+                                 const IntVect crse_ratio,
+                                 const Box& region )
 {
     BL_PROFILE( "Average::CoarsenAndInterpolate" );
 
@@ -100,14 +107,14 @@ Average::CoarsenAndInterpolate ( MultiFab& mf_dst,
     ba_tmp.coarsen( crse_ratio );
 
     if ( ba_tmp == mf_dst.boxArray() and mf_src.DistributionMap() == mf_dst.DistributionMap() )
-        Average::CoarsenAndInterpolateLoop( mf_dst, mf_src, dcomp, scomp, ncomp, ngrow, crse_ratio );
+        Average::CoarsenAndInterpolateLoop( mf_dst, mf_src, dcomp, scomp, ncomp, ngrow, crse_ratio, region );
     else
     {
         // Cannot coarsen into MultiFab with different BoxArray or DistributionMapping:
         // 1) create temporary MultiFab on coarsened version of source BoxArray with same DistributionMapping
         MultiFab mf_tmp( ba_tmp, mf_src.DistributionMap(), ncomp, 0, MFInfo(), FArrayBoxFactory() );
         // 2) interpolate from mf_src to mf_tmp (start writing into component 0)
-        Average::CoarsenAndInterpolateLoop( mf_tmp, mf_src, 0, scomp, ncomp, ngrow, crse_ratio );
+        Average::CoarsenAndInterpolateLoop( mf_tmp, mf_src, 0, scomp, ncomp, ngrow, crse_ratio, region );
         // 3) copy from mf_tmp to mf_dst (with different BoxArray or DistributionMapping)
         mf_dst.copy( mf_tmp, 0, dcomp, ncomp );
     }
@@ -0,0 +1,151 @@
+/* Copyright 2020 Maxence Thevenet, Michael Rowan
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpXMemoryMonitor.H"
+
+#include <AMReX_BaseFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace amrex;
+
+int MemoryMonitor::m_enabled = 0;
+int MemoryMonitor::m_dry_run = 0;
+
+// Subsystem labels of the instrumented allocation sites, in report order.
+// The registry makes the reduction in PrintReport collective even on
+// ranks that never executed a site.
+const std::vector<std::string> MemoryMonitor::m_names = {
+    "E and B (fine patch)",
+    "E and B (coarse patch)",
+    "E and B (aux)",
+    "current",
+    "rho and F",
+    "buffers and masks",
+    "particles",
+};
+
+std::map<std::string, MemoryMonitor::Bytes> MemoryMonitor::m_bytes;
+
+void
+MemoryMonitor::ReadParameters ()
+{
+    ParmParse pp("warpx");
+    pp.query("do_memory_report", m_enabled);
+    pp.query("dry_run_memory", m_dry_run);
+    // the dry run reuses the accounting of the report
+    if (m_dry_run) m_enabled = 1;
+}
+
+void
+MemoryMonitor::Count (const std::string& name, const BoxArray& ba,
+                      const DistributionMapping& dm, const int ncomp,
+                      const IntVect& ngrow, const int bytes_per_elem)
+{
+    if (!m_enabled) return;
+    const int myproc = ParallelDescriptor::MyProc();
+    long npts = 0;
+    for (int i = 0, n = ba.size(); i < n; ++i) {
+        if (dm[i] == myproc) {
+            npts += amrex::grow(ba[i], ngrow).numPts();
+        }
+    }
+    Bytes& b = m_bytes[name];
+    b.current += npts * ncomp * bytes_per_elem;
+    b.high = std::max(b.high, b.current);
+}
+
+void
+MemoryMonitor::Set (const std::string& name, const long bytes)
+{
+    if (!m_enabled) return;
+    Bytes& b = m_bytes[name];
+    b.current = bytes;
+    b.high = std::max(b.high, b.current);
+}
+
+int
+MemoryMonitor::NumLabels ()
+{
+    return static_cast<int>(m_names.size());
+}
+
+const std::string&
+MemoryMonitor::LabelName (const int i)
+{
+    return m_names[i];
+}
+
+long
+MemoryMonitor::Current (const int i)
+{
+    if (!m_enabled) return 0;
+    return m_bytes[m_names[i]].current;
+}
+
+long
+MemoryMonitor::HighWater (const int i)
+{
+    if (!m_enabled) return 0;
+    return m_bytes[m_names[i]].high;
+}
+
+void
+MemoryMonitor::PrintReport ()
+{
+    if (!m_enabled) return;
+
+    std::stringstream ss;
+    ss << "\nMemory report (current and high-water bytes;"
+       << " total over ranks, and largest single rank):\n"
+       << std::setw(24) << std::left << "subsystem"
+       << std::setw(14) << std::right << "total GB"
+       << std::setw(14) << "total HW GB"
+       << std::setw(14) << "rank GB"
+       << std::setw(14) << "rank HW GB" << "\n";
+
+    long grand_total = 0;
+    for (const auto& name : m_names) {
+        // absent entries contribute zeros to the reduction
+        const Bytes& b = m_bytes[name];
+        long sums[2] = {b.current, b.high};
+        long maxs[2] = {b.current, b.high};
+        ParallelDescriptor::ReduceLongSum(sums, 2);
+        ParallelDescriptor::ReduceLongMax(maxs, 2);
+        if (sums[1] == 0) continue;
+        grand_total += sums[1];
+        ss << std::setw(24) << std::left << name << std::right
+           << std::setw(14) << std::fixed << std::setprecision(3)
+           << 1.e-9*sums[0]
+           << std::setw(14) << 1.e-9*sums[1]
+           << std::setw(14) << 1.e-9*maxs[0]
+           << std::setw(14) << 1.e-9*maxs[1] << "\n";
+    }
+    ss << std::setw(24) << std::left << "sum of the above (HW)" << std::right
+       << std::setw(28) << std::fixed << std::setprecision(3)
+       << 1.e-9*grand_total << "\n";
+
+    // Actual Fab bytes tracked by AMReX: covers everything allocated in
+    // Fabs (including PML, spectral and diagnostic buffers), but with no
+    // subsystem breakdown. Zero in a dry run, where nothing is allocated.
+    long fab_bytes[2] = {static_cast<long>(TotalBytesAllocatedInFabs()),
+                         static_cast<long>(TotalBytesAllocatedInFabsHWM())};
+    long fab_maxs[2] = {fab_bytes[0], fab_bytes[1]};
+    ParallelDescriptor::ReduceLongSum(fab_bytes, 2);
+    ParallelDescriptor::ReduceLongMax(fab_maxs, 2);
+    ss << std::setw(24) << std::left << "AMReX Fabs (actual)" << std::right
+       << std::setw(14) << std::fixed << std::setprecision(3)
+       << 1.e-9*fab_bytes[0]
+       << std::setw(14) << 1.e-9*fab_bytes[1]
+       << std::setw(14) << 1.e-9*fab_maxs[0]
+       << std::setw(14) << 1.e-9*fab_maxs[1] << "\n";
+
+    amrex::Print() << ss.str();
+}
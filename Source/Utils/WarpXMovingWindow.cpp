@@ -65,7 +65,12 @@ WarpX::MoveWindow (bool move_j)
     const Real* cdx = geom[0].CellSize();
     int num_shift_base = static_cast<int>((moving_window_x - current_lo[dir]) / cdx[dir]);
 
-    if (num_shift_base == 0) return 0;
+    if (num_shift_base == 0) {
+        // The window does not move this step; the next injection may still
+        // be pre-generated (no-op unless warpx.do_staged_injection).
+        StageContinuousInjection();
+        return 0;
+    }
 
     // update the problem domain. Note the we only do this on the base level because
     // amrex::Geometry objects share the same, static RealBox.
@@ -190,6 +195,12 @@ WarpX::MoveWindow (bool move_j)
         }
     }
 
+    // The particles that are now behind the domain boundary in the window
+    // direction are removed right away, tile by tile: the generic
+    // Redistribute path would otherwise have to carry them (this removal
+    // is deterministic and purely local).
+    mypc->PruneOutOfWindowParticles(dir, geom[0].ProbLo(dir), geom[0].ProbHi(dir));
+
     // Continuously inject plasma in new cells (by default only on level 0)
     if (WarpX::warpx_do_continuous_injection) {
 
@@ -228,9 +239,88 @@ WarpX::MoveWindow (bool move_j)
         }
     }
 
+    // Pre-generate the particles of the next injection, so that the next
+    // call to ContinuousInjection reduces to a cheap append (no-op unless
+    // warpx.do_staged_injection).
+    StageContinuousInjection();
+
     return num_shift_base;
 }
 
+/* \brief Pre-generate the particles that the next MoveWindow is predicted
+ * to inject (enabled with warpx.do_staged_injection).
+ * The position of the moving window is extrapolated over one time step and
+ * the particles of the corresponding injection are generated into a staging
+ * buffer, with the problem domain temporarily shifted to its predicted
+ * position so that the staged particles land on the correct tiles. If the
+ * prediction turns out to be wrong, the next ContinuousInjection falls back
+ * to a regular, synchronous injection (see
+ * PhysicalParticleContainer::SpliceStagedInjection).
+ */
+void
+WarpX::StageContinuousInjection ()
+{
+    if (do_staged_injection == 0) return;
+    if (WarpX::warpx_do_continuous_injection == 0) return;
+    // In boosted-frame simulations, the time of the injection enters the
+    // Lorentz transform of the particle attributes: particles cannot be
+    // generated one step ahead of time.
+    if (WarpX::gamma_boost > 1.) return;
+
+    const int lev = 0;
+    int dir = moving_window_dir;
+    const Real* current_lo = geom[lev].ProbLo();
+    const Real* current_hi = geom[lev].ProbHi();
+    const Real* cdx = geom[lev].CellSize();
+
+    // Predict the position of the moving window after the next step
+    Real next_moving_window_x = moving_window_x + moving_window_v * dt[0];
+    int num_shift = static_cast<int>((next_moving_window_x - current_lo[dir]) / cdx[dir]);
+    if (num_shift == 0) return;
+
+    // Predicted problem domain after the next MoveWindow
+    Real new_lo[AMREX_SPACEDIM];
+    Real new_hi[AMREX_SPACEDIM];
+    for (int i=0; i<AMREX_SPACEDIM; i++) {
+        new_lo[i] = current_lo[i];
+        new_hi[i] = current_hi[i];
+    }
+    new_lo[dir] += num_shift * cdx[dir];
+    new_hi[dir] += num_shift * cdx[dir];
+    const RealBox next_domain(new_lo, new_hi);
+
+    // Predicted injection box: same logic as in MoveWindow, with the
+    // problem domain replaced by its predicted position. Note that
+    // current_injection_position does not change between steps when
+    // gamma_boost = 1.
+    RealBox particleBox = next_domain;
+    Real new_injection_position;
+    Real dx = cdx[dir];
+    if (moving_window_v >= 0){
+        // Forward-moving window
+        new_injection_position = current_injection_position +
+            std::floor( (next_domain.hi(dir) - current_injection_position)/dx ) * dx;
+        particleBox.setLo( dir, current_injection_position );
+        particleBox.setHi( dir, new_injection_position );
+    } else {
+        // Backward-moving window
+        new_injection_position = current_injection_position -
+            std::floor( (current_injection_position - next_domain.lo(dir))/dx ) * dx;
+        particleBox.setLo( dir, new_injection_position );
+        particleBox.setHi( dir, current_injection_position );
+    }
+
+    if (particleBox.ok() and (current_injection_position != new_injection_position)){
+        // Generate the staged particles with the predicted problem domain
+        // in place, so that they are assigned to the tiles they will belong
+        // to after the shift.
+        const RealBox current_domain = geom[lev].ProbDomain();
+        ResetProbDomain(next_domain);
+        mypc->StageContinuousInjection(particleBox);
+        ResetProbDomain(current_domain);
+    }
+}
+
 void
 WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir,
                 IntVect ng_extra, amrex::Real external_field, bool useparser,
@@ -244,12 +334,12 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir,
 
     AMREX_ALWAYS_ASSERT(ng.min() >= num_shift);
 
-    MultiFab tmpmf(ba, dm, nc, ng);
-    MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
-
+    // Fill the guard cells of mf itself: the band of cells that crosses a
+    // box boundary when shifting is read from them, so that the fields do
+    // not have to be copied to a temporary first.
     if ( WarpX::safe_guard_cells ) {
         // Fill guard cells.
-        tmpmf.FillBoundary(geom.periodicity());
+        mf.FillBoundary(geom.periodicity());
     } else {
         IntVect ng_mw = IntVect::TheUnitVector();
         // Enough guard cells in the MW direction
@@ -259,9 +349,17 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir,
         // Make sure we don't exceed number of guard cells allocated
         ng_mw = ng_mw.min(ng);
         // Fill guard cells.
-        tmpmf.FillBoundary(ng_mw, geom.periodicity());
+        mf.FillBoundary(ng_mw, geom.periodicity());
     }
 
+    // The shifted fields are assembled in a temporary MultiFab and copied
+    // back into `mf` at the end of this function: this halves the copies
+    // (the previous version copied the full field to the temporary first,
+    // then wrote it back shifted). The temporary cannot simply be adopted
+    // as the new storage, because `mf` may be aliased: at level 0, the
+    // *_aux fields are alias MultiFabs into the *_fp fields shifted here.
+    MultiFab tmpmf(ba, dm, nc, ng);
+
     // Make a box that covers the region that the window moved into
     const IndexType& typ = ba.ixType();
     const Box& domainBox = geom.Domain();
@@ -300,8 +398,8 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir,
 
     for (MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
     {
-        auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        auto const& dstfab = tmpmf.array(mfi);
+        auto const& srcfab = mf.array(mfi);
 
         const Box& outbox = mfi.fabbox() & adjBox;
 
@@ -351,7 +449,25 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir,
         {
             dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
         });
+
+        // The narrow band of guard cells that the shift does not reach
+        // keeps its previous (unshifted) values, as it did when the shift
+        // was performed in place.
+        Box bndBox = mf[mfi].box();
+        if (num_shift > 0) {
+            bndBox.setSmall(dir, dstBox.bigEnd(dir)+1);
+        } else {
+            bndBox.setBig(dir, dstBox.smallEnd(dir)-1);
+        }
+        AMREX_PARALLEL_FOR_4D ( bndBox, nc, i, j, k, n,
+        {
+            dstfab(i,j,k,n) = srcfab(i,j,k,n);
+        });
     }
+
+    // Copy the shifted fields back into the original storage
+    // (a purely local, box-by-box copy, including the guard cells)
+    MultiFab::Copy(mf, tmpmf, 0, 0, nc, ng);
 }
 
 void
@@ -0,0 +1,36 @@
+/* Copyright 2020 Maxence Thevenet
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpXRandomPool.H"
+
+#include <atomic>
+
+namespace {
+    // Per-rank seed, drawn once from the AMReX host generator. The host
+    // generator is seeded per rank (amrex.init_random), so deriving the
+    // pool seed from it keeps seeded runs reproducible and decorrelates
+    // the ranks. The function-local static makes the lazy initialization
+    // thread-safe (GetPool may be called from OpenMP regions).
+    unsigned long long PoolSeed ()
+    {
+        static const unsigned long long the_seed =
+            static_cast<unsigned long long>(amrex::Random() * 1.e18) + 1ULL;
+        return the_seed;
+    }
+
+    // Offset into the Philox subsequences, advanced at every GetPool()
+    // call so that successive kernels use disjoint parts of the counter
+    // space. The stride bounds the number of draws one engine may make.
+    std::atomic<unsigned long long> s_next_offset{0};
+    constexpr unsigned long long s_offset_stride = 65536;
+}
+
+WarpXRandomPool
+WarpXRandomPool::GetPool () noexcept
+{
+    return WarpXRandomPool{PoolSeed(),
+                           s_next_offset.fetch_add(s_offset_stride)};
+}
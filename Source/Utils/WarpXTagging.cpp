@@ -7,35 +7,103 @@
  */
 
 #include <WarpX.H>
-#include <AMReX_BoxIterator.H>
-#include <array>
-#include <algorithm>
+#include "Utils/WarpXUtil.H"
+
+#include <cmath>
 
 using namespace amrex;
 
 void
-WarpX::ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/)
+WarpX::ErrorEst (int lev, TagBoxArray& tags, Real time, int /*ngrow*/)
 {
-    const Real* problo = Geom(lev).ProbLo();
-    const Real* dx = Geom(lev).CellSize();
+    const auto problo = Geom(lev).ProbLoArray();
+    const auto dx = Geom(lev).CellSizeArray();
+
+    // The parsed expression does not depend on the level: build the
+    // parser (and upload its evaluation tape) only once
+    if (!str_refinement_function.empty() and !refinement_function_parser) {
+        refinement_function_parser.reset(new ParserWrapper<4>(
+            makeParser(str_refinement_function,{"x","y","z","t"})));
+    }
+    ParserWrapper<4> *ref_parser = refinement_function_parser.get();
+
+    const GpuArray<Real,AMREX_SPACEDIM> tag_lo {AMREX_D_DECL(
+        fine_tag_lo[0], fine_tag_lo[1], fine_tag_lo[2])};
+    const GpuArray<Real,AMREX_SPACEDIM> tag_hi {AMREX_D_DECL(
+        fine_tag_hi[0], fine_tag_hi[1], fine_tag_hi[2])};
+
+    // Charge density deposited from the particles of this level, for the
+    // density-based criterion (in RZ, component 0 holds the mode-0 real
+    // part, i.e. the axisymmetric density)
+    std::unique_ptr<MultiFab> rho;
+    if (refine_charge_density_threshold > 0.) {
+        rho = mypc->GetChargeDensity(lev);
+    }
+    const Real rho_threshold = refine_charge_density_threshold;
 
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+    for (MFIter mfi(tags, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        auto& fab = tags[mfi];
-        const Box& bx = fab.box();
-        for (BoxIterator bi(bx); bi.ok(); ++bi)
+        auto const& tag_arr = tags.array(mfi);
+
+        // Static refinement box and user-defined criterion, evaluated at
+        // the cell centers (including the buffer cells around the valid
+        // region, like the original host implementation did)
+        const Box& gbx = mfi.growntilebox();
+        ParallelFor( gbx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            const IntVect& cell = bi();
-            RealVect pos {AMREX_D_DECL((cell[0]+0.5_rt)*dx[0]+problo[0],
-                                       (cell[1]+0.5_rt)*dx[1]+problo[1],
-                                       (cell[2]+0.5_rt)*dx[2]+problo[2])};
-            if (pos > fine_tag_lo && pos < fine_tag_hi) {
-                fab(cell) = TagBox::SET;
+            const Real x = problo[0] + (i+0.5_rt)*dx[0];
+#if   (AMREX_SPACEDIM == 2)
+            const Real y = 0.0_rt;
+            const Real z = problo[1] + (j+0.5_rt)*dx[1];
+            const bool in_tag_box = (x > tag_lo[0] and x < tag_hi[0] and
+                                     z > tag_lo[1] and z < tag_hi[1]);
+#elif (AMREX_SPACEDIM == 3)
+            const Real y = problo[1] + (j+0.5_rt)*dx[1];
+            const Real z = problo[2] + (k+0.5_rt)*dx[2];
+            const bool in_tag_box = (x > tag_lo[0] and x < tag_hi[0] and
+                                     y > tag_lo[1] and y < tag_hi[1] and
+                                     z > tag_lo[2] and z < tag_hi[2]);
+#endif
+            if (in_tag_box) {
+                tag_arr(i,j,k) = TagBox::SET;
+            }
+            if (ref_parser and (*ref_parser)(x,y,z,time) > 0.0_rt) {
+                tag_arr(i,j,k) = TagBox::SET;
             }
+        } );
+
+        // Density-based criterion: tag the valid cells where the deposited
+        // charge density exceeds the threshold at any of the points of the
+        // (possibly staggered) density around the cell
+        if (rho) {
+            auto const& rho_arr = rho->const_array(mfi);
+            const IntVect rho_stag = rho->ixType().toIntVect();
+            // Number of density points per cell in each direction
+            // (2 along a nodal direction, 1 along a cell-centered one)
+            GpuArray<int,3> np {1,1,1};
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                np[idim] = rho_stag[idim]+1;
+            }
+            ParallelFor( mfi.tilebox(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                Real rho_max = 0.0_rt;
+                for         (int kk = 0; kk < np[2]; ++kk) {
+                    for     (int jj = 0; jj < np[1]; ++jj) {
+                        for (int ii = 0; ii < np[0]; ++ii) {
+                            rho_max = amrex::max( rho_max,
+                                std::abs(rho_arr(i+ii,j+jj,k+kk)) );
+                        }
+                    }
+                }
+                if (rho_max > rho_threshold) {
+                    tag_arr(i,j,k) = TagBox::SET;
+                }
+            } );
         }
     }
 }
-
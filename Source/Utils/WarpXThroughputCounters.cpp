@@ -0,0 +1,106 @@
+/* Copyright 2020 Maxence Thevenet, Michael Rowan
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpXThroughputCounters.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace amrex;
+
+int ThroughputCounters::m_enabled = 0;
+
+// Region names of the instrumented kernels, in table order. The registry
+// makes the reduction in Print collective even on ranks that never
+// executed a region.
+const std::vector<std::string> ThroughputCounters::m_names = {
+    "FieldGather",
+    "ParticlePush",
+    "CurrentDeposition",
+    "ChargeDeposition",
+    "EvolveB",
+    "EvolveE",
+};
+
+std::map<std::string, ThroughputCounters::Counts> ThroughputCounters::m_counts;
+
+void
+ThroughputCounters::ReadParameters ()
+{
+    ParmParse pp("warpx");
+    pp.query("do_throughput_counters", m_enabled);
+}
+
+Real
+ThroughputCounters::Start ()
+{
+    if (!m_enabled) return 0.;
+    Gpu::synchronize();
+    return amrex::second();
+}
+
+void
+ThroughputCounters::Add (const std::string& name, const Real t_start,
+                         const long items, const long bytes)
+{
+    if (!m_enabled) return;
+    Gpu::synchronize();
+    const Real seconds = amrex::second() - t_start;
+#ifdef _OPENMP
+#pragma omp critical (warpx_throughput_counters)
+#endif
+    {
+        Counts& c = m_counts[name];
+        c.calls += 1;
+        c.items += items;
+        c.bytes += bytes;
+        c.seconds += seconds;
+    }
+}
+
+void
+ThroughputCounters::Print ()
+{
+    if (!m_enabled) return;
+
+    std::stringstream ss;
+    ss << "\nThroughput counters (items and bytes summed over ranks,"
+       << " time of the slowest rank):\n"
+       << std::setw(20) << std::left << "region"
+       << std::setw(12) << std::right << "calls"
+       << std::setw(14) << "Gitems"
+       << std::setw(12) << "GB"
+       << std::setw(12) << "seconds"
+       << std::setw(12) << "Gitems/s"
+       << std::setw(12) << "GB/s"
+       << std::setw(12) << "bytes/item" << "\n";
+
+    for (const auto& name : m_names) {
+        // absent entries contribute zeros to the reduction
+        const Counts& c = m_counts[name];
+        long sums[3] = {c.calls, c.items, c.bytes};
+        ParallelDescriptor::ReduceLongSum(sums, 3);
+        Real seconds = c.seconds;
+        ParallelDescriptor::ReduceRealMax(seconds);
+        if (sums[0] == 0) continue;
+        ss << std::setw(20) << std::left << name << std::right
+           << std::setw(12) << sums[0]
+           << std::setw(14) << std::fixed << std::setprecision(3)
+           << 1.e-9*sums[1]
+           << std::setw(12) << 1.e-9*sums[2]
+           << std::setw(12) << seconds
+           << std::setw(12) << 1.e-9*sums[1]/seconds
+           << std::setw(12) << 1.e-9*sums[2]/seconds
+           << std::setw(12) << std::setprecision(1)
+           << Real(sums[2])/Real(sums[1]) << "\n";
+    }
+    amrex::Print() << ss.str();
+}
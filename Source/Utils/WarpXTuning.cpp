@@ -0,0 +1,235 @@
+/* Copyright 2020 Maxence Thevenet, Weiqun Zhang
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpXTuning.H"
+
+#include "WarpX.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+using namespace amrex;
+
+namespace
+{
+    /** Human-readable description of a configuration, for the summary */
+    std::string ConfigDescription (const KernelConfig& config)
+    {
+        if (config.m_variant == KernelConfig::SharedMem) {
+            return "shared memory, " + std::to_string(config.m_np_per_block)
+                 + " particles/block";
+        } else if (config.m_variant == KernelConfig::Vectorized) {
+            return "vectorized";
+        }
+        return "standard";
+    }
+}
+
+void
+KernelAutotuner::ReadParameters ()
+{
+    ParmParse pp("warpx");
+    pp.query("do_kernel_autotune", m_active);
+    pp.query("autotune_samples", m_samples_per_candidate);
+    pp.query("autotune_cache_file", m_cache_file);
+}
+
+std::string
+KernelAutotuner::CacheKey () const
+{
+    std::string device = "cpu";
+#if defined(AMREX_USE_CUDA)
+    cudaDeviceProp prop;
+    cudaGetDeviceProperties(&prop, Gpu::Device::deviceId());
+    device = prop.name;
+#elif defined(AMREX_USE_HIP)
+    hipDeviceProp_t prop;
+    hipGetDeviceProperties(&prop, Gpu::Device::deviceId());
+    device = prop.name;
+#endif
+    // the key must be a single token of the cache file
+    std::replace(device.begin(), device.end(), ' ', '_');
+    return device + ":shape" + std::to_string(WarpX::nox);
+}
+
+void
+KernelAutotuner::InitData ()
+{
+    if (!m_active) return;
+    m_done = false;
+
+    // Build the candidate lists. Variants are only candidates where they
+    // can actually be selected: the shared-memory variants exist on GPU,
+    // the vectorized deposition on CPU, and neither applies when the fused
+    // push+deposit loop or the Esirkepov deposition is used.
+    const bool tune_depo =
+        (WarpX::current_deposition_algo == CurrentDepositionAlgo::Direct)
+        && !WarpX::do_fused_push_deposit;
+    const bool tune_gather = !WarpX::do_fused_push_deposit;
+    m_candidates[0].push_back(KernelConfig());
+    m_candidates[1].push_back(KernelConfig());
+#ifdef AMREX_USE_GPU
+    for (int np_per_block : {128, 256, 512}) {
+        KernelConfig shared;
+        shared.m_variant = KernelConfig::SharedMem;
+        shared.m_np_per_block = np_per_block;
+        if (tune_depo) m_candidates[0].push_back(shared);
+        if (tune_gather) m_candidates[1].push_back(shared);
+    }
+#else
+    if (tune_depo) {
+        KernelConfig vect;
+        vect.m_variant = KernelConfig::Vectorized;
+        m_candidates[0].push_back(vect);
+    }
+    (void) tune_gather;
+#endif
+    m_times[0].assign(m_candidates[0].size(), std::numeric_limits<Real>::max());
+    m_times[1].assign(m_candidates[1].size(), std::numeric_limits<Real>::max());
+
+    // A previous run may have tuned this device and shape order already
+    int found = 0;
+    int cached[4] = {0, 256, 0, 256};
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ifstream ifs(m_cache_file);
+        const std::string my_key = CacheKey();
+        std::string key;
+        while (ifs >> key >> cached[0] >> cached[1] >> cached[2] >> cached[3]) {
+            if (key == my_key) {
+                found = 1;
+                break;
+            }
+        }
+    }
+    ParallelDescriptor::Bcast(&found, 1,
+                              ParallelDescriptor::IOProcessorNumber());
+    if (found) {
+        ParallelDescriptor::Bcast(cached, 4,
+                                  ParallelDescriptor::IOProcessorNumber());
+        m_best[0].m_variant = cached[0];
+        m_best[0].m_np_per_block = cached[1];
+        m_best[1].m_variant = cached[2];
+        m_best[1].m_np_per_block = cached[3];
+        ApplyConfig(m_best[0], true);
+        ApplyConfig(m_best[1], false);
+        m_done = true;
+        Print() << "Kernel autotuner: loaded configuration for " << CacheKey()
+                << " from " << m_cache_file << "\n"
+                << "  current deposition: " << ConfigDescription(m_best[0]) << "\n"
+                << "  field gather: " << ConfigDescription(m_best[1]) << "\n";
+        return;
+    }
+
+    // Start measuring, skipping phases where there is only one candidate
+    m_phase = -1;
+    NextPhase();
+}
+
+void
+KernelAutotuner::ApplyNextCandidate ()
+{
+    ApplyConfig(m_candidates[m_phase][m_icandidate], m_phase == 0);
+}
+
+void
+KernelAutotuner::RecordSample (Real time)
+{
+    // All ranks must agree on the winner: measure the slowest rank
+    ParallelDescriptor::ReduceRealMax(time);
+    Real& best_time = m_times[m_phase][m_icandidate];
+    best_time = std::min(best_time, time);
+
+    if (++m_isample < m_samples_per_candidate) return;
+    m_isample = 0;
+    if (++m_icandidate < static_cast<int>(m_candidates[m_phase].size())) return;
+    m_icandidate = 0;
+
+    // This phase is complete: lock in the fastest candidate
+    const auto& times = m_times[m_phase];
+    const int ibest = std::min_element(times.begin(), times.end())
+                    - times.begin();
+    m_best[m_phase] = m_candidates[m_phase][ibest];
+    ApplyConfig(m_best[m_phase], m_phase == 0);
+    NextPhase();
+}
+
+void
+KernelAutotuner::NextPhase ()
+{
+    ++m_phase;
+    while (m_phase < 2 && m_candidates[m_phase].size() < 2) {
+        // nothing to tune in this phase: keep the current flags
+        m_best[m_phase] = m_candidates[m_phase][0];
+        ++m_phase;
+    }
+    if (m_phase >= 2) {
+        m_done = true;
+        const bool measured = m_candidates[0].size() > 1
+                           || m_candidates[1].size() > 1;
+        if (measured) {
+            WriteCache();
+            Print() << "Kernel autotuner: selected for " << CacheKey() << "\n"
+                    << "  current deposition: "
+                    << ConfigDescription(m_best[0]) << "\n"
+                    << "  field gather: "
+                    << ConfigDescription(m_best[1]) << "\n";
+        }
+    }
+}
+
+void
+KernelAutotuner::ApplyConfig (const KernelConfig& config, const bool deposition)
+{
+    if (deposition) {
+        WarpX::do_shared_mem_current_deposition =
+            (config.m_variant == KernelConfig::SharedMem);
+        WarpX::do_vectorized_deposition =
+            (config.m_variant == KernelConfig::Vectorized);
+        if (config.m_variant == KernelConfig::SharedMem) {
+            WarpX::shared_mem_depo_np_per_block = config.m_np_per_block;
+        }
+    } else {
+        WarpX::do_shared_mem_field_gather =
+            (config.m_variant == KernelConfig::SharedMem);
+        if (config.m_variant == KernelConfig::SharedMem) {
+            WarpX::shared_mem_gather_np_per_block = config.m_np_per_block;
+        }
+    }
+}
+
+void
+KernelAutotuner::WriteCache () const
+{
+    if (!ParallelDescriptor::IOProcessor()) return;
+
+    // Keep the entries of other devices/shape orders, replace ours
+    const std::string my_key = CacheKey();
+    std::ostringstream oss;
+    {
+        std::ifstream ifs(m_cache_file);
+        std::string line;
+        while (std::getline(ifs, line)) {
+            std::istringstream iss(line);
+            std::string key;
+            if ((iss >> key) && key != my_key && !line.empty()) {
+                oss << line << "\n";
+            }
+        }
+    }
+    oss << my_key
+        << " " << m_best[0].m_variant << " " << m_best[0].m_np_per_block
+        << " " << m_best[1].m_variant << " " << m_best[1].m_np_per_block
+        << "\n";
+
+    std::ofstream ofs(m_cache_file, std::ofstream::trunc);
+    ofs << oss.str();
+}
@@ -81,9 +81,12 @@ void ConvertLabParamsToBoost()
 
 
     pp_amr.query("max_level", max_level);
+    bool have_fine_tag = false;
     if (max_level > 0){
-      pp_wpx.getarr("fine_tag_lo", fine_tag_lo);
-      pp_wpx.getarr("fine_tag_hi", fine_tag_hi);
+      // The static refinement box is optional when a dynamic refinement
+      // criterion is used
+      have_fine_tag = pp_wpx.queryarr("fine_tag_lo", fine_tag_lo);
+      if (have_fine_tag) pp_wpx.getarr("fine_tag_hi", fine_tag_hi);
     }
 
 
@@ -101,7 +104,7 @@ void ConvertLabParamsToBoost()
             convert_factor = 1./( gamma_boost * ( 1 - beta_boost ) );
             prob_lo[idim] *= convert_factor;
             prob_hi[idim] *= convert_factor;
-            if (max_level > 0){
+            if (max_level > 0 && have_fine_tag){
               fine_tag_lo[idim] *= convert_factor;
               fine_tag_hi[idim] *= convert_factor;
             }
@@ -113,7 +116,7 @@ void ConvertLabParamsToBoost()
 
     pp_geom.addarr("prob_lo", prob_lo);
     pp_geom.addarr("prob_hi", prob_hi);
-    if (max_level > 0){
+    if (max_level > 0 && have_fine_tag){
       pp_wpx.addarr("fine_tag_lo", fine_tag_lo);
       pp_wpx.addarr("fine_tag_hi", fine_tag_hi);
     }
@@ -16,6 +16,8 @@
 #include "Utils/WarpXUtil.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXThroughputCounters.H"
+#include "Utils/WarpXMemoryMonitor.H"
 
 #include <AMReX_ParmParse.H>
 #include <AMReX_MultiFabUtil.H>
@@ -81,6 +83,7 @@ bool WarpX::use_fdtd_nci_corr = false;
 int  WarpX::l_lower_order_in_v = true;
 
 bool WarpX::use_filter        = false;
+bool WarpX::do_sparse_current = false;
 bool WarpX::serialize_ics     = false;
 bool WarpX::refine_plasma     = false;
 
@@ -92,6 +95,18 @@ int  WarpX::sort_int = 4;
 int  WarpX::sort_int = -1;
 #endif
 amrex::IntVect WarpX::sort_bin_size(AMREX_D_DECL(4,4,4));
+int WarpX::sort_in_place = 0;
+
+int WarpX::do_shared_mem_current_deposition = 0;
+int WarpX::do_shared_mem_field_gather = 0;
+int WarpX::shared_mem_depo_np_per_block = 256;
+int WarpX::shared_mem_gather_np_per_block = 256;
+int WarpX::do_fused_push_deposit = 0;
+int WarpX::do_vectorized_deposition = 0;
+int WarpX::staging_buffer_mb = 0;
+int WarpX::do_staged_injection = 0;
+int WarpX::do_warp_aggregated_rho_depo = 1;
+int WarpX::do_overlap_comms = 0;
 
 bool WarpX::do_back_transformed_diagnostics = false;
 std::string WarpX::lab_data_directory = "lab_frame_data";
@@ -107,6 +122,9 @@ Real WarpX::particle_slice_width_lab = 0.0;
 bool WarpX::do_dynamic_scheduling = true;
 
 int WarpX::do_electrostatic = 0;
+int WarpX::poisson_warm_start = 1;
+Real WarpX::poisson_loose_precision_threshold = 0.;
+Real WarpX::poisson_loose_precision_factor = 10.;
 int WarpX::do_subcycling = 0;
 bool WarpX::safe_guard_cells = 0;
 
@@ -146,6 +164,7 @@ IntVect WarpX::filter_npass_each_dir(1);
 
 int WarpX::n_field_gather_buffer = -1;
 int WarpX::n_current_deposition_buffer = -1;
+int WarpX::do_current_buffer_bypass = 0;
 
 int WarpX::do_nodal = false;
 
@@ -247,6 +266,9 @@ WarpX::WarpX ()
     current_buf.resize(nlevs_max);
     charge_buf.resize(nlevs_max);
 
+    current_deposition_flags.resize(nlevs_max);
+    current_deposition_flags_reduced.resize(nlevs_max, 0);
+
     pml.resize(nlevs_max);
     costs.resize(nlevs_max);
 
@@ -485,12 +507,20 @@ WarpX::ReadParameters ()
         }
 
         pp.query("do_electrostatic", do_electrostatic);
+        pp.query("poisson_warm_start", poisson_warm_start);
+        pp.query("poisson_loose_precision_threshold", poisson_loose_precision_threshold);
+        pp.query("poisson_loose_precision_factor", poisson_loose_precision_factor);
         pp.query("n_buffer", n_buffer);
         pp.query("const_dt", const_dt);
 
         // Read filter and fill IntVect filter_npass_each_dir with
         // proper size for AMREX_SPACEDIM
         pp.query("use_filter", use_filter);
+        // Sparse-current mode: skip the boxes on which no particle has
+        // deposited current in the filter, the guard-cell sums and the j
+        // term of the E-field update (for e.g. beam-only simulations,
+        // where the current is nonzero in a small fraction of the boxes)
+        pp.query("do_sparse_current", do_sparse_current);
         Vector<int> parse_filter_npass_each_dir(AMREX_SPACEDIM,1);
         pp.queryarr("filter_npass_each_dir", parse_filter_npass_each_dir);
         filter_npass_each_dir[0] = parse_filter_npass_each_dir[0];
@@ -514,7 +544,22 @@ WarpX::ReadParameters ()
         pp.query("do_dive_cleaning", do_dive_cleaning);
         pp.query("n_field_gather_buffer", n_field_gather_buffer);
         pp.query("n_current_deposition_buffer", n_current_deposition_buffer);
+        pp.query("do_current_buffer_bypass", do_current_buffer_bypass);
         pp.query("sort_int", sort_int);
+        pp.query("sort_in_place", sort_in_place);
+        pp.query("do_shared_mem_current_deposition", do_shared_mem_current_deposition);
+        pp.query("do_shared_mem_field_gather", do_shared_mem_field_gather);
+        pp.query("shared_mem_depo_np_per_block", shared_mem_depo_np_per_block);
+        pp.query("shared_mem_gather_np_per_block", shared_mem_gather_np_per_block);
+        m_kernel_autotuner.ReadParameters();
+        ThroughputCounters::ReadParameters();
+        MemoryMonitor::ReadParameters();
+        pp.query("do_fused_push_deposit", do_fused_push_deposit);
+        pp.query("do_vectorized_deposition", do_vectorized_deposition);
+        pp.query("staging_buffer_mb", staging_buffer_mb);
+        pp.query("do_staged_injection", do_staged_injection);
+        pp.query("do_warp_aggregated_rho_depo", do_warp_aggregated_rho_depo);
+        pp.query("do_overlap_comms", do_overlap_comms);
 
         Vector<int> vect_sort_bin_size(AMREX_SPACEDIM,1);
         bool sort_bin_size_is_specified = pp.queryarr("sort_bin_size", vect_sort_bin_size);
@@ -563,6 +608,13 @@ WarpX::ReadParameters ()
 #ifdef WARPX_USE_OPENPMD
         pp.query("openpmd_tspf", openpmd_tspf);
 #endif
+        pp.query("checkpoint_compression", checkpoint_compression);
+#ifndef WARPX_USE_ZSTD
+        if (checkpoint_compression) {
+            amrex::Abort("warpx.checkpoint_compression requires compiling with USE_ZSTD=TRUE");
+        }
+#endif
+
         pp.query("plot_raw_fields", plot_raw_fields);
         pp.query("plot_raw_fields_guards", plot_raw_fields_guards);
         pp.query("plot_coarsening_ratio", plot_coarsening_ratio);
@@ -634,15 +686,35 @@ WarpX::ReadParameters ()
         }
 
         if (maxLevel() > 0) {
+            if (pp.contains("refinement_function(x,y,z,t)")) {
+                Store_parserString(pp, "refinement_function(x,y,z,t)",
+                                   str_refinement_function);
+            }
+            pp.query("refine_charge_density_threshold",
+                     refine_charge_density_threshold);
             Vector<Real> lo, hi;
-            pp.getarr("fine_tag_lo", lo);
-            pp.getarr("fine_tag_hi", hi);
-            fine_tag_lo = RealVect{lo};
-            fine_tag_hi = RealVect{hi};
+            if (str_refinement_function.empty() and
+                refine_charge_density_threshold <= 0.) {
+                // Without a dynamic criterion, the static refinement
+                // box is required
+                pp.getarr("fine_tag_lo", lo);
+                pp.getarr("fine_tag_hi", hi);
+            } else if (pp.queryarr("fine_tag_lo", lo)) {
+                pp.getarr("fine_tag_hi", hi);
+            }
+            if (!lo.empty()) {
+                fine_tag_lo = RealVect{lo};
+                fine_tag_hi = RealVect{hi};
+            } else {
+                // Empty static box (lo > hi): tags nothing
+                fine_tag_lo = RealVect(AMREX_D_DECL( 1., 1., 1.));
+                fine_tag_hi = RealVect(AMREX_D_DECL(-1.,-1.,-1.));
+            }
         }
 
         pp.query("load_balance_int", load_balance_int);
         pp.query("load_balance_with_sfc", load_balance_with_sfc);
+        pp.query("load_balance_node_size", load_balance_node_size);
         pp.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
         pp.query("load_balance_efficiency_ratio_threshold", load_balance_efficiency_ratio_threshold);
 
@@ -694,6 +766,12 @@ WarpX::ReadParameters ()
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE( nox == noy and nox == noz ,
             "warpx.nox, noy and noz must be equal");
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE( nox >= 1, "warpx.nox must >= 1");
+#ifdef WARPX_PARTICLE_SHAPE
+        // The shape order was fixed at compile time (PARTICLE_SHAPE in the
+        // makefile): only the corresponding kernels were instantiated.
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE( nox == WARPX_PARTICLE_SHAPE,
+            "interpolation.nox must match the compile-time PARTICLE_SHAPE");
+#endif
     }
 
     {
@@ -716,7 +794,8 @@ WarpX::ReadParameters ()
     {
         ParmParse pp("psatd");
         pp.query("periodic_single_box_fft", fft_periodic_single_box);
-        pp.query("fftw_plan_measure", fftw_plan_measure);
+        // Note: `psatd.fftw_plan_measure` and `psatd.fftw_wisdom_file`
+        // are read in SpectralFieldData, when the first FFT plan is created
         pp.query("nox", nox_fft);
         pp.query("noy", noy_fft);
         pp.query("noz", noz_fft);
@@ -783,6 +862,9 @@ WarpX::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& new_grids,
                                 const DistributionMapping& new_dmap)
 {
     AllocLevelData(lev, new_grids, new_dmap);
+    // In the memory dry run AllocLevelData only accounted the footprint
+    // of the level data, so there is nothing to initialize
+    if (MemoryMonitor::DryRun()) return;
     InitLevelData(lev, time);
 }
 
@@ -858,6 +940,28 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         n_field_gather_buffer = n_current_deposition_buffer + 1;
     }
 
+    if (do_current_buffer_bypass && maxLevel() > 0) {
+        // Border particles then deposit on the fine patch like interior
+        // particles (including into its guard cells), and the coarse
+        // patch is filled entirely by the existing fine-to-coarse
+        // restriction: the current deposition buffers are not allocated,
+        // and the partition of the particles into the buffers reduces to
+        // the gather buffers only. The restriction kernel is the adjoint
+        // of linear interpolation at refinement ratio 2, so the bypass
+        // only replaces the coarse deposition of a border particle by a
+        // slightly widened (smoothed) shape; it is restricted to the
+        // low orders where this widening stays within one coarse cell.
+        for (int ilev = 0; ilev < maxLevel(); ++ilev) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(refRatio(ilev) == IntVect(2),
+                "warpx.do_current_buffer_bypass requires a refinement ratio of 2");
+        }
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::nox <= 2,
+            "warpx.do_current_buffer_bypass requires a particle shape order <= 2");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(mypc->nSpeciesDepositOnMainGrid() == 0,
+            "warpx.do_current_buffer_bypass is incompatible with deposit_on_main_grid species");
+        n_current_deposition_buffer = 0;
+    }
+
     AllocLevelMFs(lev, ba, dm, guard_cells.ng_alloc_EB, guard_cells.ng_alloc_J,
                   guard_cells.ng_alloc_Rho, guard_cells.ng_alloc_F,
                   guard_cells.ng_Extra, aux_is_nodal);
@@ -878,43 +982,64 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     ncomps = n_rz_azimuthal_modes*2 - 1;
 #endif
 
+    // Allocate a MultiFab and account its footprint to a subsystem of
+    // the memory monitor (warpx.do_memory_report). In the memory dry run
+    // (warpx.dry_run_memory) the footprint is recorded without
+    // allocating.
+    auto alloc_mf = [&dm](std::unique_ptr<MultiFab>& mf, const BoxArray& mfba,
+                          int nc, const IntVect& ng, const char* label)
+    {
+        MemoryMonitor::Count(label, mfba, dm, nc, ng);
+        if (!MemoryMonitor::DryRun()) {
+            mf.reset( new MultiFab(mfba, dm, nc, ng));
+        }
+    };
+    auto alloc_imf = [&dm](std::unique_ptr<iMultiFab>& mf, const BoxArray& mfba,
+                           int nc, const IntVect& ng, const char* label)
+    {
+        MemoryMonitor::Count(label, mfba, dm, nc, ng, sizeof(int));
+        if (!MemoryMonitor::DryRun()) {
+            mf.reset( new iMultiFab(mfba, dm, nc, ng));
+        }
+    };
+
     //
     // The fine patch
     //
     std::array<Real,3> dx = CellSize(lev);
 
-    Bfield_fp[lev][0].reset( new MultiFab(amrex::convert(ba,Bx_nodal_flag),dm,ncomps,ngE+ngextra));
-    Bfield_fp[lev][1].reset( new MultiFab(amrex::convert(ba,By_nodal_flag),dm,ncomps,ngE+ngextra));
-    Bfield_fp[lev][2].reset( new MultiFab(amrex::convert(ba,Bz_nodal_flag),dm,ncomps,ngE+ngextra));
+    alloc_mf(Bfield_fp[lev][0], amrex::convert(ba,Bx_nodal_flag), ncomps, ngE+ngextra, "E and B (fine patch)");
+    alloc_mf(Bfield_fp[lev][1], amrex::convert(ba,By_nodal_flag), ncomps, ngE+ngextra, "E and B (fine patch)");
+    alloc_mf(Bfield_fp[lev][2], amrex::convert(ba,Bz_nodal_flag), ncomps, ngE+ngextra, "E and B (fine patch)");
 
-    Efield_fp[lev][0].reset( new MultiFab(amrex::convert(ba,Ex_nodal_flag),dm,ncomps,ngE+ngextra));
-    Efield_fp[lev][1].reset( new MultiFab(amrex::convert(ba,Ey_nodal_flag),dm,ncomps,ngE+ngextra));
-    Efield_fp[lev][2].reset( new MultiFab(amrex::convert(ba,Ez_nodal_flag),dm,ncomps,ngE+ngextra));
+    alloc_mf(Efield_fp[lev][0], amrex::convert(ba,Ex_nodal_flag), ncomps, ngE+ngextra, "E and B (fine patch)");
+    alloc_mf(Efield_fp[lev][1], amrex::convert(ba,Ey_nodal_flag), ncomps, ngE+ngextra, "E and B (fine patch)");
+    alloc_mf(Efield_fp[lev][2], amrex::convert(ba,Ez_nodal_flag), ncomps, ngE+ngextra, "E and B (fine patch)");
 
-    current_fp[lev][0].reset( new MultiFab(amrex::convert(ba,jx_nodal_flag),dm,ncomps,ngJ));
-    current_fp[lev][1].reset( new MultiFab(amrex::convert(ba,jy_nodal_flag),dm,ncomps,ngJ));
-    current_fp[lev][2].reset( new MultiFab(amrex::convert(ba,jz_nodal_flag),dm,ncomps,ngJ));
+    alloc_mf(current_fp[lev][0], amrex::convert(ba,jx_nodal_flag), ncomps, ngJ, "current");
+    alloc_mf(current_fp[lev][1], amrex::convert(ba,jy_nodal_flag), ncomps, ngJ, "current");
+    alloc_mf(current_fp[lev][2], amrex::convert(ba,jz_nodal_flag), ncomps, ngJ, "current");
 
     if (do_dive_cleaning || plot_rho)
     {
-        rho_fp[lev].reset(new MultiFab(amrex::convert(ba,rho_nodal_flag),dm,2*ncomps,ngRho));
+        alloc_mf(rho_fp[lev], amrex::convert(ba,rho_nodal_flag), 2*ncomps, ngRho, "rho and F");
     }
 
     if (do_subcycling == 1 && lev == 0)
     {
-        current_store[lev][0].reset( new MultiFab(amrex::convert(ba,jx_nodal_flag),dm,ncomps,ngJ));
-        current_store[lev][1].reset( new MultiFab(amrex::convert(ba,jy_nodal_flag),dm,ncomps,ngJ));
-        current_store[lev][2].reset( new MultiFab(amrex::convert(ba,jz_nodal_flag),dm,ncomps,ngJ));
+        alloc_mf(current_store[lev][0], amrex::convert(ba,jx_nodal_flag), ncomps, ngJ, "current");
+        alloc_mf(current_store[lev][1], amrex::convert(ba,jy_nodal_flag), ncomps, ngJ, "current");
+        alloc_mf(current_store[lev][2], amrex::convert(ba,jz_nodal_flag), ncomps, ngJ, "current");
     }
 
     if (do_dive_cleaning)
     {
-        F_fp[lev].reset  (new MultiFab(amrex::convert(ba,IntVect::TheUnitVector()),dm,ncomps, ngF.max()));
+        alloc_mf(F_fp[lev], amrex::convert(ba,IntVect::TheUnitVector()), ncomps, IntVect(ngF.max()), "rho and F");
     }
 #ifdef WARPX_USE_PSATD
     else
     {
-        rho_fp[lev].reset(new MultiFab(amrex::convert(ba,rho_nodal_flag),dm,2*ncomps,ngRho));
+        alloc_mf(rho_fp[lev], amrex::convert(ba,rho_nodal_flag), 2*ncomps, ngRho, "rho and F");
     }
     // Allocate and initialize the spectral solver
 #   if (AMREX_SPACEDIM == 3)
@@ -930,19 +1055,25 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     // Get the cell-centered box
     BoxArray realspace_ba = ba;  // Copy box
     realspace_ba.enclosedCells(); // Make it cell-centered
-    // Define spectral solver
+    // Define spectral solver (not accounted by the memory monitor and
+    // skipped in the memory dry run; its FFT buffers only show up in the
+    // AMReX Fab totals of a full run)
 #   ifdef WARPX_DIM_RZ
     realspace_ba.grow(1, ngE[1]); // add guard cells only in z
-    spectral_solver_fp[lev].reset( new SpectralSolverRZ( realspace_ba, dm,
-        n_rz_azimuthal_modes, noz_fft, do_nodal, dx_vect, dt[lev], lev ) );
+    if (!MemoryMonitor::DryRun()) {
+        spectral_solver_fp[lev].reset( new SpectralSolverRZ( realspace_ba, dm,
+            n_rz_azimuthal_modes, noz_fft, do_nodal, dx_vect, dt[lev], lev ) );
+    }
 #   else
     if ( fft_periodic_single_box == false ) {
         realspace_ba.grow(ngE); // add guard cells
     }
     bool const pml=false;
-    spectral_solver_fp[lev].reset( new SpectralSolver( realspace_ba, dm,
-        nox_fft, noy_fft, noz_fft, do_nodal, v_galilean, dx_vect, dt[lev],
-        pml, fft_periodic_single_box ) );
+    if (!MemoryMonitor::DryRun()) {
+        spectral_solver_fp[lev].reset( new SpectralSolver( realspace_ba, dm,
+            nox_fft, noy_fft, noz_fft, do_nodal, v_galilean, dx_vect, dt[lev],
+            pml, fft_periodic_single_box ) );
+    }
 #   endif
 #endif
     m_fdtd_solver_fp[lev].reset(
@@ -954,30 +1085,33 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     {
         // Create aux multifabs on Nodal Box Array
         BoxArray const nba = amrex::convert(ba,IntVect::TheNodeVector());
-        Bfield_aux[lev][0].reset( new MultiFab(nba,dm,ncomps,ngE));
-        Bfield_aux[lev][1].reset( new MultiFab(nba,dm,ncomps,ngE));
-        Bfield_aux[lev][2].reset( new MultiFab(nba,dm,ncomps,ngE));
+        alloc_mf(Bfield_aux[lev][0], nba, ncomps, ngE, "E and B (aux)");
+        alloc_mf(Bfield_aux[lev][1], nba, ncomps, ngE, "E and B (aux)");
+        alloc_mf(Bfield_aux[lev][2], nba, ncomps, ngE, "E and B (aux)");
 
-        Efield_aux[lev][0].reset( new MultiFab(nba,dm,ncomps,ngE));
-        Efield_aux[lev][1].reset( new MultiFab(nba,dm,ncomps,ngE));
-        Efield_aux[lev][2].reset( new MultiFab(nba,dm,ncomps,ngE));
+        alloc_mf(Efield_aux[lev][0], nba, ncomps, ngE, "E and B (aux)");
+        alloc_mf(Efield_aux[lev][1], nba, ncomps, ngE, "E and B (aux)");
+        alloc_mf(Efield_aux[lev][2], nba, ncomps, ngE, "E and B (aux)");
     }
     else if (lev == 0)
     {
-        for (int idir = 0; idir < 3; ++idir) {
-            Efield_aux[lev][idir].reset(new MultiFab(*Efield_fp[lev][idir], amrex::make_alias, 0, ncomps));
-            Bfield_aux[lev][idir].reset(new MultiFab(*Bfield_fp[lev][idir], amrex::make_alias, 0, ncomps));
+        // aliases of the fine patch: no memory of their own
+        if (!MemoryMonitor::DryRun()) {
+            for (int idir = 0; idir < 3; ++idir) {
+                Efield_aux[lev][idir].reset(new MultiFab(*Efield_fp[lev][idir], amrex::make_alias, 0, ncomps));
+                Bfield_aux[lev][idir].reset(new MultiFab(*Bfield_fp[lev][idir], amrex::make_alias, 0, ncomps));
+            }
         }
     }
     else
     {
-        Bfield_aux[lev][0].reset( new MultiFab(amrex::convert(ba,Bx_nodal_flag),dm,ncomps,ngE));
-        Bfield_aux[lev][1].reset( new MultiFab(amrex::convert(ba,By_nodal_flag),dm,ncomps,ngE));
-        Bfield_aux[lev][2].reset( new MultiFab(amrex::convert(ba,Bz_nodal_flag),dm,ncomps,ngE));
+        alloc_mf(Bfield_aux[lev][0], amrex::convert(ba,Bx_nodal_flag), ncomps, ngE, "E and B (aux)");
+        alloc_mf(Bfield_aux[lev][1], amrex::convert(ba,By_nodal_flag), ncomps, ngE, "E and B (aux)");
+        alloc_mf(Bfield_aux[lev][2], amrex::convert(ba,Bz_nodal_flag), ncomps, ngE, "E and B (aux)");
 
-        Efield_aux[lev][0].reset( new MultiFab(amrex::convert(ba,Ex_nodal_flag),dm,ncomps,ngE));
-        Efield_aux[lev][1].reset( new MultiFab(amrex::convert(ba,Ey_nodal_flag),dm,ncomps,ngE));
-        Efield_aux[lev][2].reset( new MultiFab(amrex::convert(ba,Ez_nodal_flag),dm,ncomps,ngE));
+        alloc_mf(Efield_aux[lev][0], amrex::convert(ba,Ex_nodal_flag), ncomps, ngE, "E and B (aux)");
+        alloc_mf(Efield_aux[lev][1], amrex::convert(ba,Ey_nodal_flag), ncomps, ngE, "E and B (aux)");
+        alloc_mf(Efield_aux[lev][2], amrex::convert(ba,Ez_nodal_flag), ncomps, ngE, "E and B (aux)");
     }
 
     //
@@ -990,31 +1124,31 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         std::array<Real,3> cdx = CellSize(lev-1);
 
         // Create the MultiFabs for B
-        Bfield_cp[lev][0].reset( new MultiFab(amrex::convert(cba,Bx_nodal_flag),dm,ncomps,ngE));
-        Bfield_cp[lev][1].reset( new MultiFab(amrex::convert(cba,By_nodal_flag),dm,ncomps,ngE));
-        Bfield_cp[lev][2].reset( new MultiFab(amrex::convert(cba,Bz_nodal_flag),dm,ncomps,ngE));
+        alloc_mf(Bfield_cp[lev][0], amrex::convert(cba,Bx_nodal_flag), ncomps, ngE, "E and B (coarse patch)");
+        alloc_mf(Bfield_cp[lev][1], amrex::convert(cba,By_nodal_flag), ncomps, ngE, "E and B (coarse patch)");
+        alloc_mf(Bfield_cp[lev][2], amrex::convert(cba,Bz_nodal_flag), ncomps, ngE, "E and B (coarse patch)");
 
         // Create the MultiFabs for E
-        Efield_cp[lev][0].reset( new MultiFab(amrex::convert(cba,Ex_nodal_flag),dm,ncomps,ngE));
-        Efield_cp[lev][1].reset( new MultiFab(amrex::convert(cba,Ey_nodal_flag),dm,ncomps,ngE));
-        Efield_cp[lev][2].reset( new MultiFab(amrex::convert(cba,Ez_nodal_flag),dm,ncomps,ngE));
+        alloc_mf(Efield_cp[lev][0], amrex::convert(cba,Ex_nodal_flag), ncomps, ngE, "E and B (coarse patch)");
+        alloc_mf(Efield_cp[lev][1], amrex::convert(cba,Ey_nodal_flag), ncomps, ngE, "E and B (coarse patch)");
+        alloc_mf(Efield_cp[lev][2], amrex::convert(cba,Ez_nodal_flag), ncomps, ngE, "E and B (coarse patch)");
 
         // Create the MultiFabs for the current
-        current_cp[lev][0].reset( new MultiFab(amrex::convert(cba,jx_nodal_flag),dm,ncomps,ngJ));
-        current_cp[lev][1].reset( new MultiFab(amrex::convert(cba,jy_nodal_flag),dm,ncomps,ngJ));
-        current_cp[lev][2].reset( new MultiFab(amrex::convert(cba,jz_nodal_flag),dm,ncomps,ngJ));
+        alloc_mf(current_cp[lev][0], amrex::convert(cba,jx_nodal_flag), ncomps, ngJ, "current");
+        alloc_mf(current_cp[lev][1], amrex::convert(cba,jy_nodal_flag), ncomps, ngJ, "current");
+        alloc_mf(current_cp[lev][2], amrex::convert(cba,jz_nodal_flag), ncomps, ngJ, "current");
 
         if (do_dive_cleaning || plot_rho){
-            rho_cp[lev].reset(new MultiFab(amrex::convert(cba,rho_nodal_flag),dm,2*ncomps,ngRho));
+            alloc_mf(rho_cp[lev], amrex::convert(cba,rho_nodal_flag), 2*ncomps, ngRho, "rho and F");
         }
         if (do_dive_cleaning)
         {
-            F_cp[lev].reset  (new MultiFab(amrex::convert(cba,IntVect::TheUnitVector()),dm,ncomps, ngF.max()));
+            alloc_mf(F_cp[lev], amrex::convert(cba,IntVect::TheUnitVector()), ncomps, IntVect(ngF.max()), "rho and F");
         }
 #ifdef WARPX_USE_PSATD
         else
         {
-            rho_cp[lev].reset(new MultiFab(amrex::convert(cba,rho_nodal_flag),dm,2*ncomps,ngRho));
+            alloc_mf(rho_cp[lev], amrex::convert(cba,rho_nodal_flag), 2*ncomps, ngRho, "rho and F");
         }
         // Allocate and initialize the spectral solver
 #   if (AMREX_SPACEDIM == 3)
@@ -1028,12 +1162,16 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         // Define spectral solver
 #   ifdef WARPX_DIM_RZ
         realspace_ba.grow(1, ngE[1]); // add guard cells only in z
-        spectral_solver_cp[lev].reset( new SpectralSolverRZ( realspace_ba, dm,
-            n_rz_azimuthal_modes, noz_fft, do_nodal, cdx_vect, dt[lev], lev ) );
+        if (!MemoryMonitor::DryRun()) {
+            spectral_solver_cp[lev].reset( new SpectralSolverRZ( realspace_ba, dm,
+                n_rz_azimuthal_modes, noz_fft, do_nodal, cdx_vect, dt[lev], lev ) );
+        }
 #   else
         realspace_ba.grow(ngE); // add guard cells
-        spectral_solver_cp[lev].reset( new SpectralSolver( realspace_ba, dm,
-            nox_fft, noy_fft, noz_fft, do_nodal, v_galilean, cdx_vect, dt[lev] ) );
+        if (!MemoryMonitor::DryRun()) {
+            spectral_solver_cp[lev].reset( new SpectralSolver( realspace_ba, dm,
+                nox_fft, noy_fft, noz_fft, do_nodal, v_galilean, cdx_vect, dt[lev] ) );
+        }
 #   endif
 #endif
         m_fdtd_solver_cp[lev].reset(
@@ -1052,37 +1190,45 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         if (n_field_gather_buffer > 0 || mypc->nSpeciesGatherFromMainGrid() > 0) {
             if (aux_is_nodal) {
                 BoxArray const& cnba = amrex::convert(cba,IntVect::TheNodeVector());
-                Bfield_cax[lev][0].reset( new MultiFab(cnba,dm,ncomps,ngE));
-                Bfield_cax[lev][1].reset( new MultiFab(cnba,dm,ncomps,ngE));
-                Bfield_cax[lev][2].reset( new MultiFab(cnba,dm,ncomps,ngE));
-                Efield_cax[lev][0].reset( new MultiFab(cnba,dm,ncomps,ngE));
-                Efield_cax[lev][1].reset( new MultiFab(cnba,dm,ncomps,ngE));
-                Efield_cax[lev][2].reset( new MultiFab(cnba,dm,ncomps,ngE));
+                alloc_mf(Bfield_cax[lev][0], cnba, ncomps, ngE, "buffers and masks");
+                alloc_mf(Bfield_cax[lev][1], cnba, ncomps, ngE, "buffers and masks");
+                alloc_mf(Bfield_cax[lev][2], cnba, ncomps, ngE, "buffers and masks");
+                alloc_mf(Efield_cax[lev][0], cnba, ncomps, ngE, "buffers and masks");
+                alloc_mf(Efield_cax[lev][1], cnba, ncomps, ngE, "buffers and masks");
+                alloc_mf(Efield_cax[lev][2], cnba, ncomps, ngE, "buffers and masks");
             } else {
                 // Create the MultiFabs for B
-                Bfield_cax[lev][0].reset( new MultiFab(amrex::convert(cba,Bx_nodal_flag),dm,ncomps,ngE));
-                Bfield_cax[lev][1].reset( new MultiFab(amrex::convert(cba,By_nodal_flag),dm,ncomps,ngE));
-                Bfield_cax[lev][2].reset( new MultiFab(amrex::convert(cba,Bz_nodal_flag),dm,ncomps,ngE));
+                alloc_mf(Bfield_cax[lev][0], amrex::convert(cba,Bx_nodal_flag), ncomps, ngE, "buffers and masks");
+                alloc_mf(Bfield_cax[lev][1], amrex::convert(cba,By_nodal_flag), ncomps, ngE, "buffers and masks");
+                alloc_mf(Bfield_cax[lev][2], amrex::convert(cba,Bz_nodal_flag), ncomps, ngE, "buffers and masks");
 
                 // Create the MultiFabs for E
-                Efield_cax[lev][0].reset( new MultiFab(amrex::convert(cba,Ex_nodal_flag),dm,ncomps,ngE));
-                Efield_cax[lev][1].reset( new MultiFab(amrex::convert(cba,Ey_nodal_flag),dm,ncomps,ngE));
-                Efield_cax[lev][2].reset( new MultiFab(amrex::convert(cba,Ez_nodal_flag),dm,ncomps,ngE));
+                alloc_mf(Efield_cax[lev][0], amrex::convert(cba,Ex_nodal_flag), ncomps, ngE, "buffers and masks");
+                alloc_mf(Efield_cax[lev][1], amrex::convert(cba,Ey_nodal_flag), ncomps, ngE, "buffers and masks");
+                alloc_mf(Efield_cax[lev][2], amrex::convert(cba,Ez_nodal_flag), ncomps, ngE, "buffers and masks");
             }
 
-            gather_buffer_masks[lev].reset( new iMultiFab(ba, dm, ncomps, 1) );
+            alloc_imf(gather_buffer_masks[lev], ba, ncomps, IntVect(1), "buffers and masks");
             // Gather buffer masks have 1 ghost cell, because of the fact
             // that particles may move by more than one cell when using subcycling.
         }
 
         if (n_current_deposition_buffer > 0) {
-            current_buf[lev][0].reset( new MultiFab(amrex::convert(cba,jx_nodal_flag),dm,ncomps,ngJ));
-            current_buf[lev][1].reset( new MultiFab(amrex::convert(cba,jy_nodal_flag),dm,ncomps,ngJ));
-            current_buf[lev][2].reset( new MultiFab(amrex::convert(cba,jz_nodal_flag),dm,ncomps,ngJ));
-            if (rho_cp[lev]) {
-                charge_buf[lev].reset( new MultiFab(amrex::convert(cba,rho_nodal_flag),dm,2*ncomps,ngRho));
+            alloc_mf(current_buf[lev][0], amrex::convert(cba,jx_nodal_flag), ncomps, ngJ, "buffers and masks");
+            alloc_mf(current_buf[lev][1], amrex::convert(cba,jy_nodal_flag), ncomps, ngJ, "buffers and masks");
+            alloc_mf(current_buf[lev][2], amrex::convert(cba,jz_nodal_flag), ncomps, ngJ, "buffers and masks");
+            // rho_cp exists with div(E) cleaning, plot_rho or PSATD
+            // (do not test the pointer itself: it is left unset in the
+            // memory dry run)
+#ifdef WARPX_USE_PSATD
+            const bool has_rho_cp = true;
+#else
+            const bool has_rho_cp = (do_dive_cleaning || plot_rho);
+#endif
+            if (has_rho_cp) {
+                alloc_mf(charge_buf[lev], amrex::convert(cba,rho_nodal_flag), 2*ncomps, ngRho, "buffers and masks");
             }
-            current_buffer_masks[lev].reset( new iMultiFab(ba, dm, ncomps, 1) );
+            alloc_imf(current_buffer_masks[lev], ba, ncomps, IntVect(1), "buffers and masks");
             // Current buffer masks have 1 ghost cell, because of the fact
             // that particles may move by more than one cell when using subcycling.
         }
@@ -1091,8 +1237,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     if (load_balance_int > 0)
     {
         costs[lev].reset(new amrex::Vector<Real>);
-        const int nboxes = Efield_fp[lev][0].get()->size();
-        costs[lev]->resize(nboxes);
+        costs[lev]->resize(ba.size());
     }
 }
 
@@ -0,0 +1,282 @@
+# Copyright 2020 WarpX developers
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+End-to-end scaling regression harness driven by the Regression test inputs.
+
+The correctness suite in `Regression/WarpX-tests.ini` already covers the
+relevant solver variants (FDTD, PSATD, RZ, QED, ...). This harness reuses
+those inputs to catch *performance* regressions: it runs a selection of
+tests for a fixed number of steps at several MPI rank counts, extracts the
+per-region timers from the TinyProfiler tables that WarpX prints at the
+end of every run, and compares them against stored baselines, failing
+loudly when a timer slows down by more than a given tolerance.
+
+The executable must be compiled with `TINY_PROFILE=TRUE` (the default).
+Since the different suites require different builds (RZ, PSATD and QED are
+compile-time options), the harness is meant to be invoked once per build,
+e.g. nightly:
+
+    python run_scaling_regression.py --executable <path/to/main3d...ex> \
+        --suite fdtd --ranks 1,2,4,8 --baseline baseline_fdtd_$(hostname).json
+
+Record (or refresh) the baselines with `--update-baseline`. Baselines are
+machine- and build-specific: store one file per (machine, suite).
+"""
+
+import argparse
+import configparser
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+# Representative tests per build variant. Every entry is a section of
+# Regression/WarpX-tests.ini ; all tests of a suite run with the same
+# executable.
+test_suites = {
+    'fdtd':  ['Langmuir_multi', 'LaserAcceleration'],
+    'fdtd2d':['Langmuir_2d', 'LaserInjection_2d'],
+    'psatd': ['Langmuir_multi_psatd'],
+    'rz':    ['Langmuir_multi_rz'],
+    'qed':   ['qed_breit_wheeler_opt_depth_evolution'],
+}
+
+# Header lines delimiting the TinyProfiler tables in the standard output.
+# The first exclusive table refers to the complete run.
+excl_table_header = 'NCalls  Excl. Min  Excl. Avg  Excl. Max   Max %'
+incl_table_header = 'NCalls  Incl. Min  Incl. Avg  Incl. Max   Max %'
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Run Regression inputs at several rank counts and '
+                    'compare the TinyProfiler timers against stored baselines')
+    parser.add_argument('--executable', required=True,
+                        help='WarpX executable, compiled with TINY_PROFILE=TRUE '
+                             'and the options required by the selected suite')
+    parser.add_argument('--suite', default='fdtd',
+                        choices=sorted(test_suites.keys()),
+                        help='predefined list of tests matching one build variant')
+    parser.add_argument('--tests', default=None,
+                        help='comma-separated list of sections of WarpX-tests.ini '
+                             '(overrides --suite)')
+    parser.add_argument('--ranks', default='1,2,4,8',
+                        help='comma-separated list of MPI rank counts')
+    parser.add_argument('--max-step', type=int, default=10,
+                        help='fixed number of steps to run each test for')
+    parser.add_argument('--mpi-command', default='mpiexec -n @nprocs@ @command@',
+                        help='command template, with the same placeholders as '
+                             'the MPIcommand entry of WarpX-tests.ini')
+    parser.add_argument('--threads', type=int, default=1,
+                        help='value of OMP_NUM_THREADS for the runs')
+    parser.add_argument('--baseline', default='perf_baseline.json',
+                        help='JSON file holding the reference timers')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the measured timers as the new baselines '
+                             'instead of comparing')
+    parser.add_argument('--tolerance', type=float, default=0.05,
+                        help='relative slowdown above which a timer is '
+                             'reported as a regression')
+    parser.add_argument('--min-time', type=float, default=0.05,
+                        help='baseline timers below this value (in seconds) are '
+                             'not compared, to stay above the noise floor')
+    parser.add_argument('--warpx-dir', default=None,
+                        help='WarpX source directory (defaults to two levels '
+                             'above this script)')
+    parser.add_argument('--results-dir', default='perf_results',
+                        help='directory where the run outputs are written')
+    parser.add_argument('--dry-run', action='store_true',
+                        help='print the run commands without executing them')
+    return parser.parse_args()
+
+
+def read_test_sections(warpx_dir, test_names):
+    """Read the requested sections of Regression/WarpX-tests.ini"""
+    ini_file = os.path.join(warpx_dir, 'Regression', 'WarpX-tests.ini')
+    config = configparser.RawConfigParser(strict=False)
+    config.read(ini_file)
+    tests = {}
+    for name in test_names:
+        if not config.has_section(name):
+            sys.exit('ERROR: test "%s" is not a section of %s' % (name, ini_file))
+        tests[name] = {
+            'input_file': os.path.join(warpx_dir, config.get(name, 'inputFile')),
+            'runtime_params': config.get(name, 'runtime_params', fallback=''),
+        }
+    return tests
+
+
+def run_command(mpi_command, nprocs, executable, test, max_step, log_file,
+                threads, dry_run):
+    """Run one test at one rank count and write its output to `log_file`"""
+    command = '%s %s %s max_step=%d amr.plot_int=-1' % (
+        executable, test['input_file'], test['runtime_params'], max_step)
+    command = mpi_command.replace('@nprocs@', str(nprocs)) \
+                         .replace('@command@', command)
+    if dry_run:
+        print(command)
+        return True
+    env = dict(os.environ)
+    env['OMP_NUM_THREADS'] = str(threads)
+    with open(log_file, 'w') as log_handler:
+        exit_code = subprocess.call(shlex.split(command), stdout=log_handler,
+                                    stderr=subprocess.STDOUT, env=env)
+    if exit_code != 0:
+        print('ERROR: "%s" failed (exit code %d), see %s'
+              % (command, exit_code, log_file))
+    return exit_code == 0
+
+
+def parse_tiny_profiler(log_file):
+    """Extract the timers of one run from the TinyProfiler tables
+
+    Returns a dict with the total run time, the inclusive time of
+    WarpX::Evolve() and the average exclusive time of each profiled
+    region (for the complete run).
+    """
+    with open(log_file) as log_handler:
+        output_text = log_handler.read()
+    timers = {}
+    # Total simulation time
+    line_match = re.search('TinyProfiler total time across processes.*',
+                           output_text)
+    if line_match is None:
+        return None
+    timers['total_time'] = float(line_match.group(0).split()[8])
+    # Time stepping, as the inclusive time of WarpX::Evolve()
+    search_area = output_text.partition(incl_table_header)[2]
+    line_match = re.search(r'\nWarpX::Evolve\(\).*', search_area)
+    timers['evolve_time'] = float(line_match.group(0).split()[3])
+    # Average exclusive time of every region of the complete run
+    search_area = output_text.partition(excl_table_header)[2] \
+                             .partition(incl_table_header)[0]
+    regions = {}
+    row = re.compile(r'^(\S+)\s+\d+\s+\S+\s+(\S+)\s+\S+\s+\S+%$')
+    for line in search_area.split('\n'):
+        line_match = row.match(line.strip())
+        if line_match is not None:
+            regions[line_match.group(1)] = float(line_match.group(2))
+    timers['regions'] = regions
+    return timers
+
+
+def compare_timers(measured, baseline, tolerance, min_time):
+    """Compare one run against its baseline
+
+    Returns the list of regressions, as (timer name, baseline time,
+    measured time) tuples. Timers below `min_time` in the baseline, and
+    timers present on only one side, are ignored.
+    """
+    regressions = []
+    flat_baseline = dict(baseline.get('regions', {}),
+                         total_time=baseline.get('total_time'),
+                         evolve_time=baseline.get('evolve_time'))
+    flat_measured = dict(measured['regions'],
+                         total_time=measured['total_time'],
+                         evolve_time=measured['evolve_time'])
+    for name, ref in sorted(flat_baseline.items()):
+        if ref is None or ref < min_time or name not in flat_measured:
+            continue
+        new = flat_measured[name]
+        if new > ref*(1. + tolerance):
+            regressions.append((name, ref, new))
+    return regressions
+
+
+def main():
+    args = parse_args()
+    warpx_dir = args.warpx_dir
+    if warpx_dir is None:
+        warpx_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                 '..', '..')
+    test_names = test_suites[args.suite]
+    if args.tests is not None:
+        test_names = args.tests.split(',')
+    rank_list = [int(n) for n in args.ranks.split(',')]
+    tests = read_test_sections(warpx_dir, test_names)
+    executable = os.path.abspath(args.executable)
+    if not args.dry_run:
+        os.makedirs(args.results_dir, exist_ok=True)
+
+    # Run all (test, rank count) combinations and collect their timers
+    measured = {}
+    failed_runs = 0
+    for name in test_names:
+        measured[name] = {}
+        for nprocs in rank_list:
+            log_file = os.path.join(args.results_dir,
+                                    '%s_%dranks.txt' % (name, nprocs))
+            ok = run_command(args.mpi_command, nprocs, executable, tests[name],
+                             args.max_step, log_file, args.threads,
+                             args.dry_run)
+            if args.dry_run:
+                continue
+            timers = parse_tiny_profiler(log_file) if ok else None
+            if timers is None:
+                print('ERROR: no TinyProfiler tables found for %s at %d ranks '
+                      '(is the executable compiled with TINY_PROFILE=TRUE?)'
+                      % (name, nprocs))
+                failed_runs += 1
+                continue
+            measured[name][str(nprocs)] = timers
+    if args.dry_run:
+        return
+
+    if args.update_baseline:
+        # Merge into the existing file, so that suites sharing a baseline
+        # file and runs with different rank lists do not clobber each other
+        baselines = {}
+        if os.path.isfile(args.baseline):
+            with open(args.baseline) as baseline_handler:
+                baselines = json.load(baseline_handler)
+        for name in measured:
+            baselines.setdefault(name, {}).update(measured[name])
+        with open(args.baseline, 'w') as baseline_handler:
+            json.dump(baselines, baseline_handler, indent=2, sort_keys=True)
+        print('Baselines written to %s' % args.baseline)
+        sys.exit(1 if failed_runs else 0)
+
+    if not os.path.isfile(args.baseline):
+        sys.exit('ERROR: baseline file %s not found ; record it first with '
+                 '--update-baseline' % args.baseline)
+    with open(args.baseline) as baseline_handler:
+        baselines = json.load(baseline_handler)
+
+    # Compare every run against its baseline and report
+    total_regressions = 0
+    for name in test_names:
+        for nprocs in rank_list:
+            key = str(nprocs)
+            if key not in measured.get(name, {}):
+                continue
+            if key not in baselines.get(name, {}):
+                print('WARNING: no baseline for %s at %d ranks, skipping '
+                      'comparison' % (name, nprocs))
+                continue
+            regressions = compare_timers(measured[name][key],
+                                         baselines[name][key],
+                                         args.tolerance, args.min_time)
+            status = 'FAIL' if regressions else 'PASS'
+            print('[%s] %s at %d ranks (evolve: %.3fs, baseline %.3fs)'
+                  % (status, name, nprocs,
+                     measured[name][key]['evolve_time'],
+                     baselines[name][key].get('evolve_time', float('nan'))))
+            for timer, ref, new in regressions:
+                print('    %-40s %9.3fs -> %9.3fs  (+%.1f%%)'
+                      % (timer, ref, new, 100.*(new/ref - 1.)))
+            total_regressions += len(regressions)
+
+    if total_regressions or failed_runs:
+        sys.exit('%d regression(s) above %.0f%% tolerance, %d failed run(s)'
+                 % (total_regressions, 100.*args.tolerance, failed_runs))
+    print('No regressions above %.0f%% tolerance' % (100.*args.tolerance))
+
+
+if __name__ == '__main__':
+    main()